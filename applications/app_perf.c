@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include "app_perf.h"
+#include "lvgl.h"
+#include "main.h"
+
+/* 帧预算：与LVGL刷新周期一致 */
+#define APP_FRAME_BUDGET_US     (LV_DISP_DEF_REFR_PERIOD * 1000)
+
+static app_frame_stats_t frame_stats;
+static rt_uint32_t frame_start;          /* 周期计数 */
+static rt_uint64_t frame_total_us;
+
+/* 初始化微秒时钟，Cortex-M7上使用DWT周期计数器 */
+void app_perf_init(void)
+{
+#ifdef DWT
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    app_perf_reset_frame_stats();
+}
+
+/* 获取当前周期计数，没有DWT时为系统节拍数。
+ * 先换算成微秒再相减会在计数回绕时（480MHz时约8.9秒）得到很大的差值，所以只换算差值 */
+rt_uint32_t app_perf_now_cycles(void)
+{
+#ifdef DWT
+    return DWT->CYCCNT;
+#else
+    return rt_tick_get();
+#endif
+}
+
+rt_uint32_t app_perf_cycles_to_us(rt_uint32_t cycles)
+{
+#ifdef DWT
+    return cycles / (SystemCoreClock / 1000000);
+#else
+    return cycles * (1000000 / RT_TICK_PER_SECOND);
+#endif
+}
+
+rt_uint32_t app_perf_elapsed_us(rt_uint32_t start)
+{
+    return app_perf_cycles_to_us(app_perf_now_cycles() - start);
+}
+
+/* ==================== 帧时间统计 ==================== */
+
+void app_perf_frame_begin(void)
+{
+    frame_start = app_perf_now_cycles();
+}
+
+void app_perf_frame_end(void)
+{
+    rt_uint32_t us = app_perf_elapsed_us(frame_start);
+    rt_uint32_t diff;
+
+    if (frame_stats.frames > 0)
+    {
+        diff = (us > frame_stats.last_us) ? us - frame_stats.last_us : frame_stats.last_us - us;
+        if (diff > frame_stats.jitter_us)
+            frame_stats.jitter_us = diff;
+    }
+
+    frame_stats.frames++;
+    frame_stats.last_us = us;
+    frame_total_us += us;
+    if (us < frame_stats.min_us)
+        frame_stats.min_us = us;
+    if (us > frame_stats.max_us)
+        frame_stats.max_us = us;
+    if (us > APP_FRAME_BUDGET_US)
+        frame_stats.over_budget++;
+}
+
+void app_perf_get_frame_stats(app_frame_stats_t *stats)
+{
+    *stats = frame_stats;
+    if (frame_stats.frames > 0)
+        stats->avg_us = (rt_uint32_t)(frame_total_us / frame_stats.frames);
+}
+
+rt_uint32_t app_perf_last_frame_us(void)
+{
+    return frame_stats.last_us;
+}
+
+void app_perf_reset_frame_stats(void)
+{
+    rt_memset(&frame_stats, 0, sizeof(frame_stats));
+    frame_stats.min_us = 0xFFFFFFFF;
+    frame_total_us = 0;
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static void frame_stats_cmd(int argc, char **argv)
+{
+    app_frame_stats_t stats;
+
+    if (argc > 1 && rt_strcmp(argv[1], "reset") == 0)
+    {
+        app_perf_reset_frame_stats();
+        return;
+    }
+
+    app_perf_get_frame_stats(&stats);
+    if (stats.frames == 0)
+    {
+        rt_kprintf("no frames recorded\n");
+        return;
+    }
+    rt_kprintf("frames: %d, over budget (%d us): %d\n",
+               stats.frames, APP_FRAME_BUDGET_US, stats.over_budget);
+    rt_kprintf("frame time: last %d, min %d, avg %d, max %d us\n",
+               stats.last_us, stats.min_us, stats.avg_us, stats.max_us);
+    rt_kprintf("jitter: %d us\n", stats.jitter_us);
+}
+MSH_CMD_EXPORT_ALIAS(frame_stats_cmd, frame_stats, show LVGL frame time statistics [reset]);
+#endif /* RT_USING_FINSH */
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __APP_PERF_H__
+#define __APP_PERF_H__
+
+#include <rtthread.h>
+
+/* 帧时间统计，单位为微秒 */
+typedef struct {
+    rt_uint32_t frames;         /* 统计的帧数 */
+    rt_uint32_t last_us;        /* 最近一帧的处理时间 */
+    rt_uint32_t min_us;
+    rt_uint32_t max_us;
+    rt_uint32_t avg_us;
+    rt_uint32_t jitter_us;      /* 相邻两帧处理时间差的最大值 */
+    rt_uint32_t over_budget;    /* 超出帧预算的帧数 */
+} app_frame_stats_t;
+
+void app_perf_init(void);
+/* 周期计数（会回绕），时间差用rt_uint32_t相减后再换算，间隔不能超过一个计数周期（480MHz时约8.9秒） */
+rt_uint32_t app_perf_now_cycles(void);
+rt_uint32_t app_perf_cycles_to_us(rt_uint32_t cycles);
+/* 从start（app_perf_now_cycles的返回值）到现在的微秒数 */
+rt_uint32_t app_perf_elapsed_us(rt_uint32_t start);
+
+void app_perf_frame_begin(void);
+void app_perf_frame_end(void);
+void app_perf_get_frame_stats(app_frame_stats_t *stats);
+rt_uint32_t app_perf_last_frame_us(void);
+void app_perf_reset_frame_stats(void);
+
+#endif /* __APP_PERF_H__ */
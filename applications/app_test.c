@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include "app_test.h"
+
+#ifdef APP_USING_TEST
+
+static rt_uint32_t test_seed = 1;
+
+static const char *test_words[] = {
+    "buy", "milk", "call", "review", "report", "fix", "printer", "send", "invoice",
+    "book", "flight", "update", "firmware", "clean", "garage", "plan", "meeting",
+    "write", "draft", "order", "parts", "check", "sensor", "backup", "server",
+};
+#define TEST_WORD_NUM (sizeof(test_words) / sizeof(test_words[0]))
+
+void app_test_srand(rt_uint32_t seed)
+{
+    test_seed = seed;
+}
+
+rt_uint32_t app_test_rand(rt_uint32_t n)
+{
+    test_seed = test_seed * 1103515245 + 12345;
+    return (test_seed >> 8) % n;
+}
+
+const char *app_test_word(void)
+{
+    return test_words[app_test_rand(TEST_WORD_NUM)];
+}
+
+void app_test_make_task(task_info_t *task, rt_uint32_t n, rt_uint32_t lists)
+{
+    rt_memset(task, 0, sizeof(task_info_t));
+    task->list_num = 1 + app_test_rand(lists);
+    task->task_num = n;
+    task->status = (app_test_rand(4) == 0) ? TASK_STATUS_PENDING : TASK_STATUS_OPEN;
+    rt_snprintf(task->title, sizeof(task->title), "%s %s %s %d",
+                app_test_word(), app_test_word(), app_test_word(), n);
+    rt_snprintf(task->list_name, sizeof(task->list_name), "List %d", task->list_num);
+    task->is_valid = true;
+}
+
+#endif /* APP_USING_TEST */
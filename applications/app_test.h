@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __APP_TEST_H__
+#define __APP_TEST_H__
+
+#include <rtthread.h>
+#include "task_model.h"
+
+/* 自测、模拟和基准命令（*_test、*_sim、*_bench）和它们共用的测试工具。
+ * 只在rtconfig.h中定义了APP_USING_TEST时编译，正式固件不定义，这些代码都不进入固件 */
+
+#if defined(APP_USING_TEST) && !defined(RT_USING_FINSH)
+#error "APP_USING_TEST needs RT_USING_FINSH, the tests run as msh commands"
+#endif
+
+#ifdef APP_USING_TEST
+
+/* 可重复的伪随机序列（线性同余），每个测试开始时设置种子 */
+void app_test_srand(rt_uint32_t seed);
+/* 返回[0, n)中的数，n不能为0 */
+rt_uint32_t app_test_rand(rt_uint32_t n);
+
+/* 随机的常用词，用于生成标题和搜索词 */
+const char *app_test_word(void);
+/* 生成测试任务：编号n，随机分到1~lists号列表，标题为三个常用词加编号，约四分之一为等待状态 */
+void app_test_make_task(task_info_t *task, rt_uint32_t n, rt_uint32_t lists);
+
+#endif /* APP_USING_TEST */
+
+#endif /* __APP_TEST_H__ */
@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include <string.h>
+#include "beam_sched.h"
+
+/* 帧号比较，允许计数回绕 */
+static bool frame_before(rt_uint32_t a, rt_uint32_t b)
+{
+    return (rt_int32_t)(a - b) < 0;
+}
+
+/* 该条带在它的帧里已经开始扫描 */
+static bool band_passed(const beam_sched_t *s, rt_uint32_t frame, rt_uint16_t band)
+{
+    if (frame_before(frame, s->scan_frame))
+        return true;
+    return frame == s->scan_frame && s->scan_band >= (rt_int16_t)band;
+}
+
+/* 释放扫描完的缓冲和错过了扫描的缓冲 */
+static rt_uint32_t release_slots(beam_sched_t *s)
+{
+    rt_uint32_t released = 0;
+    rt_uint8_t i;
+
+    for (i = 0; i < s->slots; i++)
+    {
+        beam_slot_t *slot = &s->slot[i];
+
+        if (slot->state == BEAM_SLOT_SCANNING)
+        {
+            slot->state = BEAM_SLOT_FREE;
+            released |= 1u << i;
+        }
+        else if (slot->state == BEAM_SLOT_READY && band_passed(s, slot->frame, slot->band))
+        {
+            slot->state = BEAM_SLOT_FREE;
+            released |= 1u << i;
+            s->stats.late++;
+        }
+    }
+    return released;
+}
+
+rt_err_t beam_sched_init(beam_sched_t *s, rt_uint16_t lines, rt_uint16_t band_lines, rt_uint8_t slots)
+{
+    if (lines == 0 || band_lines == 0 || band_lines > lines || slots < 2 || slots > BEAM_SCHED_MAX_SLOTS)
+        return -RT_EINVAL;
+
+    memset(s, 0, sizeof(*s));
+    s->lines = lines;
+    s->band_lines = band_lines;
+    s->bands = (lines + band_lines - 1) / band_lines;
+    s->slots = slots;
+    s->scan_band = -1;
+    s->frame_full = true;
+    return RT_EOK;
+}
+
+bool beam_sched_slot_free(const beam_sched_t *s, rt_uint8_t slot)
+{
+    return slot < s->slots && s->slot[slot].state == BEAM_SLOT_FREE;
+}
+
+rt_err_t beam_sched_begin(beam_sched_t *s, rt_uint8_t slot, rt_uint16_t band)
+{
+    beam_slot_t *sl;
+
+    if (slot >= s->slots || band >= s->bands)
+        return -RT_EINVAL;
+    sl = &s->slot[slot];
+    if (sl->state != BEAM_SLOT_FREE)
+        return -RT_EBUSY;
+
+    if (band == 0)
+        s->render_frame = (s->scan_band < 0) ? s->scan_frame : s->scan_frame + 1;
+
+    sl->state = BEAM_SLOT_RENDERING;
+    sl->band = band;
+    sl->frame = s->render_frame;
+    return RT_EOK;
+}
+
+bool beam_sched_submit(beam_sched_t *s, rt_uint8_t slot)
+{
+    beam_slot_t *sl;
+
+    if (slot >= s->slots || s->slot[slot].state != BEAM_SLOT_RENDERING)
+        return false;
+    sl = &s->slot[slot];
+
+    if (band_passed(s, sl->frame, sl->band))
+    {
+        sl->state = BEAM_SLOT_FREE;
+        s->stats.late++;
+        return false;
+    }
+
+    sl->state = BEAM_SLOT_READY;
+    s->stats.rendered++;
+    return true;
+}
+
+int beam_sched_band_start(beam_sched_t *s, rt_uint16_t band, rt_uint32_t *released)
+{
+    rt_uint32_t mask = 0;
+    int idx = -1;
+    rt_uint8_t i;
+
+    if (band >= s->bands)
+    {
+        *released = 0;
+        return -1;
+    }
+
+    /* 漏掉了消隐期的中断 */
+    if (s->scan_band >= (rt_int16_t)band)
+        mask |= beam_sched_frame_end(s);
+
+    /* 上一个条带扫描完了 */
+    mask |= release_slots(s);
+    s->scan_band = band;
+
+    for (i = 0; i < s->slots; i++)
+    {
+        beam_slot_t *sl = &s->slot[i];
+
+        if (sl->state == BEAM_SLOT_READY && sl->band == band && sl->frame == s->scan_frame)
+        {
+            sl->state = BEAM_SLOT_SCANNING;
+            idx = i;
+            s->stats.bands++;
+            break;
+        }
+    }
+    if (idx < 0)
+    {
+        s->stats.fallbacks++;
+        s->frame_full = false;
+    }
+
+    *released = mask;
+    return idx;
+}
+
+rt_uint32_t beam_sched_frame_end(beam_sched_t *s)
+{
+    rt_uint32_t released;
+
+    if (s->scan_band < 0)
+        return 0;
+
+    released = release_slots(s);
+    s->stats.frames++;
+    if (s->frame_full && s->scan_band == s->bands - 1)
+        s->stats.full_frames++;
+
+    s->scan_frame++;
+    s->scan_band = -1;
+    s->frame_full = true;
+    return released;
+}
+
+#ifdef APP_USING_TEST
+#include <stdlib.h>
+
+/* 模拟800x480面板，每帧525行（含45行消隐），60Hz时每行约31.7us */
+#define BEAM_SIM_WIDTH      800
+#define BEAM_SIM_LINES      480
+#define BEAM_SIM_BLANK      45
+#define BEAM_SIM_FRAMES     120
+#define BEAM_SIM_SPIKE_PCT  400     /* 偶尔出现的复杂条带的渲染时间 */
+#define BEAM_SIM_SPIKE_EVERY 10
+
+typedef struct {
+    rt_uint32_t fallback_frames;    /* 有条带显示后备内容的帧数 */
+    rt_uint32_t last_bad_frame;
+    rt_uint32_t conflicts;          /* 写了正在扫描的缓冲，或扫描出的不是该条带本帧的内容 */
+    rt_uint32_t passes;             /* 渲染方画完整屏的遍数 */
+} beam_sim_result_t;
+
+/* 用模拟的扫描线时钟运行调度：扫描方在每个条带开始和进入消隐期时调用调度器，
+ * 渲染方和LVGL一样按顺序轮流使用缓冲，每行时间做100份工作，画一个条带的工作量为cost_pct乘以条带行数，
+ * spike_every不为0时每spike_every帧中间的一个条带的工作量为BEAM_SIM_SPIKE_PCT */
+static void beam_sim_run(beam_sched_t *s, rt_uint32_t cost_pct, rt_uint32_t spike_every,
+                         beam_sim_result_t *r)
+{
+    rt_uint32_t content[BEAM_SCHED_MAX_SLOTS];  /* 缓冲里的内容：帧号 * 条带数 + 条带 */
+    rt_uint32_t frame, line, budget, step, remain = 0, released;
+    rt_uint16_t band = 0;
+    rt_uint8_t slot = 0;
+    bool rendering = false, frame_bad = false;
+    int scan_idx = -1;
+
+    memset(content, 0xFF, sizeof(content));
+    memset(r, 0, sizeof(*r));
+
+    for (frame = 0; frame < BEAM_SIM_FRAMES; frame++)
+    {
+        for (line = 0; line < BEAM_SIM_LINES + BEAM_SIM_BLANK; line++)
+        {
+            if (line < BEAM_SIM_LINES && line % s->band_lines == 0)
+            {
+                rt_uint16_t b = line / s->band_lines;
+
+                scan_idx = beam_sched_band_start(s, b, &released);
+                if (scan_idx < 0)
+                    frame_bad = true;
+                else if (content[scan_idx] != s->scan_frame * s->bands + b)
+                    r->conflicts++;
+            }
+            else if (line == BEAM_SIM_LINES)
+            {
+                beam_sched_frame_end(s);
+                scan_idx = -1;
+                if (frame_bad)
+                {
+                    r->fallback_frames++;
+                    r->last_bad_frame = frame;
+                }
+                frame_bad = false;
+            }
+
+            for (budget = 100; budget > 0; )
+            {
+                if (!rendering)
+                {
+                    rt_uint32_t pct = cost_pct;
+                    rt_uint16_t lines;
+
+                    /* 等缓冲扫描完 */
+                    if (!beam_sched_slot_free(s, slot))
+                        break;
+                    if (beam_sched_begin(s, slot, band) != RT_EOK || slot == scan_idx)
+                    {
+                        r->conflicts++;
+                        break;
+                    }
+                    content[slot] = ~0u;
+
+                    if (spike_every && s->render_frame % spike_every == spike_every - 1 && band == s->bands / 2)
+                        pct = BEAM_SIM_SPIKE_PCT;
+                    lines = (band == s->bands - 1) ? s->lines - band * s->band_lines : s->band_lines;
+                    remain = pct * lines;
+                    rendering = true;
+                }
+
+                step = remain < budget ? remain : budget;
+                budget -= step;
+                remain -= step;
+                if (remain > 0)
+                    continue;
+
+                content[slot] = s->slot[slot].frame * s->bands + band;
+                beam_sched_submit(s, slot);
+                slot = (slot + 1) % s->slots;
+                rendering = false;
+                if (++band == s->bands)
+                {
+                    band = 0;
+                    r->passes++;
+                }
+            }
+        }
+    }
+}
+
+static void beam_sim_print(const char *name, const beam_sched_t *s, const beam_sim_result_t *r, bool pass)
+{
+    rt_kprintf("%-9s frames %d, full %d, from buffer %d, fallback %d, late %d, passes %d, conflicts %d  %s\n",
+               name, s->stats.frames, s->stats.full_frames, s->stats.bands, s->stats.fallbacks,
+               s->stats.late, r->passes, r->conflicts, pass ? "PASS" : "FAIL");
+}
+
+/* 三种负载：每个条带都画得完、偶尔有一个条带画不完、所有条带都画不完。
+ * 画得完时除了开始的一帧都不应显示后备内容；偶尔画不完时只影响那一帧；
+ * 都画不完时（工作量加倍）只能部分显示，但渲染不能卡住；任何情况下都不能写正在扫描的缓冲 */
+static void beam_sim_cmd(int argc, char **argv)
+{
+    beam_sched_t s;
+    beam_sim_result_t r;
+    rt_uint16_t band_lines = argc > 1 ? atoi(argv[1]) : 8;
+    rt_uint32_t cost_pct = argc > 2 ? atoi(argv[2]) : 60;
+    rt_uint8_t slots = argc > 3 ? atoi(argv[3]) : 2;
+    rt_uint32_t spikes = BEAM_SIM_FRAMES / BEAM_SIM_SPIKE_EVERY;
+    bool pass, all = true;
+
+    if (cost_pct == 0 || cost_pct >= 100
+        || beam_sched_init(&s, BEAM_SIM_LINES, band_lines, slots) != RT_EOK)
+    {
+        rt_kprintf("usage: beam_sim [band_lines] [cost_pct 1-99] [slots 2-%d]\n", BEAM_SCHED_MAX_SLOTS);
+        return;
+    }
+    rt_kprintf("%d bands of %d lines, %d slots: %d bytes instead of %d for a frame buffer\n",
+               s.bands, band_lines, slots, slots * band_lines * BEAM_SIM_WIDTH * 2,
+               BEAM_SIM_WIDTH * BEAM_SIM_LINES * 2);
+
+    beam_sim_run(&s, cost_pct, 0, &r);
+    pass = r.conflicts == 0 && r.last_bad_frame == 0 && s.stats.full_frames == BEAM_SIM_FRAMES - 1;
+    beam_sim_print("steady", &s, &r, pass);
+    all &= pass;
+
+    beam_sched_init(&s, BEAM_SIM_LINES, band_lines, slots);
+    beam_sim_run(&s, cost_pct, BEAM_SIM_SPIKE_EVERY, &r);
+    pass = r.conflicts == 0 && r.fallback_frames <= 1 + spikes
+           && s.stats.full_frames >= BEAM_SIM_FRAMES - 1 - spikes;
+    beam_sim_print("spikes", &s, &r, pass);
+    all &= pass;
+
+    beam_sched_init(&s, BEAM_SIM_LINES, band_lines, slots);
+    beam_sim_run(&s, cost_pct * 2, 0, &r);
+    pass = r.conflicts == 0 && r.passes > BEAM_SIM_FRAMES / 3 && s.stats.bands > 0;
+    beam_sim_print("overload", &s, &r, pass);
+    all &= pass;
+
+    rt_kprintf("beam_sim: %s\n", all ? "PASS" : "FAIL");
+}
+MSH_CMD_EXPORT_ALIAS(beam_sim_cmd, beam_sim, simulate band display timing [band_lines] [cost_pct] [slots]);
+#endif /* APP_USING_TEST */
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __BEAM_SCHED_H__
+#define __BEAM_SCHED_H__
+
+#include <rtthread.h>
+#include <stdbool.h>
+
+/* 追扫描线的条带显示调度：屏幕按band_lines行分成条带，只用slots个条带缓冲轮流存放。
+ * 渲染方按顺序画条带，扫描到某个条带时如果有存放它的缓冲已经准备好就显示缓冲，
+ * 否则显示后备内容（静态图像或背景色）；条带扫描完后缓冲才可以重新写入，
+ * 渲染完时该条带已经开始扫描的缓冲直接丢弃。
+ * 扫描方的函数在行中断里调用，渲染方的函数调用时要屏蔽行中断。
+ * 只做决策，不访问LTDC和系统时钟，可以用模拟的扫描线时钟测试 */
+
+#define BEAM_SCHED_MAX_SLOTS    4
+
+typedef enum {
+    BEAM_SLOT_FREE = 0,
+    BEAM_SLOT_RENDERING,        /* 渲染方正在写 */
+    BEAM_SLOT_READY,            /* 等待扫描 */
+    BEAM_SLOT_SCANNING,         /* 正在扫描 */
+} beam_slot_state_t;
+
+typedef struct {
+    rt_uint8_t state;
+    rt_uint16_t band;
+    rt_uint32_t frame;          /* 要在哪一帧显示 */
+} beam_slot_t;
+
+typedef struct {
+    rt_uint32_t frames;         /* 扫描完的帧数 */
+    rt_uint32_t full_frames;    /* 所有条带都来自缓冲的帧数 */
+    rt_uint32_t bands;          /* 从缓冲扫描出的条带数 */
+    rt_uint32_t fallbacks;      /* 没有准备好而显示后备内容的条带数 */
+    rt_uint32_t rendered;       /* 按时交给扫描的条带数 */
+    rt_uint32_t late;           /* 渲染完时已经开始扫描而丢弃的条带数 */
+} beam_sched_stats_t;
+
+typedef struct {
+    rt_uint16_t lines;          /* 可见行数 */
+    rt_uint16_t band_lines;
+    rt_uint16_t bands;          /* 最后一个条带可以不满band_lines行 */
+    rt_uint8_t slots;
+
+    rt_uint32_t scan_frame;     /* 正在扫描（或即将开始扫描）的帧 */
+    rt_int16_t scan_band;       /* 正在扫描的条带，-1为本帧还没开始 */
+    bool frame_full;            /* 本帧到目前为止都来自缓冲 */
+
+    rt_uint32_t render_frame;   /* 渲染方正在画的帧 */
+    beam_slot_t slot[BEAM_SCHED_MAX_SLOTS];
+    beam_sched_stats_t stats;
+} beam_sched_t;
+
+rt_err_t beam_sched_init(beam_sched_t *s, rt_uint16_t lines, rt_uint16_t band_lines, rt_uint8_t slots);
+
+/* ---------- 渲染方 ---------- */
+/* 缓冲可以写入 */
+bool beam_sched_slot_free(const beam_sched_t *s, rt_uint8_t slot);
+/* 开始在缓冲slot中画band，缓冲还没扫描完时返回-RT_EBUSY。
+ * 画条带0时决定这一遍画的是哪一帧：本帧还没开始扫描就赶本帧，否则赶下一帧 */
+rt_err_t beam_sched_begin(beam_sched_t *s, rt_uint8_t slot, rt_uint16_t band);
+/* 缓冲slot画完，返回false时已经来不及显示，缓冲已经释放 */
+bool beam_sched_submit(beam_sched_t *s, rt_uint8_t slot);
+
+/* ---------- 扫描方（行中断）---------- */
+/* band即将开始扫描，返回要显示的缓冲，-1为显示后备内容。
+ * released返回因此释放的缓冲（每个缓冲一位），有释放时应唤醒等待的渲染方 */
+int beam_sched_band_start(beam_sched_t *s, rt_uint16_t band, rt_uint32_t *released);
+/* 最后一个条带扫描完，进入消隐期，返回释放的缓冲 */
+rt_uint32_t beam_sched_frame_end(beam_sched_t *s);
+
+#endif /* __BEAM_SCHED_H__ */
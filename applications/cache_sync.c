@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include <stdbool.h>
+#include "cache_sync.h"
+#ifndef CACHE_SYNC_MOCK
+#include "main.h"
+#endif
+
+static cache_sync_stats_t sync_stats;
+
+/* ==================== 缓存操作 ==================== */
+
+#ifndef CACHE_SYNC_MOCK
+
+/* 参数已按缓存行对齐 */
+static void line_clean(rt_ubase_t start, rt_size_t size)
+{
+    SCB_CleanDCache_by_Addr((volatile void *)start, (int32_t)size);
+}
+
+static void line_invalidate(rt_ubase_t start, rt_size_t size)
+{
+    SCB_InvalidateDCache_by_Addr((volatile void *)start, (int32_t)size);
+}
+
+static void line_clean_invalidate(rt_ubase_t start, rt_size_t size)
+{
+    SCB_CleanInvalidateDCache_by_Addr((volatile void *)start, (int32_t)size);
+}
+
+static void full_clean(void)
+{
+    SCB_CleanDCache();
+}
+
+#else
+
+/* 模拟：每一行一位，记录CPU写入后还没有写回的行 */
+#define CACHE_MOCK_MAX_SIZE     (1024 * 1024)
+
+static rt_uint8_t mock_dirty[CACHE_MOCK_MAX_SIZE / CACHE_LINE_SIZE / 8];
+static rt_ubase_t mock_base;
+static rt_size_t mock_lines;
+static rt_ubase_t mock_keep_start;          /* 正在无效化的区域，区域外的写入不能丢弃 */
+static rt_ubase_t mock_keep_end;
+
+static bool mock_line(rt_ubase_t addr, rt_size_t *line)
+{
+    if (addr < mock_base)
+        return false;
+    *line = (addr - mock_base) / CACHE_LINE_SIZE;
+    return *line < mock_lines;
+}
+
+static bool mock_is_dirty(rt_size_t line)
+{
+    return (mock_dirty[line / 8] & (1 << (line % 8))) != 0;
+}
+
+static void mock_set_dirty(rt_size_t line, bool dirty)
+{
+    if (dirty)
+        mock_dirty[line / 8] |= (rt_uint8_t)(1 << (line % 8));
+    else
+        mock_dirty[line / 8] &= (rt_uint8_t)~(1 << (line % 8));
+}
+
+void cache_mock_init(void *base, rt_size_t size)
+{
+    mock_base = CACHE_ALIGN_DOWN(base);
+    mock_lines = (CACHE_ALIGN_UP((rt_ubase_t)base + size) - mock_base) / CACHE_LINE_SIZE;
+    if (mock_lines > sizeof(mock_dirty) * 8)
+        mock_lines = sizeof(mock_dirty) * 8;
+    rt_memset(mock_dirty, 0, sizeof(mock_dirty));
+}
+
+void cache_mock_write(const void *addr, rt_size_t size)
+{
+    rt_size_t line;
+
+    for (rt_ubase_t a = CACHE_ALIGN_DOWN(addr); a < (rt_ubase_t)addr + size; a += CACHE_LINE_SIZE)
+    {
+        if (mock_line(a, &line))
+            mock_set_dirty(line, true);
+    }
+}
+
+void cache_mock_write_rect(const void *buf, rt_size_t stride, rt_size_t bpp,
+                           int x1, int y1, int x2, int y2)
+{
+    for (int y = y1; y <= y2; y++)
+        cache_mock_write((const rt_uint8_t *)buf + y * stride + x1 * bpp, (x2 - x1 + 1) * bpp);
+}
+
+static void line_clean(rt_ubase_t start, rt_size_t size)
+{
+    rt_size_t line;
+
+    RT_ASSERT(CACHE_IS_ALIGNED(start) && CACHE_IS_ALIGNED(size));
+    for (rt_ubase_t a = start; a < start + size; a += CACHE_LINE_SIZE)
+    {
+        if (mock_line(a, &line))
+            mock_set_dirty(line, false);
+    }
+}
+
+static void line_invalidate(rt_ubase_t start, rt_size_t size)
+{
+    rt_size_t line;
+
+    RT_ASSERT(CACHE_IS_ALIGNED(start) && CACHE_IS_ALIGNED(size));
+    for (rt_ubase_t a = start; a < start + size; a += CACHE_LINE_SIZE)
+    {
+        if (!mock_line(a, &line) || !mock_is_dirty(line))
+            continue;
+        /* 行中有区域外的数据还没有写回，无效化后就丢失了 */
+        if (a < mock_keep_start || a + CACHE_LINE_SIZE > mock_keep_end)
+            sync_stats.lost_lines++;
+        mock_set_dirty(line, false);
+    }
+}
+
+static void line_clean_invalidate(rt_ubase_t start, rt_size_t size)
+{
+    line_clean(start, size);
+}
+
+static void full_clean(void)
+{
+    rt_memset(mock_dirty, 0, sizeof(mock_dirty));
+}
+
+#endif /* CACHE_SYNC_MOCK */
+
+/* ==================== 按范围 ==================== */
+
+void cache_clean(const void *addr, rt_size_t size)
+{
+    rt_ubase_t start, end;
+
+    if (size == 0)
+        return;
+
+    start = CACHE_ALIGN_DOWN(addr);
+    end = CACHE_ALIGN_UP((rt_ubase_t)addr + size);
+    if (end - start >= CACHE_FULL_CLEAN_SIZE)
+    {
+        sync_stats.full_cleans++;
+        full_clean();
+        return;
+    }
+
+    sync_stats.cleans++;
+    sync_stats.clean_bytes += end - start;
+    line_clean(start, end - start);
+}
+
+void cache_invalidate(void *addr, rt_size_t size)
+{
+    rt_ubase_t start, end;
+
+    if (size == 0)
+        return;
+
+    start = CACHE_ALIGN_DOWN(addr);
+    end = CACHE_ALIGN_UP((rt_ubase_t)addr + size);
+#ifdef CACHE_SYNC_MOCK
+    mock_keep_start = (rt_ubase_t)addr;
+    mock_keep_end = (rt_ubase_t)addr + size;
+#endif
+
+    /* 首尾只有一部分在区域内的行先写回，不丢弃区域外的数据 */
+    if (!CACHE_IS_ALIGNED(addr))
+    {
+        line_clean_invalidate(start, CACHE_LINE_SIZE);
+        start += CACHE_LINE_SIZE;
+        sync_stats.edge_lines++;
+    }
+    if (end > start && !CACHE_IS_ALIGNED((rt_ubase_t)addr + size))
+    {
+        line_clean_invalidate(end - CACHE_LINE_SIZE, CACHE_LINE_SIZE);
+        end -= CACHE_LINE_SIZE;
+        sync_stats.edge_lines++;
+    }
+
+    sync_stats.invalidates++;
+    if (end > start)
+    {
+        sync_stats.invalidate_bytes += end - start;
+        line_invalidate(start, end - start);
+    }
+}
+
+/* ==================== 按矩形区域 ==================== */
+
+void cache_clean_rect(const void *buf, rt_size_t stride, rt_size_t bpp,
+                      int x1, int y1, int x2, int y2)
+{
+    const rt_uint8_t *start;
+    rt_size_t row, span;
+
+    if (x2 < x1 || y2 < y1)
+        return;
+
+    start = (const rt_uint8_t *)buf + y1 * stride + x1 * bpp;
+    row = (x2 - x1 + 1) * bpp;
+    span = (y2 - y1) * stride + row;
+
+    /* 行间空隙不比一行长时按一个范围清理，操作次数少，多写回的行没有影响 */
+    if (span >= CACHE_FULL_CLEAN_SIZE || stride - row <= row)
+    {
+        cache_clean(start, span);
+        return;
+    }
+    for (int y = y1; y <= y2; y++, start += stride)
+        cache_clean(start, row);
+}
+
+/* 行间的数据不属于这个区域，只能逐行无效化 */
+void cache_invalidate_rect(void *buf, rt_size_t stride, rt_size_t bpp,
+                           int x1, int y1, int x2, int y2)
+{
+    rt_uint8_t *start;
+    rt_size_t row;
+
+    if (x2 < x1 || y2 < y1)
+        return;
+
+    start = (rt_uint8_t *)buf + y1 * stride + x1 * bpp;
+    row = (x2 - x1 + 1) * bpp;
+    if (row == stride)
+    {
+        cache_invalidate(start, (y2 - y1 + 1) * stride);
+        return;
+    }
+    for (int y = y1; y <= y2; y++, start += stride)
+        cache_invalidate(start, row);
+}
+
+void cache_dma_handoff(const void *addr, rt_size_t size)
+{
+    sync_stats.handoffs++;
+#ifdef CACHE_SYNC_MOCK
+    rt_size_t line;
+
+    for (rt_ubase_t a = CACHE_ALIGN_DOWN(addr); a < (rt_ubase_t)addr + size; a += CACHE_LINE_SIZE)
+    {
+        if (mock_line(a, &line) && mock_is_dirty(line))
+            sync_stats.violations++;
+    }
+#endif
+}
+
+void cache_sync_get_stats(cache_sync_stats_t *stats)
+{
+    *stats = sync_stats;
+}
+
+void cache_sync_reset_stats(void)
+{
+    rt_memset(&sync_stats, 0, sizeof(sync_stats));
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static void cache_stats_cmd(int argc, char **argv)
+{
+    cache_sync_stats_t *st = &sync_stats;
+
+    rt_kprintf("clean: %d ranges, %d bytes, %d full\n", st->cleans, st->clean_bytes, st->full_cleans);
+    rt_kprintf("invalidate: %d ranges, %d bytes, %d edge lines\n",
+               st->invalidates, st->invalidate_bytes, st->edge_lines);
+    rt_kprintf("dma handoffs: %d\n", st->handoffs);
+    if (argc > 1 && rt_strcmp(argv[1], "reset") == 0)
+        cache_sync_reset_stats();
+}
+MSH_CMD_EXPORT_ALIAS(cache_stats_cmd, cache_stats, show D-cache maintenance statistics [reset]);
+
+#if defined(APP_USING_TEST) && defined(CACHE_SYNC_MOCK)
+#include "app_test.h"
+
+/* ==================== 模拟测试 ==================== */
+
+#define TEST_W          400
+#define TEST_H          120
+#define TEST_BPP        2
+#define TEST_STRIDE     (TEST_W * TEST_BPP)
+#define TEST_RECTS      500
+
+static rt_uint8_t test_fb[TEST_STRIDE * TEST_H + CACHE_LINE_SIZE];
+
+static void test_rect(int *x1, int *y1, int *x2, int *y2)
+{
+    *x1 = app_test_rand(TEST_W);
+    *y1 = app_test_rand(TEST_H);
+    *x2 = *x1 + app_test_rand(TEST_W - *x1);
+    *y2 = *y1 + app_test_rand(TEST_H - *y1);
+}
+
+/* 模拟LVGL绘制脏区域后刷新：每个区域都清理后，交给DMA的整个帧缓冲区没有脏行。
+ * 再检查漏掉清理时能发现，以及无效化不对齐的区域时不丢失区域外的写入 */
+static void cache_test_cmd(int argc, char **argv)
+{
+    /* 帧缓冲区故意不按缓存行对齐 */
+    rt_uint8_t *fb = test_fb + 6;
+    rt_size_t size = TEST_STRIDE * TEST_H;
+    rt_uint32_t flush_violations, missed, lost;
+    int x1, y1, x2, y2;
+
+    cache_mock_init(fb, size);
+    cache_sync_reset_stats();
+    app_test_srand(1);
+
+    /* 刷新：逐个区域写入后清理，包括整屏区域 */
+    for (int i = 0; i < TEST_RECTS; i++)
+    {
+        test_rect(&x1, &y1, &x2, &y2);
+        if (i % 100 == 0)
+        {
+            x1 = y1 = 0;
+            x2 = TEST_W - 1;
+            y2 = TEST_H - 1;
+        }
+        cache_mock_write_rect(fb, TEST_STRIDE, TEST_BPP, x1, y1, x2, y2);
+        cache_clean_rect(fb, TEST_STRIDE, TEST_BPP, x1, y1, x2, y2);
+        cache_dma_handoff(fb, size);
+    }
+    flush_violations = sync_stats.violations;
+
+    /* 漏掉一个区域的清理 */
+    cache_mock_write_rect(fb, TEST_STRIDE, TEST_BPP, 13, 7, 13, 7);
+    cache_dma_handoff(fb, size);
+    missed = sync_stats.violations - flush_violations;
+    cache_clean(fb, size);
+
+    /* DMA写入不对齐的区域：周围被CPU写过，无效化后再整体清理，没有写入丢失 */
+    for (int i = 0; i < TEST_RECTS; i++)
+    {
+        cache_mock_write(fb, size);
+        test_rect(&x1, &y1, &x2, &y2);
+        cache_invalidate_rect(fb, TEST_STRIDE, TEST_BPP, x1, y1, x2, y2);
+    }
+    lost = sync_stats.lost_lines;
+    cache_clean(fb, size);
+    cache_dma_handoff(fb, size);
+
+    rt_kprintf("flush: %d rects, %d clean ranges, %d full cleans, %d dirty lines at handoff\n",
+               TEST_RECTS, sync_stats.cleans, sync_stats.full_cleans, flush_violations);
+    rt_kprintf("missed clean: %d dirty lines detected\n", missed);
+    rt_kprintf("invalidate: %d rects, %d edge lines, %d lines lost\n",
+               TEST_RECTS, sync_stats.edge_lines, lost);
+    rt_kprintf("%s\n", (flush_violations == 0 && missed > 0 && lost == 0 &&
+                        sync_stats.violations == flush_violations + missed) ? "PASS" : "FAIL");
+}
+MSH_CMD_EXPORT_ALIAS(cache_test_cmd, cache_test, check D-cache maintenance against the mock cache);
+#endif /* APP_USING_TEST && CACHE_SYNC_MOCK */
+#endif /* RT_USING_FINSH */
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __CACHE_SYNC_H__
+#define __CACHE_SYNC_H__
+
+#include <rtthread.h>
+
+/* SDRAM中的帧缓冲区按写回方式缓存，CPU写入的数据可能还在D-Cache中。
+ * LTDC、DMA2D等总线主设备读取前要清理（写回）对应的缓存行，
+ * 它们写入后CPU读取前要无效化对应的缓存行。
+ *
+ * 按地址范围或帧缓冲区中的矩形区域操作，首尾不对齐时按整行处理：
+ * 清理时多写回几个字节没有影响；无效化时首尾的行可能有区域外的数据，先清理再无效化。
+ * 区域超过CACHE_FULL_CLEAN_SIZE时清理整个D-Cache，比逐行清理快。
+ *
+ * 定义CACHE_SYNC_MOCK时不操作硬件，在主机上记录每一行是否被CPU写过，
+ * cache_dma_handoff检查交给DMA的区域是否已经全部清理 */
+
+#define CACHE_LINE_SIZE         32
+#define CACHE_DCACHE_SIZE       (16 * 1024)
+#define CACHE_FULL_CLEAN_SIZE   (2 * CACHE_DCACHE_SIZE)
+
+#define CACHE_ALIGN_DOWN(addr)  RT_ALIGN_DOWN((rt_ubase_t)(addr), CACHE_LINE_SIZE)
+#define CACHE_ALIGN_UP(addr)    RT_ALIGN((rt_ubase_t)(addr), CACHE_LINE_SIZE)
+#define CACHE_IS_ALIGNED(addr)  (((rt_ubase_t)(addr) & (CACHE_LINE_SIZE - 1)) == 0)
+
+typedef struct {
+    rt_uint32_t cleans;         /* 按地址清理的次数 */
+    rt_uint32_t clean_bytes;    /* 按整行计算 */
+    rt_uint32_t full_cleans;    /* 清理整个D-Cache的次数 */
+    rt_uint32_t invalidates;
+    rt_uint32_t invalidate_bytes;
+    rt_uint32_t edge_lines;     /* 无效化时先清理的首尾不对齐的行 */
+    rt_uint32_t handoffs;       /* 交给DMA的次数 */
+    rt_uint32_t violations;     /* 交给DMA时仍未清理的行（只在模拟时检查） */
+    rt_uint32_t lost_lines;     /* 无效化时丢弃的区域外的CPU写入（只在模拟时检查） */
+} cache_sync_stats_t;
+
+/* 总线主设备读取前：写回CPU写入的数据 */
+void cache_clean(const void *addr, rt_size_t size);
+/* 总线主设备写入后：丢弃缓存中的旧数据 */
+void cache_invalidate(void *addr, rt_size_t size);
+
+/* 帧缓冲区中的矩形区域，坐标包含两端（与lv_area_t相同），stride为每行字节数 */
+void cache_clean_rect(const void *buf, rt_size_t stride, rt_size_t bpp,
+                      int x1, int y1, int x2, int y2);
+void cache_invalidate_rect(void *buf, rt_size_t stride, rt_size_t bpp,
+                           int x1, int y1, int x2, int y2);
+
+/* 启动DMA或切换LTDC地址前调用，标记这个区域交给了总线主设备 */
+void cache_dma_handoff(const void *addr, rt_size_t size);
+
+void cache_sync_get_stats(cache_sync_stats_t *stats);
+void cache_sync_reset_stats(void);
+
+#ifdef CACHE_SYNC_MOCK
+/* 模拟的内存范围和CPU写入 */
+void cache_mock_init(void *base, rt_size_t size);
+void cache_mock_write(const void *addr, rt_size_t size);
+void cache_mock_write_rect(const void *buf, rt_size_t stride, rt_size_t bpp,
+                           int x1, int y1, int x2, int y2);
+#endif
+
+#endif /* __CACHE_SYNC_H__ */
@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include "disp_overlay.h"
+#include "fb_copy.h"
+
+void disp_overlay_init(disp_overlay_t *ov, rt_uint16_t *under, rt_uint16_t width, rt_uint16_t height,
+                       rt_uint16_t key)
+{
+    rt_memset(ov, 0, sizeof(disp_overlay_t));
+    ov->under = under;
+    ov->width = width;
+    ov->height = height;
+    ov->key = key;
+    ov->alpha = 255;
+}
+
+rt_uint16_t disp_overlay_blend(rt_uint16_t fg, rt_uint16_t bg, rt_uint8_t alpha)
+{
+    rt_uint32_t fr, fgr, fb, br, bgr, bb;
+
+    if (alpha == 255)
+        return fg;
+    if (alpha == 0)
+        return bg;
+
+    /* 扩展为8位，高位复制到低位 */
+    fr = fg >> 11;
+    fgr = (fg >> 5) & 0x3F;
+    fb = fg & 0x1F;
+    br = bg >> 11;
+    bgr = (bg >> 5) & 0x3F;
+    bb = bg & 0x1F;
+    fr = (fr << 3) | (fr >> 2);
+    fgr = (fgr << 2) | (fgr >> 4);
+    fb = (fb << 3) | (fb >> 2);
+    br = (br << 3) | (br >> 2);
+    bgr = (bgr << 2) | (bgr >> 4);
+    bb = (bb << 3) | (bb >> 2);
+
+    fr = (alpha * fr + (255 - alpha) * br) / 255;
+    fgr = (alpha * fgr + (255 - alpha) * bgr) / 255;
+    fb = (alpha * fb + (255 - alpha) * bb) / 255;
+    return (rt_uint16_t)(((fr >> 3) << 11) | ((fgr >> 2) << 5) | (fb >> 3));
+}
+
+/* 叠加层在屏幕内的部分，没有时返回false */
+static bool overlay_clip(const disp_overlay_t *ov, rt_uint16_t fb_width, rt_uint16_t fb_height,
+                         int *x0, int *y0, int *x1, int *y1)
+{
+    *x0 = (ov->x < 0) ? 0 : ov->x;
+    *y0 = (ov->y < 0) ? 0 : ov->y;
+    *x1 = (ov->x + ov->width > fb_width) ? fb_width : ov->x + ov->width;
+    *y1 = (ov->y + ov->height > fb_height) ? fb_height : ov->y + ov->height;
+    return *x0 < *x1 && *y0 < *y1;
+}
+
+/* 从under中的原始像素合成叠加层，写入主帧缓冲区 */
+static void overlay_blend_rect(disp_overlay_t *ov, rt_uint16_t *fb, rt_uint16_t fb_width,
+                               int x0, int y0, int x1, int y1)
+{
+    for (int y = y0; y < y1; y++)
+    {
+        const rt_uint16_t *src = ov->pixels + (y - ov->y) * ov->width + (x0 - ov->x);
+        const rt_uint16_t *bg = ov->under + (y - ov->y) * ov->width + (x0 - ov->x);
+        rt_uint16_t *dst = fb + y * fb_width + x0;
+
+        for (int x = x0; x < x1; x++, src++, bg++, dst++)
+            *dst = (*src == ov->key) ? *bg : disp_overlay_blend(*src, *bg, ov->alpha);
+    }
+}
+
+/* 把under中的原始像素写回主帧缓冲区 */
+static void overlay_restore(disp_overlay_t *ov, rt_uint16_t *fb, rt_uint16_t fb_width, rt_uint16_t fb_height)
+{
+    int x0, y0, x1, y1;
+
+    if (!ov->saved)
+        return;
+    ov->saved = false;
+    if (!overlay_clip(ov, fb_width, fb_height, &x0, &y0, &x1, &y1))
+        return;
+
+    fb_copy_rect(fb + y0 * fb_width + x0, fb_width * sizeof(rt_uint16_t),
+                 ov->under + (y0 - ov->y) * ov->width + (x0 - ov->x), ov->width * sizeof(rt_uint16_t),
+                 (x1 - x0) * sizeof(rt_uint16_t), y1 - y0);
+}
+
+void disp_overlay_compose(disp_overlay_t *ov, rt_uint16_t *fb, rt_uint16_t fb_width, rt_uint16_t fb_height)
+{
+    int x0, y0, x1, y1;
+
+    ov->saved = false;
+    if (ov->pixels == RT_NULL || ov->alpha == 0 ||
+        !overlay_clip(ov, fb_width, fb_height, &x0, &y0, &x1, &y1))
+        return;
+
+    fb_copy_rect(ov->under + (y0 - ov->y) * ov->width + (x0 - ov->x), ov->width * sizeof(rt_uint16_t),
+                 fb + y0 * fb_width + x0, fb_width * sizeof(rt_uint16_t),
+                 (x1 - x0) * sizeof(rt_uint16_t), y1 - y0);
+    ov->saved = true;
+    overlay_blend_rect(ov, fb, fb_width, x0, y0, x1, y1);
+}
+
+void disp_overlay_update(disp_overlay_t *ov, const rt_uint16_t *pixels, rt_int16_t x, rt_int16_t y,
+                         rt_uint8_t alpha, rt_uint16_t *fb, rt_uint16_t fb_width, rt_uint16_t fb_height)
+{
+    int x0, y0, x1, y1;
+
+    /* 位置不变时直接从under重新合成，不会先闪出原始像素 */
+    if (ov->saved && x == ov->x && y == ov->y && pixels != RT_NULL && alpha != 0)
+    {
+        ov->pixels = pixels;
+        ov->alpha = alpha;
+        if (overlay_clip(ov, fb_width, fb_height, &x0, &y0, &x1, &y1))
+            overlay_blend_rect(ov, fb, fb_width, x0, y0, x1, y1);
+        return;
+    }
+
+    overlay_restore(ov, fb, fb_width, fb_height);
+    ov->pixels = pixels;
+    ov->x = x;
+    ov->y = y;
+    ov->alpha = alpha;
+    disp_overlay_compose(ov, fb, fb_width, fb_height);
+}
+
+#ifdef APP_USING_TEST
+#include <finsh.h>
+#include "app_test.h"
+
+/* ==================== 合成测试 ==================== */
+
+#define TEST_FB_W       64
+#define TEST_FB_H       48
+#define TEST_OV_W       20
+#define TEST_OV_H       10
+#define TEST_KEY        0xF81F
+
+static rt_uint16_t test_base[TEST_FB_W * TEST_FB_H];
+static rt_uint16_t test_fb[TEST_FB_W * TEST_FB_H];
+static rt_uint16_t test_ov[2][TEST_OV_W * TEST_OV_H];
+static rt_uint16_t test_under[TEST_OV_W * TEST_OV_H];
+
+/* 按定义逐通道计算的参考值：通道值重复两次后取高8位（即高位复制到低位），
+ * 用浮点混合后向下取整，截断为RGB565 */
+static rt_uint16_t reference_blend(rt_uint16_t fg, rt_uint16_t bg, rt_uint8_t alpha)
+{
+    static const int shift[3] = {11, 5, 0};
+    static const int bits[3] = {5, 6, 5};
+    rt_uint16_t out = 0;
+
+    for (int c = 0; c < 3; c++)
+    {
+        int max = (1 << bits[c]) - 1;
+        int mul = (1 << bits[c]) + 1;
+        double f = ((((fg >> shift[c]) & max) * mul) >> (2 * bits[c] - 8));
+        double b = ((((bg >> shift[c]) & max) * mul) >> (2 * bits[c] - 8));
+        int v = (int)((alpha * f + (255 - alpha) * b) / 255.0 + 1e-9);
+
+        out |= (rt_uint16_t)((v * (max + 1) / 256) << shift[c]);
+    }
+    return out;
+}
+
+/* 逐像素检查：叠加层外等于原始像素，透明色处等于原始像素，其余为参考混合值 */
+static rt_uint32_t check_frame(const rt_uint16_t *ov, int ox, int oy, rt_uint8_t alpha)
+{
+    rt_uint32_t errors = 0;
+
+    for (int y = 0; y < TEST_FB_H; y++)
+    {
+        for (int x = 0; x < TEST_FB_W; x++)
+        {
+            rt_uint16_t base = test_base[y * TEST_FB_W + x];
+            rt_uint16_t expect = base;
+
+            if (ov != RT_NULL && alpha != 0 &&
+                x >= ox && x < ox + TEST_OV_W && y >= oy && y < oy + TEST_OV_H)
+            {
+                rt_uint16_t px = ov[(y - oy) * TEST_OV_W + (x - ox)];
+                if (px != TEST_KEY)
+                    expect = reference_blend(px, base, alpha);
+            }
+            if (test_fb[y * TEST_FB_W + x] != expect)
+                errors++;
+        }
+    }
+    return errors;
+}
+
+static void overlay_test_cmd(int argc, char **argv)
+{
+    static const struct {
+        int ov, x, y;
+        rt_uint8_t alpha;
+    } steps[] = {
+        {0, 10, 8, 255}, {1, 10, 8, 255}, {1, 10, 8, 128}, {0, 11, 9, 200},
+        {0, -5, -3, 77}, {1, 50, 42, 255}, {1, 64, 10, 255}, {0, 30, 20, 0},
+        {0, 30, 20, 1}, {1, -19, 47, 254}, {0, 22, 14, 160},
+    };
+    disp_overlay_t ov;
+    rt_uint32_t blend_errors = 0, frame_errors = 0;
+
+    /* 混合：随机像素对，全部alpha */
+    app_test_srand(1);
+    for (int i = 0; i < 4096; i++)
+    {
+        rt_uint16_t fg = (rt_uint16_t)app_test_rand(0x10000), bg = (rt_uint16_t)app_test_rand(0x10000);
+
+        for (int a = 0; a < 256; a++)
+        {
+            if (disp_overlay_blend(fg, bg, (rt_uint8_t)a) != reference_blend(fg, bg, (rt_uint8_t)a))
+                blend_errors++;
+        }
+    }
+
+    /* 主帧缓冲区和两帧叠加层内容，叠加层约1/4为透明色 */
+    for (int i = 0; i < TEST_FB_W * TEST_FB_H; i++)
+        test_base[i] = (rt_uint16_t)app_test_rand(0x10000);
+    for (int k = 0; k < 2; k++)
+    {
+        for (int i = 0; i < TEST_OV_W * TEST_OV_H; i++)
+            test_ov[k][i] = ((rt_uint16_t)app_test_rand(0x10000) & 3) ? (rt_uint16_t)app_test_rand(0x10000) : TEST_KEY;
+    }
+
+    /* 主帧重绘后合成 */
+    disp_overlay_init(&ov, test_under, TEST_OV_W, TEST_OV_H, TEST_KEY);
+    rt_memcpy(test_fb, test_base, sizeof(test_fb));
+    disp_overlay_update(&ov, test_ov[0], 10, 8, 255, test_fb, TEST_FB_W, TEST_FB_H);
+    frame_errors += check_frame(test_ov[0], 10, 8, 255);
+
+    /* 叠加层单独更新内容、位置和alpha，合成结果与从原始帧重新合成相同 */
+    for (rt_size_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++)
+    {
+        disp_overlay_update(&ov, test_ov[steps[i].ov], steps[i].x, steps[i].y, steps[i].alpha,
+                            test_fb, TEST_FB_W, TEST_FB_H);
+        frame_errors += check_frame(test_ov[steps[i].ov], steps[i].x, steps[i].y, steps[i].alpha);
+
+        /* 主帧在这之间整屏重绘 */
+        if (i == 5)
+        {
+            rt_memcpy(test_fb, test_base, sizeof(test_fb));
+            disp_overlay_compose(&ov, test_fb, TEST_FB_W, TEST_FB_H);
+            frame_errors += check_frame(test_ov[steps[i].ov], steps[i].x, steps[i].y, steps[i].alpha);
+        }
+    }
+
+    /* 隐藏后恢复为原始帧 */
+    disp_overlay_update(&ov, RT_NULL, 0, 0, 255, test_fb, TEST_FB_W, TEST_FB_H);
+    frame_errors += check_frame(RT_NULL, 0, 0, 0);
+
+    rt_kprintf("blend: %d mismatches in %d pixels\n", blend_errors, 4096 * 256);
+    rt_kprintf("compose: %d steps, %d mismatched pixels\n",
+               (int)(sizeof(steps) / sizeof(steps[0])) + 3, frame_errors);
+    rt_kprintf("%s\n", (blend_errors == 0 && frame_errors == 0) ? "PASS" : "FAIL");
+}
+MSH_CMD_EXPORT_ALIAS(overlay_test_cmd, overlay_test, check software overlay compositor pixel by pixel);
+#endif /* APP_USING_TEST */
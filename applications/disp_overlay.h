@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __DISP_OVERLAY_H__
+#define __DISP_OVERLAY_H__
+
+#include <rtthread.h>
+#include <stdbool.h>
+
+/* 叠加层的软件合成：状态图标、时钟等小区域单独绘制在叠加层缓冲区中，
+ * 有LTDC第2层时由硬件合成，没有时用这里的函数合成到主帧缓冲区。
+ *
+ * 像素格式为RGB565，叠加层中等于透明色的像素不显示，其余像素按恒定alpha混合，
+ * 与LTDC第2层的色键和恒定alpha一致（透明色像素的alpha为0，其余像素为255）：
+ * 两层扩展为RGB888（高位复制到低位）后 out = (a * ov + (255 - a) * bg) / 255，再截断为RGB565。
+ *
+ * 主帧缓冲区每帧整屏重绘，合成时先把叠加层下面的原始像素保存到under中，
+ * 叠加层单独更新时从under重新合成，不会重复混合。不加锁，可以在主机上测试 */
+
+typedef struct {
+    const rt_uint16_t *pixels;  /* 叠加层当前内容，width * height */
+    rt_uint16_t *under;         /* 主帧缓冲区中叠加层下面的原始像素，width * height */
+    rt_int16_t x;               /* 在屏幕上的位置，可以部分超出屏幕 */
+    rt_int16_t y;
+    rt_uint16_t width;
+    rt_uint16_t height;
+    rt_uint16_t key;            /* 透明色 */
+    rt_uint8_t alpha;           /* 0为不显示，255为不透明 */
+    bool saved;                 /* under中保存了当前位置下面的像素 */
+} disp_overlay_t;
+
+void disp_overlay_init(disp_overlay_t *ov, rt_uint16_t *under, rt_uint16_t width, rt_uint16_t height,
+                       rt_uint16_t key);
+
+/* 混合一个像素 */
+rt_uint16_t disp_overlay_blend(rt_uint16_t fg, rt_uint16_t bg, rt_uint8_t alpha);
+
+/* 主帧缓冲区重绘后调用：保存叠加层下面的像素，再合成叠加层 */
+void disp_overlay_compose(disp_overlay_t *ov, rt_uint16_t *fb, rt_uint16_t fb_width, rt_uint16_t fb_height);
+/* 叠加层内容、位置、alpha变化后调用：先恢复原来的像素，再按新的状态合成到同一个主帧缓冲区 */
+void disp_overlay_update(disp_overlay_t *ov, const rt_uint16_t *pixels, rt_int16_t x, rt_int16_t y,
+                         rt_uint8_t alpha, rt_uint16_t *fb, rt_uint16_t fb_width, rt_uint16_t fb_height);
+
+#endif /* __DISP_OVERLAY_H__ */
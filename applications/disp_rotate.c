@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include "disp_rotate.h"
+#include "fb_copy.h"
+
+void disp_rotate_area(disp_rotate_t rot, rt_uint16_t phys_w, rt_uint16_t phys_h,
+                      const disp_area_t *in, disp_area_t *out)
+{
+    disp_area_t a = *in;
+
+    switch (rot)
+    {
+    case DISP_ROTATE_90:
+        out->x1 = a.y1;
+        out->x2 = a.y2;
+        out->y1 = phys_h - 1 - a.x2;
+        out->y2 = phys_h - 1 - a.x1;
+        break;
+    case DISP_ROTATE_180:
+        out->x1 = phys_w - 1 - a.x2;
+        out->x2 = phys_w - 1 - a.x1;
+        out->y1 = phys_h - 1 - a.y2;
+        out->y2 = phys_h - 1 - a.y1;
+        break;
+    case DISP_ROTATE_270:
+        out->x1 = phys_w - 1 - a.y2;
+        out->x2 = phys_w - 1 - a.y1;
+        out->y1 = a.x1;
+        out->y2 = a.x2;
+        break;
+    default:
+        *out = a;
+        break;
+    }
+}
+
+/* ==================== 旋转内核 ==================== */
+
+/* 源的第x列成为目标的第w-1-x行：一块内按目标行写入，源的DISP_ROTATE_TILE行都在缓存中 */
+static void rotate_90(rt_uint16_t *dst, rt_size_t dst_stride, const rt_uint16_t *src, rt_size_t src_stride,
+                      int w, int h)
+{
+    for (int ty = 0; ty < h; ty += DISP_ROTATE_TILE)
+    {
+        int th = (h - ty < DISP_ROTATE_TILE) ? h - ty : DISP_ROTATE_TILE;
+
+        for (int tx = 0; tx < w; tx += DISP_ROTATE_TILE)
+        {
+            int tw = (w - tx < DISP_ROTATE_TILE) ? w - tx : DISP_ROTATE_TILE;
+
+            for (int x = tx; x < tx + tw; x++)
+            {
+                rt_uint16_t *d = dst + (w - 1 - x) * dst_stride + ty;
+                const rt_uint16_t *s = src + ty * src_stride + x;
+
+                for (int y = 0; y < th; y++, s += src_stride)
+                    d[y] = *s;
+            }
+        }
+    }
+}
+
+/* 源的第y行成为目标的第h-1-y列，写入方向与90度相反 */
+static void rotate_270(rt_uint16_t *dst, rt_size_t dst_stride, const rt_uint16_t *src, rt_size_t src_stride,
+                       int w, int h)
+{
+    for (int ty = 0; ty < h; ty += DISP_ROTATE_TILE)
+    {
+        int th = (h - ty < DISP_ROTATE_TILE) ? h - ty : DISP_ROTATE_TILE;
+
+        for (int tx = 0; tx < w; tx += DISP_ROTATE_TILE)
+        {
+            int tw = (w - tx < DISP_ROTATE_TILE) ? w - tx : DISP_ROTATE_TILE;
+
+            for (int x = tx; x < tx + tw; x++)
+            {
+                rt_uint16_t *d = dst + x * dst_stride + (h - 1 - ty);
+                const rt_uint16_t *s = src + ty * src_stride + x;
+
+                for (int y = 0; y < th; y++, s += src_stride)
+                    d[-y] = *s;
+            }
+        }
+    }
+}
+
+/* 行顺序和行内顺序都反转，不需要分块 */
+static void rotate_180(rt_uint16_t *dst, rt_size_t dst_stride, const rt_uint16_t *src, rt_size_t src_stride,
+                       int w, int h)
+{
+    for (int y = 0; y < h; y++)
+    {
+        rt_uint16_t *d = dst + (h - 1 - y) * dst_stride + (w - 1);
+        const rt_uint16_t *s = src + y * src_stride;
+        int x = 0;
+
+        for (; x + 4 <= w; x += 4, d -= 4)
+        {
+            rt_uint16_t a = s[x], b = s[x + 1], c = s[x + 2], e = s[x + 3];
+
+            d[0] = a;
+            d[-1] = b;
+            d[-2] = c;
+            d[-3] = e;
+        }
+        for (; x < w; x++)
+            *d-- = s[x];
+    }
+}
+
+void disp_rotate_rect16(rt_uint16_t *dst, rt_size_t dst_stride, const rt_uint16_t *src, rt_size_t src_stride,
+                        int w, int h, disp_rotate_t rot)
+{
+    if (w <= 0 || h <= 0)
+        return;
+
+    switch (rot)
+    {
+    case DISP_ROTATE_90:
+        rotate_90(dst, dst_stride, src, src_stride, w, h);
+        break;
+    case DISP_ROTATE_180:
+        rotate_180(dst, dst_stride, src, src_stride, w, h);
+        break;
+    case DISP_ROTATE_270:
+        rotate_270(dst, dst_stride, src, src_stride, w, h);
+        break;
+    default:
+        fb_copy_rect(dst, dst_stride * sizeof(rt_uint16_t), src, src_stride * sizeof(rt_uint16_t),
+                     w * sizeof(rt_uint16_t), h);
+        break;
+    }
+}
+
+#ifdef APP_USING_TEST
+void disp_rotate_rect16_ref(rt_uint16_t *dst, rt_size_t dst_stride, const rt_uint16_t *src, rt_size_t src_stride,
+                            int w, int h, disp_rotate_t rot)
+{
+    for (int y = 0; y < h; y++)
+    {
+        for (int x = 0; x < w; x++)
+        {
+            int dx = x, dy = y;
+
+            if (rot == DISP_ROTATE_90)
+            {
+                dx = y;
+                dy = w - 1 - x;
+            }
+            else if (rot == DISP_ROTATE_180)
+            {
+                dx = w - 1 - x;
+                dy = h - 1 - y;
+            }
+            else if (rot == DISP_ROTATE_270)
+            {
+                dx = h - 1 - y;
+                dy = x;
+            }
+            ((volatile rt_uint16_t *)dst)[dy * dst_stride + dx] = src[y * src_stride + x];
+        }
+    }
+}
+#endif /* APP_USING_TEST */
+
+void disp_rotate_copy(rt_uint16_t *phys, rt_uint16_t phys_w, rt_uint16_t phys_h,
+                      const rt_uint16_t *logical, disp_rotate_t rot, const disp_area_t *area)
+{
+    rt_uint16_t logical_w = (rot == DISP_ROTATE_90 || rot == DISP_ROTATE_270) ? phys_h : phys_w;
+    disp_area_t out;
+
+    disp_rotate_area(rot, phys_w, phys_h, area, &out);
+    disp_rotate_rect16(phys + out.y1 * phys_w + out.x1, phys_w,
+                       logical + area->y1 * logical_w + area->x1, logical_w,
+                       area->x2 - area->x1 + 1, area->y2 - area->y1 + 1, rot);
+}
+
+#ifdef APP_USING_TEST
+#include <finsh.h>
+#include <stdlib.h>
+#include "app_perf.h"
+#include "app_test.h"
+
+/* ==================== 正确性和吞吐量测试 ==================== */
+
+#define TEST_MAX            70
+#define TEST_BUF_PX         ((TEST_MAX + 8) * (TEST_MAX + 8))
+#define TEST_PHYS_W         72
+#define TEST_PHYS_H         40
+#define TEST_EDITS          200
+#define BENCH_W             800
+#define BENCH_H             480
+
+static rt_uint16_t test_src[TEST_BUF_PX];
+static rt_uint16_t test_dst[TEST_BUF_PX];
+static rt_uint16_t test_ref[TEST_BUF_PX];
+static rt_uint16_t test_logical[TEST_PHYS_W * TEST_PHYS_H];
+static rt_uint16_t test_phys[TEST_PHYS_W * TEST_PHYS_H];
+
+/* 随机尺寸（包括不足一块和跨块边界）、随机跨度，与参考实现比较整个目标缓冲区 */
+static rt_uint32_t check_kernels(void)
+{
+    rt_uint32_t errors = 0;
+
+    for (int i = 0; i < 2000; i++)
+    {
+        disp_rotate_t rot = (disp_rotate_t)(i & 3);
+        int w = 1 + app_test_rand(TEST_MAX), h = 1 + app_test_rand(TEST_MAX);
+        bool odd = (rot == DISP_ROTATE_90 || rot == DISP_ROTATE_270);
+        rt_size_t src_stride = w + app_test_rand(8);
+        rt_size_t dst_stride = (odd ? h : w) + app_test_rand(8);
+
+        for (int k = 0; k < TEST_BUF_PX; k++)
+            test_src[k] = (rt_uint16_t)app_test_rand(0x10000);
+        rt_memset(test_dst, 0xA5, sizeof(test_dst));
+        rt_memset(test_ref, 0xA5, sizeof(test_ref));
+
+        disp_rotate_rect16(test_dst, dst_stride, test_src, src_stride, w, h, rot);
+        disp_rotate_rect16_ref(test_ref, dst_stride, test_src, src_stride, w, h, rot);
+        if (rt_memcmp(test_dst, test_ref, sizeof(test_dst)) != 0)
+            errors++;
+    }
+    return errors;
+}
+
+/* 逻辑帧中随机区域变化后只旋转这些区域，结果与按定义逐像素旋转整帧相同 */
+static rt_uint32_t check_dirty(disp_rotate_t rot)
+{
+    bool odd = (rot == DISP_ROTATE_90 || rot == DISP_ROTATE_270);
+    int lw = odd ? TEST_PHYS_H : TEST_PHYS_W;
+    int lh = odd ? TEST_PHYS_W : TEST_PHYS_H;
+    disp_area_t full = {0, 0, lw - 1, lh - 1};
+    rt_uint32_t errors = 0;
+
+    for (int i = 0; i < lw * lh; i++)
+        test_logical[i] = (rt_uint16_t)app_test_rand(0x10000);
+    disp_rotate_copy(test_phys, TEST_PHYS_W, TEST_PHYS_H, test_logical, rot, &full);
+
+    for (int i = 0; i < TEST_EDITS; i++)
+    {
+        disp_area_t a;
+        rt_uint16_t color = (rt_uint16_t)app_test_rand(0x10000);
+
+        a.x1 = app_test_rand(lw);
+        a.y1 = app_test_rand(lh);
+        a.x2 = a.x1 + app_test_rand(lw - a.x1);
+        a.y2 = a.y1 + app_test_rand(lh - a.y1);
+        for (int y = a.y1; y <= a.y2; y++)
+        {
+            for (int x = a.x1; x <= a.x2; x++)
+                test_logical[y * lw + x] = color;
+        }
+        disp_rotate_copy(test_phys, TEST_PHYS_W, TEST_PHYS_H, test_logical, rot, &a);
+    }
+
+    for (int y = 0; y < lh; y++)
+    {
+        for (int x = 0; x < lw; x++)
+        {
+            int px = x, py = y;
+
+            if (rot == DISP_ROTATE_90)
+            {
+                px = y;
+                py = TEST_PHYS_H - 1 - x;
+            }
+            else if (rot == DISP_ROTATE_180)
+            {
+                px = TEST_PHYS_W - 1 - x;
+                py = TEST_PHYS_H - 1 - y;
+            }
+            else if (rot == DISP_ROTATE_270)
+            {
+                px = TEST_PHYS_W - 1 - y;
+                py = x;
+            }
+            if (test_phys[py * TEST_PHYS_W + px] != test_logical[y * lw + x])
+                errors++;
+        }
+    }
+    return errors;
+}
+
+static void rotate_test_cmd(int argc, char **argv)
+{
+    static const char *const names[] = {"0", "90", "180", "270"};
+    rt_uint32_t kernel_errors, dirty_errors = 0;
+    rt_size_t fb_size = BENCH_W * BENCH_H * sizeof(rt_uint16_t);
+    rt_uint16_t *logical, *phys;
+    int reps = argc > 1 ? atoi(argv[1]) : 5;
+
+    if (reps <= 0)
+        reps = 5;
+
+    app_test_srand(1);
+    kernel_errors = check_kernels();
+    for (int r = 0; r < 4; r++)
+        dirty_errors += check_dirty((disp_rotate_t)r);
+    rt_kprintf("kernels: 2000 rects, %d mismatches; dirty areas: %d edits x 4, %d mismatched pixels\n",
+               kernel_errors, TEST_EDITS, dirty_errors);
+
+    /* 吞吐量：整屏和一个典型的变化区域，逐像素与分块比较 */
+    logical = rt_malloc(fb_size);
+    phys = rt_malloc(fb_size);
+    if (logical == RT_NULL || phys == RT_NULL)
+    {
+        rt_kprintf("no memory for %dx%d benchmark\n", BENCH_W, BENCH_H);
+    }
+    else
+    {
+        rt_memset(logical, 0x5A, fb_size);
+        rt_kprintf("%dx%d RGB565 x%d, MB/s (full frame / 200x120 area):\n", BENCH_W, BENCH_H, reps);
+        for (int r = 1; r < 4; r++)
+        {
+            disp_rotate_t rot = (disp_rotate_t)r;
+            bool odd = (rot == DISP_ROTATE_90 || rot == DISP_ROTATE_270);
+            int lw = odd ? BENCH_H : BENCH_W, lh = odd ? BENCH_W : BENCH_H;
+            rt_size_t dst_stride = odd ? BENCH_H : BENCH_W;
+            rt_uint32_t us[4], t0;
+
+            t0 = app_perf_now_cycles();
+            for (int i = 0; i < reps; i++)
+                disp_rotate_rect16_ref(phys, dst_stride, logical, lw, lw, lh, rot);
+            us[0] = app_perf_elapsed_us(t0);
+            t0 = app_perf_now_cycles();
+            for (int i = 0; i < reps; i++)
+                disp_rotate_rect16(phys, dst_stride, logical, lw, lw, lh, rot);
+            us[1] = app_perf_elapsed_us(t0);
+            t0 = app_perf_now_cycles();
+            for (int i = 0; i < reps * 16; i++)
+                disp_rotate_rect16_ref(phys, dst_stride, logical, lw, 200, 120, rot);
+            us[2] = app_perf_elapsed_us(t0);
+            t0 = app_perf_now_cycles();
+            for (int i = 0; i < reps * 16; i++)
+                disp_rotate_rect16(phys, dst_stride, logical, lw, 200, 120, rot);
+            us[3] = app_perf_elapsed_us(t0);
+
+            for (int k = 0; k < 4; k++)
+            {
+                if (us[k] == 0)
+                    us[k] = 1;
+            }
+            rt_kprintf("%3s  ref %d / %d, blocked %d / %d\n", names[r],
+                       (int)(fb_size * reps / us[0]), (int)(200 * 120 * 2 * 16 * reps / us[2]),
+                       (int)(fb_size * reps / us[1]), (int)(200 * 120 * 2 * 16 * reps / us[3]));
+        }
+    }
+    rt_free(logical);
+    rt_free(phys);
+
+    rt_kprintf("%s\n", (kernel_errors == 0 && dirty_errors == 0) ? "PASS" : "FAIL");
+}
+MSH_CMD_EXPORT_ALIAS(rotate_test_cmd, rotate_test, check display rotation kernels and measure throughput [reps]);
+#endif /* APP_USING_TEST */
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __DISP_ROTATE_H__
+#define __DISP_ROTATE_H__
+
+#include <rtthread.h>
+
+/* 软件旋转：LVGL按逻辑方向绘制，刷新时只把变化的区域旋转写入面板方向的帧缓冲区。
+ * 逻辑像素(x, y)对应面板像素如下，触摸点按相反的方向从面板坐标转换为逻辑坐标：
+ *   90:  (y, H-1-x)
+ *   180: (W-1-x, H-1-y)
+ *   270: (W-1-y, x)
+ * W、H为面板的宽高，90和270时逻辑宽高为H、W。
+ *
+ * 90和270按DISP_ROTATE_TILE见方的块转置，一块的源和目标各占DISP_ROTATE_TILE个缓存行，
+ * 按列读取源时不会反复换出缓存行。RGB565 */
+
+#define DISP_ROTATE_TILE    16  /* 16个RGB565像素正好一个缓存行 */
+
+typedef enum {
+    DISP_ROTATE_0 = 0,
+    DISP_ROTATE_90,
+    DISP_ROTATE_180,
+    DISP_ROTATE_270,
+} disp_rotate_t;
+
+/* 坐标包含两端，与lv_area_t相同 */
+typedef struct {
+    rt_int16_t x1;
+    rt_int16_t y1;
+    rt_int16_t x2;
+    rt_int16_t y2;
+} disp_area_t;
+
+/* 逻辑区域转换为面板区域，phys_w、phys_h为面板宽高 */
+void disp_rotate_area(disp_rotate_t rot, rt_uint16_t phys_w, rt_uint16_t phys_h,
+                      const disp_area_t *in, disp_area_t *out);
+
+/* 把逻辑帧缓冲区中的一个区域旋转写入面板帧缓冲区，两者都没有行间填充 */
+void disp_rotate_copy(rt_uint16_t *phys, rt_uint16_t phys_w, rt_uint16_t phys_h,
+                      const rt_uint16_t *logical, disp_rotate_t rot, const disp_area_t *area);
+
+/* 旋转w x h的源矩形，dst指向目标矩形的左上角，跨度单位为像素 */
+void disp_rotate_rect16(rt_uint16_t *dst, rt_size_t dst_stride, const rt_uint16_t *src, rt_size_t src_stride,
+                        int w, int h, disp_rotate_t rot);
+#ifdef APP_USING_TEST
+/* 逐像素的参考实现，只在测试中编译 */
+void disp_rotate_rect16_ref(rt_uint16_t *dst, rt_size_t dst_stride, const rt_uint16_t *src, rt_size_t src_stride,
+                            int w, int h, disp_rotate_t rot);
+#endif
+
+#endif /* __DISP_ROTATE_H__ */
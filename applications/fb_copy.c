@@ -0,0 +1,498 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include "fb_copy.h"
+#include "cache_sync.h"
+
+#if defined(__GNUC__) && (defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_7M__))
+#define FB_COPY_USE_LDM     /* LDM/STM一次搬运8个字，正好一个缓存行 */
+#endif
+
+#define FB_BURST_MIN        64  /* 短于这个长度时直接逐字节复制 */
+
+static const fb_dma_ops_t *dma_ops = RT_NULL;
+static fb_copy_stats_t copy_stats;
+
+void fb_copy_set_dma(const fb_dma_ops_t *ops)
+{
+    dma_ops = ops;
+}
+
+void fb_copy_get_stats(fb_copy_stats_t *stats)
+{
+    *stats = copy_stats;
+}
+
+/* ==================== 整行搬运 ==================== */
+
+/* d按缓存行对齐，s按4字节对齐 */
+static void copy_lines(rt_uint32_t *d, const rt_uint32_t *s, rt_size_t lines)
+{
+#ifdef FB_COPY_USE_LDM
+    while (lines--)
+    {
+        __asm volatile (
+            "ldmia %1!, {r3, r4, r5, r6, r8, r10, r11, r12}\n"
+            "stmia %0!, {r3, r4, r5, r6, r8, r10, r11, r12}\n"
+            : "+r" (d), "+r" (s)
+            :
+            : "r3", "r4", "r5", "r6", "r8", "r10", "r11", "r12", "memory");
+    }
+#else
+    /* 源也按8字节对齐时用64位访问 */
+    if (((rt_ubase_t)s & 7) == 0)
+    {
+        rt_uint64_t *d64 = (rt_uint64_t *)d;
+        const rt_uint64_t *s64 = (const rt_uint64_t *)s;
+
+        while (lines--)
+        {
+            rt_uint64_t a = s64[0], b = s64[1], c = s64[2], e = s64[3];
+
+            d64[0] = a;
+            d64[1] = b;
+            d64[2] = c;
+            d64[3] = e;
+            d64 += 4;
+            s64 += 4;
+        }
+        return;
+    }
+    while (lines--)
+    {
+        rt_uint32_t a = s[0], b = s[1], c = s[2], e = s[3];
+        rt_uint32_t f = s[4], g = s[5], h = s[6], i = s[7];
+
+        d[0] = a;
+        d[1] = b;
+        d[2] = c;
+        d[3] = e;
+        d[4] = f;
+        d[5] = g;
+        d[6] = h;
+        d[7] = i;
+        d += 8;
+        s += 8;
+    }
+#endif
+}
+
+/* d按缓存行对齐，s按2字节对齐但不按4字节对齐（RGB565相差奇数个像素），读取半字拼成字写入 */
+static void copy_lines_half(rt_uint32_t *d, const rt_uint16_t *s, rt_size_t lines)
+{
+    while (lines--)
+    {
+        rt_uint32_t a = s[0] | ((rt_uint32_t)s[1] << 16);
+        rt_uint32_t b = s[2] | ((rt_uint32_t)s[3] << 16);
+        rt_uint32_t c = s[4] | ((rt_uint32_t)s[5] << 16);
+        rt_uint32_t e = s[6] | ((rt_uint32_t)s[7] << 16);
+        rt_uint32_t f = s[8] | ((rt_uint32_t)s[9] << 16);
+        rt_uint32_t g = s[10] | ((rt_uint32_t)s[11] << 16);
+        rt_uint32_t h = s[12] | ((rt_uint32_t)s[13] << 16);
+        rt_uint32_t i = s[14] | ((rt_uint32_t)s[15] << 16);
+
+        d[0] = a;
+        d[1] = b;
+        d[2] = c;
+        d[3] = e;
+        d[4] = f;
+        d[5] = g;
+        d[6] = h;
+        d[7] = i;
+        d += 8;
+        s += 16;
+    }
+}
+
+static void fill_lines(rt_uint32_t *d, rt_uint32_t pattern, rt_size_t lines)
+{
+#ifdef FB_COPY_USE_LDM
+    register rt_uint32_t r3 __asm("r3") = pattern;
+    register rt_uint32_t r4 __asm("r4") = pattern;
+    register rt_uint32_t r5 __asm("r5") = pattern;
+    register rt_uint32_t r6 __asm("r6") = pattern;
+    register rt_uint32_t r8 __asm("r8") = pattern;
+    register rt_uint32_t r10 __asm("r10") = pattern;
+    register rt_uint32_t r11 __asm("r11") = pattern;
+    register rt_uint32_t r12 __asm("r12") = pattern;
+
+    while (lines--)
+    {
+        __asm volatile (
+            "stmia %0!, {%1, %2, %3, %4, %5, %6, %7, %8}\n"
+            : "+r" (d)
+            : "r" (r3), "r" (r4), "r" (r5), "r" (r6), "r" (r8), "r" (r10), "r" (r11), "r" (r12)
+            : "memory");
+    }
+#else
+    rt_uint64_t p64 = ((rt_uint64_t)pattern << 32) | pattern;
+    rt_uint64_t *d64 = (rt_uint64_t *)d;
+
+    while (lines--)
+    {
+        d64[0] = p64;
+        d64[1] = p64;
+        d64[2] = p64;
+        d64[3] = p64;
+        d64 += 4;
+    }
+#endif
+}
+
+/* ==================== 线性复制和填充 ==================== */
+
+void fb_copy(void *dst, const void *src, rt_size_t n)
+{
+    rt_uint8_t *d = (rt_uint8_t *)dst;
+    const rt_uint8_t *s = (const rt_uint8_t *)src;
+    rt_ubase_t rel = (rt_ubase_t)d ^ (rt_ubase_t)s;
+    rt_size_t head, lines;
+
+    if (n >= FB_BURST_MIN && (rel & 1) == 0)
+    {
+        /* 目标对齐到缓存行 */
+        head = (CACHE_LINE_SIZE - ((rt_ubase_t)d & (CACHE_LINE_SIZE - 1))) & (CACHE_LINE_SIZE - 1);
+        n -= head;
+        while (head--)
+            *d++ = *s++;
+
+        lines = n / CACHE_LINE_SIZE;
+        if ((rel & 3) == 0)
+            copy_lines((rt_uint32_t *)d, (const rt_uint32_t *)s, lines);
+        else
+            copy_lines_half((rt_uint32_t *)d, (const rt_uint16_t *)s, lines);
+        d += lines * CACHE_LINE_SIZE;
+        s += lines * CACHE_LINE_SIZE;
+        n -= lines * CACHE_LINE_SIZE;
+    }
+    else if (n >= FB_BURST_MIN)
+    {
+        /* 奇数字节的相对偏移不会出现在16位帧缓冲区中 */
+        rt_memcpy(d, s, n);
+        return;
+    }
+
+    while (n--)
+        *d++ = *s++;
+}
+
+void fb_fill16(void *dst, rt_uint16_t color, rt_size_t count)
+{
+    rt_uint16_t *d = (rt_uint16_t *)dst;
+    rt_uint32_t pattern = color | ((rt_uint32_t)color << 16);
+    rt_uint32_t *w;
+    rt_size_t lines;
+
+    if (count > 0 && ((rt_ubase_t)d & 2))
+    {
+        *d++ = color;
+        count--;
+    }
+
+    w = (rt_uint32_t *)d;
+    while (count >= 2 && ((rt_ubase_t)w & (CACHE_LINE_SIZE - 1)))
+    {
+        *w++ = pattern;
+        count -= 2;
+    }
+
+    lines = count / (CACHE_LINE_SIZE / 2);
+    fill_lines(w, pattern, lines);
+    w += lines * (CACHE_LINE_SIZE / 4);
+    count -= lines * (CACHE_LINE_SIZE / 2);
+
+    while (count >= 2)
+    {
+        *w++ = pattern;
+        count -= 2;
+    }
+    if (count)
+        *(rt_uint16_t *)w = color;
+}
+
+/* ==================== 矩形区域 ==================== */
+
+static bool dma_usable(rt_size_t bytes, rt_ubase_t bits)
+{
+    return dma_ops != RT_NULL && bytes >= FB_COPY_DMA_MIN && (bits & 1) == 0;
+}
+
+void fb_copy_rect(void *dst, rt_size_t dst_stride, const void *src, rt_size_t src_stride,
+                  rt_size_t width, rt_size_t rows)
+{
+    rt_uint8_t *d = (rt_uint8_t *)dst;
+    const rt_uint8_t *s = (const rt_uint8_t *)src;
+
+    if (width == 0 || rows == 0)
+        return;
+
+    if (dma_usable(width * rows, (rt_ubase_t)d | (rt_ubase_t)s | dst_stride | src_stride | width) &&
+        dma_ops->copy != RT_NULL)
+    {
+        /* DMA从SDRAM读取源区域，写入的目标区域不能被缓存中的旧数据覆盖 */
+        cache_clean_rect(s, src_stride, 1, 0, 0, width - 1, rows - 1);
+        cache_invalidate_rect(d, dst_stride, 1, 0, 0, width - 1, rows - 1);
+        cache_dma_handoff(s, (rows - 1) * src_stride + width);
+        copy_stats.dma_calls++;
+        if (dma_ops->copy(d, dst_stride, s, src_stride, width, rows) == RT_EOK)
+        {
+            cache_invalidate_rect(d, dst_stride, 1, 0, 0, width - 1, rows - 1);
+            copy_stats.dma_bytes += width * rows;
+            return;
+        }
+        copy_stats.dma_errors++;
+    }
+
+    copy_stats.cpu_bytes += width * rows;
+    if (dst_stride == width && src_stride == width)
+    {
+        fb_copy(d, s, width * rows);
+        return;
+    }
+    for (rt_size_t y = 0; y < rows; y++, d += dst_stride, s += src_stride)
+        fb_copy(d, s, width);
+}
+
+void fb_fill16_rect(void *dst, rt_size_t stride, rt_uint16_t color, rt_size_t width, rt_size_t rows)
+{
+    rt_uint8_t *d = (rt_uint8_t *)dst;
+
+    if (width == 0 || rows == 0)
+        return;
+
+    if (dma_usable(width * 2 * rows, (rt_ubase_t)d | stride) && dma_ops->fill16 != RT_NULL)
+    {
+        cache_invalidate_rect(d, stride, 2, 0, 0, width - 1, rows - 1);
+        copy_stats.dma_calls++;
+        if (dma_ops->fill16(d, stride, color, width, rows) == RT_EOK)
+        {
+            cache_invalidate_rect(d, stride, 2, 0, 0, width - 1, rows - 1);
+            copy_stats.dma_bytes += width * 2 * rows;
+            return;
+        }
+        copy_stats.dma_errors++;
+    }
+
+    copy_stats.cpu_bytes += width * 2 * rows;
+    if (stride == width * 2)
+    {
+        fb_fill16(d, color, width * rows);
+        return;
+    }
+    for (rt_size_t y = 0; y < rows; y++, d += stride)
+        fb_fill16(d, color, width);
+}
+
+#ifdef APP_USING_TEST
+
+/* ==================== 参考实现 ==================== */
+
+void fb_copy_rect_ref(void *dst, rt_size_t dst_stride, const void *src, rt_size_t src_stride,
+                      rt_size_t width, rt_size_t rows)
+{
+    for (rt_size_t y = 0; y < rows; y++)
+    {
+        volatile rt_uint8_t *d = (rt_uint8_t *)dst + y * dst_stride;
+        const rt_uint8_t *s = (const rt_uint8_t *)src + y * src_stride;
+
+        for (rt_size_t x = 0; x < width; x++)
+            d[x] = s[x];
+    }
+}
+
+void fb_fill16_rect_ref(void *dst, rt_size_t stride, rt_uint16_t color, rt_size_t width, rt_size_t rows)
+{
+    for (rt_size_t y = 0; y < rows; y++)
+    {
+        volatile rt_uint16_t *d = (rt_uint16_t *)((rt_uint8_t *)dst + y * stride);
+
+        for (rt_size_t x = 0; x < width; x++)
+            d[x] = color;
+    }
+}
+
+#include <finsh.h>
+#include <stdlib.h>
+#include "app_perf.h"
+#include "app_test.h"
+
+/* ==================== 正确性和吞吐量测试 ==================== */
+
+#define TEST_BUF_SIZE       (64 * 1024)
+#define TEST_ROUNDS         3000
+#define BENCH_W             800
+#define BENCH_H             480
+
+static rt_uint32_t fake_dma_calls;
+
+/* 测试用的“DMA”：用参考实现完成，每隔一次返回失败，检查CPU接手 */
+static rt_err_t fake_dma_copy(void *dst, rt_size_t dst_stride, const void *src, rt_size_t src_stride,
+                              rt_size_t width, rt_size_t rows)
+{
+    if (fake_dma_calls++ & 1)
+        return -RT_EBUSY;
+    fb_copy_rect_ref(dst, dst_stride, src, src_stride, width, rows);
+    return RT_EOK;
+}
+
+static rt_err_t fake_dma_fill16(void *dst, rt_size_t stride, rt_uint16_t color, rt_size_t width, rt_size_t rows)
+{
+    if (fake_dma_calls++ & 1)
+        return -RT_EBUSY;
+    fb_fill16_rect_ref(dst, stride, color, width, rows);
+    return RT_EOK;
+}
+
+static const fb_dma_ops_t fake_dma = {
+    fake_dma_copy,
+    fake_dma_fill16,
+};
+
+/* 随机的对齐、宽度和跨度，与参考实现比较整个缓冲区（包括区域外的字节） */
+static rt_uint32_t check_random(rt_uint8_t *src, rt_uint8_t *dst, rt_uint8_t *ref)
+{
+    rt_uint32_t errors = 0;
+
+    for (int i = 0; i < TEST_ROUNDS; i++)
+    {
+        bool fill = (i & 1) != 0;
+        rt_size_t width = 1 + app_test_rand(fill ? 300 : 600);
+        rt_size_t rows = 1 + app_test_rand(40);
+        rt_size_t d_off = app_test_rand(64), s_off = app_test_rand(64);
+        rt_size_t d_stride = width * (fill ? 2 : 1) + app_test_rand(3) * app_test_rand(80);
+        rt_size_t s_stride = width + app_test_rand(3) * app_test_rand(80);
+        rt_uint16_t color = (rt_uint16_t)app_test_rand(0x10000);
+
+        if (fill)
+        {
+            d_off &= ~1;
+            d_stride &= ~1;
+        }
+        if (d_off + d_stride * rows > TEST_BUF_SIZE || s_off + s_stride * rows > TEST_BUF_SIZE)
+            continue;
+
+        if (fill)
+        {
+            fb_fill16_rect(dst + d_off, d_stride, color, width, rows);
+            fb_fill16_rect_ref(ref + d_off, d_stride, color, width, rows);
+        }
+        else
+        {
+            fb_copy_rect(dst + d_off, d_stride, src + s_off, s_stride, width, rows);
+            fb_copy_rect_ref(ref + d_off, d_stride, src + s_off, s_stride, width, rows);
+        }
+        if (rt_memcmp(dst, ref, TEST_BUF_SIZE) != 0)
+        {
+            errors++;
+            rt_memcpy(dst, ref, TEST_BUF_SIZE);
+        }
+    }
+    return errors;
+}
+
+/* 整屏RGB565，按MB/s */
+static rt_uint32_t bench_mbps(rt_uint32_t bytes, rt_uint32_t us)
+{
+    return us ? bytes / us : 0;
+}
+
+static void fb_test_cmd(int argc, char **argv)
+{
+    rt_size_t fb_size = BENCH_W * BENCH_H * 2;
+    rt_uint8_t *src = rt_malloc(TEST_BUF_SIZE);
+    rt_uint8_t *dst = rt_malloc(TEST_BUF_SIZE);
+    rt_uint8_t *ref = rt_malloc(TEST_BUF_SIZE);
+    rt_uint8_t *fa = RT_NULL, *fb = RT_NULL;
+    rt_uint32_t cpu_errors, dma_errors, t0, us[6];
+    int reps = argc > 1 ? atoi(argv[1]) : 10;
+    const fb_dma_ops_t *saved = dma_ops;
+
+    if (src == RT_NULL || dst == RT_NULL || ref == RT_NULL)
+    {
+        rt_kprintf("out of memory\n");
+        goto out;
+    }
+    if (reps <= 0)
+        reps = 10;
+
+    app_test_srand(1);
+    for (int i = 0; i < TEST_BUF_SIZE; i++)
+        src[i] = (rt_uint8_t)app_test_rand(256);
+    rt_memset(dst, 0xA5, TEST_BUF_SIZE);
+    rt_memset(ref, 0xA5, TEST_BUF_SIZE);
+
+    dma_ops = RT_NULL;
+    cpu_errors = check_random(src, dst, ref);
+    dma_ops = &fake_dma;
+    fake_dma_calls = 0;
+    dma_errors = check_random(src, dst, ref);
+    dma_ops = saved;
+    rt_kprintf("correctness: %d rounds cpu, %d mismatches; %d rounds with dma (%d dma calls), %d mismatches\n",
+               TEST_ROUNDS, cpu_errors, TEST_ROUNDS, fake_dma_calls, dma_errors);
+
+    /* 吞吐量：整屏复制（同对齐和相差一个像素）和填充 */
+    fa = rt_malloc(fb_size + CACHE_LINE_SIZE);
+    fb = rt_malloc(fb_size + CACHE_LINE_SIZE);
+    if (fa == RT_NULL || fb == RT_NULL)
+    {
+        rt_kprintf("no memory for %dx%d benchmark\n", BENCH_W, BENCH_H);
+        goto out;
+    }
+    rt_memset(fa, 0x5A, fb_size + CACHE_LINE_SIZE);
+
+    dma_ops = RT_NULL;
+    t0 = app_perf_now_cycles();
+    for (int i = 0; i < reps; i++)
+        fb_copy_rect_ref(fb, BENCH_W * 2, fa, BENCH_W * 2, BENCH_W * 2 - 2, BENCH_H);
+    us[0] = app_perf_elapsed_us(t0);
+    t0 = app_perf_now_cycles();
+    for (int i = 0; i < reps; i++)
+    {
+        for (int y = 0; y < BENCH_H; y++)
+            rt_memcpy(fb + y * BENCH_W * 2, fa + y * BENCH_W * 2, BENCH_W * 2 - 2);
+    }
+    us[1] = app_perf_elapsed_us(t0);
+    t0 = app_perf_now_cycles();
+    for (int i = 0; i < reps; i++)
+        fb_copy_rect(fb, BENCH_W * 2, fa, BENCH_W * 2, BENCH_W * 2 - 2, BENCH_H);
+    us[2] = app_perf_elapsed_us(t0);
+    t0 = app_perf_now_cycles();
+    for (int i = 0; i < reps; i++)
+        fb_copy_rect(fb, BENCH_W * 2, fa + 2, BENCH_W * 2, BENCH_W * 2 - 2, BENCH_H);
+    us[3] = app_perf_elapsed_us(t0);
+    t0 = app_perf_now_cycles();
+    for (int i = 0; i < reps; i++)
+        fb_fill16_rect_ref(fb, BENCH_W * 2, 0x1234, BENCH_W - 1, BENCH_H);
+    us[4] = app_perf_elapsed_us(t0);
+    t0 = app_perf_now_cycles();
+    for (int i = 0; i < reps; i++)
+        fb_fill16_rect(fb, BENCH_W * 2, 0x1234, BENCH_W - 1, BENCH_H);
+    us[5] = app_perf_elapsed_us(t0);
+    dma_ops = saved;
+
+    rt_kprintf("%dx%d RGB565 x%d, MB/s:\n", BENCH_W, BENCH_H, reps);
+    rt_kprintf("copy   ref %d, memcpy %d, fb_copy %d, fb_copy odd pixel %d\n",
+               bench_mbps(fb_size * reps, us[0]), bench_mbps(fb_size * reps, us[1]),
+               bench_mbps(fb_size * reps, us[2]), bench_mbps(fb_size * reps, us[3]));
+    rt_kprintf("fill   ref %d, fb_fill16 %d\n",
+               bench_mbps(fb_size * reps, us[4]), bench_mbps(fb_size * reps, us[5]));
+    rt_kprintf("%s\n", (cpu_errors == 0 && dma_errors == 0) ? "PASS" : "FAIL");
+
+out:
+    dma_ops = saved;
+    rt_free(src);
+    rt_free(dst);
+    rt_free(ref);
+    rt_free(fa);
+    rt_free(fb);
+}
+MSH_CMD_EXPORT_ALIAS(fb_test_cmd, fb_test, check framebuffer copy and fill and measure throughput [reps]);
+#endif /* APP_USING_TEST */
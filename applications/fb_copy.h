@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __FB_COPY_H__
+#define __FB_COPY_H__
+
+#include <rtthread.h>
+
+/* 帧缓冲区的复制和填充：SDRAM按32字节（一个缓存行）突发访问效率最高，
+ * 目标地址先对齐到缓存行，再每次搬运一整行（Cortex-M7上用LDM/STM八个寄存器，其他平台用展开的64位访问）。
+ * 源和目标的相对对齐不满足时退回较窄的访问。
+ *
+ * 矩形区域按行复制，每行字节数等于跨度时合并为一次线性复制。
+ * 注册了DMA（DMA2D）并且区域不小于FB_COPY_DMA_MIN字节时交给DMA，
+ * 调用前清理源区域、调用前后无效化目标区域的D-Cache，DMA失败时由CPU完成。
+ * *_ref为逐字节/逐像素的参考实现，只在测试中编译 */
+
+#define FB_COPY_DMA_MIN     8192    /* 小于这个字节数时CPU更快（DMA2D的配置和等待开销） */
+
+typedef struct {
+    /* width为每行字节数，地址、跨度和width都是2的倍数 */
+    rt_err_t (*copy)(void *dst, rt_size_t dst_stride, const void *src, rt_size_t src_stride,
+                     rt_size_t width, rt_size_t rows);
+    /* width为每行像素数 */
+    rt_err_t (*fill16)(void *dst, rt_size_t stride, rt_uint16_t color, rt_size_t width, rt_size_t rows);
+} fb_dma_ops_t;
+
+typedef struct {
+    rt_uint32_t cpu_bytes;
+    rt_uint32_t dma_bytes;
+    rt_uint32_t dma_calls;
+    rt_uint32_t dma_errors;
+} fb_copy_stats_t;
+
+void fb_copy_set_dma(const fb_dma_ops_t *ops);
+
+void fb_copy(void *dst, const void *src, rt_size_t n);
+void fb_fill16(void *dst, rt_uint16_t color, rt_size_t count);
+
+/* 跨度和width单位为字节 */
+void fb_copy_rect(void *dst, rt_size_t dst_stride, const void *src, rt_size_t src_stride,
+                  rt_size_t width, rt_size_t rows);
+/* 跨度单位为字节，width为每行像素数 */
+void fb_fill16_rect(void *dst, rt_size_t stride, rt_uint16_t color, rt_size_t width, rt_size_t rows);
+
+#ifdef APP_USING_TEST
+void fb_copy_rect_ref(void *dst, rt_size_t dst_stride, const void *src, rt_size_t src_stride,
+                      rt_size_t width, rt_size_t rows);
+void fb_fill16_rect_ref(void *dst, rt_size_t stride, rt_uint16_t color, rt_size_t width, rt_size_t rows);
+#endif
+
+void fb_copy_get_stats(fb_copy_stats_t *stats);
+
+#endif /* __FB_COPY_H__ */
@@ -0,0 +1,374 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include "flow_credit.h"
+
+/* ==================== 接收方 ==================== */
+
+void flow_credit_init(flow_credit_t *c, rt_uint16_t window)
+{
+    rt_memset(c, 0, sizeof(flow_credit_t));
+    c->window = window;
+    c->advertised = window;
+}
+
+rt_uint16_t flow_credit_in_use(const flow_credit_t *c)
+{
+    return (rt_uint16_t)(c->received - c->consumed - c->dropped_pkts);
+}
+
+/* 检测到一个数据包开始（在接收中断中调用），返回它的接收序号 */
+rt_uint16_t flow_credit_on_packet(flow_credit_t *c, rt_uint32_t now_ms)
+{
+    rt_uint16_t in_use;
+
+    c->received++;
+    c->last_rx_ms = now_ms;
+    c->stats.packets++;
+
+    in_use = flow_credit_in_use(c);
+    if (in_use > c->stats.peak_in_use)
+        c->stats.peak_in_use = in_use;
+    if (c->acked)
+    {
+        if ((rt_int16_t)(c->received - c->advertised) > 0)
+            c->stats.overruns++;
+        else if (c->received == c->advertised)
+            c->stats.stalls++;
+    }
+    return c->received;
+}
+
+/* 数据包处理完，缓冲区可以再次使用（在处理线程中调用） */
+void flow_credit_on_consumed(flow_credit_t *c)
+{
+    c->consumed++;
+}
+
+/* 数据包被丢弃（过长、接收缓冲区溢出或消息队列满），不占用缓冲区（在接收中断中调用）。
+ * 单独计数，避免和处理线程同时修改consumed时丢失计数，使窗口永久变小 */
+void flow_credit_on_drop(flow_credit_t *c)
+{
+    c->dropped_pkts++;
+    c->stats.dropped++;
+}
+
+/* 丢弃了包头以外的数据，可能有数据包没有被计数 */
+void flow_credit_on_error(flow_credit_t *c)
+{
+    c->suspect = true;
+}
+
+/* 处理ESP32回复credit_init的确认包，index为确认包的接收序号，
+ * 确认包在ESP32一侧是第1个，两边的计数按它对齐 */
+void flow_credit_on_ack(flow_credit_t *c, rt_uint16_t index)
+{
+    rt_uint16_t offset = index - 1;
+    rt_base_t level;
+
+    if (!c->init_sent)
+        return;
+
+    level = rt_hw_interrupt_disable();
+    c->received -= offset;
+    c->consumed -= offset;
+    rt_hw_interrupt_enable(level);
+
+    /* 确认前收到的数据包还没处理完时，ESP32得到的窗口会多出这几个，处理完之前不再通告 */
+    c->advertised = c->init_window;
+    c->acked = true;
+    c->suspect = false;
+    c->refreshed = false;
+}
+
+flow_credit_action_t flow_credit_poll(flow_credit_t *c, rt_uint32_t now_ms, rt_uint16_t *value)
+{
+    rt_uint16_t limit = c->consumed + c->dropped_pkts + c->window;
+    rt_int16_t delta = (rt_int16_t)(limit - c->advertised);
+
+    *value = c->window;
+    if (!c->acked)
+    {
+        if (!c->init_sent || now_ms - c->init_ms >= FLOW_CREDIT_RETRY_MS)
+            return FLOW_CREDIT_INIT;
+        return FLOW_CREDIT_NONE;
+    }
+
+    /* 计数可能不同步时，等链路空闲后重新初始化 */
+    if (c->suspect && now_ms - c->last_rx_ms >= FLOW_CREDIT_RESYNC_MS)
+        return FLOW_CREDIT_INIT;
+
+    *value = limit;
+    if (delta > 0)
+    {
+        /* 累计到半个窗口再通告；发送方已经停下或拖得太久时立即通告 */
+        if (delta >= (c->window + 1) / 2 || c->received == c->advertised ||
+            now_ms - c->last_adv_ms >= FLOW_CREDIT_REFRESH_MS)
+            return FLOW_CREDIT_UPDATE;
+        return FLOW_CREDIT_NONE;
+    }
+
+    /* 通告后一直没有数据包，可能通告丢失，重复一次 */
+    if (!c->refreshed && now_ms - c->last_adv_ms >= FLOW_CREDIT_REFRESH_MS &&
+        now_ms - c->last_rx_ms >= FLOW_CREDIT_REFRESH_MS)
+        return FLOW_CREDIT_UPDATE;
+    return FLOW_CREDIT_NONE;
+}
+
+void flow_credit_sent(flow_credit_t *c, flow_credit_action_t action, rt_uint16_t value,
+                      rt_uint32_t now_ms)
+{
+    if (action == FLOW_CREDIT_INIT)
+    {
+        /* ESP32收到后计数清零，确认之前的通告编号不同，暂停通告 */
+        if (c->acked)
+            c->stats.resyncs++;
+        c->acked = false;
+        c->init_sent = true;
+        c->init_window = value;
+        c->init_ms = now_ms;
+        c->last_adv_ms = now_ms;
+    }
+    else if (action == FLOW_CREDIT_UPDATE)
+    {
+        c->refreshed = (value == c->advertised);
+        c->advertised = value;
+        c->last_adv_ms = now_ms;
+        c->stats.adverts++;
+    }
+}
+
+#ifdef APP_USING_TEST
+
+/* ==================== 发送方 ==================== */
+
+void flow_sender_init(flow_sender_t *s)
+{
+    rt_memset(s, 0, sizeof(flow_sender_t));
+}
+
+/* 没有收到credit_init时不限制 */
+bool flow_sender_can_send(const flow_sender_t *s)
+{
+    return !s->enabled || (rt_int16_t)(s->limit - s->sent) > 0;
+}
+
+void flow_sender_on_sent(flow_sender_t *s)
+{
+    s->sent++;
+    s->ack_pending = false;
+}
+
+void flow_sender_on_command(flow_sender_t *s, flow_credit_action_t action, rt_uint16_t value)
+{
+    if (action == FLOW_CREDIT_INIT && value > 0)
+    {
+        s->sent = 0;
+        s->limit = value;
+        s->enabled = true;
+        s->ack_pending = true;
+    }
+    else if (action == FLOW_CREDIT_UPDATE && s->enabled && (rt_int16_t)(value - s->limit) > 0)
+    {
+        s->limit = value;
+    }
+}
+
+#include <finsh.h>
+#include <stdlib.h>
+
+/* ==================== 过载模拟 ==================== */
+
+#define SIM_RETX_MS         500         /* 丢包后重新获取的延迟 */
+#define SIM_CMD_MS          2           /* 命令到达ESP32的延迟 */
+#define SIM_LIMIT_MS        600000
+#define SIM_CMD_RING        16
+
+typedef struct {
+    rt_uint32_t t_ms;
+    flow_credit_action_t action;
+    rt_uint16_t value;
+} sim_cmd_t;
+
+/* 本机消息队列中的一项 */
+typedef struct {
+    rt_uint16_t index;          /* 接收序号 */
+    bool ack;                   /* credit_init的确认包 */
+} sim_msg_t;
+
+typedef struct {
+    rt_uint32_t done_ms;
+    rt_uint32_t dropped;
+    rt_uint32_t retx;
+    rt_uint32_t busy_ms;        /* 链路占用时间 */
+    rt_uint32_t adverts;
+} sim_result_t;
+
+static rt_uint32_t *sim_retx_at;        /* 等待重发的时间，每个数据包最多一项 */
+static rt_uint32_t sim_retx_size;
+static sim_msg_t *sim_queue;
+
+/* ESP32以send_ms的间隔连续发送数据包，本机每consume_ms处理一个，队列容量为window。
+ * 不使用信用时队列满就丢包，ESP32在SIM_RETX_MS后重发；使用信用时ESP32按上限暂停 */
+static void credit_sim_run(rt_uint32_t packets, rt_uint32_t send_ms, rt_uint32_t consume_ms,
+                           rt_uint16_t window, bool use_credit, sim_result_t *r)
+{
+    flow_credit_t credit;
+    flow_sender_t sender;
+    sim_cmd_t cmds[SIM_CMD_RING];
+    sim_msg_t current;
+    rt_uint32_t cmd_head = 0, cmd_tail = 0;
+    rt_uint32_t retx_head = 0, retx_tail = 0;
+    rt_uint32_t q_head = 0, q_tail = 0;
+    rt_uint32_t next_new = 0, delivered = 0;
+    rt_uint32_t tx_end = 0, consume_end = 0;
+    bool tx_busy = false, tx_ack = false, consuming = false;
+    flow_credit_action_t action;
+    rt_uint16_t value;
+
+    rt_memset(r, 0, sizeof(sim_result_t));
+    flow_credit_init(&credit, window);
+    flow_sender_init(&sender);
+
+    for (rt_uint32_t t = 0; t < SIM_LIMIT_MS && delivered < packets; t++)
+    {
+        /* 命令到达ESP32 */
+        while (cmd_tail != cmd_head && cmds[cmd_tail % SIM_CMD_RING].t_ms <= t)
+        {
+            sim_cmd_t *cmd = &cmds[cmd_tail++ % SIM_CMD_RING];
+            flow_sender_on_command(&sender, cmd->action, cmd->value);
+        }
+
+        /* 一个数据包发送完成，由接收中断计数后放入消息队列 */
+        if (tx_busy && t >= tx_end)
+        {
+            rt_uint16_t index = flow_credit_on_packet(&credit, t);
+
+            tx_busy = false;
+            if (q_head - q_tail < window)
+            {
+                sim_queue[q_head % window].index = index;
+                sim_queue[q_head % window].ack = tx_ack;
+                q_head++;
+            }
+            else
+            {
+                flow_credit_on_drop(&credit);
+                r->dropped++;
+                if (!tx_ack)
+                    sim_retx_at[retx_head++ % sim_retx_size] = t + SIM_RETX_MS;
+            }
+        }
+
+        /* 处理完一个数据包 */
+        if (consuming && t >= consume_end)
+        {
+            consuming = false;
+            if (current.ack)
+                flow_credit_on_ack(&credit, current.index);
+            else
+                delivered++;
+            flow_credit_on_consumed(&credit);
+        }
+        if (!consuming && q_tail != q_head)
+        {
+            current = sim_queue[q_tail++ % window];
+            consuming = true;
+            consume_end = t + (current.ack ? 0 : consume_ms);
+        }
+
+        /* 本机通告信用 */
+        if (use_credit && cmd_head - cmd_tail < SIM_CMD_RING)
+        {
+            action = flow_credit_poll(&credit, t, &value);
+            if (action != FLOW_CREDIT_NONE)
+            {
+                sim_cmd_t *cmd = &cmds[cmd_head++ % SIM_CMD_RING];
+                cmd->t_ms = t + SIM_CMD_MS;
+                cmd->action = action;
+                cmd->value = value;
+                flow_credit_sent(&credit, action, value, t);
+            }
+        }
+
+        /* ESP32开始发送下一个数据包：确认包优先，其次重发 */
+        if (!tx_busy && flow_sender_can_send(&sender))
+        {
+            tx_ack = sender.ack_pending;
+            if (tx_ack)
+            {
+                tx_busy = true;
+            }
+            else if (retx_tail != retx_head && sim_retx_at[retx_tail % sim_retx_size] <= t)
+            {
+                retx_tail++;
+                r->retx++;
+                tx_busy = true;
+            }
+            else if (next_new < packets)
+            {
+                next_new++;
+                tx_busy = true;
+            }
+            if (tx_busy)
+            {
+                flow_sender_on_sent(&sender);
+                tx_end = t + send_ms;
+                r->busy_ms += send_ms;
+            }
+        }
+    }
+    r->done_ms = (delivered >= packets) ? (packets ? consume_end : 0) : SIM_LIMIT_MS;
+    r->adverts = credit.stats.adverts;
+}
+
+static void credit_sim_print(const char *mode, rt_uint32_t packets, const sim_result_t *r)
+{
+    rt_kprintf("%-7s %8d %7d %8d %6d %8d %7d%%\n", mode, r->done_ms,
+               r->done_ms ? packets * 1000 / r->done_ms : 0, r->dropped, r->retx, r->adverts,
+               r->done_ms ? r->busy_ms * 100 / r->done_ms : 0);
+}
+
+static void credit_sim_cmd(int argc, char **argv)
+{
+    rt_uint32_t packets = argc > 1 ? atoi(argv[1]) : 200;
+    rt_uint32_t send_ms = argc > 2 ? atoi(argv[2]) : 10;
+    rt_uint32_t consume_ms = argc > 3 ? atoi(argv[3]) : 30;
+    rt_uint16_t window = argc > 4 ? atoi(argv[4]) : 4;
+    sim_result_t none, credit;
+
+    if (send_ms == 0) send_ms = 1;
+    if (window == 0) window = 1;
+
+    sim_retx_size = packets + 1;
+    sim_retx_at = rt_malloc(sim_retx_size * sizeof(rt_uint32_t));
+    sim_queue = rt_malloc(window * sizeof(sim_msg_t));
+    if (sim_retx_at == RT_NULL || sim_queue == RT_NULL)
+    {
+        rt_kprintf("no memory\n");
+    }
+    else
+    {
+        credit_sim_run(packets, send_ms, consume_ms, window, false, &none);
+        credit_sim_run(packets, send_ms, consume_ms, window, true, &credit);
+    }
+    if (sim_retx_at) rt_free(sim_retx_at);
+    if (sim_queue) rt_free(sim_queue);
+    if (sim_retx_at == RT_NULL || sim_queue == RT_NULL)
+        return;
+
+    rt_kprintf("%d packets, send %d ms, consume %d ms, window %d\n", packets, send_ms, consume_ms, window);
+    rt_kprintf("mode    time(ms)   pkt/s  dropped   retx  adverts  link busy\n");
+    credit_sim_print("none", packets, &none);
+    credit_sim_print("credit", packets, &credit);
+}
+MSH_CMD_EXPORT_ALIAS(credit_sim_cmd, credit_sim, simulate ESP32 overload [packets] [send_ms] [consume_ms] [window]);
+#endif /* APP_USING_TEST */
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __FLOW_CREDIT_H__
+#define __FLOW_CREDIT_H__
+
+#include <rtthread.h>
+#include <stdbool.h>
+
+/* 数据包级的信用流控：接收方（本机）按空闲的数据包缓冲区数量向发送方（ESP32）通告发送上限，
+ * 发送方已发送的数据包数达到上限时暂停，缓冲区满时不再丢包重传。
+ *
+ * 上限是累计值：limit = 已处理的数据包数 + 窗口大小（16位回绕），
+ * 重复或延迟到达的通告不会多给信用。命令格式：
+ *   credit_init:<窗口>   ESP32计数清零，先回复 STATUS credit:<窗口>，这个确认包记为第1个
+ *   credit:<上限>        ESP32可以发送到第<上限>个数据包
+ * 本机处理确认包时按它的接收序号对齐计数，之前在途的数据包不影响之后的计数。
+ * 没有收到确认前不发送credit，按重试间隔重新发送credit_init（兼容不支持的固件）。
+ * 只做决策，不调用系统时钟和发送函数，可以用模拟时钟测试。
+ * received、dropped_pkts和丢包统计在接收中断中修改，其他在处理线程中修改，对齐计数时关中断 */
+
+#define FLOW_CREDIT_RETRY_MS    60000       /* 没有确认时重新发送credit_init的间隔 */
+#define FLOW_CREDIT_REFRESH_MS  2000        /* 通告后没有新数据包时重复一次通告 */
+#define FLOW_CREDIT_RESYNC_MS   5000        /* 帧错误后链路空闲这么久时重新同步计数 */
+
+typedef enum {
+    FLOW_CREDIT_NONE = 0,
+    FLOW_CREDIT_INIT,           /* 发送credit_init:<value> */
+    FLOW_CREDIT_UPDATE,         /* 发送credit:<value> */
+} flow_credit_action_t;
+
+typedef struct {
+    rt_uint32_t packets;        /* 收到的数据包数 */
+    rt_uint32_t adverts;        /* 发送的通告数 */
+    rt_uint32_t stalls;         /* 发送方用完信用的次数 */
+    rt_uint32_t overruns;       /* 超过上限到达的数据包（发送方不遵守或不支持信用） */
+    rt_uint32_t dropped;        /* 没有缓冲区而丢弃的数据包 */
+    rt_uint32_t resyncs;
+    rt_uint32_t peak_in_use;
+} flow_credit_stats_t;
+
+typedef struct {
+    rt_uint16_t window;
+    rt_uint16_t received;
+    rt_uint16_t consumed;       /* 处理完的数据包数 */
+    rt_uint16_t dropped_pkts;   /* 丢弃的数据包数，和consumed一样释放缓冲区 */
+    rt_uint16_t advertised;     /* 上次通告的上限 */
+    rt_uint16_t init_window;    /* credit_init中的窗口 */
+    bool acked;                 /* ESP32已确认支持信用 */
+    bool suspect;               /* 出现过帧错误，计数可能不同步 */
+    bool refreshed;             /* 当前通告已经重复过 */
+    rt_uint32_t last_adv_ms;
+    rt_uint32_t last_rx_ms;
+    rt_uint32_t init_ms;        /* 上次发送credit_init的时间 */
+    bool init_sent;
+    flow_credit_stats_t stats;
+} flow_credit_t;
+
+void flow_credit_init(flow_credit_t *c, rt_uint16_t window);
+rt_uint16_t flow_credit_on_packet(flow_credit_t *c, rt_uint32_t now_ms);
+void flow_credit_on_consumed(flow_credit_t *c);
+void flow_credit_on_drop(flow_credit_t *c);
+void flow_credit_on_error(flow_credit_t *c);
+void flow_credit_on_ack(flow_credit_t *c, rt_uint16_t index);
+rt_uint16_t flow_credit_in_use(const flow_credit_t *c);
+
+/* 返回需要发送的命令和参数，命令发送成功后调用flow_credit_sent */
+flow_credit_action_t flow_credit_poll(flow_credit_t *c, rt_uint32_t now_ms, rt_uint16_t *value);
+void flow_credit_sent(flow_credit_t *c, flow_credit_action_t action, rt_uint16_t value,
+                      rt_uint32_t now_ms);
+
+#ifdef APP_USING_TEST
+/* 发送方（ESP32固件）的逻辑，模拟测试中使用 */
+typedef struct {
+    rt_uint16_t sent;
+    rt_uint16_t limit;
+    bool enabled;
+    bool ack_pending;           /* 收到credit_init，下一个数据包发送确认 */
+} flow_sender_t;
+
+void flow_sender_init(flow_sender_t *s);
+bool flow_sender_can_send(const flow_sender_t *s);
+void flow_sender_on_sent(flow_sender_t *s);
+void flow_sender_on_command(flow_sender_t *s, flow_credit_action_t action, rt_uint16_t value);
+#endif /* APP_USING_TEST */
+
+#endif /* __FLOW_CREDIT_H__ */
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include "input_debounce.h"
+
+#define RING_MASK (INPUT_RING_SIZE - 1)
+
+/* ==================== 事件队列 ==================== */
+
+void input_ring_init(input_ring_t *ring)
+{
+    rt_memset(ring, 0, sizeof(input_ring_t));
+}
+
+/* 在中断中调用，队列满时丢弃新事件 */
+bool input_ring_push(input_ring_t *ring, const input_key_event_t *ev)
+{
+    rt_uint32_t head = ring->head;
+
+    if (head - ring->tail >= INPUT_RING_SIZE)
+    {
+        ring->overflows++;
+        return false;
+    }
+    ring->buf[head & RING_MASK] = *ev;
+    ring->head = head + 1;
+    return true;
+}
+
+bool input_ring_pop(input_ring_t *ring, input_key_event_t *ev)
+{
+    rt_uint32_t tail = ring->tail;
+
+    if (tail == ring->head)
+        return false;
+    *ev = ring->buf[tail & RING_MASK];
+    ring->tail = tail + 1;
+    return true;
+}
+
+bool input_ring_empty(const input_ring_t *ring)
+{
+    return ring->tail == ring->head;
+}
+
+/* ==================== 按键消抖 ==================== */
+
+void key_debounce_init(key_debounce_t *k, rt_uint8_t level, bool active_low)
+{
+    k->stable = level ? 1 : 0;
+    k->active_low = active_low;
+    k->last_ms = 0;
+}
+
+/* 处理一个边沿：电平与消抖后的电平不同且距上次接受的边沿超过消抖时间才接受。
+ * 返回1表示按下，0表示释放，-1表示忽略 */
+int key_debounce_edge(key_debounce_t *k, rt_uint8_t level, rt_uint32_t t_ms)
+{
+    level = level ? 1 : 0;
+
+    if (level == k->stable)
+        return -1;
+    if (k->last_ms != 0 && t_ms - k->last_ms < INPUT_DEBOUNCE_MS)
+        return -1;
+
+    k->stable = level;
+    k->last_ms = t_ms ? t_ms : 1;
+    return key_debounce_is_pressed(k) ? 1 : 0;
+}
+
+bool key_debounce_is_pressed(const key_debounce_t *k)
+{
+    return k->active_low ? (k->stable == 0) : (k->stable != 0);
+}
+
+/* ==================== 正交编码器 ==================== */
+
+/* 状态转换表：下标为(上次AB << 2) | 本次AB，非法跳变（抖动）记为0 */
+static const rt_int8_t quad_table[16] = {
+     0, -1,  1,  0,
+     1,  0,  0, -1,
+    -1,  0,  0,  1,
+     0,  1, -1,  0,
+};
+
+void quad_decoder_init(quad_decoder_t *q, rt_uint8_t a, rt_uint8_t b)
+{
+    q->state = ((a ? 1 : 0) << 1) | (b ? 1 : 0);
+    q->accum = 0;
+}
+
+/* A或B任一边沿时调用，每转过一格返回+1或-1，否则返回0 */
+int quad_decoder_update(quad_decoder_t *q, rt_uint8_t a, rt_uint8_t b)
+{
+    rt_uint8_t state = ((a ? 1 : 0) << 1) | (b ? 1 : 0);
+
+    q->accum += quad_table[(q->state << 2) | state];
+    q->state = state;
+
+    if (q->accum >= QUAD_STEPS_PER_DETENT)
+    {
+        q->accum = 0;
+        return 1;
+    }
+    if (q->accum <= -QUAD_STEPS_PER_DETENT)
+    {
+        q->accum = 0;
+        return -1;
+    }
+    return 0;
+}
+
+#ifdef APP_USING_TEST
+#include <finsh.h>
+
+/* ==================== 边沿序列测试 ==================== */
+
+/* 按键引脚的一个边沿，低电平按下 */
+typedef struct {
+    rt_uint32_t t_ms;
+    rt_uint8_t level;
+} test_edge_t;
+
+/* 按下和释放各抖动几次 */
+static const test_edge_t edges_bounce[] = {
+    {1000, 0}, {1002, 1}, {1004, 0}, {1007, 1}, {1010, 0},
+    {1200, 1}, {1203, 0}, {1206, 1},
+};
+/* 空闲时5ms的干扰：按下被接受，回到高电平的边沿落在消抖时间内被丢弃 */
+static const test_edge_t edges_glitch[] = {
+    {2000, 0}, {2005, 1},
+};
+/* 快速连按，每次按下和释放间隔30ms */
+static const test_edge_t edges_repeat[] = {
+    {3000, 0}, {3030, 1}, {3060, 0}, {3090, 1}, {3120, 0}, {3150, 1},
+};
+
+/* 输入边沿序列，返回接受的边沿数，presses返回其中按下的次数 */
+static int debounce_run(key_debounce_t *k, const test_edge_t *edges, int n, int *presses)
+{
+    int accepted = 0;
+
+    *presses = 0;
+    for (int i = 0; i < n; i++)
+    {
+        int ret = key_debounce_edge(k, edges[i].level, edges[i].t_ms);
+
+        if (ret >= 0)
+            accepted++;
+        if (ret == 1)
+            (*presses)++;
+    }
+    return accepted;
+}
+
+/* 编码器AB电平序列，返回转过的格数之和 */
+static int quad_run(quad_decoder_t *q, const rt_uint8_t (*ab)[2], int n)
+{
+    int steps = 0;
+
+    for (int i = 0; i < n; i++)
+        steps += quad_decoder_update(q, ab[i][0], ab[i][1]);
+    return steps;
+}
+
+#define TEST_COUNT(a) (int)(sizeof(a) / sizeof(a[0]))
+
+/* 用边沿序列检查按键消抖、编码器解码和事件队列 */
+static void input_test_cmd(void)
+{
+    /* 顺时针一格：00 -> 10 -> 11 -> 01 -> 00 */
+    static const rt_uint8_t quad_cw[][2] = {
+        {1, 0}, {1, 1}, {0, 1}, {0, 0}, {1, 0}, {1, 1}, {0, 1}, {0, 0}, {1, 0}, {1, 1}, {0, 1}, {0, 0},
+    };
+    static const rt_uint8_t quad_ccw[][2] = {
+        {0, 1}, {1, 1}, {1, 0}, {0, 0}, {0, 1}, {1, 1}, {1, 0}, {0, 0},
+    };
+    /* 格中间触点抖动，来回跳变不累计 */
+    static const rt_uint8_t quad_chatter[][2] = {
+        {1, 0}, {0, 0}, {1, 0}, {0, 0}, {1, 0}, {1, 1}, {0, 1}, {0, 0},
+    };
+    /* 同时跳变两位是非法的，忽略 */
+    static const rt_uint8_t quad_skip[][2] = {
+        {1, 1}, {0, 0}, {1, 1}, {0, 0},
+    };
+    key_debounce_t k;
+    quad_decoder_t q;
+    input_ring_t ring;
+    input_key_event_t ev;
+    int accepted, presses, steps, passed = 0, total = 0;
+    rt_uint32_t popped;
+    bool pass;
+
+    key_debounce_init(&k, 1, true);
+    accepted = debounce_run(&k, edges_bounce, TEST_COUNT(edges_bounce), &presses);
+    pass = accepted == 2 && presses == 1 && !key_debounce_is_pressed(&k);
+    passed += pass;
+    total++;
+    rt_kprintf("bounce  %d edges accepted, %d presses  %s\n", accepted, presses, pass ? "PASS" : "FAIL");
+
+    /* 读取时核对电平（与input_keys中的做法相同），补上被丢弃的释放 */
+    accepted = debounce_run(&k, edges_glitch, TEST_COUNT(edges_glitch), &presses);
+    pass = accepted == 1 && key_debounce_is_pressed(&k)
+           && key_debounce_edge(&k, 1, 2000 + INPUT_DEBOUNCE_MS) == 0 && !key_debounce_is_pressed(&k);
+    passed += pass;
+    total++;
+    rt_kprintf("glitch  %d edge accepted, released after resync  %s\n", accepted, pass ? "PASS" : "FAIL");
+
+    accepted = debounce_run(&k, edges_repeat, TEST_COUNT(edges_repeat), &presses);
+    pass = accepted == TEST_COUNT(edges_repeat) && presses == 3;
+    passed += pass;
+    total++;
+    rt_kprintf("repeat  %d edges accepted, %d presses  %s\n", accepted, presses, pass ? "PASS" : "FAIL");
+
+    /* 时间戳为0的边沿也要开始消抖时间 */
+    key_debounce_init(&k, 1, true);
+    pass = key_debounce_edge(&k, 0, 0) == 1 && key_debounce_edge(&k, 1, 5) == -1;
+    passed += pass;
+    total++;
+    rt_kprintf("zero    %s\n", pass ? "PASS" : "FAIL");
+
+    quad_decoder_init(&q, 0, 0);
+    steps = quad_run(&q, quad_cw, TEST_COUNT(quad_cw));
+    pass = steps == 3;
+    steps = quad_run(&q, quad_ccw, TEST_COUNT(quad_ccw));
+    pass = pass && steps == -2;
+    steps = quad_run(&q, quad_chatter, TEST_COUNT(quad_chatter));
+    pass = pass && steps == 1;
+    steps = quad_run(&q, quad_skip, TEST_COUNT(quad_skip));
+    pass = pass && steps == 0;
+    passed += pass;
+    total++;
+    rt_kprintf("encoder %s\n", pass ? "PASS" : "FAIL");
+
+    /* 队列满时丢弃新事件并计数，计数器回绕时顺序不变 */
+    input_ring_init(&ring);
+    ring.head = ring.tail = 0xFFFFFFF8u;
+    for (rt_uint32_t i = 0; i <= INPUT_RING_SIZE; i++)
+    {
+        ev.t_ms = i;
+        ev.code = i;
+        ev.value = 1;
+        input_ring_push(&ring, &ev);
+    }
+    pass = ring.overflows == 1;
+    for (popped = 0; input_ring_pop(&ring, &ev); popped++)
+        pass = pass && ev.code == popped;
+    pass = pass && popped == INPUT_RING_SIZE && input_ring_empty(&ring);
+    passed += pass;
+    total++;
+    rt_kprintf("ring    %d popped, %d overflow  %s\n", popped, ring.overflows, pass ? "PASS" : "FAIL");
+
+    rt_kprintf("input_test: %d/%d %s\n", passed, total, passed == total ? "PASS" : "FAIL");
+}
+MSH_CMD_EXPORT_ALIAS(input_test_cmd, input_test, check key debounce encoder decoding and event queue);
+#endif /* APP_USING_TEST */
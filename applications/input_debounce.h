@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __INPUT_DEBOUNCE_H__
+#define __INPUT_DEBOUNCE_H__
+
+#include <rtthread.h>
+#include <stdbool.h>
+
+/* 按键消抖、正交编码器解码和输入事件环形队列，
+ * 在中断中调用，不依赖硬件，可以在主机上用边沿序列测试 */
+
+#define INPUT_DEBOUNCE_MS       20      /* 按键消抖时间 */
+#define INPUT_RING_SIZE         16      /* 事件队列大小（2的幂） */
+#define QUAD_STEPS_PER_DETENT   4       /* 编码器每格的状态变化数 */
+
+/* 输入事件：按键value为1按下/0释放，编码器value为+1/-1 */
+typedef struct {
+    rt_uint32_t t_ms;
+    rt_uint32_t code;
+    rt_int8_t value;
+} input_key_event_t;
+
+/* 单生产者（中断）单消费者（LVGL线程）环形队列 */
+typedef struct {
+    input_key_event_t buf[INPUT_RING_SIZE];
+    volatile rt_uint32_t head;
+    volatile rt_uint32_t tail;
+    rt_uint32_t overflows;
+} input_ring_t;
+
+/* 按键消抖状态 */
+typedef struct {
+    rt_uint8_t stable;              /* 消抖后的电平 */
+    bool active_low;                /* 低电平表示按下 */
+    rt_uint32_t last_ms;            /* 上次接受边沿的时间 */
+} key_debounce_t;
+
+/* 正交编码器解码状态 */
+typedef struct {
+    rt_uint8_t state;               /* 上一次的AB电平 */
+    rt_int8_t accum;                /* 累计的四分之一步 */
+} quad_decoder_t;
+
+void input_ring_init(input_ring_t *ring);
+bool input_ring_push(input_ring_t *ring, const input_key_event_t *ev);
+bool input_ring_pop(input_ring_t *ring, input_key_event_t *ev);
+bool input_ring_empty(const input_ring_t *ring);
+
+void key_debounce_init(key_debounce_t *k, rt_uint8_t level, bool active_low);
+int key_debounce_edge(key_debounce_t *k, rt_uint8_t level, rt_uint32_t t_ms);
+bool key_debounce_is_pressed(const key_debounce_t *k);
+
+void quad_decoder_init(quad_decoder_t *q, rt_uint8_t a, rt_uint8_t b);
+int quad_decoder_update(quad_decoder_t *q, rt_uint8_t a, rt_uint8_t b);
+
+#endif /* __INPUT_DEBOUNCE_H__ */
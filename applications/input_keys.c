@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include "input_keys.h"
+
+#define DBG_TAG "input.keys"
+#define DBG_LVL DBG_INFO
+#include <rtdbg.h>
+
+/* 一个按键引脚 */
+typedef struct {
+    rt_base_t pin;
+    rt_uint32_t code;
+    input_ring_t *ring;
+    key_debounce_t db;
+    volatile bool recheck;          /* 有边沿被消抖丢弃，读取时需要核对电平 */
+} key_pin_t;
+
+static input_ring_t keypad_ring;
+static input_ring_t encoder_ring;
+
+/* 编码器按键和普通按键一样消抖，事件放入编码器队列 */
+static key_pin_t key_pins[] = {
+    { INPUT_KEY_PIN_UP,      INPUT_KEY_UP,         &keypad_ring },
+    { INPUT_KEY_PIN_DOWN,    INPUT_KEY_DOWN,       &keypad_ring },
+    { INPUT_KEY_PIN_ENTER,   INPUT_KEY_ENTER,      &keypad_ring },
+    { INPUT_KEY_PIN_ESC,     INPUT_KEY_ESC,        &keypad_ring },
+    { INPUT_KEY_PIN_NEXT,    INPUT_KEY_NEXT,       &keypad_ring },
+    { INPUT_KEY_PIN_PREV,    INPUT_KEY_PREV,       &keypad_ring },
+    { INPUT_ENCODER_PIN_BTN, INPUT_ENCODER_BUTTON, &encoder_ring },
+};
+#define KEY_PIN_NUM (sizeof(key_pins) / sizeof(key_pins[0]))
+
+static quad_decoder_t encoder_quad;
+static bool keypad_present = false;
+static bool encoder_present = false;
+static input_keys_stats_t keys_stats;
+
+static void push_event(input_ring_t *ring, rt_uint32_t code, rt_int8_t value, rt_uint32_t t_ms)
+{
+    input_key_event_t ev;
+
+    ev.t_ms = t_ms;
+    ev.code = code;
+    ev.value = value;
+    if (!input_ring_push(ring, &ev))
+        keys_stats.overflows++;
+}
+
+/* ==================== 中断处理 ==================== */
+
+/* 按键双边沿中断 */
+static void key_irq_handler(void *args)
+{
+    key_pin_t *k = (key_pin_t *)args;
+    rt_uint32_t t = rt_tick_get_millisecond();
+    int ret;
+
+    keys_stats.key_irqs++;
+    ret = key_debounce_edge(&k->db, rt_pin_read(k->pin), t);
+    if (ret < 0)
+    {
+        k->recheck = true;
+        return;
+    }
+    k->recheck = false;
+    keys_stats.key_events++;
+    push_event(k->ring, k->code, (rt_int8_t)ret, t);
+}
+
+/* 编码器A/B双边沿中断，抖动产生的非法跳变由状态表过滤 */
+static void encoder_irq_handler(void *args)
+{
+    int step;
+
+    keys_stats.encoder_irqs++;
+    step = quad_decoder_update(&encoder_quad, rt_pin_read(INPUT_ENCODER_PIN_A),
+                               rt_pin_read(INPUT_ENCODER_PIN_B));
+    if (step != 0)
+    {
+        keys_stats.encoder_steps++;
+        push_event(&encoder_ring, INPUT_ENCODER_ROTATE, (rt_int8_t)step, rt_tick_get_millisecond());
+    }
+}
+
+/* 抖动结束时的边沿可能落在消抖时间内被丢弃，读取时核对这些按键的电平，
+ * 只检查有边沿被丢弃的按键，空闲时不读引脚 */
+static void keys_resync(input_ring_t *ring)
+{
+    rt_uint32_t t = rt_tick_get_millisecond();
+    rt_base_t level;
+    int ret;
+
+    for (rt_uint32_t i = 0; i < KEY_PIN_NUM; i++)
+    {
+        key_pin_t *k = &key_pins[i];
+
+        if (k->pin < 0 || k->ring != ring || !k->recheck)
+            continue;
+
+        level = rt_hw_interrupt_disable();
+        ret = key_debounce_edge(&k->db, rt_pin_read(k->pin), t);
+        if (ret >= 0)
+        {
+            keys_stats.resyncs++;
+            push_event(k->ring, k->code, (rt_int8_t)ret, t);
+            k->recheck = false;
+        }
+        else if (t - k->db.last_ms >= INPUT_DEBOUNCE_MS)
+        {
+            /* 电平已稳定且与消抖结果一致 */
+            k->recheck = false;
+        }
+        rt_hw_interrupt_enable(level);
+    }
+}
+
+/* ==================== 接口函数 ==================== */
+
+rt_err_t input_keys_init(void)
+{
+    input_ring_init(&keypad_ring);
+    input_ring_init(&encoder_ring);
+
+    for (rt_uint32_t i = 0; i < KEY_PIN_NUM; i++)
+    {
+        key_pin_t *k = &key_pins[i];
+
+        if (k->pin < 0)
+            continue;
+
+        /* 按键接地，低电平表示按下 */
+        rt_pin_mode(k->pin, PIN_MODE_INPUT_PULLUP);
+        key_debounce_init(&k->db, rt_pin_read(k->pin), true);
+        if (rt_pin_attach_irq(k->pin, PIN_IRQ_MODE_RISING_FALLING, key_irq_handler, k) != RT_EOK ||
+            rt_pin_irq_enable(k->pin, PIN_IRQ_ENABLE) != RT_EOK)
+        {
+            LOG_W("Key %d: irq on pin %d unavailable", k->code, k->pin);
+            k->pin = -1;
+            continue;
+        }
+
+        if (k->ring == &keypad_ring)
+            keypad_present = true;
+    }
+
+    if (INPUT_ENCODER_PIN_A >= 0 && INPUT_ENCODER_PIN_B >= 0)
+    {
+        rt_pin_mode(INPUT_ENCODER_PIN_A, PIN_MODE_INPUT_PULLUP);
+        rt_pin_mode(INPUT_ENCODER_PIN_B, PIN_MODE_INPUT_PULLUP);
+        quad_decoder_init(&encoder_quad, rt_pin_read(INPUT_ENCODER_PIN_A), rt_pin_read(INPUT_ENCODER_PIN_B));
+        if (rt_pin_attach_irq(INPUT_ENCODER_PIN_A, PIN_IRQ_MODE_RISING_FALLING, encoder_irq_handler, RT_NULL) == RT_EOK &&
+            rt_pin_attach_irq(INPUT_ENCODER_PIN_B, PIN_IRQ_MODE_RISING_FALLING, encoder_irq_handler, RT_NULL) == RT_EOK &&
+            rt_pin_irq_enable(INPUT_ENCODER_PIN_A, PIN_IRQ_ENABLE) == RT_EOK &&
+            rt_pin_irq_enable(INPUT_ENCODER_PIN_B, PIN_IRQ_ENABLE) == RT_EOK)
+        {
+            encoder_present = true;
+        }
+        else
+        {
+            LOG_W("Encoder irq unavailable");
+        }
+    }
+
+    if (!keypad_present && !encoder_present)
+    {
+        LOG_I("No keys or encoder configured");
+        return -RT_ENOSYS;
+    }
+
+    LOG_I("Input keys started: keypad %s, encoder %s",
+          keypad_present ? "yes" : "no", encoder_present ? "yes" : "no");
+    return RT_EOK;
+}
+
+bool input_keys_has_keypad(void)
+{
+    return keypad_present;
+}
+
+bool input_keys_has_encoder(void)
+{
+    return encoder_present;
+}
+
+bool input_keys_keypad_pop(input_key_event_t *ev)
+{
+    keys_resync(&keypad_ring);
+    return input_ring_pop(&keypad_ring, ev);
+}
+
+bool input_keys_encoder_pop(input_key_event_t *ev)
+{
+    keys_resync(&encoder_ring);
+    return input_ring_pop(&encoder_ring, ev);
+}
+
+bool input_keys_keypad_pending(void)
+{
+    return !input_ring_empty(&keypad_ring);
+}
+
+bool input_keys_encoder_pending(void)
+{
+    return !input_ring_empty(&encoder_ring);
+}
+
+void input_keys_get_stats(input_keys_stats_t *stats)
+{
+    *stats = keys_stats;
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static void keys_stats_cmd(void)
+{
+    input_keys_stats_t stats;
+
+    input_keys_get_stats(&stats);
+    rt_kprintf("keypad: %s, encoder: %s\n",
+               keypad_present ? "yes" : "no", encoder_present ? "yes" : "no");
+    rt_kprintf("key irqs: %d, key events: %d, resyncs: %d\n",
+               stats.key_irqs, stats.key_events, stats.resyncs);
+    rt_kprintf("encoder irqs: %d, steps: %d, overflows: %d\n",
+               stats.encoder_irqs, stats.encoder_steps, stats.overflows);
+}
+MSH_CMD_EXPORT_ALIAS(keys_stats_cmd, keys_stats, show key and encoder statistics);
+#endif /* RT_USING_FINSH */
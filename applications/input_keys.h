@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __INPUT_KEYS_H__
+#define __INPUT_KEYS_H__
+
+#include <rtthread.h>
+#include <stdbool.h>
+#include "input_debounce.h"
+
+/* GPIO按键和正交编码器驱动：双边沿中断，中断中带时间戳消抖后放入环形队列，
+ * 由LVGL的keypad_read/encoder_read取出，空闲时不轮询 */
+
+/* 引脚配置，-1表示未连接 */
+#ifndef INPUT_KEY_PIN_UP
+#define INPUT_KEY_PIN_UP        (-1)
+#endif
+#ifndef INPUT_KEY_PIN_DOWN
+#define INPUT_KEY_PIN_DOWN      (-1)
+#endif
+#ifndef INPUT_KEY_PIN_ENTER
+#define INPUT_KEY_PIN_ENTER     (-1)
+#endif
+#ifndef INPUT_KEY_PIN_ESC
+#define INPUT_KEY_PIN_ESC       (-1)
+#endif
+#ifndef INPUT_KEY_PIN_NEXT
+#define INPUT_KEY_PIN_NEXT      (-1)
+#endif
+#ifndef INPUT_KEY_PIN_PREV
+#define INPUT_KEY_PIN_PREV      (-1)
+#endif
+#ifndef INPUT_ENCODER_PIN_A
+#define INPUT_ENCODER_PIN_A     (-1)
+#endif
+#ifndef INPUT_ENCODER_PIN_B
+#define INPUT_ENCODER_PIN_B     (-1)
+#endif
+#ifndef INPUT_ENCODER_PIN_BTN
+#define INPUT_ENCODER_PIN_BTN   (-1)
+#endif
+
+/* 按键编号，由indev层转换为LVGL键值 */
+typedef enum {
+    INPUT_KEY_NONE = 0,
+    INPUT_KEY_UP,
+    INPUT_KEY_DOWN,
+    INPUT_KEY_ENTER,
+    INPUT_KEY_ESC,
+    INPUT_KEY_NEXT,
+    INPUT_KEY_PREV,
+    INPUT_KEY_NUM
+} input_key_id_t;
+
+/* 编码器事件的code */
+#define INPUT_ENCODER_ROTATE    0       /* value为+1/-1 */
+#define INPUT_ENCODER_BUTTON    1       /* value为1按下/0释放 */
+
+typedef struct {
+    rt_uint32_t key_irqs;           /* 按键中断次数（含抖动） */
+    rt_uint32_t key_events;         /* 消抖后的按键事件 */
+    rt_uint32_t encoder_irqs;
+    rt_uint32_t encoder_steps;
+    rt_uint32_t resyncs;            /* 读取时补发的释放事件 */
+    rt_uint32_t overflows;          /* 队列满丢弃的事件 */
+} input_keys_stats_t;
+
+rt_err_t input_keys_init(void);
+bool input_keys_has_keypad(void);
+bool input_keys_has_encoder(void);
+bool input_keys_keypad_pop(input_key_event_t *ev);
+bool input_keys_encoder_pop(input_key_event_t *ev);
+bool input_keys_keypad_pending(void);
+bool input_keys_encoder_pending(void);
+void input_keys_get_stats(input_keys_stats_t *stats);
+
+#endif /* __INPUT_KEYS_H__ */
@@ -0,0 +1,394 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include <stdlib.h>
+#include "input_replay.h"
+#include "app_perf.h"
+
+#ifdef RT_USING_DFS
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#define DBG_TAG "input.replay"
+#define DBG_LVL DBG_INFO
+#include <rtdbg.h>
+
+/* 录制文件头 */
+typedef struct {
+    rt_uint32_t magic;
+    rt_uint16_t version;
+    rt_uint16_t event_size;
+    rt_uint32_t count;
+} input_replay_header_t;
+
+static input_replay_state_t replay_state = INPUT_REPLAY_IDLE;
+static input_event_t *events = RT_NULL;
+static rt_uint32_t event_capacity;
+static rt_uint32_t event_count;
+static rt_uint32_t record_base_ms;      /* 录制开始时间 */
+static rt_uint32_t record_dropped;
+
+static rt_uint32_t play_start_ms;       /* 回放开始时间 */
+static rt_uint32_t play_base_ms;        /* 录制时间0对应的当前时间 */
+static rt_uint32_t play_cursor[INPUT_DEV_NUM];
+static rt_uint32_t play_clock;          /* 快速回放时的虚拟时钟（相对时间） */
+static bool play_fast;
+static bool play_stepped[INPUT_DEV_NUM]; /* 快速回放：本次读取已推进过时钟 */
+static rt_uint32_t play_last_ms[INPUT_DEV_NUM]; /* 各设备最后交出的事件时间（当前时间基准） */
+
+static void free_events(void)
+{
+    if (events)
+    {
+        rt_free(events);
+        events = RT_NULL;
+    }
+    event_capacity = 0;
+    event_count = 0;
+}
+
+/* ==================== 录制 ==================== */
+
+rt_err_t input_replay_record_start(rt_uint32_t max_events)
+{
+    input_event_t *buf;
+
+    if (replay_state != INPUT_REPLAY_IDLE)
+        return -RT_EBUSY;
+    if (max_events == 0)
+        max_events = INPUT_REPLAY_DEFAULT_EVENTS;
+
+    buf = rt_malloc(max_events * sizeof(input_event_t));
+    if (buf == RT_NULL)
+    {
+        LOG_E("No memory for %d input events", max_events);
+        return -RT_ENOMEM;
+    }
+
+    free_events();
+    events = buf;
+    event_capacity = max_events;
+    record_dropped = 0;
+    record_base_ms = rt_tick_get_millisecond();
+    replay_state = INPUT_REPLAY_RECORDING;
+
+    LOG_I("Input recording started (max %d events)", max_events);
+    return RT_EOK;
+}
+
+/* 停止录制，path不为空时保存到文件，录制数据保留在内存中可直接回放 */
+rt_err_t input_replay_record_stop(const char *path)
+{
+    if (replay_state != INPUT_REPLAY_RECORDING)
+        return -RT_ERROR;
+
+    replay_state = INPUT_REPLAY_IDLE;
+    LOG_I("Input recording stopped: %d events, %d dropped", event_count, record_dropped);
+
+    if (path == RT_NULL)
+        return RT_EOK;
+
+#ifdef RT_USING_DFS
+    {
+        input_replay_header_t header;
+        int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC);
+        if (fd < 0)
+        {
+            LOG_E("Cannot create %s", path);
+            return -RT_EIO;
+        }
+        header.magic = INPUT_REPLAY_MAGIC;
+        header.version = INPUT_REPLAY_VERSION;
+        header.event_size = sizeof(input_event_t);
+        header.count = event_count;
+        if (write(fd, &header, sizeof(header)) != sizeof(header) ||
+            write(fd, events, event_count * sizeof(input_event_t)) != (int)(event_count * sizeof(input_event_t)))
+        {
+            LOG_E("Failed to write %s", path);
+            close(fd);
+            return -RT_EIO;
+        }
+        close(fd);
+        LOG_I("Input recording saved to %s", path);
+        return RT_EOK;
+    }
+#else
+    LOG_W("File system not available, recording kept in memory only");
+    return -RT_ENOSYS;
+#endif
+}
+
+/* 由indev读取回调调用，记录一条输入 */
+void input_replay_record(input_dev_type_t type, rt_uint8_t count,
+                         const rt_int16_t *xs, const rt_int16_t *ys, rt_uint32_t t_ms)
+{
+    input_event_t *ev;
+    int n;
+
+    if (replay_state != INPUT_REPLAY_RECORDING)
+        return;
+
+    if (event_count >= event_capacity)
+    {
+        record_dropped++;
+        return;
+    }
+
+    ev = &events[event_count++];
+    rt_memset(ev, 0, sizeof(input_event_t));
+    ev->t_ms = ((rt_int32_t)(t_ms - record_base_ms) > 0) ? t_ms - record_base_ms : 0;
+    ev->type = type;
+    ev->count = count;
+
+    /* 按键和编码器只有一个值 */
+    n = (type == INPUT_DEV_TOUCH) ? count : 1;
+    if (n > TOUCH_MULTI_MAX_CONTACTS)
+        n = TOUCH_MULTI_MAX_CONTACTS;
+    for (int i = 0; i < n; i++)
+    {
+        ev->x[i] = xs ? xs[i] : 0;
+        ev->y[i] = ys ? ys[i] : 0;
+    }
+}
+
+/* ==================== 回放 ==================== */
+
+#ifdef RT_USING_DFS
+static rt_err_t load_events(const char *path)
+{
+    input_replay_header_t header;
+    input_event_t *buf;
+    int fd;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        LOG_E("Cannot open %s", path);
+        return -RT_EIO;
+    }
+    if (read(fd, &header, sizeof(header)) != sizeof(header) ||
+        header.magic != INPUT_REPLAY_MAGIC || header.version != INPUT_REPLAY_VERSION ||
+        header.event_size != sizeof(input_event_t))
+    {
+        LOG_E("%s is not an input recording", path);
+        close(fd);
+        return -RT_EINVAL;
+    }
+
+    buf = rt_malloc((header.count ? header.count : 1) * sizeof(input_event_t));
+    if (buf == RT_NULL)
+    {
+        close(fd);
+        return -RT_ENOMEM;
+    }
+    if (read(fd, buf, header.count * sizeof(input_event_t)) != (int)(header.count * sizeof(input_event_t)))
+    {
+        LOG_E("%s is truncated", path);
+        rt_free(buf);
+        close(fd);
+        return -RT_EIO;
+    }
+    close(fd);
+
+    free_events();
+    events = buf;
+    event_capacity = header.count;
+    event_count = header.count;
+    return RT_EOK;
+}
+#endif
+
+/* 开始回放，path为空时回放内存中的录制数据；fast为true时不等待原始时间间隔 */
+rt_err_t input_replay_play_start(const char *path, bool fast)
+{
+    if (replay_state != INPUT_REPLAY_IDLE)
+        return -RT_EBUSY;
+
+    if (path != RT_NULL)
+    {
+#ifdef RT_USING_DFS
+        rt_err_t err = load_events(path);
+        if (err != RT_EOK)
+            return err;
+#else
+        return -RT_ENOSYS;
+#endif
+    }
+
+    if (events == RT_NULL || event_count == 0)
+    {
+        LOG_W("Nothing to replay");
+        return -RT_EEMPTY;
+    }
+
+    rt_memset(play_cursor, 0, sizeof(play_cursor));
+    rt_memset(play_stepped, 0, sizeof(play_stepped));
+    play_clock = 0;
+    play_fast = fast;
+    play_start_ms = rt_tick_get_millisecond();
+    play_base_ms = play_start_ms;
+    for (int t = 0; t < INPUT_DEV_NUM; t++)
+        play_last_ms[t] = play_base_ms;
+    app_perf_reset_frame_stats();
+    replay_state = INPUT_REPLAY_PLAYING;
+
+    LOG_I("Replaying %d input events (%s)", event_count, fast ? "fast" : "real time");
+    return RT_EOK;
+}
+
+void input_replay_play_stop(void)
+{
+    app_frame_stats_t stats;
+
+    if (replay_state != INPUT_REPLAY_PLAYING)
+        return;
+
+    replay_state = INPUT_REPLAY_IDLE;
+    app_perf_get_frame_stats(&stats);
+    LOG_I("Replay finished in %d ms: %d frames, avg %d us, max %d us, jitter %d us",
+          rt_tick_get_millisecond() - play_start_ms, stats.frames, stats.avg_us, stats.max_us, stats.jitter_us);
+}
+
+/* 回放期间所有设备的硬件输入都被忽略 */
+bool input_replay_is_playing(input_dev_type_t type)
+{
+    return replay_state == INPUT_REPLAY_PLAYING;
+}
+
+/* 取出该设备下一条到期的事件，t_ms转换为当前时间基准 */
+bool input_replay_next(input_dev_type_t type, input_event_t *event)
+{
+    rt_uint32_t i;
+    rt_uint32_t now_rel;
+    bool finished = true;
+
+    if (replay_state != INPUT_REPLAY_PLAYING || type >= INPUT_DEV_NUM)
+        return false;
+
+    /* 找到该设备的下一条事件 */
+    for (i = play_cursor[type]; i < event_count; i++)
+    {
+        if (events[i].type == type)
+            break;
+    }
+    play_cursor[type] = i;
+
+    if (i < event_count)
+    {
+        if (play_fast)
+        {
+            /* 快速回放：没有到期事件时把虚拟时钟推进到下一条事件，
+             * 每次读取只推进一次，让UI在两条事件之间有机会刷新。
+             * 时间基准在开始时固定，事件之间保持录制时的间隔，手势速度不变 */
+            if (events[i].t_ms > play_clock)
+            {
+                if (play_stepped[type])
+                {
+                    play_stepped[type] = false;
+                    return false;
+                }
+                play_stepped[type] = true;
+                play_clock = events[i].t_ms;
+                *event = events[i];
+                event->t_ms += play_base_ms;
+                play_last_ms[type] = event->t_ms;
+                play_cursor[type] = i + 1;
+                return true;
+            }
+            now_rel = play_clock;
+        }
+        else
+        {
+            now_rel = rt_tick_get_millisecond() - play_base_ms;
+        }
+
+        if (events[i].t_ms <= now_rel)
+        {
+            *event = events[i];
+            event->t_ms += play_base_ms;
+            play_last_ms[type] = event->t_ms;
+            play_cursor[type] = i + 1;
+            return true;
+        }
+        return false;
+    }
+
+    /* 所有设备都回放完毕时结束 */
+    for (int t = 0; t < INPUT_DEV_NUM; t++)
+    {
+        for (i = play_cursor[t]; i < event_count; i++)
+        {
+            if (events[i].type == t)
+            {
+                finished = false;
+                break;
+            }
+        }
+    }
+    if (finished)
+        input_replay_play_stop();
+    return false;
+}
+
+/* 快速回放时事件时间超前于当前时间，回放结束后补发的事件不能早于这个时间 */
+rt_uint32_t input_replay_last_ms(input_dev_type_t type)
+{
+    return (type < INPUT_DEV_NUM) ? play_last_ms[type] : 0;
+}
+
+input_replay_state_t input_replay_get_state(void)
+{
+    return replay_state;
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static void input_rec_cmd(int argc, char **argv)
+{
+    if (argc >= 2 && rt_strcmp(argv[1], "start") == 0)
+    {
+        input_replay_record_start(argc > 2 ? atoi(argv[2]) : 0);
+    }
+    else if (argc >= 2 && rt_strcmp(argv[1], "stop") == 0)
+    {
+        input_replay_record_stop(argc > 2 ? argv[2] : RT_NULL);
+    }
+    else
+    {
+        rt_kprintf("usage: input_rec start [max_events]\n");
+        rt_kprintf("       input_rec stop [file]\n");
+    }
+}
+MSH_CMD_EXPORT_ALIAS(input_rec_cmd, input_rec, record input events);
+
+static void input_replay_cmd(int argc, char **argv)
+{
+    const char *path = RT_NULL;
+    bool fast = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (rt_strcmp(argv[i], "stop") == 0)
+        {
+            input_replay_play_stop();
+            return;
+        }
+        else if (rt_strcmp(argv[i], "fast") == 0)
+            fast = true;
+        else
+            path = argv[i];
+    }
+    input_replay_play_start(path, fast);
+}
+MSH_CMD_EXPORT_ALIAS(input_replay_cmd, input_replay, replay recorded input [file] [fast] | stop);
+#endif /* RT_USING_FINSH */
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __INPUT_REPLAY_H__
+#define __INPUT_REPLAY_H__
+
+#include <rtthread.h>
+#include <stdbool.h>
+#include "touch_multi.h"
+
+/* 输入录制与回放：indev读取回调把带时间戳的输入流录制到内存（可保存为文件），
+ * 回放时用录制的数据代替硬件读取，可按原始节奏或尽快回放，
+ * 用于在不同版本之间比较帧时间和响应延迟 */
+
+#define INPUT_REPLAY_DEFAULT_EVENTS 4096    /* 默认录制缓冲区事件数 */
+#define INPUT_REPLAY_MAGIC          0x52504E49  /* "INPR" */
+#define INPUT_REPLAY_VERSION        1
+
+typedef enum {
+    INPUT_DEV_TOUCH = 0,
+    INPUT_DEV_KEYPAD,
+    INPUT_DEV_ENCODER,
+    INPUT_DEV_NUM
+} input_dev_type_t;
+
+typedef enum {
+    INPUT_REPLAY_IDLE = 0,
+    INPUT_REPLAY_RECORDING,
+    INPUT_REPLAY_PLAYING,
+} input_replay_state_t;
+
+/* 一条输入事件
+ * 触摸：count为触点数，x/y为各触点坐标
+ * 按键：count为按下状态，x[0]为键值
+ * 编码器：count为按下状态，x[0]为旋转增量 */
+typedef struct {
+    rt_uint32_t t_ms;               /* 相对录制开始的时间 */
+    rt_uint8_t type;
+    rt_uint8_t count;
+    rt_int16_t x[TOUCH_MULTI_MAX_CONTACTS];
+    rt_int16_t y[TOUCH_MULTI_MAX_CONTACTS];
+} input_event_t;
+
+rt_err_t input_replay_record_start(rt_uint32_t max_events);
+rt_err_t input_replay_record_stop(const char *path);
+void input_replay_record(input_dev_type_t type, rt_uint8_t count,
+                         const rt_int16_t *xs, const rt_int16_t *ys, rt_uint32_t t_ms);
+
+rt_err_t input_replay_play_start(const char *path, bool fast);
+void input_replay_play_stop(void);
+bool input_replay_is_playing(input_dev_type_t type);
+bool input_replay_next(input_dev_type_t type, input_event_t *event);
+/* 该设备最后回放的事件时间，回放结束后仍然有效 */
+rt_uint32_t input_replay_last_ms(input_dev_type_t type);
+
+input_replay_state_t input_replay_get_state(void);
+
+#endif /* __INPUT_REPLAY_H__ */
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include "link_transport.h"
+
+/* 进程内回环：写入时直接在调用者上下文中交给另一端，
+ * 不依赖硬件，在主机上可以代替ESP32链路驱动整个协议栈 */
+
+static rt_err_t loopback_open(link_transport_t *link)
+{
+    return (link->priv != RT_NULL) ? RT_EOK : -RT_EINVAL;
+}
+
+static void loopback_close(link_transport_t *link)
+{
+}
+
+static rt_size_t loopback_write(link_transport_t *link, const void *data, rt_size_t len)
+{
+    link_transport_t *peer = (link_transport_t *)link->priv;
+
+    /* 另一端没有打开时数据丢失，与断开的物理链路相同 */
+    if (!peer->opened)
+        return 0;
+    link_deliver(peer, (const rt_uint8_t *)data, len);
+    return len;
+}
+
+static const link_ops_t loopback_ops = {
+    loopback_open,
+    loopback_close,
+    loopback_write,
+};
+
+/* 初始化一对回环传输层，不注册（名称可以重复使用），需要时由调用者注册 */
+rt_err_t link_loopback_init_pair(link_transport_t *a, link_transport_t *b,
+                                 const char *name_a, const char *name_b)
+{
+    rt_memset(a, 0, sizeof(link_transport_t));
+    rt_memset(b, 0, sizeof(link_transport_t));
+
+    a->name = name_a;
+    a->ops = &loopback_ops;
+    a->caps = LINK_CAP_ASYNC_TX | LINK_CAP_LOSSLESS;
+    a->priv = b;
+
+    b->name = name_b;
+    b->ops = &loopback_ops;
+    b->caps = a->caps;
+    b->priv = a;
+    return RT_EOK;
+}
@@ -0,0 +1,392 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include "link_mux.h"
+
+enum {
+    RX_IDLE = 0,
+    RX_CH,
+    RX_LEN,
+    RX_DATA,
+    RX_CRC,
+};
+
+/* CRC-8，多项式0x07 */
+static rt_uint8_t crc8_update(rt_uint8_t crc, rt_uint8_t byte)
+{
+    crc ^= byte;
+    for (int i = 0; i < 8; i++)
+        crc = (crc & 0x80) ? (rt_uint8_t)((crc << 1) ^ 0x07) : (rt_uint8_t)(crc << 1);
+    return crc;
+}
+
+static rt_uint8_t frame_crc(rt_uint8_t ch, rt_uint8_t len, const rt_uint8_t *payload)
+{
+    rt_uint8_t crc = crc8_update(crc8_update(0, ch), len);
+
+    for (rt_uint8_t i = 0; i < len; i++)
+        crc = crc8_update(crc, payload[i]);
+    return crc;
+}
+
+void link_mux_init(link_mux_t *mux, link_mux_rx_cb_t cb, void *ctx)
+{
+    rt_memset(mux, 0, sizeof(link_mux_t));
+    mux->rx_cb = cb;
+    mux->rx_ctx = ctx;
+}
+
+rt_err_t link_mux_chan_init(link_mux_t *mux, rt_uint8_t ch, rt_uint8_t prio,
+                            rt_uint8_t *buf, rt_uint32_t size)
+{
+    link_mux_chan_t *c;
+
+    if (ch >= LINK_MUX_CHANNELS || buf == RT_NULL || size == 0 || (size & (size - 1)) != 0)
+        return -RT_EINVAL;
+
+    c = &mux->chan[ch];
+    rt_memset(c, 0, sizeof(link_mux_chan_t));
+    c->buf = buf;
+    c->size = size;
+    c->prio = prio;
+    return RT_EOK;
+}
+
+/* ==================== 发送 ==================== */
+
+static rt_uint32_t chan_used(const link_mux_chan_t *c)
+{
+    return c->head - c->tail;
+}
+
+rt_size_t link_mux_space(const link_mux_t *mux, rt_uint8_t ch)
+{
+    const link_mux_chan_t *c = &mux->chan[ch];
+
+    return c->buf ? c->size - chan_used(c) : 0;
+}
+
+/* 缓冲区不够时只写入能放下的部分 */
+rt_size_t link_mux_write(link_mux_t *mux, rt_uint8_t ch, const void *data, rt_size_t len)
+{
+    const rt_uint8_t *p = (const rt_uint8_t *)data;
+    link_mux_chan_t *c;
+    rt_size_t n;
+
+    if (ch >= LINK_MUX_CHANNELS || mux->chan[ch].buf == RT_NULL)
+        return 0;
+
+    c = &mux->chan[ch];
+    n = link_mux_space(mux, ch);
+    if (n < len)
+        c->stats.tx_full++;
+    else
+        n = len;
+
+    for (rt_size_t i = 0; i < n; i++)
+        c->buf[(c->head + i) & (c->size - 1)] = p[i];
+    c->head += n;
+    c->stats.tx_bytes += n;
+    return n;
+}
+
+rt_size_t link_mux_discard(link_mux_t *mux, rt_uint8_t ch)
+{
+    link_mux_chan_t *c;
+    rt_size_t n;
+
+    if (ch >= LINK_MUX_CHANNELS || mux->chan[ch].buf == RT_NULL)
+        return 0;
+
+    c = &mux->chan[ch];
+    n = c->head - c->tail;
+    c->tail = c->head;
+    return n;
+}
+
+bool link_mux_pending(const link_mux_t *mux)
+{
+    for (int i = 0; i < LINK_MUX_CHANNELS; i++)
+    {
+        if (chan_used(&mux->chan[i]) > 0)
+            return true;
+    }
+    return false;
+}
+
+/* 选择优先级最高的有数据通道；低优先级通道连续让出LINK_MUX_STARVE_FRAMES帧后发送一帧，
+ * 控制消息最多等待一帧，诊断数据不会被批量传输饿死 */
+rt_size_t link_mux_next_frame(link_mux_t *mux, rt_uint8_t *out)
+{
+    link_mux_chan_t *c;
+    int best = -1;
+    rt_uint32_t n;
+
+    for (int i = 0; i < LINK_MUX_CHANNELS; i++)
+    {
+        c = &mux->chan[i];
+        if (chan_used(c) == 0)
+            continue;
+        if (c->skipped >= LINK_MUX_STARVE_FRAMES)
+        {
+            best = i;
+            break;
+        }
+        if (best < 0 || c->prio < mux->chan[best].prio)
+            best = i;
+    }
+    if (best < 0)
+        return 0;
+
+    for (int i = 0; i < LINK_MUX_CHANNELS; i++)
+    {
+        if (i != best && chan_used(&mux->chan[i]) > 0)
+            mux->chan[i].skipped++;
+    }
+
+    c = &mux->chan[best];
+    c->skipped = 0;
+    n = chan_used(c);
+    if (n > LINK_MUX_FRAME_PAYLOAD)
+        n = LINK_MUX_FRAME_PAYLOAD;
+
+    out[0] = LINK_MUX_SOF;
+    out[1] = (rt_uint8_t)best;
+    out[2] = (rt_uint8_t)n;
+    for (rt_uint32_t i = 0; i < n; i++)
+        out[3 + i] = c->buf[(c->tail + i) & (c->size - 1)];
+    c->tail += n;
+    out[3 + n] = frame_crc(out[1], out[2], out + 3);
+    c->stats.tx_frames++;
+    return n + 4;
+}
+
+/* ==================== 接收 ==================== */
+
+void link_mux_input(link_mux_t *mux, const rt_uint8_t *data, rt_size_t len)
+{
+    rt_size_t i = 0;
+
+    while (i < len)
+    {
+        rt_uint8_t byte = data[i];
+
+        switch (mux->rx_state)
+        {
+        case RX_IDLE:
+        {
+            /* 帧外的数据整段交给原始通道 */
+            rt_size_t start = i;
+
+            while (i < len && data[i] != LINK_MUX_SOF)
+                i++;
+            if (i > start)
+            {
+                mux->rx_raw_bytes += i - start;
+                if (mux->rx_cb)
+                    mux->rx_cb(mux->rx_ctx, LINK_MUX_RAW, data + start, i - start);
+            }
+            if (i < len)
+            {
+                mux->rx_state = RX_CH;
+                i++;
+            }
+            continue;
+        }
+        case RX_CH:
+            if (byte >= LINK_MUX_CHANNELS)
+            {
+                /* 不是帧头，这个字节重新按帧外数据处理 */
+                mux->rx_crc_errors++;
+                mux->rx_state = RX_IDLE;
+                continue;
+            }
+            mux->rx_ch = byte;
+            mux->rx_state = RX_LEN;
+            break;
+        case RX_LEN:
+            if (byte == 0 || byte > LINK_MUX_FRAME_PAYLOAD)
+            {
+                mux->rx_crc_errors++;
+                mux->rx_state = RX_IDLE;
+                continue;
+            }
+            mux->rx_len = byte;
+            mux->rx_pos = 0;
+            mux->rx_state = RX_DATA;
+            break;
+        case RX_DATA:
+            mux->rx_buf[mux->rx_pos++] = byte;
+            if (mux->rx_pos == mux->rx_len)
+                mux->rx_state = RX_CRC;
+            break;
+        case RX_CRC:
+            mux->rx_state = RX_IDLE;
+            if (byte != frame_crc(mux->rx_ch, mux->rx_len, mux->rx_buf))
+            {
+                mux->rx_crc_errors++;
+                break;
+            }
+            mux->chan[mux->rx_ch].stats.rx_frames++;
+            mux->chan[mux->rx_ch].stats.rx_bytes += mux->rx_len;
+            if (mux->rx_cb)
+                mux->rx_cb(mux->rx_ctx, mux->rx_ch, mux->rx_buf, mux->rx_len);
+            break;
+        }
+        i++;
+    }
+}
+
+#ifdef APP_USING_TEST
+#include <finsh.h>
+#include <stdlib.h>
+
+/* ==================== 延迟测试 ==================== */
+
+#define SIM_BULK_PACKET     1000        /* 批量数据按数据包写入 */
+#define SIM_CTRL_LEN        48          /* 一条控制消息（RESULT数据包）的长度 */
+#define SIM_BUF_SIZE        4096
+#define SIM_LIMIT_US        600000000   /* 模拟时间上限 */
+
+static rt_uint8_t sim_buf[LINK_MUX_CHANNELS][SIM_BUF_SIZE];
+static rt_uint32_t sim_rx_bytes[LINK_MUX_CHANNELS];
+static rt_uint32_t sim_rx_errors;
+
+static rt_uint8_t sim_byte(rt_uint8_t ch, rt_uint32_t i)
+{
+    return (rt_uint8_t)(ch * 101 + i * 7 + (i >> 8)) & 0x7F;
+}
+
+static void sim_rx_cb(void *ctx, rt_uint8_t ch, const rt_uint8_t *data, rt_size_t len)
+{
+    if (ch >= LINK_MUX_CHANNELS)
+    {
+        sim_rx_errors += len;
+        return;
+    }
+    for (rt_size_t i = 0; i < len; i++)
+    {
+        if (data[i] != sim_byte(ch, sim_rx_bytes[ch] + i))
+            sim_rx_errors++;
+    }
+    sim_rx_bytes[ch] += len;
+}
+
+/* ESP32一侧在t=0写入bulk字节的任务数据，传输期间每period_ms产生一条控制消息和一段诊断数据，
+ * 链路按baud传输（每字节10位）。不分通道时数据按写入顺序排队，控制消息排在之前写入的全部数据后面；
+ * 分通道时按帧调度，接收端经过link_mux_input校验每个通道的数据 */
+static void mux_sim_cmd(int argc, char **argv)
+{
+    static link_mux_t tx, rx;
+    static rt_uint8_t frame[LINK_MUX_FRAME_MAX];
+    static rt_uint8_t chunk[SIM_BULK_PACKET];
+    static rt_uint32_t ctrl_t[64];
+    rt_uint32_t bulk = argc > 1 ? atoi(argv[1]) : 32768;
+    rt_uint32_t baud = argc > 2 ? atoi(argv[2]) : 115200;
+    rt_uint32_t period_ms = argc > 3 ? atoi(argv[3]) : 200;
+    rt_uint32_t byte_us, t, end, fifo_bulk_end, bulk_done = 0, overhead = 0;
+    rt_uint32_t fifo_n = 0, fifo_sum = 0, fifo_max = 0;
+    rt_uint32_t ctrl_n = 0, ctrl_done = 0, lat_sum = 0, lat_max = 0, next_ctrl = 0;
+    rt_uint32_t written[LINK_MUX_CHANNELS] = {0};
+
+    if (bulk == 0) bulk = 32768;
+    if (baud == 0) baud = 115200;
+    if (period_ms == 0) period_ms = 200;
+    byte_us = 10000000 / baud;
+    if (byte_us == 0) byte_us = 1;
+
+    /* 不分通道 */
+    fifo_bulk_end = end = bulk * byte_us;
+    for (t = 0; t < fifo_bulk_end; t += period_ms * 1000)
+    {
+        rt_uint32_t lat;
+
+        if (end < t)
+            end = t;
+        end += SIM_CTRL_LEN * byte_us;
+        lat = end - t;
+        end += SIM_CTRL_LEN * byte_us;      /* 诊断数据 */
+        fifo_sum += lat;
+        if (lat > fifo_max) fifo_max = lat;
+        fifo_n++;
+    }
+
+    /* 分通道 */
+    link_mux_init(&tx, RT_NULL, RT_NULL);
+    link_mux_init(&rx, sim_rx_cb, RT_NULL);
+    link_mux_chan_init(&tx, LINK_MUX_CH_CONTROL, 0, sim_buf[0], SIM_BUF_SIZE);
+    link_mux_chan_init(&tx, LINK_MUX_CH_BULK, 1, sim_buf[1], SIM_BUF_SIZE);
+    link_mux_chan_init(&tx, LINK_MUX_CH_DIAG, 2, sim_buf[2], SIM_BUF_SIZE);
+    rt_memset(sim_rx_bytes, 0, sizeof(sim_rx_bytes));
+    sim_rx_errors = 0;
+
+    t = 0;
+    while (t < SIM_LIMIT_US && (bulk_done == 0 || ctrl_done < ctrl_n))
+    {
+        rt_size_t len;
+
+        /* 任务数据按数据包尽快写入 */
+        while (written[1] < bulk && link_mux_space(&tx, LINK_MUX_CH_BULK) >= SIM_BULK_PACKET)
+        {
+            rt_uint32_t n = (bulk - written[1] < SIM_BULK_PACKET) ? bulk - written[1] : SIM_BULK_PACKET;
+
+            for (rt_uint32_t i = 0; i < n; i++)
+                chunk[i] = sim_byte(LINK_MUX_CH_BULK, written[1] + i);
+            written[1] += link_mux_write(&tx, LINK_MUX_CH_BULK, chunk, n);
+        }
+
+        /* 和不分通道时相同的时刻产生控制消息和诊断数据 */
+        while (next_ctrl < fifo_bulk_end && next_ctrl <= t)
+        {
+            for (int ch = LINK_MUX_CH_CONTROL; ch <= LINK_MUX_CH_DIAG; ch += 2)
+            {
+                for (rt_uint32_t i = 0; i < SIM_CTRL_LEN; i++)
+                    chunk[i] = sim_byte(ch, written[ch] + i);
+                written[ch] += link_mux_write(&tx, ch, chunk, SIM_CTRL_LEN);
+            }
+            ctrl_t[ctrl_n++ & 63] = next_ctrl;
+            next_ctrl += period_ms * 1000;
+        }
+
+        len = link_mux_next_frame(&tx, frame);
+        if (len == 0)
+        {
+            t = next_ctrl;
+            continue;
+        }
+        t += len * byte_us;
+        overhead += 4;
+        link_mux_input(&rx, frame, len);
+
+        if (bulk_done == 0 && sim_rx_bytes[1] >= bulk)
+            bulk_done = t;
+        while (ctrl_done < sim_rx_bytes[0] / SIM_CTRL_LEN)
+        {
+            rt_uint32_t lat = t - ctrl_t[ctrl_done++ & 63];
+
+            lat_sum += lat;
+            if (lat > lat_max) lat_max = lat;
+        }
+    }
+
+    rt_kprintf("%d bytes bulk at %d baud, control message every %d ms\n", bulk, baud, period_ms);
+    rt_kprintf("mode  bulk(ms)  ctrl msgs  ctrl avg(ms)  ctrl max(ms)\n");
+    rt_kprintf("fifo  %8d  %9d  %12d  %12d\n", fifo_bulk_end / 1000, fifo_n,
+               fifo_n ? fifo_sum / fifo_n / 1000 : 0, fifo_max / 1000);
+    rt_kprintf("mux   %8d  %9d  %12d  %12d\n", bulk_done / 1000, ctrl_done,
+               ctrl_done ? lat_sum / ctrl_done / 1000 : 0, lat_max / 1000);
+    rt_kprintf("framing overhead %d bytes, crc errors %d, data errors %d: %s\n", overhead,
+               rx.rx_crc_errors, sim_rx_errors,
+               (sim_rx_errors == 0 && rx.rx_crc_errors == 0 && sim_rx_bytes[1] == bulk &&
+                sim_rx_bytes[0] == written[0] && sim_rx_bytes[2] == written[2]) ? "PASS" : "FAIL");
+}
+MSH_CMD_EXPORT_ALIAS(mux_sim_cmd, mux_sim, measure control latency during bulk transfer [bytes] [baud] [period_ms]);
+#endif /* APP_USING_TEST */
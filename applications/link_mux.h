@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __LINK_MUX_H__
+#define __LINK_MUX_H__
+
+#include <rtthread.h>
+#include <stdbool.h>
+
+/* 在一条ESP32链路上复用多个逻辑通道：每个通道有自己的发送缓冲区和优先级，
+ * 发送时按帧交错，每帧最多LINK_MUX_FRAME_PAYLOAD字节，
+ * 大批量的任务数据不会挡住控制消息。
+ *
+ * 帧格式：SOF(0x1B) | 通道 | 长度 | 负载 | CRC8(通道、长度、负载)
+ * 文本协议中不会出现0x1B，帧外的字节按原始数据交给LINK_MUX_RAW（兼容不分通道的固件）。
+ * 收发两端使用同一套逻辑，不加锁，不依赖硬件，可以在主机上测试 */
+
+#define LINK_MUX_CHANNELS       3
+#define LINK_MUX_FRAME_PAYLOAD  64
+#define LINK_MUX_FRAME_MAX      (LINK_MUX_FRAME_PAYLOAD + 4)
+#define LINK_MUX_SOF            0x1B
+#define LINK_MUX_RAW            0xFF    /* 帧外的原始数据 */
+#define LINK_MUX_STARVE_FRAMES  8       /* 低优先级通道最多连续让出的帧数 */
+
+/* 通道分配 */
+#define LINK_MUX_CH_CONTROL     0       /* 命令和结果、流控 */
+#define LINK_MUX_CH_BULK        1       /* 任务列表和推送 */
+#define LINK_MUX_CH_DIAG        2       /* 状态、帮助、测试和遥测 */
+
+typedef void (*link_mux_rx_cb_t)(void *ctx, rt_uint8_t ch, const rt_uint8_t *data, rt_size_t len);
+
+typedef struct {
+    rt_uint32_t tx_bytes;
+    rt_uint32_t tx_frames;
+    rt_uint32_t tx_full;        /* 写入时缓冲区满 */
+    rt_uint32_t rx_bytes;
+    rt_uint32_t rx_frames;
+} link_mux_chan_stats_t;
+
+typedef struct {
+    rt_uint8_t *buf;            /* 发送环形缓冲区，大小为2的幂 */
+    rt_uint32_t size;
+    rt_uint32_t head;
+    rt_uint32_t tail;
+    rt_uint8_t prio;            /* 数值越小越优先 */
+    rt_uint8_t skipped;         /* 有数据但被更高优先级通道抢先的帧数 */
+    link_mux_chan_stats_t stats;
+} link_mux_chan_t;
+
+typedef struct {
+    link_mux_chan_t chan[LINK_MUX_CHANNELS];
+
+    /* 接收解析状态 */
+    rt_uint8_t rx_state;
+    rt_uint8_t rx_ch;
+    rt_uint8_t rx_len;
+    rt_uint8_t rx_pos;
+    rt_uint8_t rx_buf[LINK_MUX_FRAME_PAYLOAD];
+    link_mux_rx_cb_t rx_cb;
+    void *rx_ctx;
+
+    rt_uint32_t rx_crc_errors;
+    rt_uint32_t rx_raw_bytes;
+} link_mux_t;
+
+void link_mux_init(link_mux_t *mux, link_mux_rx_cb_t cb, void *ctx);
+rt_err_t link_mux_chan_init(link_mux_t *mux, rt_uint8_t ch, rt_uint8_t prio,
+                            rt_uint8_t *buf, rt_uint32_t size);
+
+/* 写入通道的发送缓冲区，返回写入的字节数 */
+rt_size_t link_mux_write(link_mux_t *mux, rt_uint8_t ch, const void *data, rt_size_t len);
+rt_size_t link_mux_space(const link_mux_t *mux, rt_uint8_t ch);
+/* 丢弃通道中还没发出的数据（发送失败后避免半条消息接到下一条前面），返回丢弃的字节数 */
+rt_size_t link_mux_discard(link_mux_t *mux, rt_uint8_t ch);
+bool link_mux_pending(const link_mux_t *mux);
+/* 按优先级取出下一帧写入out（至少LINK_MUX_FRAME_MAX字节），返回帧长度，没有数据时返回0 */
+rt_size_t link_mux_next_frame(link_mux_t *mux, rt_uint8_t *out);
+
+/* 解析收到的字节，按通道回调 */
+void link_mux_input(link_mux_t *mux, const rt_uint8_t *data, rt_size_t len);
+
+#endif /* __LINK_MUX_H__ */
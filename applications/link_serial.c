@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include "link_transport.h"
+
+#define DBG_TAG "link.serial"
+#define DBG_LVL DBG_INFO
+#include <rtdbg.h>
+
+#define SERIAL_LINK_MAX     2       /* 同时打开的串口传输层数 */
+#define SERIAL_READ_CHUNK   64      /* 接收回调中每次读取的字节数 */
+
+/* 接收回调没有上下文参数，按设备查找对应的传输层 */
+static link_transport_t *serial_links[SERIAL_LINK_MAX];
+
+static link_transport_t *serial_lookup(rt_device_t dev)
+{
+    for (int i = 0; i < SERIAL_LINK_MAX; i++)
+    {
+        if (serial_links[i] && ((link_serial_t *)serial_links[i]->priv)->dev == dev)
+            return serial_links[i];
+    }
+    return RT_NULL;
+}
+
+/* 串口接收中断中调用，读出全部数据交给上层 */
+static rt_err_t serial_rx_indicate(rt_device_t dev, rt_size_t size)
+{
+    link_transport_t *link = serial_lookup(dev);
+    rt_uint8_t buf[SERIAL_READ_CHUNK];
+    rt_size_t n;
+
+    if (link == RT_NULL)
+        return -RT_ERROR;
+
+    while ((n = rt_device_read(dev, -1, buf, sizeof(buf))) > 0)
+    {
+        link_deliver(link, buf, n);
+    }
+    return RT_EOK;
+}
+
+static rt_err_t serial_open(link_transport_t *link)
+{
+    link_serial_t *serial = (link_serial_t *)link->priv;
+    int slot;
+
+    for (slot = 0; slot < SERIAL_LINK_MAX && serial_links[slot] != RT_NULL; slot++);
+    if (slot == SERIAL_LINK_MAX)
+        return -RT_EFULL;
+
+    serial->dev = rt_device_find(serial->dev_name);
+    if (serial->dev == RT_NULL)
+    {
+        LOG_E("Cannot find device: %s", serial->dev_name);
+        return -RT_ENOSYS;
+    }
+
+    /* USB CDC没有波特率，不修改配置 */
+    if (serial->baud)
+    {
+        struct serial_configure config = RT_SERIAL_CONFIG_DEFAULT;
+        config.baud_rate = serial->baud;
+        config.data_bits = DATA_BITS_8;
+        config.stop_bits = STOP_BITS_1;
+        config.parity = PARITY_NONE;
+#ifdef RT_SERIAL_FLOWCONTROL_CTSRTS
+        config.flowcontrol = serial->hw_flow ? RT_SERIAL_FLOWCONTROL_CTSRTS : RT_SERIAL_FLOWCONTROL_NONE;
+        if (serial->hw_flow)
+            link->caps |= LINK_CAP_HW_FLOW;
+#else
+        if (serial->hw_flow)
+            LOG_W("RTS/CTS not supported by serial driver, %s without flow control", serial->dev_name);
+#endif
+        rt_device_control(serial->dev, RT_DEVICE_CTRL_CONFIG, &config);
+    }
+
+    if (rt_device_open(serial->dev, RT_DEVICE_FLAG_RDWR | RT_DEVICE_FLAG_INT_RX) != RT_EOK)
+    {
+        LOG_E("Failed to open device: %s", serial->dev_name);
+        return -RT_EIO;
+    }
+
+    serial_links[slot] = link;
+    rt_device_set_rx_indicate(serial->dev, serial_rx_indicate);
+    return RT_EOK;
+}
+
+static void serial_close(link_transport_t *link)
+{
+    link_serial_t *serial = (link_serial_t *)link->priv;
+
+    rt_device_set_rx_indicate(serial->dev, RT_NULL);
+    rt_device_close(serial->dev);
+    for (int i = 0; i < SERIAL_LINK_MAX; i++)
+    {
+        if (serial_links[i] == link)
+            serial_links[i] = RT_NULL;
+    }
+}
+
+/* 轮询发送，写完才返回 */
+static rt_size_t serial_write(link_transport_t *link, const void *data, rt_size_t len)
+{
+    return rt_device_write(((link_serial_t *)link->priv)->dev, 0, data, len);
+}
+
+static const link_ops_t serial_ops = {
+    serial_open,
+    serial_close,
+    serial_write,
+};
+
+static void serial_setup(link_transport_t *link, link_serial_t *serial, const char *name,
+                         const char *dev_name, rt_uint32_t baud)
+{
+    rt_memset(link, 0, sizeof(link_transport_t));
+    rt_memset(serial, 0, sizeof(link_serial_t));
+    serial->dev_name = dev_name;
+    serial->baud = baud;
+    link->name = name;
+    link->ops = &serial_ops;
+    link->priv = serial;
+}
+
+/* 初始化并注册串口传输层 */
+rt_err_t link_serial_init(link_transport_t *link, link_serial_t *serial, const char *name,
+                          const char *dev_name, rt_uint32_t baud)
+{
+    serial_setup(link, serial, name, dev_name, baud);
+    link->bitrate = baud;
+    return link_register(link);
+}
+
+/* 打开前设置，接收数据来不及读取时由硬件拉高RTS，ESP32暂停发送 */
+void link_serial_set_hw_flow(link_transport_t *link, bool enable)
+{
+    ((link_serial_t *)link->priv)->hw_flow = enable;
+}
+
+/* USB CDC虚拟串口：没有波特率，速率由USB决定 */
+rt_err_t link_cdc_init(link_transport_t *link, link_serial_t *serial, const char *name,
+                       const char *dev_name)
+{
+    serial_setup(link, serial, name, dev_name, 0);
+    link->caps = LINK_CAP_HW_FLOW;      /* USB本身有流控 */
+    return link_register(link);
+}
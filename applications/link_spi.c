@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include "link_transport.h"
+
+#ifdef RT_USING_SPI
+
+#define DBG_TAG "link.spi"
+#define DBG_LVL DBG_INFO
+#include <rtdbg.h>
+
+#define SPI_LINK_THREAD_STACK       1024
+#define SPI_LINK_THREAD_PRIO        (PKG_LVGL_THREAD_PRIO + 1)
+#define SPI_LINK_WRITE_TIMEOUT_MS   500     /* 写入时等待发送缓冲区的最长时间 */
+
+/* 传输线程：rt_spi_transfer使用DMA并阻塞到传输完成，期间写入者填充另一个发送缓冲区 */
+static struct rt_thread spi_thread;
+static rt_uint8_t spi_thread_stack[SPI_LINK_THREAD_STACK];
+static struct rt_mutex spi_lock;            /* 保护spi_frame_t */
+static struct rt_semaphore spi_wake;        /* 握手上升沿或有数据要发送 */
+static struct rt_semaphore spi_space;       /* 发送缓冲区有空间 */
+static struct rt_semaphore spi_exit;
+static link_transport_t *spi_link = RT_NULL;
+static volatile bool spi_running = false;
+
+/* 握手引脚上升沿：从机已准备好下一帧 */
+static void spi_hs_irq(void *args)
+{
+    link_spi_t *spi = (link_spi_t *)args;
+
+    spi->hs_armed = true;
+    rt_sem_release(&spi_wake);
+}
+
+static void spi_thread_entry(void *param)
+{
+    link_transport_t *link = (link_transport_t *)param;
+    link_spi_t *spi = (link_spi_t *)link->priv;
+    const rt_uint8_t *tx, *payload;
+    rt_size_t len;
+
+    while (spi_running)
+    {
+        rt_mutex_take(&spi_lock, RT_WAITING_FOREVER);
+        tx = spi_frame_next(&spi->frame, spi->hs_armed, rt_tick_get_millisecond());
+        rt_mutex_release(&spi_lock);
+
+        if (tx == RT_NULL)
+        {
+            /* 等待握手信号、新数据或下一次查询，漏掉上升沿时按电平恢复 */
+            if (rt_sem_take(&spi_wake, rt_tick_from_millisecond(SPI_FRAME_POLL_MS)) != RT_EOK &&
+                rt_pin_read(spi->hs_pin) == PIN_HIGH)
+                spi->hs_armed = true;
+            continue;
+        }
+
+        /* 从机在传输结束后拉低握手信号，重新准备好后再拉高 */
+        spi->hs_armed = false;
+        if (rt_spi_transfer(spi->dev, tx, spi->rx, SPI_FRAME_SIZE) != SPI_FRAME_SIZE)
+        {
+            rt_mutex_take(&spi_lock, RT_WAITING_FOREVER);
+            spi_frame_retry(&spi->frame);
+            rt_mutex_release(&spi_lock);
+            link->stats.rx_errors++;
+            continue;
+        }
+
+        rt_mutex_take(&spi_lock, RT_WAITING_FOREVER);
+        len = spi_frame_done(&spi->frame, spi->rx, rt_tick_get_millisecond(), &payload);
+        rt_mutex_release(&spi_lock);
+        rt_sem_release(&spi_space);
+
+        /* 负载直接交给数据包解析，rx只在本线程中使用 */
+        if (len)
+            link_deliver(link, payload, len);
+    }
+    rt_sem_release(&spi_exit);
+}
+
+static rt_err_t spi_open(link_transport_t *link)
+{
+    link_spi_t *spi = (link_spi_t *)link->priv;
+    struct rt_spi_configuration cfg;
+    rt_err_t err;
+
+    if (spi_link != RT_NULL)
+        return -RT_EBUSY;
+
+    spi->dev = (struct rt_spi_device *)rt_device_find(spi->dev_name);
+    if (spi->dev == RT_NULL)
+    {
+        LOG_E("Cannot find SPI device: %s", spi->dev_name);
+        return -RT_ENOSYS;
+    }
+
+    cfg.data_width = 8;
+    cfg.mode = RT_SPI_MASTER | RT_SPI_MODE_0 | RT_SPI_MSB;
+    cfg.max_hz = spi->max_hz;
+    err = rt_spi_configure(spi->dev, &cfg);
+    if (err != RT_EOK)
+    {
+        LOG_E("Failed to configure %s", spi->dev_name);
+        return err;
+    }
+
+    spi_frame_init(&spi->frame, SPI_FRAME_POLL_MS);
+    rt_mutex_init(&spi_lock, "esp_spi", RT_IPC_FLAG_PRIO);
+    rt_sem_init(&spi_wake, "spi_wk", 0, RT_IPC_FLAG_FIFO);
+    rt_sem_init(&spi_space, "spi_sp", 0, RT_IPC_FLAG_FIFO);
+    rt_sem_init(&spi_exit, "spi_ex", 0, RT_IPC_FLAG_FIFO);
+
+    rt_pin_mode(spi->hs_pin, PIN_MODE_INPUT_PULLDOWN);
+    rt_pin_attach_irq(spi->hs_pin, PIN_IRQ_MODE_RISING, spi_hs_irq, spi);
+    rt_pin_irq_enable(spi->hs_pin, PIN_IRQ_ENABLE);
+    spi->hs_armed = (rt_pin_read(spi->hs_pin) == PIN_HIGH);
+
+    spi_link = link;
+    spi_running = true;
+    err = rt_thread_init(&spi_thread, "esp_spi",
+                         spi_thread_entry,
+                         link,
+                         &spi_thread_stack[0],
+                         sizeof(spi_thread_stack),
+                         SPI_LINK_THREAD_PRIO,
+                         10);
+    if (err != RT_EOK)
+    {
+        LOG_E("Failed to create SPI link thread");
+        rt_pin_irq_enable(spi->hs_pin, PIN_IRQ_DISABLE);
+        spi_running = false;
+        spi_link = RT_NULL;
+        return err;
+    }
+    rt_thread_startup(&spi_thread);
+    return RT_EOK;
+}
+
+static void spi_close(link_transport_t *link)
+{
+    link_spi_t *spi = (link_spi_t *)link->priv;
+
+    rt_pin_irq_enable(spi->hs_pin, PIN_IRQ_DISABLE);
+    rt_pin_detach_irq(spi->hs_pin);
+    spi_running = false;
+    rt_sem_release(&spi_wake);
+    rt_sem_take(&spi_exit, RT_WAITING_FOREVER);
+
+    rt_mutex_detach(&spi_lock);
+    rt_sem_detach(&spi_wake);
+    rt_sem_detach(&spi_space);
+    rt_sem_detach(&spi_exit);
+    spi_link = RT_NULL;
+}
+
+/* 数据写入帧缓冲区后立即返回，两个缓冲区都满时等待传输线程发出一帧 */
+static rt_size_t spi_write(link_transport_t *link, const void *data, rt_size_t len)
+{
+    link_spi_t *spi = (link_spi_t *)link->priv;
+    const rt_uint8_t *p = (const rt_uint8_t *)data;
+    rt_size_t written = 0;
+
+    while (written < len)
+    {
+        rt_mutex_take(&spi_lock, RT_WAITING_FOREVER);
+        written += spi_frame_write(&spi->frame, p + written, len - written);
+        rt_mutex_release(&spi_lock);
+        rt_sem_release(&spi_wake);
+
+        if (written < len &&
+            rt_sem_take(&spi_space, rt_tick_from_millisecond(SPI_LINK_WRITE_TIMEOUT_MS)) != RT_EOK)
+            break;
+    }
+    return written;
+}
+
+static const link_ops_t spi_ops = {
+    spi_open,
+    spi_close,
+    spi_write,
+};
+
+/* 初始化并注册SPI传输层，hs_pin为ESP32的握手引脚 */
+rt_err_t link_spi_init(link_transport_t *link, link_spi_t *spi, const char *name,
+                       const char *dev_name, rt_base_t hs_pin, rt_uint32_t max_hz)
+{
+    rt_memset(link, 0, sizeof(link_transport_t));
+    rt_memset(spi, 0, sizeof(link_spi_t));
+    spi->dev_name = dev_name;
+    spi->hs_pin = hs_pin;
+    spi->max_hz = max_hz;
+    link->name = name;
+    link->ops = &spi_ops;
+    link->caps = LINK_CAP_ASYNC_TX | LINK_CAP_HW_FLOW | LINK_CAP_DMA;
+    link->bitrate = max_hz;
+    link->priv = spi;
+    return link_register(link);
+}
+
+#endif /* RT_USING_SPI */
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include <stdlib.h>
+#include "link_transport.h"
+
+#define DBG_TAG "link"
+#define DBG_LVL DBG_INFO
+#include <rtdbg.h>
+
+static link_transport_t *link_list = RT_NULL;
+
+/* ==================== 注册 ==================== */
+
+rt_err_t link_register(link_transport_t *link)
+{
+    rt_base_t level;
+    rt_uint32_t n = 0;
+
+    if (link == RT_NULL || link->ops == RT_NULL || link_find(link->name) != RT_NULL)
+        return -RT_EINVAL;
+
+    for (link_transport_t *l = link_list; l != RT_NULL; l = l->next)
+        n++;
+    if (n >= LINK_NAME_MAX)
+        return -RT_EFULL;
+
+    level = rt_hw_interrupt_disable();
+    link->next = link_list;
+    link_list = link;
+    rt_hw_interrupt_enable(level);
+    return RT_EOK;
+}
+
+link_transport_t *link_find(const char *name)
+{
+    for (link_transport_t *l = link_list; l != RT_NULL; l = l->next)
+    {
+        if (rt_strcmp(l->name, name) == 0)
+            return l;
+    }
+    return RT_NULL;
+}
+
+link_transport_t *link_first(void)
+{
+    return link_list;
+}
+
+/* ==================== 通用操作 ==================== */
+
+void link_set_rx_callback(link_transport_t *link, link_rx_cb_t cb, void *ctx)
+{
+    rt_base_t level = rt_hw_interrupt_disable();
+
+    link->rx_cb = cb;
+    link->rx_ctx = ctx;
+    rt_hw_interrupt_enable(level);
+}
+
+rt_err_t link_open(link_transport_t *link)
+{
+    rt_err_t err;
+
+    if (link->opened)
+        return RT_EOK;
+    err = link->ops->open(link);
+    if (err == RT_EOK)
+    {
+        link->opened = true;
+        LOG_I("Link %s opened (caps 0x%02x, %d bit/s)", link->name, link->caps, link->bitrate);
+    }
+    else
+    {
+        LOG_E("Failed to open link %s (%d)", link->name, err);
+    }
+    return err;
+}
+
+void link_close(link_transport_t *link)
+{
+    if (!link->opened)
+        return;
+    if (link->ops->close)
+        link->ops->close(link);
+    link->opened = false;
+}
+
+rt_size_t link_write(link_transport_t *link, const void *data, rt_size_t len)
+{
+    rt_size_t written;
+
+    if (link == RT_NULL || !link->opened)
+        return 0;
+
+    written = link->ops->write(link, data, len);
+    link->stats.tx_calls++;
+    link->stats.tx_bytes += written;
+    if (written != len)
+        link->stats.tx_errors++;
+    return written;
+}
+
+void link_deliver(link_transport_t *link, const rt_uint8_t *data, rt_size_t len)
+{
+    link->stats.rx_calls++;
+    link->stats.rx_bytes += len;
+    if (link->rx_cb)
+        link->rx_cb(link->rx_ctx, data, len);
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+#include "app_perf.h"
+
+static void link_list_cmd(int argc, char **argv)
+{
+    for (link_transport_t *l = link_list; l != RT_NULL; l = l->next)
+    {
+        rt_kprintf("%-8s %s caps 0x%02x %8d bit/s  tx %d B/%d err  rx %d B/%d calls\n",
+                   l->name, l->opened ? "open  " : "closed", l->caps, l->bitrate,
+                   l->stats.tx_bytes, l->stats.tx_errors, l->stats.rx_bytes, l->stats.rx_calls);
+    }
+}
+MSH_CMD_EXPORT_ALIAS(link_list_cmd, link_list, list ESP32 link transports);
+
+#ifdef APP_USING_TEST
+static rt_uint32_t bench_rx_bytes;
+
+static void bench_rx_cb(void *ctx, const rt_uint8_t *data, rt_size_t len)
+{
+    bench_rx_bytes += len;
+}
+
+/* 对指定的传输层写入bytes字节（每次chunk字节），统计写入耗时和吞吐量。
+ * loop时建立一对临时的回环传输层，同时统计另一端收到的字节数；
+ * 对真实链路测试时只统计发送，ESP32会把测试数据当作未知命令 */
+static void link_bench_cmd(int argc, char **argv)
+{
+    static link_transport_t loop_a, loop_b;
+    static rt_uint8_t chunk_buf[256];
+    const char *name = argc > 1 ? argv[1] : "loop";
+    rt_uint32_t bytes = argc > 2 ? atoi(argv[2]) : 65536;
+    rt_uint32_t chunk = argc > 3 ? atoi(argv[3]) : 64;
+    rt_uint32_t sent = 0, t0, us, max_us = 0;
+    link_transport_t *link;
+    bool loop = (rt_strcmp(name, "loop") == 0);
+
+    if (chunk == 0 || chunk > sizeof(chunk_buf))
+        chunk = sizeof(chunk_buf);
+
+    if (loop)
+    {
+        link_loopback_init_pair(&loop_a, &loop_b, "loop_a", "loop_b");
+        link_open(&loop_a);
+        link_open(&loop_b);
+        link_set_rx_callback(&loop_b, bench_rx_cb, RT_NULL);
+        link = &loop_a;
+    }
+    else
+    {
+        link = link_find(name);
+        if (link == RT_NULL || link_open(link) != RT_EOK)
+        {
+            rt_kprintf("link %s not available\n", name);
+            return;
+        }
+    }
+
+    /* 可打印的测试数据，每块以换行结束 */
+    for (rt_uint32_t i = 0; i < chunk; i++)
+        chunk_buf[i] = 'a' + i % 26;
+    chunk_buf[chunk - 1] = '\n';
+
+    bench_rx_bytes = 0;
+    t0 = app_perf_now_cycles();
+    while (sent < bytes)
+    {
+        rt_uint32_t n = (bytes - sent < chunk) ? bytes - sent : chunk;
+        rt_uint32_t t1 = app_perf_now_cycles();
+
+        if (link_write(link, chunk_buf, n) != n)
+            break;
+        t1 = app_perf_elapsed_us(t1);
+        if (t1 > max_us) max_us = t1;
+        sent += n;
+    }
+    us = app_perf_elapsed_us(t0);
+
+    rt_kprintf("%s: %d bytes in %d us (%d KB/s), max write %d us\n", link->name, sent, us,
+               us ? (rt_uint32_t)((rt_uint64_t)sent * 1000000 / us / 1024) : 0, max_us);
+    if (link->bitrate)
+        rt_kprintf("link rate %d bit/s, expected %d ms\n", link->bitrate,
+                   (rt_uint32_t)((rt_uint64_t)sent * 10 * 1000 / link->bitrate));
+    if (loop)
+    {
+        rt_kprintf("received %d bytes\n", bench_rx_bytes);
+        link_close(&loop_a);
+        link_close(&loop_b);
+    }
+}
+MSH_CMD_EXPORT_ALIAS(link_bench_cmd, link_bench, benchmark a link transport [name|loop] [bytes] [chunk]);
+#endif /* APP_USING_TEST */
+#endif /* RT_USING_FINSH */
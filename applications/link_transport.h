@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __LINK_TRANSPORT_H__
+#define __LINK_TRANSPORT_H__
+
+#include <rtthread.h>
+#include <stdbool.h>
+#include "spi_frame.h"
+
+/* 与ESP32通信的传输层接口：打开、写入、接收回调、能力标志和统计，
+ * 上层的数据包解析和UI代码不关心具体的物理链路。
+ * 已实现：RT-Thread串口设备、USB CDC（虚拟串口）、SPI主机（DMA帧）、
+ * 进程内回环（主机测试和基准测试用） */
+
+#define LINK_NAME_MAX       8       /* 注册的传输层数量上限 */
+
+/* 能力标志 */
+#define LINK_CAP_ASYNC_TX   0x01    /* 写入不阻塞，数据放入发送缓冲区后立即返回 */
+#define LINK_CAP_HW_FLOW    0x02    /* 硬件流控（RTS/CTS、SPI握手信号或USB） */
+#define LINK_CAP_DMA        0x04    /* DMA传输 */
+#define LINK_CAP_LOSSLESS   0x08    /* 不会丢失数据（回环） */
+
+typedef struct link_transport link_transport_t;
+
+/* 收到数据时调用，调用上下文由传输层决定（串口为接收中断） */
+typedef void (*link_rx_cb_t)(void *ctx, const rt_uint8_t *data, rt_size_t len);
+
+typedef struct {
+    rt_err_t (*open)(link_transport_t *link);
+    void (*close)(link_transport_t *link);
+    /* 返回写入的字节数，失败时为0；没有LINK_CAP_ASYNC_TX时可能阻塞，只在工作队列线程中调用 */
+    rt_size_t (*write)(link_transport_t *link, const void *data, rt_size_t len);
+} link_ops_t;
+
+typedef struct {
+    rt_uint32_t tx_bytes;
+    rt_uint32_t rx_bytes;
+    rt_uint32_t tx_calls;
+    rt_uint32_t rx_calls;       /* 接收回调次数 */
+    rt_uint32_t tx_errors;      /* 写入不完整或失败 */
+    rt_uint32_t rx_errors;
+} link_stats_t;
+
+struct link_transport {
+    const char *name;
+    const link_ops_t *ops;
+    rt_uint32_t caps;
+    rt_uint32_t bitrate;        /* 链路速率（bit/s），未知时为0 */
+    bool opened;
+    link_rx_cb_t rx_cb;
+    void *rx_ctx;
+    link_stats_t stats;
+    void *priv;                 /* 实现私有数据 */
+    link_transport_t *next;
+};
+
+rt_err_t link_register(link_transport_t *link);
+link_transport_t *link_find(const char *name);
+link_transport_t *link_first(void);
+
+void link_set_rx_callback(link_transport_t *link, link_rx_cb_t cb, void *ctx);
+rt_err_t link_open(link_transport_t *link);
+void link_close(link_transport_t *link);
+rt_size_t link_write(link_transport_t *link, const void *data, rt_size_t len);
+
+/* 由实现调用，把收到的数据交给上层 */
+void link_deliver(link_transport_t *link, const rt_uint8_t *data, rt_size_t len);
+
+/* ==================== 各传输层实现 ==================== */
+
+/* RT-Thread串口设备，baud为0时不修改设备配置（USB CDC虚拟串口） */
+typedef struct {
+    rt_device_t dev;
+    const char *dev_name;
+    rt_uint32_t baud;
+    bool hw_flow;               /* 打开时启用RTS/CTS */
+} link_serial_t;
+
+rt_err_t link_serial_init(link_transport_t *link, link_serial_t *serial, const char *name,
+                          const char *dev_name, rt_uint32_t baud);
+rt_err_t link_cdc_init(link_transport_t *link, link_serial_t *serial, const char *name,
+                       const char *dev_name);
+void link_serial_set_hw_flow(link_transport_t *link, bool enable);
+
+/* SPI主机：ESP32为从机，握手引脚高电平表示从机已准备好DMA缓冲区，
+ * 固定大小的帧双向同时传输，帧调度和分段见spi_frame.h。只支持一个SPI传输层 */
+typedef struct {
+    struct rt_spi_device *dev;
+    const char *dev_name;
+    rt_base_t hs_pin;
+    rt_uint32_t max_hz;
+    spi_frame_t frame;
+    rt_uint8_t rx[SPI_FRAME_SIZE];
+    volatile bool hs_armed;         /* 上次传输后出现过握手上升沿 */
+} link_spi_t;
+
+rt_err_t link_spi_init(link_transport_t *link, link_spi_t *spi, const char *name,
+                       const char *dev_name, rt_base_t hs_pin, rt_uint32_t max_hz);
+
+/* 进程内回环：一对传输层，一端写入的数据在另一端收到 */
+rt_err_t link_loopback_init_pair(link_transport_t *a, link_transport_t *b,
+                                 const char *name_a, const char *name_b);
+
+#endif /* __LINK_TRANSPORT_H__ */
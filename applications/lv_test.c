@@ -8,6 +8,23 @@
 #include <rtdevice.h>
 #include "lvgl.h"
 #include "touch_800x480.h"
+#include "ui_workq.h"
+#include "app_perf.h"
+#include "task_model.h"
+#include "task_store.h"
+#include "task_diff.h"
+#include "sync_sched.h"
+#include "task_push.h"
+#include "link_transport.h"
+#include "link_mux.h"
+#include "flow_credit.h"
+#include "task_search.h"
+#include "task_list_view.h"
+#include "task_parser.h"
+#include "touch_gesture.h"
+#include "touch_sampler.h"
+#include "touch_multi.h"
+#include "ui_quality.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -19,11 +36,29 @@
 /* 外部函数声明 */
 extern void lv_port_disp_init(void);
 extern void lv_port_indev_init(void);
+extern touch_gesture_t *lv_port_indev_get_gesture(void);
+extern touch_multi_t *lv_port_indev_get_multi(void);
+extern void lv_port_indev_set_group(lv_group_t *group);
+extern lv_disp_t *lv_port_disp_get_overlay(void);
+extern void lv_port_disp_set_overlay(lv_coord_t x, lv_coord_t y, lv_opa_t opa);
+extern bool lv_port_disp_overlay_is_soft(void);
+extern bool lv_port_disp_beam_frame(void);
 
 /* 串口通信函数声明 */
-static int esp32_uart_init(void);
-static rt_err_t esp32_uart_rx_callback(rt_device_t dev, rt_size_t size);
-static void send_command_to_esp32(const char* command);
+static int esp32_link_init(void);
+static void esp32_link_rx_callback(void *ctx, const rt_uint8_t *data, rt_size_t len);
+static void esp32_mux_rx_callback(void *ctx, rt_uint8_t ch, const rt_uint8_t *data, rt_size_t len);
+static rt_err_t send_command_to_esp32(const char* command);
+static rt_err_t esp32_command_work(void *data);
+static void submit_command_to_esp32(const char* command);
+static void submit_task_command(const char* verb, task_id_t id);
+
+/* 后台同步函数声明 */
+static rt_uint32_t sync_now_ms(void);
+static void sync_timer_cb(lv_timer_t *timer);
+static rt_err_t sync_command_work(void *data);
+static void sync_command_done(void *data, rt_err_t result);
+static void submit_sync_command(const char* command);
 static void process_esp32_packet(const char* packet);
 static void update_task_list_from_esp32(const char* response);
 static void parse_comma_separated_tasks(const char* task_data);
@@ -35,12 +70,21 @@ static void extract_packet_field(const char* packet, const char* field_name, cha
 static void update_task_display(void);
 static void update_selected_index_display(void);
 
+/* 手势与惯性滚动函数声明 */
+static void task_list_gesture_cb(const touch_gesture_event_t *evt, void *user_data);
+static void task_list_kinetic_timer_cb(lv_timer_t *timer);
+static void task_list_multi_touch_cb(const touch_multi_event_t *evt, void *user_data);
+static void task_list_key_event_handler(lv_event_t *e);
+
 /* 事件处理函数声明 */
 static void btn_up_event_handler(lv_event_t *e);
 static void btn_down_event_handler(lv_event_t *e);
 static void btn_finish_event_handler(lv_event_t *e);
 static void btn_delete_event_handler(lv_event_t *e);
 static void btn_get_event_handler(lv_event_t *e);
+static void btn_sort_event_handler(lv_event_t *e);
+static void search_ta_event_handler(lv_event_t *e);
+static void task_list_view_event_cb(task_list_view_event_t event, int index, void *user_data);
 
 /* RT-Thread相关定义 */
 static struct rt_thread lvgl_thread;
@@ -63,27 +107,35 @@ static rt_uint8_t uart_msg_thread_stack[2048];
 typedef struct {
     char data[UART_MSG_MAX_SIZE];
     rt_size_t len;
+    rt_uint16_t index;              /* 信用流控的接收序号 */
+    bool injected;                  /* 本机注入的数据包，不是ESP32发送的，不计入信用流控 */
 } uart_msg_t;
 
 static rt_mq_t uart_msg_queue = RT_NULL;
 
-/* 互斥锁保护共享资源 */
-static rt_mutex_t ui_mutex = RT_NULL;
+/* 接收流控：消息队列的每一项是一个信用，ESP32用完信用后暂停发送 */
+#define ESP32_CREDIT_WINDOW     UART_MSG_QUEUE_SIZE
+#define ESP32_CREDIT_POLL_MS    100
+static flow_credit_t esp32_credit;
 
-/* 任务信息结构体 */
+/* 接收统计 */
 typedef struct {
-    char title[128];        /* 任务标题 */
-    char list_name[64];     /* 列表名称 */
-    int list_num;           /* 列表编号 */
-    int task_num;           /* 任务编号 */
-    bool is_valid;          /* 是否有效 */
-} task_info_t;
+    rt_uint32_t queue_full;         /* 消息队列满丢弃的数据包 */
+    rt_uint32_t overflows;          /* 接收缓冲区溢出丢弃的数据包 */
+    rt_uint32_t oversize;           /* 超过UART_MSG_MAX_SIZE丢弃的数据包 */
+    rt_uint32_t garbage;            /* 包外丢弃的字节数 */
+} esp32_rx_stats_t;
+
+static esp32_rx_stats_t esp32_rx_stats;
+static rt_uint16_t esp32_packet_index;          /* 正在处理的数据包的接收序号 */
+
+/* 互斥锁保护共享资源 */
+static rt_mutex_t ui_mutex = RT_NULL;
 
 /* UI对象结构体 */
 typedef struct {
     lv_obj_t *screen;
     lv_obj_t *task_list_cont;      /* 左侧任务列表容器 */
-    lv_obj_t *task_label;          /* 任务显示标签 */
     lv_obj_t *control_panel;       /* 右侧控制面板 */
     lv_obj_t *btn_up;              /* 上键 */
     lv_obj_t *btn_down;            /* 下键 */
@@ -91,28 +143,153 @@ typedef struct {
     lv_obj_t *btn_finish;          /* Finish按钮 */
     lv_obj_t *btn_delete;          /* Delete按钮 */
     lv_obj_t *btn_get;             /* Get按钮 */
+    lv_obj_t *btn_sort;            /* 排序按钮 */
+    lv_obj_t *sort_label;          /* 排序方式标签 */
+    lv_obj_t *search_ta;           /* 搜索框 */
+    lv_obj_t *keyboard;            /* 屏幕键盘 */
 } lv_ui;
 
 /* 串口通信相关定义 - 减小缓冲区 */
 #define ESP32_UART_NAME    "uart4"    /* 串口设备名称 */
 #define ESP32_UART_BAUD    115200     /* 波特率 */
+#ifndef ESP32_UART_HW_FLOW
+#define ESP32_UART_HW_FLOW 0          /* 1：使用RTS/CTS硬件流控（需要连接RTS/CTS引脚） */
+#endif
 #define UART_RX_BUFFER_SIZE 2048      /* 减小接收缓冲区大小 */
 
+/* 与ESP32通信使用的传输层，可改为其他已注册的传输层 */
+#ifndef ESP32_LINK_NAME
+#define ESP32_LINK_NAME    "uart"
+#endif
+#define ESP32_CDC_NAME     "vcom"     /* USB CDC虚拟串口设备名称 */
+
+/* SPI链路：ESP32为SPI从机，握手引脚为-1时不注册 */
+#ifndef ESP32_SPI_DEVICE
+#define ESP32_SPI_DEVICE   "spi20"
+#endif
+#ifndef ESP32_SPI_HS_PIN
+#define ESP32_SPI_HS_PIN   (-1)
+#endif
+#ifndef ESP32_SPI_HZ
+#define ESP32_SPI_HZ       20000000
+#endif
+
 /* 串口通信变量 */
-static rt_device_t esp32_uart_dev = RT_NULL;
-static char uart_rx_buffer[UART_RX_BUFFER_SIZE];
-static rt_size_t uart_rx_index = 0;
-static bool in_packet = false;  /* 是否在接收数据包 */
+static link_transport_t *esp32_link = RT_NULL;
+static link_transport_t esp32_uart_link;
+static link_serial_t esp32_uart_serial;
+#ifdef RT_USB_DEVICE_CDC
+static link_transport_t esp32_cdc_link;
+static link_serial_t esp32_cdc_serial;
+#endif
+#ifdef RT_USING_SPI
+static link_transport_t esp32_spi_link;
+static link_spi_t esp32_spi;
+#endif
+
+/* 数据包解析：每个逻辑通道一个，帧外的原始数据（不分通道的固件）使用raw */
+typedef struct {
+    char *buf;
+    rt_size_t size;
+    rt_size_t index;
+    bool in_packet;                 /* 是否在接收数据包 */
+    bool urgent;                    /* 数据包插到消息队列最前面 */
+    rt_uint16_t packet_index;       /* 正在接收的数据包的接收序号 */
+} esp32_framer_t;
+
+#define ESP32_CTRL_BUFFER_SIZE  256
+#define ESP32_BULK_BUFFER_SIZE  (UART_MSG_MAX_SIZE + 16)
+
+static char esp32_raw_buffer[UART_RX_BUFFER_SIZE];
+static char esp32_ctrl_buffer[ESP32_CTRL_BUFFER_SIZE];
+static char esp32_bulk_buffer[ESP32_BULK_BUFFER_SIZE];
+static char esp32_diag_buffer[ESP32_CTRL_BUFFER_SIZE];
+static esp32_framer_t esp32_raw_framer = {esp32_raw_buffer, sizeof(esp32_raw_buffer), 0, false, false, 0};
+static esp32_framer_t esp32_framers[LINK_MUX_CHANNELS] = {
+    {esp32_ctrl_buffer, sizeof(esp32_ctrl_buffer), 0, false, true, 0},
+    {esp32_bulk_buffer, sizeof(esp32_bulk_buffer), 0, false, false, 0},
+    {esp32_diag_buffer, sizeof(esp32_diag_buffer), 0, false, false, 0},
+};
+
+/* 链路通道复用：ESP32确认mux_init后发送也按通道分帧，命令走控制通道，不会排在批量数据后面 */
+#define ESP32_MUX_RETRY_MS      60000
+static link_mux_t esp32_mux;
+static rt_uint8_t esp32_mux_tx_ctrl[256];
+static rt_uint8_t esp32_mux_tx_bulk[256];
+static rt_uint8_t esp32_mux_tx_diag[128];
+static volatile bool esp32_mux_acked = false;
+static bool esp32_mux_init_sent = false;
+static rt_uint32_t esp32_mux_init_ms;
+static rt_uint32_t esp32_mux_lost;              /* 确认后又收到原始数据包（ESP32重启）的次数 */
 
 /* 任务管理变量 */
-#define MAX_TASK_COUNT 20  /* 减少最大任务数量 */
-static task_info_t task_info_array[MAX_TASK_COUNT];
-static int current_task_count = 0;
+/* 任务数量上限，可以在rtconfig.h中修改；任务存储、暂存区和索引都按这个数量从堆中分配 */
+#ifndef MAX_TASK_COUNT
+#define MAX_TASK_COUNT 1000
+#endif
+static task_store_t task_store;
+static int current_task_count = 0;   /* 当前显示的任务数 */
+
+/* 标题搜索索引，随task_store增量更新 */
+#define SEARCH_MAX_POSTINGS (MAX_TASK_COUNT * 64)
+static task_search_t task_search;
+
+/* 视图中匹配搜索条件的任务，交给分组列表显示 */
+static task_id_t *visible_ids = RT_NULL;
+
+/* 按列表分组的任务列表，selected_task_index为其中展开的任务的位置 */
+static task_list_view_t task_list_view;
 static int selected_task_index = 1;  /* 当前选中的任务索引（从1开始） */
 
+/* 分片解析时的暂存区，解析完成后与task_store比较，只提交变化的部分 */
+static task_info_t *staging_task_array = RT_NULL;
+static int staging_task_count = 0;
+static bool staging_overflow = false;       /* 列表超过MAX_TASK_COUNT，多出的任务被丢弃 */
+static task_diff_t task_diff;
+
+/* 超过一个数据包的任务列表分片发送：TASKS_PART的数据为"片号:任务数据"，片号从0开始，
+ * 最后一片用TASKS并带上片号（不带片号的TASKS是完整列表）。
+ * 片在token边界切开，逐片解析进暂存区，收齐后一起提交；缺片时丢弃并重新获取 */
+static task_parser_t list_parser;
+static int list_next_part = -1;             /* 下一个应收到的片号，-1为没有正在接收的列表 */
+
+/* 后台同步：按自适应间隔发送get，链路忙时推迟 */
+#define SYNC_TIMER_PERIOD_MS    100
+static sync_sched_t sync_sched;
+static lv_timer_t *sync_timer = NULL;
+static volatile bool esp32_packet_busy = false;  /* UART线程正在处理数据包 */
+
+/* 绘制质量调节：滚动等帧时间超出预算时临时关闭阴影、抗锯齿和半透明 */
+static ui_quality_t ui_quality;
+
+/* 订阅ESP32推送，订阅成功后停止轮询 */
+static task_push_t task_push;
+static bool sync_polling = true;        /* 当前是否由sync_sched轮询 */
+#define PUSH_MAX_TASK_COUNT 32     /* 一个SET推送最多的任务数，超出时重新获取完整列表 */
+static task_info_t push_task_array[PUSH_MAX_TASK_COUNT];  /* SET推送解析出的任务 */
+static int push_task_count = 0;
+static bool push_overflow = false;
+
+/* 当前视图：排序方式和过滤条件，切换时使用task_store中缓存的视图 */
+static task_sort_t task_sort = TASK_SORT_ORDER;
+static task_filter_t task_filter = {TASK_FILTER_ANY_STATUS, 0};
+
 /* 全局UI对象 */
 static lv_ui guider_ui;
 
+/* 任务列表惯性滚动 */
+static touch_kinetic_t list_kinetic;
+static lv_timer_t *kinetic_timer = NULL;
+
+/* 按键和编码器的焦点组：任务列表和控制按钮 */
+static lv_group_t *input_group = NULL;
+
+/* 双指缩放：超过阈值时切换任务列表字体 */
+#define PINCH_ZOOM_IN_SCALE     (TOUCH_MULTI_SCALE_ONE * 5 / 4)
+#define PINCH_ZOOM_OUT_SCALE    (TOUCH_MULTI_SCALE_ONE * 4 / 5)
+static bool task_list_large_font = false;
+static bool pinch_applied = false;     /* 本次双指操作已切换过字体 */
+
 /* 字体声明 */
 LV_FONT_DECLARE(lv_font_montserratMedium_16)
 LV_FONT_DECLARE(lv_font_montserratMedium_12)
@@ -172,6 +349,46 @@ static void extract_packet_field(const char* packet, const char* field_name, cha
 
 /* ==================== UART消息处理线程 ==================== */
 
+/* 需要时向ESP32通告接收信用，只在UART消息处理线程中调用 */
+static void esp32_credit_poll(void)
+{
+    char cmd[24];
+    rt_uint16_t value;
+    rt_uint32_t now = sync_now_ms();
+    flow_credit_action_t action;
+
+    if (esp32_link == RT_NULL)
+        return;
+
+    action = flow_credit_poll(&esp32_credit, now, &value);
+    if (action == FLOW_CREDIT_NONE)
+        return;
+
+    rt_snprintf(cmd, sizeof(cmd), "%s:%d", (action == FLOW_CREDIT_INIT) ? "credit_init" : "credit", value);
+    if (ui_workq_submit(UI_WORKQ_PRIO_HIGH, esp32_command_work, RT_NULL, cmd, rt_strlen(cmd) + 1) == RT_EOK)
+    {
+        flow_credit_sent(&esp32_credit, action, value, now);
+    }
+}
+
+/* 没有确认时定期请求ESP32按通道分帧发送，只在UART消息处理线程中调用 */
+static void esp32_mux_poll(void)
+{
+    static const char cmd[] = "mux_init:3";
+    rt_uint32_t now = sync_now_ms();
+
+    if (esp32_link == RT_NULL || esp32_mux_acked)
+        return;
+    if (esp32_mux_init_sent && now - esp32_mux_init_ms < ESP32_MUX_RETRY_MS)
+        return;
+
+    if (ui_workq_submit(UI_WORKQ_PRIO_HIGH, esp32_command_work, RT_NULL, cmd, sizeof(cmd)) == RT_EOK)
+    {
+        esp32_mux_init_sent = true;
+        esp32_mux_init_ms = now;
+    }
+}
+
 /* UART消息处理线程入口函数 */
 static void uart_msg_process_thread_entry(void *parameter)
 {
@@ -181,53 +398,73 @@ static void uart_msg_process_thread_entry(void *parameter)
 
     while (1)
     {
-        /* 从消息队列接收数据 */
-        if (rt_mq_recv(uart_msg_queue, &msg, sizeof(uart_msg_t), RT_WAITING_FOREVER) == RT_EOK)
+        /* 从消息队列接收数据，空闲时定期检查是否需要通告信用 */
+        if (rt_mq_recv(uart_msg_queue, &msg, sizeof(uart_msg_t),
+                       rt_tick_from_millisecond(ESP32_CREDIT_POLL_MS)) == RT_EOK)
         {
-            /* 获取UI互斥锁 */
-            if (rt_mutex_take(ui_mutex, RT_WAITING_FOREVER) == RT_EOK)
-            {
-                /* 处理接收到的数据包 */
-                LOG_D("Processing packet (len=%d)", msg.len);
-                process_esp32_packet(msg.data);
-
-                /* 释放UI互斥锁 */
-                rt_mutex_release(ui_mutex);
-            }
+            /* 处理接收到的数据包，只在修改UI数据时获取ui_mutex */
+            LOG_D("Processing packet (len=%d)", msg.len);
+            esp32_packet_busy = true;
+            esp32_packet_index = msg.index;
+            process_esp32_packet(msg.data);
+            esp32_packet_busy = false;
+
+            /* 处理完才归还信用 */
+            if (!msg.injected)
+                flow_credit_on_consumed(&esp32_credit);
         }
+        esp32_credit_poll();
+        esp32_mux_poll();
     }
 }
 
 /* ==================== UI更新函数 ==================== */
 
+/* 当前排序和过滤条件对应的视图 */
+static task_view_t *active_view(void)
+{
+    return task_store_get_view(&task_store, task_sort, &task_filter);
+}
+
+/* 当前选中的任务ID，没有时返回TASK_ID_NONE */
+static task_id_t selected_task_id(void)
+{
+    return task_list_view_task(&task_list_view, selected_task_index - 1);
+}
+
 /* 更新任务显示 */
 static void update_task_display(void)
 {
-    if (guider_ui.task_label == NULL) return;
+    if (guider_ui.task_list_cont == NULL || visible_ids == RT_NULL) return;
 
-    char display_text[1536] = {0};  /* 减小显示缓冲区 */
-    int pos = 0;
+    char empty_text[64];
+    int visible_count = 0;
+    task_view_t *view = active_view();
+    rt_uint32_t count = view ? view->count : 0;
 
-    /* 构建显示文本 */
-    for (int i = 0; i < current_task_count && i < MAX_TASK_COUNT; i++)
+    /* 按视图顺序取出匹配搜索条件的任务 */
+    for (rt_uint32_t i = 0; i < count && visible_count < MAX_TASK_COUNT; i++)
     {
-        if (task_info_array[i].is_valid)
+        task_id_t id = task_view_at(view, i);
+        if (task_search_match(&task_search, id))
         {
-            pos += rt_snprintf(display_text + pos, sizeof(display_text) - pos,
-                             "%d. %s [%s]\n",
-                             i + 1,
-                             task_info_array[i].title,
-                             task_info_array[i].list_name);
+            visible_ids[visible_count++] = id;
         }
     }
 
-    if (current_task_count == 0)
+    if (task_search.active)
+    {
+        rt_snprintf(empty_text, sizeof(empty_text), "No tasks match \"%s\"", task_search.query);
+    }
+    else
     {
-        rt_strcpy(display_text, "No tasks available\nPress GET to load tasks");
+        rt_strcpy(empty_text, "No tasks available\nPress GET to load tasks");
     }
 
-    /* 更新标签文本 */
-    lv_label_set_text(guider_ui.task_label, display_text);
+    /* 按列表分组显示，只为可见的行创建对象 */
+    task_list_view_set_tasks(&task_list_view, &task_store, visible_ids, visible_count, empty_text);
+    current_task_count = task_list_view_count(&task_list_view);
+    task_list_view_set_selected(&task_list_view, selected_task_index - 1);
 
     LOG_I("Task display updated with %d tasks", current_task_count);
 }
@@ -240,103 +477,210 @@ static void update_selected_index_display(void)
     char index_text[16];
     rt_snprintf(index_text, sizeof(index_text), "%d", selected_task_index);
     lv_label_set_text(guider_ui.index_label, index_text);
+    task_list_view_set_selected(&task_list_view, selected_task_index - 1);
 }
 
-/* ==================== 任务列表解析函数 ==================== */
+/* 分组列表回调：点击任务行选中，折叠/展开后选中项位置改变 */
+static void task_list_view_event_cb(task_list_view_event_t event, int index, void *user_data)
+{
+    if (event == TASK_LIST_VIEW_LAYOUT)
+    {
+        current_task_count = task_list_view_count(&task_list_view);
+    }
+    selected_task_index = (index >= 0) ? index + 1 : 1;
+    update_selected_index_display();
+}
 
-/* 解析逗号分隔的任务数据 */
-static void parse_comma_separated_tasks(const char* task_data)
+/* ==================== 手势与惯性滚动 ==================== */
+
+/* 任务列表当前使用的字体 */
+static const lv_font_t *task_list_font(void)
 {
-    if (task_data == RT_NULL || rt_strlen(task_data) == 0)
+    return task_list_large_font ? &lv_font_montserratMedium_16 : &lv_font_montserratMedium_12;
+}
+
+/* 选中索引跟随滚动位置：取列表可见区域顶部的任务 */
+static void sync_selection_to_scroll(void)
+{
+    int index = task_list_view_index_at_y(&task_list_view, lv_obj_get_scroll_y(guider_ui.task_list_cont)) + 1;
+
+    if (index < 1) index = 1;
+
+    if (index != selected_task_index)
     {
-        LOG_W("Empty task data received");
-        current_task_count = 0;
-        update_task_display();
+        selected_task_index = index;
+        update_selected_index_display();
+    }
+}
+
+/* 手势回调，在lv_task_handler中调用（已持有ui_mutex） */
+static void task_list_gesture_cb(const touch_gesture_event_t *evt, void *user_data)
+{
+    lv_area_t coords;
+
+    if (evt->type != TOUCH_GESTURE_FLING || guider_ui.task_list_cont == NULL)
+        return;
+    if (evt->dir != TOUCH_DIR_UP && evt->dir != TOUCH_DIR_DOWN)
+        return;
+
+    /* 只处理从任务列表区域开始的fling */
+    lv_obj_get_coords(guider_ui.task_list_cont, &coords);
+    if (evt->start_x < coords.x1 || evt->start_x > coords.x2 ||
+        evt->start_y < coords.y1 || evt->start_y > coords.y2)
+        return;
+
+    touch_kinetic_start(&list_kinetic, evt->vy, lv_tick_get());
+    /* 惯性滚动期间保持高速采样，及时响应按下停止 */
+    touch_sampler_keep_alive(TOUCH_KINETIC_TAU_MS * 4);
+    LOG_D("Kinetic scroll started, v=%d px/s", (int)evt->vy);
+}
+
+/* 多点触摸回调：双指滚动任务列表，双指缩放切换字体（已持有ui_mutex） */
+static void task_list_multi_touch_cb(const touch_multi_event_t *evt, void *user_data)
+{
+    lv_obj_t *cont = guider_ui.task_list_cont;
+    lv_area_t coords;
+    bool large;
+
+    if (cont == NULL)
         return;
+
+    switch (evt->type) {
+    case TOUCH_MULTI_TWO_BEGIN:
+        pinch_applied = false;
+        touch_kinetic_stop(&list_kinetic);
+        break;
+
+    case TOUCH_MULTI_TWO_MOVE:
+        lv_obj_get_coords(cont, &coords);
+        if (evt->center_x < coords.x1 || evt->center_x > coords.x2 ||
+            evt->center_y < coords.y1 || evt->center_y > coords.y2)
+            break;
+
+        if (!pinch_applied && (evt->scale >= PINCH_ZOOM_IN_SCALE || evt->scale <= PINCH_ZOOM_OUT_SCALE))
+        {
+            large = (evt->scale >= PINCH_ZOOM_IN_SCALE);
+            pinch_applied = true;
+            if (large != task_list_large_font)
+            {
+                task_list_large_font = large;
+                task_list_view_set_font(&task_list_view, task_list_font());
+                LOG_D("Task list font %s", large ? "enlarged" : "reduced");
+            }
+        }
+        else if (evt->dy != 0)
+        {
+            lv_obj_scroll_by(cont, 0, evt->dy, LV_ANIM_OFF);
+        }
+        break;
+
+    case TOUCH_MULTI_TWO_END:
+        sync_selection_to_scroll();
+        break;
+
+    default:
+        break;
     }
+}
 
-    LOG_I("Parsing comma-separated task data (length=%d)", rt_strlen(task_data));
+/* 每帧推进惯性滚动 */
+static void task_list_kinetic_timer_cb(lv_timer_t *timer)
+{
+    lv_obj_t *cont = guider_ui.task_list_cont;
+    rt_int32_t delta;
+
+    if (!list_kinetic.active)
+        return;
 
-    /* 清空现有任务 */
-    for (int i = 0; i < MAX_TASK_COUNT; i++)
+    /* 重新按下时立即停止 */
+    if (touch_gesture_is_pressed(lv_port_indev_get_gesture()))
     {
-        rt_memset(&task_info_array[i], 0, sizeof(task_info_t));
-        task_info_array[i].is_valid = false;
+        touch_kinetic_stop(&list_kinetic);
+        sync_selection_to_scroll();
+        return;
     }
-    current_task_count = 0;
 
-    /* 特殊处理无任务的情况 */
-    if (rt_strcmp(task_data, "NO_TASKS") == 0)
+    touch_kinetic_step(&list_kinetic, lv_tick_get(), &delta);
+
+    /* 到达边界时停止 */
+    if ((delta > 0 && lv_obj_get_scroll_y(cont) <= 0) ||
+        (delta < 0 && lv_obj_get_scroll_bottom(cont) <= 0))
     {
-        LOG_I("No tasks available");
-        update_task_display();
-        return;
+        touch_kinetic_stop(&list_kinetic);
+    }
+    else if (delta != 0)
+    {
+        lv_obj_scroll_by(cont, 0, delta, LV_ANIM_OFF);
     }
 
-    /* 复制数据以便处理 */
-    char *data_copy = rt_malloc(rt_strlen(task_data) + 1);
-    if (data_copy == RT_NULL)
+    if (!list_kinetic.active)
     {
-        LOG_E("Failed to allocate memory for task data parsing");
-        return;
+        sync_selection_to_scroll();
     }
-    rt_strcpy(data_copy, task_data);
+}
+
+/* ==================== 按键导航 ==================== */
+
+/* 移动选中项并滚动列表使其位于可见区域顶部 */
+static void move_selection(int delta)
+{
+    int index = selected_task_index + delta;
+
+    if (current_task_count == 0)
+        return;
+    if (index > current_task_count) index = current_task_count;
+    if (index < 1) index = 1;
+    if (index == selected_task_index)
+        return;
 
-    /* 用逗号分割数据 */
-    char *token = strtok(data_copy, DATA_DELIMITER);
-    int task_index = 0;
-    char current_list_name[64] = {0};
-    int current_list_num = 0;
+    selected_task_index = index;
+    update_selected_index_display();
+    touch_kinetic_stop(&list_kinetic);
+    lv_obj_scroll_to_y(guider_ui.task_list_cont, task_list_view_y_of(&task_list_view, index - 1), LV_ANIM_ON);
+}
 
-    while (token != RT_NULL && task_index < MAX_TASK_COUNT)
+/* 任务列表获得焦点时：上下键或编码器编辑模式下的旋转移动选中项，
+ * ESC退出编辑模式，在lv_task_handler中调用（已持有ui_mutex） */
+static void task_list_key_event_handler(lv_event_t *e)
+{
+    switch (lv_event_get_key(e))
     {
-        /* 去除前后空白 */
-        while (*token == ' ' || *token == '\t') token++;
-        char *end = token + rt_strlen(token) - 1;
-        while (end > token && (*end == ' ' || *end == '\t')) *end-- = '\0';
+    case LV_KEY_UP:
+    case LV_KEY_LEFT:
+        move_selection(-1);
+        break;
 
-        LOG_D("Processing token: [%s]", token);
+    case LV_KEY_DOWN:
+    case LV_KEY_RIGHT:
+        move_selection(1);
+        break;
 
-        /* 检查是否是列表名（格式: "1.ListName"） */
-        if (token[0] >= '1' && token[0] <= '9' && token[1] == '.' &&
-            strchr(token + 2, '.') == NULL)  /* 确保后面没有其他点号 */
-        {
-            current_list_num = token[0] - '0';
-            rt_strncpy(current_list_name, token + 2, sizeof(current_list_name) - 1);
-            LOG_D("Found list %d: %s", current_list_num, current_list_name);
-        }
-        /* 检查是否是任务（格式: "1.1.TaskTitle"） */
-        else if (token[0] >= '1' && token[0] <= '9' && token[1] == '.')
-        {
-            char *second_dot = strchr(token + 2, '.');
-            if (second_dot != NULL)
-            {
-                /* 解析列表编号和任务编号 */
-                int list_num = token[0] - '0';
-                int task_num = atoi(token + 2);
-                char *task_title = second_dot + 1;
-
-                /* 存储任务信息 */
-                task_info_t *task_info = &task_info_array[task_index];
-                rt_strncpy(task_info->title, task_title, sizeof(task_info->title) - 1);
-                rt_strncpy(task_info->list_name, current_list_name, sizeof(task_info->list_name) - 1);
-                task_info->list_num = list_num;
-                task_info->task_num = task_num;
-                task_info->is_valid = true;
-
-                task_index++;
-                current_task_count++;
-
-                LOG_D("Parsed task %d.%d: %s", list_num, task_num, task_title);
-            }
-        }
+    case LV_KEY_ESC:
+        lv_group_set_editing(input_group, false);
+        break;
 
-        token = strtok(RT_NULL, DATA_DELIMITER);
+    default:
+        break;
     }
+}
+
+/* ==================== 任务列表解析函数 ==================== */
 
-    rt_free(data_copy);
+/* 解析器回调：把任务存入暂存区 */
+static bool stage_parsed_task(void *ctx, const task_info_t *task)
+{
+    if (staging_task_array == RT_NULL || staging_task_count >= MAX_TASK_COUNT)
+    {
+        staging_overflow = true;
+        return false;
+    }
+    staging_task_array[staging_task_count++] = *task;
+    return true;
+}
 
-    /* 更新显示 */
+/* 任务有变化后刷新显示并调整选中索引（需持有ui_mutex） */
+static void task_list_changed(void)
+{
     update_task_display();
 
     /* 调整选中索引 */
@@ -350,105 +694,484 @@ static void parse_comma_separated_tasks(const char* task_data)
         selected_task_index = 1;
         update_selected_index_display();
     }
+}
+
+/* 提交暂存区的任务并刷新显示（需持有ui_mutex） */
+static void commit_staged_tasks(void)
+{
+    task_diff_result_t result;
+
+    if (staging_overflow)
+    {
+        LOG_W("Task list truncated to %d tasks (MAX_TASK_COUNT)", staging_task_count);
+    }
+
+    /* 按任务编号与现有任务比较，只修改变化的任务 */
+    task_diff_apply(&task_diff, &task_store, staging_task_array, staging_task_count, &result);
+    sync_sched_on_result(&sync_sched, sync_now_ms(), task_diff_changes(&result) > 0);
+    if (result.duplicates > 0)
+    {
+        LOG_W("%d duplicate tasks ignored", result.duplicates);
+    }
+    LOG_I("Task list diff: +%d -%d ~%d >%d, %d unchanged (%d us)",
+          result.inserts, result.removes, result.updates, result.moves, result.unchanged, result.us);
 
-    LOG_I("Task parsing completed. Total tasks: %d", current_task_count);
+    /* 没有变化时不更新显示，不产生任何重绘 */
+    if (task_diff_changes(&result) == 0)
+        return;
+    task_list_changed();
 }
 
-/* ==================== 数据包处理函数 ==================== */
+/* 解析完解析器中的数据，每片之间让出CPU（不持有ui_mutex） */
+static void run_task_parser(task_parser_t *parser)
+{
+    task_parse_status_t status;
 
-/* 处理ESP32数据包 */
-static void process_esp32_packet(const char* packet)
+    do
+    {
+        status = task_parser_step(parser, TASK_PARSE_SLICE_TOKENS, TASK_PARSE_SLICE_US);
+        if (status == TASK_PARSE_MORE)
+        {
+            /* 让出CPU，LVGL线程可以完成当前帧 */
+            rt_thread_delay(1);
+        }
+    } while (status == TASK_PARSE_MORE);
+
+    LOG_I("Parsed %d tokens in %d slices (max slice %d us)",
+          parser->tokens, parser->slices, parser->max_slice_us);
+}
+
+/* 分片解析任务数据（不持有ui_mutex） */
+static rt_err_t parse_task_tokens(const char* task_data, task_parser_emit_t emit)
 {
-    LOG_I("Processing ESP32 packet");
+    task_parser_t parser;
 
-    /* 验证包头 */
-    if (strstr(packet, PKT_START) != packet)
+    if (task_parser_begin(&parser, task_data, emit, RT_NULL) != RT_EOK)
     {
-        LOG_E("Invalid packet start");
-        return;
+        return -RT_ENOMEM;
     }
+    run_task_parser(&parser);
+    task_parser_end(&parser);
+    return RT_EOK;
+}
 
-    /* 验证包尾 */
-    if (strstr(packet, PKT_END) == NULL)
+/* 提交暂存区（不持有ui_mutex） */
+static void finish_task_list(void)
+{
+    if (rt_mutex_take(ui_mutex, RT_WAITING_FOREVER) == RT_EOK)
     {
-        LOG_E("Invalid packet end");
-        return;
+        commit_staged_tasks();
+        rt_mutex_release(ui_mutex);
     }
 
-    /* 提取字段 */
-    char type[64], data[1024], checksum_str[16];  /* 减小数据缓冲区 */
-    extract_packet_field(packet, "TYPE", type, sizeof(type));
-    extract_packet_field(packet, "DATA", data, sizeof(data));
-    extract_packet_field(packet, "CHECKSUM", checksum_str, sizeof(checksum_str));
+    LOG_I("Task parsing completed. Total tasks: %d", staging_task_count);
+}
 
-    /* 验证校验和 */
-    int checksum = atoi(checksum_str);
-    if (!verify_checksum(type, data, checksum))
+/* 增量或分片不完整时重新获取完整列表 */
+static void request_full_list(void)
+{
+    if (ui_workq_submit(UI_WORKQ_PRIO_NORMAL, sync_command_work, sync_command_done,
+                        "get", sizeof("get")) != RT_EOK)
     {
-        LOG_E("Checksum verification failed");
-        return;
+        rt_mutex_take(ui_mutex, RT_WAITING_FOREVER);
+        sync_sched_on_error(&sync_sched, sync_now_ms());
+        rt_mutex_release(ui_mutex);
     }
+}
 
-    LOG_I("Packet type: %s", type);
+/* 丢弃正在接收的分片列表 */
+static void drop_task_list_parts(void)
+{
+    if (list_next_part >= 0)
+    {
+        task_parser_end(&list_parser);
+        list_next_part = -1;
+    }
+}
 
-    /* 根据类型处理 */
-    if (rt_strcmp(type, "TASKS") == 0)
+/* 解析逗号分隔的任务数据
+ * 在UART消息线程中调用，不持有ui_mutex。解析分片进行，每片之间让出CPU，
+ * 保证大批量数据加载时LVGL帧率稳定；全部解析完成后才获取ui_mutex提交结果 */
+static void parse_comma_separated_tasks(const char* task_data)
+{
+    if (list_next_part >= 0)
     {
-        LOG_I("Received task list");
-        parse_comma_separated_tasks(data);
+        LOG_W("Task list part %d missing, using complete list", list_next_part);
+        drop_task_list_parts();
     }
-    else if (rt_strcmp(type, "RESULT") == 0)
+    staging_task_count = 0;
+    staging_overflow = false;
+
+    if (task_data == RT_NULL || rt_strlen(task_data) == 0)
     {
-        LOG_I("Operation result: %s", data);
-        /* 延时后可选择手动获取任务列表 */
-        rt_thread_mdelay(500);
+        LOG_W("Empty task data received");
     }
-    else if (rt_strcmp(type, "ERROR") == 0)
+    /* 特殊处理无任务的情况 */
+    else if (rt_strcmp(task_data, "NO_TASKS") == 0)
     {
-        LOG_E("Error: %s", data);
+        LOG_I("No tasks available");
     }
-    else if (rt_strcmp(type, "STATUS") == 0)
+    else
     {
-        LOG_I("Status: %s", data);
+        LOG_I("Parsing comma-separated task data (length=%d)", rt_strlen(task_data));
+
+        if (parse_task_tokens(task_data, stage_parsed_task) != RT_EOK)
+        {
+            return;
+        }
     }
-    else if (rt_strcmp(type, "HELP") == 0)
+
+    finish_task_list();
+}
+
+/* 取出分片数据的片号，没有片号时返回-1 */
+static int task_list_part(const char* data, const char** payload)
+{
+    const char *p = data;
+    int part = 0;
+
+    while (*p >= '0' && *p <= '9' && p - data < TASK_ID_MAX_DIGITS)
     {
-        LOG_I("Help: %s", data);
+        part = part * 10 + (*p - '0');
+        p++;
     }
-    else if (rt_strcmp(type, "TEST") == 0)
+    /* 任务数据以"编号."开头，片号以"片号:"开头 */
+    if (p == data || *p != ':')
+        return -1;
+    *payload = p + 1;
+    return part;
+}
+
+/* 解析一片任务列表，last为最后一片，收齐后提交（不持有ui_mutex） */
+static void parse_task_list_part(const char* data, bool last)
+{
+    const char *payload;
+    int part = task_list_part(data, &payload);
+    rt_err_t err;
+
+    if (part < 0)
     {
-        LOG_I("Test response: %s", data);
+        LOG_E("Invalid task list part");
+        drop_task_list_parts();
+        return;
+    }
+
+    if (part == 0)
+    {
+        drop_task_list_parts();
+        staging_task_count = 0;
+        staging_overflow = false;
+        err = task_parser_begin(&list_parser, payload, stage_parsed_task, RT_NULL);
+    }
+    else if (part == list_next_part)
+    {
+        err = task_parser_next(&list_parser, payload);
     }
     else
     {
-        LOG_W("Unknown packet type: %s", type);
+        /* 缺片或重复，已解析的部分不完整 */
+        LOG_W("Task list part %d, expected %d, requesting full list", part, list_next_part);
+        drop_task_list_parts();
+        request_full_list();
+        return;
+    }
+    if (err != RT_EOK)
+    {
+        list_next_part = -1;
+        return;
     }
+    list_next_part = part + 1;
+
+    LOG_I("Task list part %d (length=%d)", part, rt_strlen(payload));
+    run_task_parser(&list_parser);
+    if (!last)
+        return;
+
+    drop_task_list_parts();
+    finish_task_list();
 }
 
-/* ==================== 事件处理函数 ==================== */
+/* ==================== 推送处理函数 ==================== */
 
-/* 上键事件处理 */
-static void btn_up_event_handler(lv_event_t *e)
+static bool stage_pushed_task(void *ctx, const task_info_t *task)
 {
-    lv_event_code_t code = lv_event_get_code(e);
-    lv_obj_t *btn = lv_event_get_target(e);
+    if (push_task_count >= PUSH_MAX_TASK_COUNT)
+    {
+        push_overflow = true;
+        return false;
+    }
+    push_task_array[push_task_count++] = *task;
+    return true;
+}
 
-    switch (code) {
-    case LV_EVENT_PRESSED:
-        /* 按下时变红 */
-        lv_obj_set_style_bg_color(btn, lv_color_hex(0xFF0000), LV_PART_MAIN|LV_STATE_DEFAULT);
-        break;
+/* 应用SET推送：按编号修改已有任务，没有的新增到末尾（需持有ui_mutex） */
+static int apply_pushed_tasks(void)
+{
+    int changed = 0;
 
-    case LV_EVENT_RELEASED:
-        /* 松开时恢复颜色并执行操作 */
-        lv_obj_set_style_bg_color(btn, lv_color_hex(0x2195f6), LV_PART_MAIN|LV_STATE_DEFAULT);
+    for (int i = 0; i < push_task_count; i++)
+    {
+        task_info_t *task = &push_task_array[i];
+        task_id_t id = task_store_find(&task_store, task->list_num, task->task_num);
 
-        /* 获取UI互斥锁 */
-        if (rt_mutex_take(ui_mutex, 100) == RT_EOK)
+        if (id != TASK_ID_NONE)
         {
-            if (selected_task_index > 1)
+            /* 推送中没有列表项时保留原来的列表名 */
+            if (task->list_name[0] == '\0')
             {
-                selected_task_index--;
+                rt_strcpy(task->list_name, task_store_get(&task_store, id)->list_name);
+            }
+            if (task_store_update(&task_store, id, task) == RT_EOK)
+            {
+                changed++;
+            }
+        }
+        else if (task_store_add(&task_store, task) != TASK_ID_NONE)
+        {
+            changed++;
+        }
+        else
+        {
+            LOG_W("No room for pushed task %d.%d", task->list_num, task->task_num);
+        }
+    }
+    return changed;
+}
+
+/* 应用DEL推送：逗号分隔的"列表编号.任务编号"（需持有ui_mutex） */
+static int apply_pushed_removals(const char* payload)
+{
+    const char *p = payload;
+    int removed = 0;
+
+    while (*p)
+    {
+        char *end;
+        long list_num = strtol(p, &end, 10);
+        long task_num;
+        task_id_t id;
+
+        if (end == p || *end != '.')
+            break;
+        p = end + 1;
+        task_num = strtol(p, &end, 10);
+        if (end == p)
+            break;
+
+        id = task_store_find(&task_store, (int)list_num, (int)task_num);
+        if (id != TASK_ID_NONE && task_store_remove(&task_store, id) == RT_EOK)
+        {
+            removed++;
+        }
+
+        if (*end != ',')
+            break;
+        p = end + 1;
+    }
+    return removed;
+}
+
+/* 处理ESP32推送（在UART消息线程中调用） */
+static void process_push_packet(const char* data)
+{
+    rt_uint32_t seq;
+    task_push_kind_t kind;
+    task_push_action_t action;
+    const char *payload;
+    int changed = 0;
+
+    if (rt_mutex_take(ui_mutex, RT_WAITING_FOREVER) != RT_EOK)
+        return;
+    if (task_push_parse(data, &seq, &kind, &payload) != RT_EOK)
+    {
+        task_push.stats.invalid++;
+        rt_mutex_release(ui_mutex);
+        LOG_E("Invalid push data");
+        return;
+    }
+    action = task_push_accept(&task_push, seq, kind, sync_now_ms());
+    rt_mutex_release(ui_mutex);
+
+    LOG_I("Push %u %s: %s", seq, task_push_kind_name(kind),
+          action == TASK_PUSH_APPLY ? "apply" : (action == TASK_PUSH_IGNORE ? "ignored" : "gap, resync"));
+
+    if (action == TASK_PUSH_RESYNC)
+    {
+        /* 丢弃增量，重新订阅后ESP32推送完整列表 */
+        if (ui_workq_submit(UI_WORKQ_PRIO_NORMAL, sync_command_work, sync_command_done,
+                            "subscribe", sizeof("subscribe")) != RT_EOK)
+        {
+            rt_mutex_take(ui_mutex, RT_WAITING_FOREVER);
+            task_push_reset(&task_push, sync_now_ms());
+            rt_mutex_release(ui_mutex);
+        }
+        return;
+    }
+    if (action != TASK_PUSH_APPLY)
+        return;
+
+    /* 完整列表与TASKS相同，按差异更新 */
+    if (kind == TASK_PUSH_ALL)
+    {
+        parse_comma_separated_tasks(payload);
+        return;
+    }
+
+    if (kind == TASK_PUSH_SET)
+    {
+        push_task_count = 0;
+        push_overflow = false;
+        if (parse_task_tokens(payload, stage_pushed_task) != RT_EOK)
+            return;
+        if (push_overflow)
+        {
+            LOG_W("Push has more than %d tasks, requesting full list", PUSH_MAX_TASK_COUNT);
+            request_full_list();
+            return;
+        }
+    }
+
+    if (rt_mutex_take(ui_mutex, RT_WAITING_FOREVER) == RT_EOK)
+    {
+        changed = (kind == TASK_PUSH_SET) ? apply_pushed_tasks() : apply_pushed_removals(payload);
+        if (changed > 0)
+        {
+            task_list_changed();
+        }
+        rt_mutex_release(ui_mutex);
+    }
+}
+
+/* ==================== 数据包处理函数 ==================== */
+
+/* 处理ESP32数据包 */
+static void process_esp32_packet(const char* packet)
+{
+    LOG_I("Processing ESP32 packet");
+
+    /* 验证包头 */
+    if (strstr(packet, PKT_START) != packet)
+    {
+        LOG_E("Invalid packet start");
+        return;
+    }
+
+    /* 验证包尾 */
+    if (strstr(packet, PKT_END) == NULL)
+    {
+        LOG_E("Invalid packet end");
+        return;
+    }
+
+    /* 提取字段 */
+    char type[64], data[UART_MSG_MAX_SIZE], checksum_str[16];
+    extract_packet_field(packet, "TYPE", type, sizeof(type));
+    extract_packet_field(packet, "DATA", data, sizeof(data));
+    extract_packet_field(packet, "CHECKSUM", checksum_str, sizeof(checksum_str));
+
+    /* 验证校验和 */
+    int checksum = atoi(checksum_str);
+    if (!verify_checksum(type, data, checksum))
+    {
+        LOG_E("Checksum verification failed");
+        return;
+    }
+
+    LOG_I("Packet type: %s", type);
+
+    /* 根据类型处理 */
+    if (rt_strcmp(type, "TASKS") == 0)
+    {
+        const char *payload;
+
+        LOG_I("Received task list");
+        /* 带片号的是分片列表的最后一片 */
+        if (task_list_part(data, &payload) >= 0)
+            parse_task_list_part(data, true);
+        else
+            parse_comma_separated_tasks(data);
+    }
+    else if (rt_strcmp(type, "TASKS_PART") == 0)
+    {
+        parse_task_list_part(data, false);
+    }
+    else if (rt_strcmp(type, "RESULT") == 0)
+    {
+        LOG_I("Operation result: %s", data);
+        /* 延时后可选择手动获取任务列表 */
+        rt_thread_mdelay(500);
+    }
+    else if (rt_strcmp(type, "PUSH") == 0)
+    {
+        process_push_packet(data);
+    }
+    else if (rt_strcmp(type, "ERROR") == 0)
+    {
+        LOG_E("Error: %s", data);
+
+        /* 订阅期间收到错误，认为ESP32不支持推送，继续轮询 */
+        if (rt_mutex_take(ui_mutex, RT_WAITING_FOREVER) == RT_EOK)
+        {
+            if (task_push.state == TASK_PUSH_SUBSCRIBING)
+            {
+                task_push_reset(&task_push, sync_now_ms());
+            }
+            rt_mutex_release(ui_mutex);
+        }
+    }
+    else if (rt_strcmp(type, "STATUS") == 0)
+    {
+        LOG_I("Status: %s", data);
+
+        /* ESP32确认信用流控，按这个包的接收序号对齐计数 */
+        if (rt_strncmp(data, "credit:", 7) == 0)
+        {
+            flow_credit_on_ack(&esp32_credit, esp32_packet_index);
+        }
+        /* ESP32确认通道复用，之后的命令按通道分帧发送 */
+        else if (rt_strncmp(data, "mux:", 4) == 0)
+        {
+            esp32_mux_acked = (atoi(data + 4) == LINK_MUX_CHANNELS);
+        }
+    }
+    else if (rt_strcmp(type, "HELP") == 0)
+    {
+        LOG_I("Help: %s", data);
+    }
+    else if (rt_strcmp(type, "TEST") == 0)
+    {
+        LOG_I("Test response: %s", data);
+    }
+    else
+    {
+        LOG_W("Unknown packet type: %s", type);
+    }
+}
+
+/* ==================== 事件处理函数 ==================== */
+
+/* 上键事件处理 */
+static void btn_up_event_handler(lv_event_t *e)
+{
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_obj_t *btn = lv_event_get_target(e);
+
+    switch (code) {
+    case LV_EVENT_PRESSED:
+        /* 按下时变红 */
+        lv_obj_set_style_bg_color(btn, lv_color_hex(0xFF0000), LV_PART_MAIN|LV_STATE_DEFAULT);
+        break;
+
+    case LV_EVENT_RELEASED:
+        /* 松开时恢复颜色并执行操作 */
+        lv_obj_set_style_bg_color(btn, lv_color_hex(0x2195f6), LV_PART_MAIN|LV_STATE_DEFAULT);
+
+        /* 获取UI互斥锁 */
+        if (rt_mutex_take(ui_mutex, 100) == RT_EOK)
+        {
+            if (selected_task_index > 1)
+            {
+                selected_task_index--;
                 update_selected_index_display();
             }
             rt_mutex_release(ui_mutex);
@@ -512,18 +1235,7 @@ static void btn_finish_event_handler(lv_event_t *e)
         /* 获取UI互斥锁 */
         if (rt_mutex_take(ui_mutex, 100) == RT_EOK)
         {
-            if (selected_task_index > 0 && selected_task_index <= current_task_count)
-            {
-                task_info_t *task = &task_info_array[selected_task_index - 1];
-                if (task->is_valid)
-                {
-                    char cmd[64];
-                    rt_snprintf(cmd, sizeof(cmd), "finish %d.%d",
-                              task->list_num, task->task_num);
-                    send_command_to_esp32(cmd);
-                    LOG_I("Finish task %d: %s", selected_task_index, cmd);
-                }
-            }
+            submit_task_command("finish", selected_task_id());
             rt_mutex_release(ui_mutex);
         }
         break;
@@ -552,18 +1264,7 @@ static void btn_delete_event_handler(lv_event_t *e)
         /* 获取UI互斥锁 */
         if (rt_mutex_take(ui_mutex, 100) == RT_EOK)
         {
-            if (selected_task_index > 0 && selected_task_index <= current_task_count)
-            {
-                task_info_t *task = &task_info_array[selected_task_index - 1];
-                if (task->is_valid)
-                {
-                    char cmd[64];
-                    rt_snprintf(cmd, sizeof(cmd), "delete %d.%d",
-                              task->list_num, task->task_num);
-                    send_command_to_esp32(cmd);
-                    LOG_I("Delete task %d: %s", selected_task_index, cmd);
-                }
-            }
+            submit_task_command("delete", selected_task_id());
             rt_mutex_release(ui_mutex);
         }
         break;
@@ -589,9 +1290,102 @@ static void btn_get_event_handler(lv_event_t *e)
         /* 松开时恢复颜色并执行操作 */
         lv_obj_set_style_bg_color(btn, lv_color_hex(0xFF9800), LV_PART_MAIN|LV_STATE_DEFAULT);
 
-        /* 发送get命令 */
+        /* 轮询时由同步调度发送get，不与正在等待的请求重叠；订阅推送时直接发送 */
         LOG_I("Manual GET button pressed");
-        send_command_to_esp32("get");
+        if (rt_mutex_take(ui_mutex, 100) == RT_EOK)
+        {
+            if (sync_polling)
+            {
+                sync_sched_trigger(&sync_sched, sync_now_ms());
+            }
+            else
+            {
+                submit_sync_command("get");
+            }
+            rt_mutex_release(ui_mutex);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+/* 切换视图并保持选中同一个任务（需持有ui_mutex） */
+static void switch_task_view(task_sort_t sort, const task_filter_t *filter)
+{
+    task_id_t id = selected_task_id();
+
+    task_sort = sort;
+    task_filter = *filter;
+    update_task_display();
+
+    selected_task_index = task_list_view_index_of(&task_list_view, id) + 1;
+    if (selected_task_index < 1)
+    {
+        selected_task_index = 1;
+    }
+    update_selected_index_display();
+    if (guider_ui.sort_label != NULL)
+    {
+        lv_label_set_text_fmt(guider_ui.sort_label, "SORT: %s", task_sort_name(task_sort));
+    }
+}
+
+/* 排序按钮事件处理：依次切换排序方式 */
+static void btn_sort_event_handler(lv_event_t *e)
+{
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_obj_t *btn = lv_event_get_target(e);
+
+    switch (code) {
+    case LV_EVENT_PRESSED:
+        /* 按下时变红 */
+        lv_obj_set_style_bg_color(btn, lv_color_hex(0xFF0000), LV_PART_MAIN|LV_STATE_DEFAULT);
+        break;
+
+    case LV_EVENT_RELEASED:
+        /* 松开时恢复颜色并执行操作 */
+        lv_obj_set_style_bg_color(btn, lv_color_hex(0x607D8B), LV_PART_MAIN|LV_STATE_DEFAULT);
+
+        /* 获取UI互斥锁 */
+        if (rt_mutex_take(ui_mutex, 100) == RT_EOK)
+        {
+            switch_task_view((task_sort_t)((task_sort + 1) % TASK_SORT_NUM), &task_filter);
+            rt_mutex_release(ui_mutex);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+/* 搜索框事件处理：输入时即时过滤，获得焦点时弹出键盘 */
+static void search_ta_event_handler(lv_event_t *e)
+{
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_obj_t *ta = lv_event_get_target(e);
+
+    switch (code) {
+    case LV_EVENT_FOCUSED:
+        lv_keyboard_set_textarea(guider_ui.keyboard, ta);
+        lv_obj_clear_flag(guider_ui.keyboard, LV_OBJ_FLAG_HIDDEN);
+        break;
+
+    case LV_EVENT_DEFOCUSED:
+    case LV_EVENT_READY:
+    case LV_EVENT_CANCEL:
+        lv_obj_add_flag(guider_ui.keyboard, LV_OBJ_FLAG_HIDDEN);
+        break;
+
+    case LV_EVENT_VALUE_CHANGED:
+        /* 在lv_task_handler中调用，已持有ui_mutex */
+        task_search_query(&task_search, &task_store, lv_textarea_get_text(ta));
+        selected_task_index = 1;
+        update_task_display();
+        update_selected_index_display();
+        lv_obj_scroll_to_y(guider_ui.task_list_cont, 0, LV_ANIM_OFF);
         break;
 
     default:
@@ -601,175 +1395,470 @@ static void btn_get_event_handler(lv_event_t *e)
 
 /* ==================== 串口通信函数 ==================== */
 
-/* 初始化ESP32串口通信 */
-static int esp32_uart_init(void)
+/* 注册可用的传输层，打开ESP32_LINK_NAME指定的一个 */
+static int esp32_link_init(void)
 {
-    /* 查找串口设备 */
-    esp32_uart_dev = rt_device_find(ESP32_UART_NAME);
-    if (esp32_uart_dev == RT_NULL)
+    link_serial_init(&esp32_uart_link, &esp32_uart_serial, "uart", ESP32_UART_NAME, ESP32_UART_BAUD);
+    link_serial_set_hw_flow(&esp32_uart_link, ESP32_UART_HW_FLOW);
+#ifdef RT_USB_DEVICE_CDC
+    link_cdc_init(&esp32_cdc_link, &esp32_cdc_serial, "cdc", ESP32_CDC_NAME);
+#endif
+#ifdef RT_USING_SPI
+    if (ESP32_SPI_HS_PIN >= 0)
+        link_spi_init(&esp32_spi_link, &esp32_spi, "spi", ESP32_SPI_DEVICE, ESP32_SPI_HS_PIN, ESP32_SPI_HZ);
+#endif
+
+    esp32_link = link_find(ESP32_LINK_NAME);
+    if (esp32_link == RT_NULL)
     {
-        LOG_E("Cannot find ESP32 UART device: %s", ESP32_UART_NAME);
+        LOG_E("Cannot find ESP32 link: %s", ESP32_LINK_NAME);
         return -1;
     }
 
-    /* 配置串口参数 */
-    struct serial_configure config = RT_SERIAL_CONFIG_DEFAULT;
-    config.baud_rate = ESP32_UART_BAUD;
-    config.data_bits = DATA_BITS_8;
-    config.stop_bits = STOP_BITS_1;
-    config.parity = PARITY_NONE;
-
-    rt_device_control(esp32_uart_dev, RT_DEVICE_CTRL_CONFIG, &config);
+    link_mux_init(&esp32_mux, esp32_mux_rx_callback, RT_NULL);
+    link_mux_chan_init(&esp32_mux, LINK_MUX_CH_CONTROL, 0, esp32_mux_tx_ctrl, sizeof(esp32_mux_tx_ctrl));
+    link_mux_chan_init(&esp32_mux, LINK_MUX_CH_BULK, 1, esp32_mux_tx_bulk, sizeof(esp32_mux_tx_bulk));
+    link_mux_chan_init(&esp32_mux, LINK_MUX_CH_DIAG, 2, esp32_mux_tx_diag, sizeof(esp32_mux_tx_diag));
 
-    /* 打开串口设备 */
-    if (rt_device_open(esp32_uart_dev, RT_DEVICE_FLAG_RDWR | RT_DEVICE_FLAG_INT_RX) != RT_EOK)
+    link_set_rx_callback(esp32_link, esp32_link_rx_callback, RT_NULL);
+    if (link_open(esp32_link) != RT_EOK)
     {
-        LOG_E("Failed to open ESP32 UART device");
+        esp32_link = RT_NULL;
         return -1;
     }
 
-    /* 设置接收回调函数 */
-    rt_device_set_rx_indicate(esp32_uart_dev, esp32_uart_rx_callback);
-
-    LOG_I("ESP32 UART initialized successfully");
-    LOG_I("UART Device: %s, Baud: %d", ESP32_UART_NAME, ESP32_UART_BAUD);
+    LOG_I("ESP32 link initialized successfully");
+    LOG_I("Link: %s, %d bit/s", esp32_link->name, esp32_link->bitrate);
     return 0;
 }
 
-/* 串口接收回调函数 - 处理数据包格式 */
-static rt_err_t esp32_uart_rx_callback(rt_device_t dev, rt_size_t size)
+/* 按数据包格式解析一个通道的数据（串口时在接收中断中调用） */
+static void esp32_framer_input(esp32_framer_t *f, const rt_uint8_t *data, rt_size_t len)
 {
     char ch;
+    rt_err_t err;
     static uart_msg_t msg;
 
-    while (rt_device_read(dev, -1, &ch, 1) == 1)
+    for (rt_size_t i = 0; i < len; i++)
     {
-        /* 检查缓冲区溢出 */
-        if (uart_rx_index >= UART_RX_BUFFER_SIZE - 1)
+        ch = (char)data[i];
+
+        /* 检查缓冲区溢出：数据包过长，丢弃这个包，之后从下一个包头开始 */
+        if (f->index >= f->size - 1)
         {
-            LOG_W("UART buffer overflow, resetting");
-            uart_rx_index = 0;
-            in_packet = false;
-            continue;
+            LOG_W("UART buffer overflow, dropping packet");
+            esp32_rx_stats.overflows++;
+            flow_credit_on_drop(&esp32_credit);
+            f->index = 0;
+            f->in_packet = false;
         }
 
-        uart_rx_buffer[uart_rx_index++] = ch;
-        uart_rx_buffer[uart_rx_index] = '\0';
+        f->buf[f->index++] = ch;
+        f->buf[f->index] = '\0';
 
         /* 检查包头 */
-        if (!in_packet)
+        if (!f->in_packet)
         {
             /* 查找包头 */
-            char *pkt_start = strstr(uart_rx_buffer, PKT_START);
+            char *pkt_start = strstr(f->buf, PKT_START);
             if (pkt_start != NULL)
             {
                 /* 找到包头，移动缓冲区内容 */
-                int offset = pkt_start - uart_rx_buffer;
+                int offset = pkt_start - f->buf;
                 if (offset > 0)
                 {
-                    memmove(uart_rx_buffer, pkt_start, uart_rx_index - offset + 1);
-                    uart_rx_index -= offset;
+                    memmove(f->buf, pkt_start, f->index - offset + 1);
+                    f->index -= offset;
                 }
-                in_packet = true;
+                f->in_packet = true;
+                f->packet_index = flow_credit_on_packet(&esp32_credit, sync_now_ms());
                 LOG_D("Packet start detected");
             }
             else
             {
-                /* 如果缓冲区太大但没有包头，清空部分缓冲区 */
-                if (uart_rx_index > 100)
+                /* 如果缓冲区太大但没有包头，清空缓冲区，保留可能是半个包头的结尾 */
+                if (f->index > 100)
+                {
+                    int keep = sizeof(PKT_START) - 2;
+
+                    /* 丢弃的数据中有损坏的包头时，可能有数据包没有被计数 */
+                    if (strstr(f->buf, "<PKT") != NULL)
+                    {
+                        flow_credit_on_error(&esp32_credit);
+                    }
+                    esp32_rx_stats.garbage += f->index - keep;
+                    memmove(f->buf, f->buf + f->index - keep, keep + 1);
+                    f->index = keep;
+                }
+            }
+        }
+
+        /* 检查包尾 */
+        if (f->in_packet)
+        {
+            char *pkt_end = strstr(f->buf, PKT_END);
+            if (pkt_end != NULL)
+            {
+                /* 找到完整的数据包 */
+                int pkt_len = pkt_end - f->buf + rt_strlen(PKT_END);
+
+                if (pkt_len >= UART_MSG_MAX_SIZE)
+                {
+                    LOG_W("Packet too long (len=%d), dropped", pkt_len);
+                    esp32_rx_stats.oversize++;
+                    flow_credit_on_drop(&esp32_credit);
+                }
+                else
+                {
+                    /* 复制数据包到消息 */
+                    rt_memcpy(msg.data, f->buf, pkt_len);
+                    msg.data[pkt_len] = '\0';
+                    msg.len = pkt_len;
+                    msg.index = f->packet_index;
+                    msg.injected = false;
+
+                    /* 发送到消息队列，ESP32遵守信用时不会满，控制通道的数据包优先处理 */
+                    err = f->urgent ? rt_mq_urgent(uart_msg_queue, &msg, sizeof(uart_msg_t))
+                                    : rt_mq_send(uart_msg_queue, &msg, sizeof(uart_msg_t));
+                    if (err != RT_EOK)
+                    {
+                        LOG_W("UART message queue full, packet dropped");
+                        esp32_rx_stats.queue_full++;
+                        flow_credit_on_drop(&esp32_credit);
+                    }
+                    LOG_D("Complete packet received (len=%d)", pkt_len);
+                }
+
+                /* 移除已处理的数据包 */
+                if (f->index > pkt_len)
                 {
-                    uart_rx_index = 0;
+                    memmove(f->buf, f->buf + pkt_len, f->index - pkt_len);
+                    f->index -= pkt_len;
+                    f->buf[f->index] = '\0';
+                }
+                else
+                {
+                    f->index = 0;
+                }
+
+                f->in_packet = false;
+
+                /* 确认通道复用后又收到原始数据包，ESP32已重启，重新协商 */
+                if (f == &esp32_raw_framer && esp32_mux_acked)
+                {
+                    esp32_mux_acked = false;
+                    esp32_mux_init_sent = false;
+                    esp32_mux_lost++;
                 }
             }
         }
+    }
+}
+
+/* 通道复用层解析出的数据，按通道交给各自的数据包解析 */
+static void esp32_mux_rx_callback(void *ctx, rt_uint8_t ch, const rt_uint8_t *data, rt_size_t len)
+{
+    esp32_framer_input((ch < LINK_MUX_CHANNELS) ? &esp32_framers[ch] : &esp32_raw_framer, data, len);
+}
+
+/* 传输层接收回调（串口时在接收中断中调用） */
+static void esp32_link_rx_callback(void *ctx, const rt_uint8_t *data, rt_size_t len)
+{
+    link_mux_input(&esp32_mux, data, len);
+}
+
+/* 发送命令到ESP32（可能阻塞，只在工作队列线程中调用） */
+static rt_err_t send_command_to_esp32(const char* command)
+{
+    if (esp32_link == RT_NULL)
+    {
+        LOG_E("ESP32 link not initialized");
+        return -RT_ERROR;
+    }
+
+    /* 发送命令，通道复用时写入控制通道后按帧发出。
+     * 命令没有完整写出时不发送结束符，避免ESP32执行被截断的命令 */
+    rt_size_t cmd_len = rt_strlen(command);
+    rt_size_t written;
+    if (esp32_mux_acked)
+    {
+        rt_uint8_t frame[LINK_MUX_FRAME_MAX];
+        rt_size_t len;
+
+        /* 整条命令连同结束符放得下才写入 */
+        if (link_mux_space(&esp32_mux, LINK_MUX_CH_CONTROL) < cmd_len + 2)
+        {
+            LOG_W("Command too long for control channel: %s", command);
+            return -RT_EFULL;
+        }
+        written = link_mux_write(&esp32_mux, LINK_MUX_CH_CONTROL, command, cmd_len);
+        link_mux_write(&esp32_mux, LINK_MUX_CH_CONTROL, "\r\n", 2);
+        while ((len = link_mux_next_frame(&esp32_mux, frame)) > 0)
+        {
+            if (link_write(esp32_link, frame, len) != len)
+            {
+                /* 剩下的部分不再发出，也不留给下一条命令 */
+                link_mux_discard(&esp32_mux, LINK_MUX_CH_CONTROL);
+                written = 0;
+                break;
+            }
+        }
+    }
+    else
+    {
+        written = link_write(esp32_link, command, cmd_len);
+        if (written == cmd_len && link_write(esp32_link, "\r\n", 2) != 2)
+        {
+            written = 0;
+        }
+    }
+
+    if (written != cmd_len)
+    {
+        LOG_W("Command to ESP32 not sent completely: %s (bytes written: %d/%d)", command, written, cmd_len);
+        return -RT_EIO;
+    }
+    LOG_I("Command sent to ESP32: %s", command);
+    return RT_EOK;
+}
+
+/* 工作队列中执行的发送函数 */
+static rt_err_t esp32_command_work(void *data)
+{
+    return send_command_to_esp32((const char *)data);
+}
+
+/* 命令发送完成回调，在UI线程中执行 */
+static void esp32_command_done(void *data, rt_err_t result)
+{
+    if (result != RT_EOK)
+    {
+        LOG_W("Command '%s' failed (%d)", (const char *)data, result);
+    }
+}
+
+/* 从UI事件中提交命令，由工作队列在后台发送 */
+static void submit_command_to_esp32(const char* command)
+{
+    rt_err_t err = ui_workq_submit(UI_WORKQ_PRIO_HIGH, esp32_command_work, esp32_command_done,
+                                   command, rt_strlen(command) + 1);
+    if (err != RT_EOK)
+    {
+        LOG_E("Failed to queue command '%s' (%d)", command, err);
+    }
+}
+
+/* 针对单个任务的命令，按(列表编号, 任务编号)关联，不依赖列表中的位置 */
+typedef struct {
+    int list_num;
+    int task_num;
+    char cmd[48];
+} esp32_task_command_t;
+
+static rt_err_t esp32_task_command_work(void *data)
+{
+    return send_command_to_esp32(((esp32_task_command_t *)data)->cmd);
+}
+
+/* 任务命令完成回调，在UI线程中执行（已持有ui_mutex）。
+ * 发送失败时撤销处理中标记，任务列表可能已重新加载，按编号查找 */
+static void esp32_task_command_done(void *data, rt_err_t result)
+{
+    esp32_task_command_t *command = (esp32_task_command_t *)data;
+    task_id_t id;
+
+    if (result == RT_EOK)
+        return;
+
+    LOG_W("Command '%s' failed (%d)", command->cmd, result);
+    id = task_store_find(&task_store, command->list_num, command->task_num);
+    if (id != TASK_ID_NONE && task_store_get(&task_store, id)->status == TASK_STATUS_PENDING)
+    {
+        task_store_set_status(&task_store, id, TASK_STATUS_OPEN);
+        update_task_display();
+    }
+}
+
+/* 对任务发送命令（verb为finish/delete），ESP32刷新前先标记为处理中（需持有ui_mutex） */
+static void submit_task_command(const char* verb, task_id_t id)
+{
+    const task_info_t *task = task_store_get(&task_store, id);
+    esp32_task_command_t command;
+    rt_err_t err;
+
+    if (task == NULL)
+        return;
+
+    command.list_num = task->list_num;
+    command.task_num = task->task_num;
+    rt_snprintf(command.cmd, sizeof(command.cmd), "%s %d.%d", verb, task->list_num, task->task_num);
+
+    err = ui_workq_submit(UI_WORKQ_PRIO_HIGH, esp32_task_command_work, esp32_task_command_done,
+                          &command, sizeof(command));
+    if (err != RT_EOK)
+    {
+        LOG_E("Failed to queue command '%s' (%d)", command.cmd, err);
+        return;
+    }
+    LOG_I("Task %d.%d: %s", command.list_num, command.task_num, command.cmd);
 
-        /* 检查包尾 */
-        if (in_packet)
-        {
-            char *pkt_end = strstr(uart_rx_buffer, PKT_END);
-            if (pkt_end != NULL)
-            {
-                /* 找到完整的数据包 */
-                int pkt_len = pkt_end - uart_rx_buffer + rt_strlen(PKT_END);
+    task_store_set_status(&task_store, id, TASK_STATUS_PENDING);
+    update_task_display();
 
-                /* 复制数据包到消息 */
-                rt_strncpy(msg.data, uart_rx_buffer, pkt_len);
-                msg.data[pkt_len] = '\0';
-                msg.len = pkt_len;
+    /* 命令执行后尽快同步，确认结果 */
+    sync_sched_on_activity(&sync_sched, sync_now_ms());
+}
 
-                /* 发送到消息队列 */
-                rt_mq_send(uart_msg_queue, &msg, sizeof(uart_msg_t));
-                LOG_D("Complete packet received (len=%d)", pkt_len);
+/* ==================== 后台同步 ==================== */
 
-                /* 移除已处理的数据包 */
-                if (uart_rx_index > pkt_len)
-                {
-                    memmove(uart_rx_buffer, uart_rx_buffer + pkt_len, uart_rx_index - pkt_len);
-                    uart_rx_index -= pkt_len;
-                    uart_rx_buffer[uart_rx_index] = '\0';
-                }
-                else
-                {
-                    uart_rx_index = 0;
-                }
+static rt_uint32_t sync_now_ms(void)
+{
+    return rt_tick_get_millisecond();
+}
 
-                in_packet = false;
-            }
-        }
+/* 正在接收或处理数据包，或者有命令等待发送 */
+static bool esp32_link_busy(void)
+{
+    ui_workq_stats_t stats;
+
+    ui_workq_get_stats(&stats);
+    bool receiving = esp32_raw_framer.in_packet;
+
+    for (int i = 0; i < LINK_MUX_CHANNELS; i++)
+        receiving = receiving || esp32_framers[i].in_packet;
+    return receiving || esp32_packet_busy || stats.pending > 0;
+}
+
+/* 同步命令：get或subscribe */
+static rt_err_t sync_command_work(void *data)
+{
+    return send_command_to_esp32((const char *)data);
+}
+
+/* 在UI线程中执行（已持有ui_mutex） */
+static void sync_command_done(void *data, rt_err_t result)
+{
+    if (result == RT_EOK)
+        return;
+
+    LOG_W("Sync command '%s' failed (%d)", (const char *)data, result);
+    if (rt_strcmp((const char *)data, "subscribe") == 0)
+    {
+        task_push_reset(&task_push, sync_now_ms());
     }
+    else
+    {
+        sync_sched_on_error(&sync_sched, sync_now_ms());
+    }
+}
 
-    return RT_EOK;
+static void submit_sync_command(const char* command)
+{
+    if (ui_workq_submit(UI_WORKQ_PRIO_NORMAL, sync_command_work, sync_command_done,
+                        command, rt_strlen(command) + 1) != RT_EOK)
+    {
+        sync_command_done((void *)command, -RT_EFULL);
+    }
 }
 
-/* 发送命令到ESP32 */
-static void send_command_to_esp32(const char* command)
+/* 在lv_task_handler中调用（已持有ui_mutex） */
+static void sync_timer_cb(lv_timer_t *timer)
 {
-    if (esp32_uart_dev == RT_NULL)
+    rt_uint32_t now = sync_now_ms();
+    bool busy = esp32_link_busy();
+    bool polling;
+
+    if (task_push_poll(&task_push, now, busy))
     {
-        LOG_E("ESP32 UART not initialized");
+        LOG_I("Subscribing to task pushes");
+        submit_sync_command("subscribe");
         return;
     }
 
-    /* 发送命令 */
-    rt_size_t cmd_len = rt_strlen(command);
-    rt_size_t written = rt_device_write(esp32_uart_dev, 0, command, cmd_len);
-    rt_device_write(esp32_uart_dev, 0, "\r\n", 2);
+    /* 订阅期间和订阅成功后不轮询，订阅失败时恢复轮询 */
+    polling = (task_push.state == TASK_PUSH_IDLE);
+    if (polling != sync_polling)
+    {
+        sync_polling = polling;
+        sync_sched_enable(&sync_sched, polling, now);
+    }
 
-    LOG_I("Command sent to ESP32: %s (bytes written: %d/%d)", command, written, cmd_len);
+    if (!sync_sched_poll(&sync_sched, now, busy))
+        return;
+
+    LOG_D("Sync poll (interval %d ms)", sync_sched.interval_ms);
+    submit_sync_command("get");
 }
 
 /* ==================== UI创建函数 ==================== */
 
+#define CONTROL_PANEL_W             220     /* 横屏时右侧控制面板的宽度 */
+#define CONTROL_PANEL_PORTRAIT_H    200     /* 竖屏时下方控制面板的高度 */
+
 /* 创建UI界面 */
 static void setup_scr_screen(lv_ui *ui)
 {
+    /* 按显示方向布局：横屏时控制面板在右侧，竖屏时在下方，按钮自动换行 */
+    lv_coord_t scr_w = lv_disp_get_hor_res(NULL);
+    lv_coord_t scr_h = lv_disp_get_ver_res(NULL);
+    bool portrait = scr_h > scr_w;
+    lv_coord_t panel_w = portrait ? scr_w - 20 : CONTROL_PANEL_W;
+    lv_coord_t panel_h = portrait ? CONTROL_PANEL_PORTRAIT_H : scr_h - 20;
+    lv_coord_t list_w = portrait ? scr_w - 20 : scr_w - panel_w - 30;
+    lv_coord_t list_h = portrait ? scr_h - panel_h - 75 : scr_h - 65;
+
     /* 创建主屏幕 */
     ui->screen = lv_obj_create(NULL);
-    lv_obj_set_size(ui->screen, 800, 480);
+    lv_obj_set_size(ui->screen, scr_w, scr_h);
     lv_obj_set_style_bg_color(ui->screen, lv_color_hex(0xf0f0f0), LV_PART_MAIN|LV_STATE_DEFAULT);
 
+    /* 创建搜索框 */
+    ui->search_ta = lv_textarea_create(ui->screen);
+    lv_obj_set_pos(ui->search_ta, 10, 10);
+    lv_obj_set_size(ui->search_ta, list_w, 40);
+    lv_textarea_set_one_line(ui->search_ta, true);
+    lv_textarea_set_max_length(ui->search_ta, TASK_SEARCH_QUERY_SIZE - 1);
+    lv_textarea_set_placeholder_text(ui->search_ta, "Search tasks");
+    lv_obj_set_style_text_font(ui->search_ta, &lv_font_montserratMedium_16, LV_PART_MAIN|LV_STATE_DEFAULT);
+    lv_obj_add_event_cb(ui->search_ta, search_ta_event_handler, LV_EVENT_ALL, NULL);
+
     /* 创建左侧任务列表容器 */
     ui->task_list_cont = lv_obj_create(ui->screen);
-    lv_obj_set_pos(ui->task_list_cont, 10, 10);
-    lv_obj_set_size(ui->task_list_cont, 550, 460);
+    lv_obj_set_pos(ui->task_list_cont, 10, 55);
+    lv_obj_set_size(ui->task_list_cont, list_w, list_h);
     lv_obj_set_style_bg_color(ui->task_list_cont, lv_color_hex(0xffffff), LV_PART_MAIN|LV_STATE_DEFAULT);
     lv_obj_set_style_border_width(ui->task_list_cont, 2, LV_PART_MAIN|LV_STATE_DEFAULT);
     lv_obj_set_style_border_color(ui->task_list_cont, lv_color_hex(0x2195f6), LV_PART_MAIN|LV_STATE_DEFAULT);
     lv_obj_set_style_radius(ui->task_list_cont, 5, LV_PART_MAIN|LV_STATE_DEFAULT);
     lv_obj_set_style_pad_all(ui->task_list_cont, 10, LV_PART_MAIN|LV_STATE_DEFAULT);
-
-    /* 创建任务显示标签 */
-    ui->task_label = lv_label_create(ui->task_list_cont);
-    lv_label_set_text(ui->task_label, "No tasks loaded\nPress GET to load tasks");
-    lv_obj_set_pos(ui->task_label, 0, 0);
-    lv_obj_set_size(ui->task_label, 530, 440);
-    lv_obj_set_style_text_font(ui->task_label, &lv_font_montserratMedium_12, LV_PART_MAIN|LV_STATE_DEFAULT);
-    lv_label_set_long_mode(ui->task_label, LV_LABEL_LONG_WRAP);
+    /* 惯性滚动由手势引擎处理 */
+    lv_obj_clear_flag(ui->task_list_cont, LV_OBJ_FLAG_SCROLL_MOMENTUM);
+    touch_gesture_set_callback(lv_port_indev_get_gesture(), task_list_gesture_cb, NULL);
+    touch_multi_set_callback(lv_port_indev_get_multi(), task_list_multi_touch_cb, NULL);
+    kinetic_timer = lv_timer_create(task_list_kinetic_timer_cb, LV_DISP_DEF_REFR_PERIOD, NULL);
+    lv_obj_add_event_cb(ui->task_list_cont, task_list_key_event_handler, LV_EVENT_KEY, NULL);
+
+    /* 创建分组任务列表，行对象在显示任务时按需创建 */
+    if (task_list_view_init(&task_list_view, ui->task_list_cont, MAX_TASK_COUNT) != RT_EOK)
+    {
+        LOG_E("Failed to create task list view");
+    }
+    task_list_view_set_callback(&task_list_view, task_list_view_event_cb, NULL);
 
     /* 创建右侧控制面板 */
     ui->control_panel = lv_obj_create(ui->screen);
-    lv_obj_set_pos(ui->control_panel, 570, 10);
-    lv_obj_set_size(ui->control_panel, 220, 460);
+    if (portrait)
+    {
+        lv_obj_set_pos(ui->control_panel, 10, scr_h - panel_h - 10);
+        lv_obj_set_flex_flow(ui->control_panel, LV_FLEX_FLOW_ROW_WRAP);
+        lv_obj_set_flex_align(ui->control_panel, LV_FLEX_ALIGN_SPACE_EVENLY, LV_FLEX_ALIGN_CENTER,
+                              LV_FLEX_ALIGN_SPACE_EVENLY);
+    }
+    else
+    {
+        lv_obj_set_pos(ui->control_panel, scr_w - panel_w - 10, 10);
+    }
+    lv_obj_set_size(ui->control_panel, panel_w, panel_h);
     lv_obj_set_style_bg_color(ui->control_panel, lv_color_hex(0xffffff), LV_PART_MAIN|LV_STATE_DEFAULT);
     lv_obj_set_style_border_width(ui->control_panel, 2, LV_PART_MAIN|LV_STATE_DEFAULT);
     lv_obj_set_style_border_color(ui->control_panel, lv_color_hex(0x2195f6), LV_PART_MAIN|LV_STATE_DEFAULT);
@@ -852,9 +1941,87 @@ static void setup_scr_screen(lv_ui *ui)
     lv_obj_set_style_text_font(delete_label, &lv_font_montserratMedium_16, LV_PART_MAIN|LV_STATE_DEFAULT);
     lv_obj_add_event_cb(ui->btn_delete, btn_delete_event_handler, LV_EVENT_ALL, NULL);
 
+    /* 创建排序按钮 */
+    ui->btn_sort = lv_btn_create(ui->control_panel);
+    lv_obj_set_pos(ui->btn_sort, 30, 385);
+    lv_obj_set_size(ui->btn_sort, 140, 40);
+    lv_obj_set_style_bg_color(ui->btn_sort, lv_color_hex(0x607D8B), LV_PART_MAIN|LV_STATE_DEFAULT);
+    ui->sort_label = lv_label_create(ui->btn_sort);
+    lv_label_set_text_fmt(ui->sort_label, "SORT: %s", task_sort_name(task_sort));
+    lv_obj_center(ui->sort_label);
+    lv_obj_set_style_text_color(ui->sort_label, lv_color_hex(0xffffff), LV_PART_MAIN|LV_STATE_DEFAULT);
+    lv_obj_add_event_cb(ui->btn_sort, btn_sort_event_handler, LV_EVENT_ALL, NULL);
+
+    update_task_display();
+
+    /* 创建屏幕键盘，搜索框获得焦点时显示 */
+    ui->keyboard = lv_keyboard_create(ui->screen);
+    lv_obj_set_size(ui->keyboard, scr_w, 220);
+    lv_obj_align(ui->keyboard, LV_ALIGN_BOTTOM_MID, 0, 0);
+    lv_obj_add_flag(ui->keyboard, LV_OBJ_FLAG_HIDDEN);
+
+    /* 按键和编码器的焦点顺序：任务列表，然后从上到下的按钮。
+     * 编码器在任务列表上按下进入编辑模式，旋转即移动选中项 */
+    input_group = lv_group_create();
+    lv_group_set_wrap(input_group, true);
+    lv_group_add_obj(input_group, ui->task_list_cont);
+    lv_group_add_obj(input_group, ui->btn_get);
+    lv_group_add_obj(input_group, ui->btn_up);
+    lv_group_add_obj(input_group, ui->btn_down);
+    lv_group_add_obj(input_group, ui->btn_finish);
+    lv_group_add_obj(input_group, ui->btn_delete);
+    lv_group_add_obj(input_group, ui->btn_sort);
+    lv_port_indev_set_group(input_group);
+
     LOG_I("UI setup completed with GET button");
 }
 
+/* 叠加层上的状态栏：链路状态、是否忙和帧时间，更新时不重绘主屏幕 */
+#define STATUS_TIMER_PERIOD_MS  500
+static lv_obj_t *status_label = NULL;
+
+/* 在lv_task_handler中调用（已持有ui_mutex） */
+static void status_timer_cb(lv_timer_t *timer)
+{
+    app_frame_stats_t stats;
+    char text[64];
+
+    app_perf_get_frame_stats(&stats);
+    rt_snprintf(text, sizeof(text), "%s%s%s %s %d.%d ms",
+                esp32_link ? esp32_link->name : "no link",
+                esp32_mux_acked ? " mux" : "",
+                esp32_credit.acked ? " credit" : "",
+                esp32_link_busy() ? LV_SYMBOL_REFRESH : LV_SYMBOL_OK,
+                stats.avg_us / 1000, stats.avg_us / 100 % 10);
+
+    /* 内容不变时不重绘叠加层 */
+    if (rt_strcmp(lv_label_get_text(status_label), text) != 0)
+        lv_label_set_text(status_label, text);
+}
+
+/* 叠加层的屏幕是透明色，标签使用不透明背景且不使用圆角，避免抗锯齿边缘混入透明色 */
+static void status_overlay_init(void)
+{
+    lv_disp_t *overlay = lv_port_disp_get_overlay();
+    lv_obj_t *scr;
+
+    if (overlay == NULL)
+        return;
+
+    scr = lv_disp_get_scr_act(overlay);
+    status_label = lv_label_create(scr);
+    lv_obj_set_size(status_label, lv_disp_get_hor_res(overlay), lv_disp_get_ver_res(overlay));
+    lv_obj_set_style_bg_color(status_label, lv_color_hex(0x303030), 0);
+    lv_obj_set_style_bg_opa(status_label, LV_OPA_COVER, 0);
+    lv_obj_set_style_radius(status_label, 0, 0);
+    lv_obj_set_style_pad_all(status_label, 6, 0);
+    lv_obj_set_style_text_color(status_label, lv_color_hex(0xFFFFFF), 0);
+    lv_label_set_text(status_label, "");
+    lv_timer_create(status_timer_cb, STATUS_TIMER_PERIOD_MS, NULL);
+
+    LOG_I("Status overlay: %s", lv_port_disp_overlay_is_soft() ? "software" : "LTDC layer 2");
+}
+
 /* ==================== 主线程函数 ==================== */
 
 /* LVGL线程入口函数 */
@@ -868,7 +2035,8 @@ static void lvgl_thread_entry(void *parameter)
         return;
     }
 
-    /* 创建UART消息队列 */
+    /* 创建UART消息队列，每一项对应一个接收信用 */
+    flow_credit_init(&esp32_credit, ESP32_CREDIT_WINDOW);
     uart_msg_queue = rt_mq_create("uart_mq", sizeof(uart_msg_t), UART_MSG_QUEUE_SIZE, RT_IPC_FLAG_FIFO);
     if (uart_msg_queue == RT_NULL)
     {
@@ -891,22 +2059,50 @@ static void lvgl_thread_entry(void *parameter)
     }
     rt_thread_startup(&uart_msg_thread);
 
-    /* 初始化ESP32串口通信 */
-    if (esp32_uart_init() != 0)
+    /* 初始化性能计时 */
+    app_perf_init();
+
+    /* 启动自适应触摸采样，失败时在主循环中轮询 */
+    if (touch_sampler_init() != RT_EOK)
     {
-        LOG_W("ESP32 UART communication failed");
+        LOG_W("Touch sampler unavailable, scanning in LVGL loop");
+    }
+
+    /* 启动后台工作队列 */
+    if (ui_workq_init() != RT_EOK)
+    {
+        LOG_E("Failed to start UI work queue");
+        return;
+    }
+
+    /* 初始化任务存储和搜索索引，在UART线程收到任务列表之前 */
+    staging_task_array = rt_malloc(MAX_TASK_COUNT * sizeof(task_info_t));
+    visible_ids = rt_malloc(MAX_TASK_COUNT * sizeof(task_id_t));
+    if (staging_task_array == RT_NULL || visible_ids == RT_NULL ||
+        task_store_init(&task_store, MAX_TASK_COUNT) != RT_EOK ||
+        task_diff_init(&task_diff, MAX_TASK_COUNT) != RT_EOK ||
+        task_search_init(&task_search, MAX_TASK_COUNT, SEARCH_MAX_POSTINGS) != RT_EOK)
+    {
+        LOG_E("Failed to create task store (%d tasks)", MAX_TASK_COUNT);
+        return;
     }
 
-    /* 初始化任务信息数组 */
-    for (int i = 0; i < MAX_TASK_COUNT; i++)
+    /* 初始化ESP32串口通信 */
+    if (esp32_link_init() != 0)
     {
-        rt_memset(&task_info_array[i], 0, sizeof(task_info_t));
-        task_info_array[i].is_valid = false;
+        LOG_W("ESP32 UART communication failed");
     }
+    task_store_set_listener(&task_store, task_search_on_change, &task_search);
+    sync_sched_init(&sync_sched, SYNC_SCHED_MIN_MS, SYNC_SCHED_MAX_MS, SYNC_SCHED_TIMEOUT_MS, sync_now_ms());
+    task_push_init(&task_push, TASK_PUSH_TIMEOUT_MS, TASK_PUSH_RETRY_MS, sync_now_ms());
+    sync_timer = lv_timer_create(sync_timer_cb, SYNC_TIMER_PERIOD_MS, NULL);
 
     /* 创建UI */
     setup_scr_screen(&guider_ui);
     lv_scr_load(guider_ui.screen);
+    status_overlay_init();
+    ui_quality_init(&ui_quality, LV_DISP_DEF_REFR_PERIOD * 1000);
+    ui_quality_attach(&ui_quality, lv_disp_get_default());
 
     LOG_I("LVGL application started!");
     LOG_I("Using manual GET button for task loading");
@@ -915,15 +2111,33 @@ static void lvgl_thread_entry(void *parameter)
     /* LVGL主循环 */
     while (1)
     {
+        bool beam = false;
+
         /* 获取UI互斥锁 */
         if (rt_mutex_take(ui_mutex, 10) == RT_EOK)
         {
-            Touch_Scan();
+            /* 条带显示模式没有帧缓冲，每帧重绘整个屏幕 */
+            beam = lv_port_disp_beam_frame();
+            app_perf_frame_begin();
+            if (!touch_sampler_is_running())
+            {
+                Touch_Scan();
+            }
             lv_task_handler();
+            ui_workq_dispatch();
+            app_perf_frame_end();
+            if (ui_quality_frame(&ui_quality, app_perf_last_frame_us(), sync_now_ms()))
+            {
+                ui_quality_apply(&ui_quality);
+            }
             rt_mutex_release(ui_mutex);
         }
 
-        rt_thread_mdelay(LV_DISP_DEF_REFR_PERIOD);
+        /* 条带显示模式下刷新时等待扫描，不再延时 */
+        if (!beam)
+        {
+            rt_thread_mdelay(LV_DISP_DEF_REFR_PERIOD);
+        }
     }
 }
 
@@ -952,3 +2166,568 @@ static int lvgl_thread_init(void)
 }
 
 INIT_APP_EXPORT(lvgl_thread_init);
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+/* 设置任务列表的排序方式和过滤条件 */
+static void task_view_cmd(int argc, char **argv)
+{
+    task_sort_t sort = task_sort;
+    task_filter_t filter = task_filter;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (rt_strcmp(argv[i], "sort") == 0 && i + 1 < argc)
+        {
+            i++;
+            for (int k = 0; k < TASK_SORT_NUM; k++)
+            {
+                if (rt_strcmp(argv[i], task_sort_name((task_sort_t)k)) == 0)
+                    sort = (task_sort_t)k;
+            }
+        }
+        else if (rt_strcmp(argv[i], "all") == 0)
+        {
+            filter.status_mask = TASK_FILTER_ANY_STATUS;
+            filter.list_num = 0;
+        }
+        else if (rt_strcmp(argv[i], "open") == 0)
+            filter.status_mask = 1 << TASK_STATUS_OPEN;
+        else if (rt_strcmp(argv[i], "pending") == 0)
+            filter.status_mask = 1 << TASK_STATUS_PENDING;
+        else if (rt_strcmp(argv[i], "list") == 0 && i + 1 < argc)
+            filter.list_num = atoi(argv[++i]);
+        else
+        {
+            rt_kprintf("usage: task_view [sort order|list|title|status] [all|open|pending] [list N]\n");
+            return;
+        }
+    }
+
+    if (ui_mutex == RT_NULL || rt_mutex_take(ui_mutex, RT_WAITING_FOREVER) != RT_EOK)
+        return;
+    switch_task_view(sort, &filter);
+    rt_kprintf("sort: %s, status mask: 0x%02x, list: %d, %d of %d tasks\n",
+               task_sort_name(task_sort), task_filter.status_mask, task_filter.list_num,
+               current_task_count, task_store_count(&task_store));
+    rt_kprintf("views: %d hits, %d builds, %d inserts, %d removes\n",
+               task_store.stats.view_hits, task_store.stats.view_builds,
+               task_store.stats.view_inserts, task_store.stats.view_removes);
+    rt_mutex_release(ui_mutex);
+}
+MSH_CMD_EXPORT_ALIAS(task_view_cmd, task_view, set task list sort and filter);
+
+/* 统计对象树中的对象数 */
+static rt_uint32_t count_objects(lv_obj_t *obj)
+{
+    rt_uint32_t n = 1;
+
+    for (rt_uint32_t i = 0; i < lv_obj_get_child_cnt(obj); i++)
+    {
+        n += count_objects(lv_obj_get_child(obj, i));
+    }
+    return n;
+}
+
+/* 折叠/展开全部分组，并显示对象数和折叠/展开以来的帧时间 */
+static void task_groups_cmd(int argc, char **argv)
+{
+    app_frame_stats_t stats;
+
+    if (ui_mutex == RT_NULL || guider_ui.screen == NULL ||
+        rt_mutex_take(ui_mutex, RT_WAITING_FOREVER) != RT_EOK)
+        return;
+
+    if (argc > 1 && (rt_strcmp(argv[1], "collapse") == 0 || rt_strcmp(argv[1], "expand") == 0))
+    {
+        task_list_view_set_all_collapsed(&task_list_view, rt_strcmp(argv[1], "collapse") == 0);
+        app_perf_reset_frame_stats();
+    }
+
+    app_perf_get_frame_stats(&stats);
+    rt_kprintf("groups: %d, rows: %d lines, %d selectable\n",
+               task_list_view.group_count, task_list_view.line_count, task_list_view.selectable_count);
+    rt_kprintf("objects: %d in task list, %d on screen\n",
+               task_list_view_object_count(&task_list_view), count_objects(guider_ui.screen));
+    rt_kprintf("frames: %d, avg %d us, max %d us\n", stats.frames, stats.avg_us, stats.max_us);
+    rt_mutex_release(ui_mutex);
+}
+MSH_CMD_EXPORT_ALIAS(task_groups_cmd, task_groups, collapse or expand task groups and show cost [collapse|expand]);
+
+/* 显示或设置绘制质量调节，参数为级别0-3时固定级别 */
+static void ui_quality_cmd(int argc, char **argv)
+{
+    ui_quality_stats_t *st = &ui_quality.stats;
+
+    if (ui_mutex == RT_NULL || rt_mutex_take(ui_mutex, RT_WAITING_FOREVER) != RT_EOK)
+        return;
+
+    if (argc > 1 && rt_strcmp(argv[1], "reset") == 0)
+        rt_memset(st, 0, sizeof(ui_quality_stats_t));
+    else if (argc > 1 && ui_quality_lock(&ui_quality, rt_strcmp(argv[1], "auto") == 0 ? -1 : atoi(argv[1])))
+        ui_quality_apply(&ui_quality);
+
+    rt_kprintf("quality: %s (%s), budget %d us, avg frame %d us\n", ui_quality_level_name(ui_quality.level),
+               ui_quality.locked < 0 ? "auto" : "fixed", ui_quality.budget_us, ui_quality.avg_us);
+    rt_kprintf("degrades %d, upgrades %d (failed %d), restores %d, simplified rects %d\n",
+               st->degrades, st->upgrades, st->upgrade_failures, st->restores, st->simplified);
+    for (int i = 0; i < UI_QUALITY_LEVELS; i++)
+        rt_kprintf("  %-10s frames %d, over budget %d\n", ui_quality_level_name(i), st->frames[i], st->over_budget[i]);
+    rt_mutex_release(ui_mutex);
+}
+MSH_CMD_EXPORT_ALIAS(ui_quality_cmd, ui_quality, show render quality governor [auto|0-3|reset]);
+
+/* 启用/停止后台同步，显示当前间隔和统计 */
+static void sync_cmd(int argc, char **argv)
+{
+    rt_uint32_t now;
+
+    if (ui_mutex == RT_NULL || rt_mutex_take(ui_mutex, RT_WAITING_FOREVER) != RT_EOK)
+        return;
+
+    now = sync_now_ms();
+    if (argc > 1 && rt_strcmp(argv[1], "on") == 0)
+        sync_sched_enable(&sync_sched, true, now);
+    else if (argc > 1 && rt_strcmp(argv[1], "off") == 0)
+        sync_sched_enable(&sync_sched, false, now);
+    else if (argc > 1 && rt_strcmp(argv[1], "now") == 0)
+        sync_sched_trigger(&sync_sched, now);
+
+    rt_kprintf("sync: %s, interval %d ms, next in %d ms%s\n",
+               sync_sched.enabled ? "on" : "off", sync_sched.interval_ms,
+               sync_sched_delay(&sync_sched, now), sync_sched.in_flight ? ", waiting for reply" : "");
+    rt_kprintf("polls: %d, changes: %d, unchanged: %d, timeouts: %d, busy: %d\n",
+               sync_sched.stats.polls, sync_sched.stats.changes, sync_sched.stats.unchanged,
+               sync_sched.stats.timeouts, sync_sched.stats.busy_defers);
+    rt_mutex_release(ui_mutex);
+}
+MSH_CMD_EXPORT_ALIAS(sync_cmd, task_sync, background task sync [on|off|now]);
+
+static void esp32_flow_cmd(int argc, char **argv)
+{
+    flow_credit_stats_t *stats = &esp32_credit.stats;
+
+    rt_kprintf("credit: %s, window %d, in use %d (peak %d), limit %d\n",
+               esp32_credit.acked ? "on" : "waiting for ESP32", esp32_credit.window,
+               flow_credit_in_use(&esp32_credit), stats->peak_in_use, esp32_credit.advertised);
+    rt_kprintf("packets %d, adverts %d, stalls %d, overruns %d, resyncs %d\n",
+               stats->packets, stats->adverts, stats->stalls, stats->overruns, stats->resyncs);
+    rt_kprintf("dropped %d: queue full %d, overflow %d, oversize %d; garbage %d bytes\n",
+               stats->dropped, esp32_rx_stats.queue_full, esp32_rx_stats.overflows,
+               esp32_rx_stats.oversize, esp32_rx_stats.garbage);
+}
+MSH_CMD_EXPORT_ALIAS(esp32_flow_cmd, esp32_flow, show ESP32 receive flow control);
+
+static void esp32_mux_cmd(int argc, char **argv)
+{
+    static const char *names[LINK_MUX_CHANNELS] = {"control", "bulk", "diag"};
+
+    rt_kprintf("mux: %s, lost %d, crc errors %d, raw %d bytes\n",
+               esp32_mux_acked ? "on" : (esp32_mux_init_sent ? "waiting for ESP32" : "off"),
+               esp32_mux_lost, esp32_mux.rx_crc_errors, esp32_mux.rx_raw_bytes);
+    rt_kprintf("channel  tx bytes  tx frames  tx full  rx bytes  rx frames\n");
+    for (int i = 0; i < LINK_MUX_CHANNELS; i++)
+    {
+        link_mux_chan_stats_t *st = &esp32_mux.chan[i].stats;
+
+        rt_kprintf("%-7s  %8d  %9d  %7d  %8d  %9d\n", names[i], st->tx_bytes, st->tx_frames,
+                   st->tx_full, st->rx_bytes, st->rx_frames);
+    }
+}
+MSH_CMD_EXPORT_ALIAS(esp32_mux_cmd, esp32_mux, show ESP32 link channel statistics);
+
+/* 移动状态栏叠加层并设置不透明度 */
+static void overlay_cmd(int argc, char **argv)
+{
+    lv_disp_t *overlay = lv_port_disp_get_overlay();
+
+    if (ui_mutex == RT_NULL || overlay == NULL || rt_mutex_take(ui_mutex, RT_WAITING_FOREVER) != RT_EOK)
+        return;
+
+    if (argc > 2)
+        lv_port_disp_set_overlay(atoi(argv[1]), atoi(argv[2]), argc > 3 ? atoi(argv[3]) : LV_OPA_COVER);
+    rt_kprintf("overlay: %dx%d, %s\n", lv_disp_get_hor_res(overlay), lv_disp_get_ver_res(overlay),
+               lv_port_disp_overlay_is_soft() ? "software composited" : "LTDC layer 2");
+    rt_mutex_release(ui_mutex);
+}
+MSH_CMD_EXPORT_ALIAS(overlay_cmd, overlay, move status overlay [x y [opa]]);
+
+#ifdef APP_USING_TEST
+#include "app_test.h"
+
+/* 重新提交最近一次收到的任务列表，统计重绘的行数和无效区域像素数。
+ * edit时先修改第一个任务的标题，模拟只有一个任务变化的刷新 */
+static void task_refresh_bench_cmd(int argc, char **argv)
+{
+    lv_disp_t *disp = lv_disp_get_default();
+    rt_uint32_t rows, pixels = 0, t0, us;
+    rt_uint16_t inv_p;
+
+    if (ui_mutex == RT_NULL || guider_ui.screen == NULL || disp == NULL ||
+        rt_mutex_take(ui_mutex, RT_WAITING_FOREVER) != RT_EOK)
+        return;
+
+    if (argc > 1 && rt_strcmp(argv[1], "edit") == 0 && staging_task_count > 0)
+    {
+        char *title = staging_task_array[0].title;
+        rt_size_t len = rt_strlen(title);
+
+        if (len > 0 && title[len - 1] == '*')
+            title[len - 1] = '\0';
+        else if (len + 1 < TASK_TITLE_SIZE)
+            rt_strcpy(title + len, "*");
+    }
+
+    rows = task_list_view.redraw_rows;
+    inv_p = disp->inv_p;
+    t0 = app_perf_now_cycles();
+    commit_staged_tasks();
+    us = app_perf_elapsed_us(t0);
+
+    /* 本次提交新增的无效区域（合并前） */
+    for (rt_uint16_t i = inv_p; i < disp->inv_p; i++)
+    {
+        pixels += lv_area_get_size(&disp->inv_areas[i]);
+    }
+
+    rt_kprintf("tasks: %d, commit: %d us\n", staging_task_count, us);
+    rt_kprintf("redrawn rows: %d, invalidated areas: %d, pixels: %d\n",
+               task_list_view.redraw_rows - rows, disp->inv_p - inv_p, pixels);
+    rt_mutex_release(ui_mutex);
+}
+MSH_CMD_EXPORT_ALIAS(task_refresh_bench_cmd, task_refresh_bench, measure redraw cost of a task list refresh [edit]);
+
+/* 滚动测量结果，time_ms按主循环的节奏计算（一帧至少一个刷新周期） */
+typedef struct {
+    rt_uint32_t frames;
+    rt_uint32_t over;
+    rt_uint32_t total_us;
+    rt_uint32_t max_us;
+    rt_uint32_t time_ms;
+    rt_uint32_t levels[UI_QUALITY_LEVELS];
+    rt_uint32_t restore_ms;     /* 停止滚动后恢复完整质量用的时间 */
+} quality_bench_t;
+
+static void quality_bench_run(lv_disp_t *disp, lv_obj_t *cont, int frames, int step, quality_bench_t *r)
+{
+    rt_uint32_t budget = LV_DISP_DEF_REFR_PERIOD * 1000;
+    rt_uint32_t t0, us, idle_start;
+    int dir = 1;
+
+    rt_memset(r, 0, sizeof(quality_bench_t));
+    lv_obj_scroll_to_y(cont, 0, LV_ANIM_OFF);
+    lv_refr_now(disp);
+
+    for (int i = 0; i < frames; i++)
+    {
+        if (dir > 0 && lv_obj_get_scroll_bottom(cont) <= 0)
+            dir = -1;
+        else if (dir < 0 && lv_obj_get_scroll_y(cont) <= 0)
+            dir = 1;
+        lv_obj_scroll_by(cont, 0, (lv_coord_t)(-dir * step), LV_ANIM_OFF);
+
+        t0 = app_perf_now_cycles();
+        lv_refr_now(disp);
+        us = app_perf_elapsed_us(t0);
+
+        r->frames++;
+        r->total_us += us;
+        r->levels[ui_quality.level]++;
+        if (us > r->max_us)
+            r->max_us = us;
+        if (us > budget)
+            r->over++;
+        r->time_ms += (us > budget) ? us / 1000 : LV_DISP_DEF_REFR_PERIOD;
+        if (ui_quality_frame(&ui_quality, us, sync_now_ms()))
+            ui_quality_apply(&ui_quality);
+    }
+
+    /* 停止滚动，按主循环的节奏空闲，直到恢复完整质量 */
+    idle_start = sync_now_ms();
+    while (ui_quality.level != UI_QUALITY_FULL && sync_now_ms() - idle_start < UI_QUALITY_RESTORE_MS * 2)
+    {
+        rt_thread_mdelay(LV_DISP_DEF_REFR_PERIOD);
+        t0 = app_perf_now_cycles();
+        lv_refr_now(disp);
+        if (ui_quality_frame(&ui_quality, app_perf_elapsed_us(t0), sync_now_ms()))
+            ui_quality_apply(&ui_quality);
+    }
+    r->restore_ms = sync_now_ms() - idle_start;
+    lv_refr_now(disp);
+}
+
+static void quality_bench_print(const char *name, const quality_bench_t *r)
+{
+    rt_kprintf("%-8s %6d %5d %7d %7d %4d ", name, r->frames, r->over,
+               r->frames ? r->total_us / r->frames : 0, r->max_us,
+               r->time_ms ? r->frames * 1000 / r->time_ms : 0);
+    for (int i = 0; i < UI_QUALITY_LEVELS; i++)
+        rt_kprintf("%s%d", i ? "/" : "", r->levels[i]);
+    rt_kprintf("\n");
+}
+
+/* 不需要触摸输入的滚动测量：给任务行加上阴影、圆角和半透明边框，
+ * 每帧滚动step像素并立即刷新，先固定完整质量再自动调节，对比帧时间 */
+static void quality_bench_cmd(int argc, char **argv)
+{
+    static lv_style_t heavy_style;
+    int frames = argc > 1 ? atoi(argv[1]) : 120;
+    int step = argc > 2 ? atoi(argv[2]) : 24;
+    lv_disp_t *disp = lv_disp_get_default();
+    lv_obj_t *cont = guider_ui.task_list_cont;
+    quality_bench_t fixed, adaptive;
+    int saved_lock;
+
+    if (frames <= 0 || step <= 0 || ui_mutex == RT_NULL || cont == NULL || disp == NULL ||
+        rt_mutex_take(ui_mutex, RT_WAITING_FOREVER) != RT_EOK)
+        return;
+
+    lv_obj_scroll_to_y(cont, 0, LV_ANIM_OFF);
+    if (lv_obj_get_scroll_bottom(cont) <= 0)
+    {
+        rt_kprintf("task list does not scroll, load more tasks first (push_sim)\n");
+        rt_mutex_release(ui_mutex);
+        return;
+    }
+
+    lv_style_init(&heavy_style);
+    lv_style_set_radius(&heavy_style, 8);
+    lv_style_set_shadow_width(&heavy_style, 16);
+    lv_style_set_shadow_spread(&heavy_style, 2);
+    lv_style_set_shadow_opa(&heavy_style, LV_OPA_40);
+    lv_style_set_border_width(&heavy_style, 2);
+    lv_style_set_border_color(&heavy_style, lv_color_hex(0x2196f3));
+    lv_style_set_border_opa(&heavy_style, LV_OPA_50);
+    for (rt_uint32_t r = 0; r < task_list_view.row_count; r++)
+        lv_obj_add_style(task_list_view.rows[r], &heavy_style, LV_PART_MAIN|LV_STATE_DEFAULT);
+
+    saved_lock = ui_quality.locked;
+    if (ui_quality_lock(&ui_quality, UI_QUALITY_FULL))
+        ui_quality_apply(&ui_quality);
+    quality_bench_run(disp, cont, frames, step, &fixed);
+    ui_quality_lock(&ui_quality, -1);
+    quality_bench_run(disp, cont, frames, step, &adaptive);
+
+    rt_kprintf("scroll %d px/frame, budget %d us\n", step, LV_DISP_DEF_REFR_PERIOD * 1000);
+    rt_kprintf("mode     frames  over  avg us  max us  fps levels full/no shadow/no aa/no blend\n");
+    quality_bench_print("full", &fixed);
+    quality_bench_print("adaptive", &adaptive);
+    rt_kprintf("back to full quality %d ms after scrolling stopped\n", adaptive.restore_ms);
+
+    for (rt_uint32_t r = 0; r < task_list_view.row_count; r++)
+        lv_obj_remove_style(task_list_view.rows[r], &heavy_style, LV_PART_MAIN|LV_STATE_DEFAULT);
+    lv_style_reset(&heavy_style);
+    if (ui_quality_lock(&ui_quality, saved_lock))
+        ui_quality_apply(&ui_quality);
+    lv_obj_scroll_to_y(cont, 0, LV_ANIM_OFF);
+    rt_mutex_release(ui_mutex);
+}
+MSH_CMD_EXPORT_ALIAS(quality_bench_cmd, quality_bench, measure scrolling with adaptive render quality [frames] [step]);
+
+/* 按ESP32的格式生成数据包，放入UART消息队列，与真实接收的数据包走相同的处理路径 */
+static rt_err_t inject_packet(const char* type, const char* data)
+{
+    static uart_msg_t msg;
+    static char combined[UART_MSG_MAX_SIZE];
+
+    rt_snprintf(combined, sizeof(combined), "%s%s", type, data);
+    msg.len = rt_snprintf(msg.data, sizeof(msg.data), "%sTYPE:%s%sDATA:%s%sCHECKSUM:%d%s",
+                          PKT_START, type, PKT_DELIMITER, data, PKT_DELIMITER,
+                          calculate_checksum(combined), PKT_END);
+    if (msg.len >= sizeof(msg.data))
+        return -RT_EINVAL;
+    /* 不经过接收中断，不能修改received，也不占ESP32的窗口 */
+    msg.index = 0;
+    msg.injected = true;
+
+    /* 队列满时等待UART线程处理 */
+    while (rt_mq_send(uart_msg_queue, &msg, sizeof(uart_msg_t)) == -RT_EFULL)
+    {
+        rt_thread_mdelay(10);
+    }
+    return RT_EOK;
+}
+
+/* 把当前任务按接收顺序写成TASKS格式，列表变化时先写列表项 */
+static void format_task_list(char* buf, rt_size_t size)
+{
+    static const task_filter_t all = {TASK_FILTER_ANY_STATUS, 0};
+    task_view_t *view = task_store_get_view(&task_store, TASK_SORT_ORDER, &all);
+    rt_size_t len = 0;
+    int list_num = -1;
+
+    buf[0] = '\0';
+    for (rt_uint32_t i = 0; view != RT_NULL && i < view->count && len < size; i++)
+    {
+        const task_info_t *task = task_store_get(&task_store, task_view_at(view, i));
+
+        if (task->list_num != list_num)
+        {
+            list_num = task->list_num;
+            len += rt_snprintf(buf + len, size - len, "%s%d.%s", len ? "," : "", task->list_num, task->list_name);
+        }
+        if (len < size)
+            len += rt_snprintf(buf + len, size - len, ",%d.%d.%s", task->list_num, task->task_num, task->title);
+    }
+    if (len >= size)
+        buf[size - 1] = '\0';
+}
+
+/* 模拟ESP32推送：
+ * all            推送当前任务列表作为基准
+ * set L.T.title  修改或新增一个任务
+ * del L.T        删除一个任务
+ * gap            跳过一个序号，触发重新订阅
+ * stream [n]     连续推送n个修改，依次改变各任务标题 */
+static void push_sim_cmd(int argc, char **argv)
+{
+    static char data[UART_MSG_MAX_SIZE - 64];
+    rt_uint32_t seq;
+    int n = 1, header;
+
+    if (argc < 2 || ui_mutex == RT_NULL || uart_msg_queue == RT_NULL)
+    {
+        rt_kprintf("usage: push_sim all | set L.T.title | del L.T | gap | stream [n]\n");
+        return;
+    }
+    if (rt_mutex_take(ui_mutex, RT_WAITING_FOREVER) != RT_EOK)
+        return;
+    seq = task_push.expected_seq;
+
+    if (rt_strcmp(argv[1], "all") == 0)
+    {
+        header = rt_snprintf(data, sizeof(data), "%u:ALL:", seq);
+        format_task_list(data + header, sizeof(data) - header);
+        rt_mutex_release(ui_mutex);
+        inject_packet("PUSH", data);
+    }
+    else if (rt_strcmp(argv[1], "set") == 0 && argc > 2)
+    {
+        rt_mutex_release(ui_mutex);
+        rt_snprintf(data, sizeof(data), "%u:SET:%s", seq, argv[2]);
+        inject_packet("PUSH", data);
+    }
+    else if (rt_strcmp(argv[1], "del") == 0 && argc > 2)
+    {
+        rt_mutex_release(ui_mutex);
+        rt_snprintf(data, sizeof(data), "%u:DEL:%s", seq, argv[2]);
+        inject_packet("PUSH", data);
+    }
+    else if (rt_strcmp(argv[1], "gap") == 0)
+    {
+        rt_mutex_release(ui_mutex);
+        rt_snprintf(data, sizeof(data), "%u:DEL:0.0", seq + 1);
+        inject_packet("PUSH", data);
+    }
+    else if (rt_strcmp(argv[1], "stream") == 0)
+    {
+        static const task_filter_t all = {TASK_FILTER_ANY_STATUS, 0};
+        task_view_t *view = task_store_get_view(&task_store, TASK_SORT_ORDER, &all);
+        rt_uint32_t count = view ? view->count : 0;
+        rt_uint32_t t0 = app_perf_now_cycles();
+
+        if (argc > 2)
+            n = atoi(argv[2]);
+        for (int i = 0; i < n && count > 0; i++)
+        {
+            const task_info_t *task = task_store_get(&task_store, task_view_at(view, i % count));
+
+            rt_snprintf(data, sizeof(data), "%u:SET:%d.%d.Pushed %d", seq + i,
+                        task->list_num, task->task_num, i);
+            /* 推送由UART线程处理，发送期间不持有ui_mutex */
+            rt_mutex_release(ui_mutex);
+            inject_packet("PUSH", data);
+            rt_mutex_take(ui_mutex, RT_WAITING_FOREVER);
+            view = task_store_get_view(&task_store, TASK_SORT_ORDER, &all);
+            count = view ? view->count : 0;
+        }
+        rt_mutex_release(ui_mutex);
+        rt_kprintf("%d pushes queued in %d us\n", n, app_perf_elapsed_us(t0));
+    }
+    else
+    {
+        rt_mutex_release(ui_mutex);
+    }
+
+    rt_kprintf("push: state %d, next seq %u, %d applied, %d duplicates, %d gaps, %d subscribes\n",
+               task_push.state, task_push.expected_seq, task_push.stats.applied,
+               task_push.stats.duplicates, task_push.stats.gaps, task_push.stats.subscribes);
+}
+MSH_CMD_EXPORT_ALIAS(push_sim_cmd, push_sim, simulate ESP32 task pushes);
+
+/* 模拟ESP32分片发送n个任务的列表：TASKS_PART加最后一片TASKS，经过与真实数据包相同的处理路径，
+ * 等UART线程处理完后检查task_store中的任务数和最后一个任务（超过MAX_TASK_COUNT时只保留前面的） */
+static void list_sim_cmd(int argc, char **argv)
+{
+    static char data[UART_MSG_MAX_SIZE - 64];
+    static char token[TASK_TITLE_SIZE + TASK_LIST_NAME_SIZE + 32];
+    static char last_title[TASK_TITLE_SIZE];
+    task_info_t task;
+    rt_uint32_t n = argc > 1 ? atoi(argv[1]) : 200;
+    rt_uint32_t expect = n < MAX_TASK_COUNT ? n : MAX_TASK_COUNT;
+    rt_uint32_t start, timeout, count = 0;
+    int list_num = -1, last_list = 0, part = 0;
+    rt_size_t len, tlen;
+    bool pass = false;
+
+    if (n == 0 || ui_mutex == RT_NULL || uart_msg_queue == RT_NULL)
+    {
+        rt_kprintf("usage: list_sim [tasks]\n");
+        return;
+    }
+
+    app_test_srand(rt_tick_get());
+    len = rt_snprintf(data, sizeof(data), "%d:", part);
+    for (rt_uint32_t i = 0; i < n; i++)
+    {
+        app_test_make_task(&task, i + 1, 9);
+        if (i == expect - 1)
+        {
+            last_list = task.list_num;
+            rt_strcpy(last_title, task.title);
+        }
+
+        tlen = 0;
+        if (task.list_num != list_num)
+        {
+            list_num = task.list_num;
+            tlen = rt_snprintf(token, sizeof(token), "%d.%s,", task.list_num, task.list_name);
+        }
+        tlen += rt_snprintf(token + tlen, sizeof(token) - tlen, "%d.%d.%s,",
+                            task.list_num, task.task_num, task.title);
+
+        /* 放不下时发出这一片（去掉末尾的逗号），在token边界切开 */
+        if (len + tlen >= sizeof(data))
+        {
+            data[len - 1] = '\0';
+            inject_packet("TASKS_PART", data);
+            len = rt_snprintf(data, sizeof(data), "%d:", ++part);
+        }
+        rt_memcpy(data + len, token, tlen + 1);
+        len += tlen;
+    }
+    data[len - 1] = '\0';
+    inject_packet("TASKS", data);
+    rt_kprintf("%d tasks queued in %d parts\n", n, part + 1);
+
+    /* 每片最多几毫秒，留足处理时间 */
+    start = rt_tick_get_millisecond();
+    timeout = 5000 + n;
+    while (!pass && rt_tick_get_millisecond() - start < timeout)
+    {
+        rt_thread_mdelay(50);
+        rt_mutex_take(ui_mutex, RT_WAITING_FOREVER);
+        task_id_t id = task_store_find(&task_store, last_list, expect);
+        count = task_store.count;
+        pass = list_next_part < 0 && count == expect && id != TASK_ID_NONE
+               && rt_strcmp(task_store_get(&task_store, id)->title, last_title) == 0;
+        rt_mutex_release(ui_mutex);
+    }
+
+    rt_kprintf("store: %d tasks (expected %d) after %d ms  %s\n",
+               count, expect, rt_tick_get_millisecond() - start, pass ? "PASS" : "FAIL");
+}
+MSH_CMD_EXPORT_ALIAS(list_sim_cmd, list_sim, simulate a task list sent in parts [tasks]);
+#endif /* APP_USING_TEST */
+#endif /* RT_USING_FINSH */
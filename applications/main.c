@@ -80,11 +80,12 @@ void MPU_Config(void)
   MPU_InitStruct.BaseAddress      = SDRAM_BANK_ADDR;
   MPU_InitStruct.Size             = MPU_REGION_SIZE_32MB;         // SDRAM
   MPU_InitStruct.AccessPermission = MPU_REGION_FULL_ACCESS;
-  MPU_InitStruct.IsBufferable     = MPU_ACCESS_NOT_BUFFERABLE;
+  /* 写回、读写分配：帧缓冲区交给LTDC/DMA2D前由cache_sync清理对应的缓存行 */
+  MPU_InitStruct.IsBufferable     = MPU_ACCESS_BUFFERABLE;
   MPU_InitStruct.IsCacheable      = MPU_ACCESS_CACHEABLE;
   MPU_InitStruct.IsShareable      = MPU_ACCESS_NOT_SHAREABLE;
   MPU_InitStruct.Number           = MPU_REGION_NUMBER1;
-  MPU_InitStruct.TypeExtField     = MPU_TEX_LEVEL0;
+  MPU_InitStruct.TypeExtField     = MPU_TEX_LEVEL1;
   MPU_InitStruct.SubRegionDisable = 0x00;
   MPU_InitStruct.DisableExec      = MPU_INSTRUCTION_ACCESS_ENABLE;
 
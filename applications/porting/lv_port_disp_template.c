@@ -14,6 +14,13 @@
 
 #include "fmc.h"
 #include "ltdc.h"
+#include "disp_overlay.h"
+#include "cache_sync.h"
+#include "fb_copy.h"
+#include "disp_rotate.h"
+#include "rview.h"
+#include "beam_sched.h"
+#include "dma2d.h"
 /*********************
  *      DEFINES
  *********************/
@@ -23,6 +30,49 @@ static lv_disp_drv_t * disp_drv_user;
 
 #define 	LVGL_MemoryAdd	( LCD_MemoryAdd + LCD_Width*LCD_Height*BytesPerPixel_0 )	// ��ʾ��������ַ
 
+/*Overlay shown on LTDC layer 2 for small, fast-changing widgets (status, clock, spinner).
+ *Set OVERLAY_USE_LTDC to 0 to composite it into the main frame buffers in software instead*/
+#ifndef OVERLAY_USE_LTDC
+#define OVERLAY_USE_LTDC    1
+#endif
+#define OVERLAY_WIDTH       240
+#define OVERLAY_HEIGHT      32
+#define OVERLAY_MemoryAdd   ( LVGL_MemoryAdd + 2*LCD_Width*LCD_Height*sizeof(lv_color_t) )
+#define OVERLAY_SIZE        ( OVERLAY_WIDTH*OVERLAY_HEIGHT*sizeof(lv_color_t) )
+/*Overlay pixels rotated to the panel orientation, two buffers after the under buffer*/
+#define OVERLAY_ROT_MemoryAdd   ( OVERLAY_MemoryAdd + 3*OVERLAY_SIZE )
+/*Remote view shadow frame and the copy of what the viewer shows, logical orientation*/
+#define RVIEW_MemoryAdd     ( OVERLAY_ROT_MemoryAdd + 2*OVERLAY_SIZE )
+#define RVIEW_POLL_MS       50      /*Sends areas held back by the frame rate cap once the screen is idle*/
+
+/*LVGL resolution, swapped when the panel is mounted in portrait*/
+#define ROTATION_ODD        ( LV_PORT_DISP_ROTATION == 90 || LV_PORT_DISP_ROTATION == 270 )
+#define LOGICAL_W           ( ROTATION_ODD ? LCD_Height : LCD_Width )
+#define LOGICAL_H           ( ROTATION_ODD ? LCD_Width : LCD_Height )
+
+#define MAIN_STRIDE         ( LCD_Width*sizeof(lv_color_t) )
+#define MAIN_SIZE           ( LCD_Width*LCD_Height*sizeof(lv_color_t) )
+
+#define DMA2D_TIMEOUT_MS    50      /*A full 800x480 RGB565 copy takes a few ms*/
+
+#if LV_PORT_DISP_BEAM && LV_PORT_DISP_ROTATION != 0
+#error "LV_PORT_DISP_BEAM scans out LVGL's buffers directly and needs LV_PORT_DISP_ROTATION 0"
+#endif
+#define BEAM_SLOTS          2       /*LVGL's two draw buffers are the ring of bands*/
+#define BEAM_SLOT_SIZE      ( LV_PORT_DISP_BEAM_LINES*LCD_Width )
+/*Band buffers at a fixed address at the top of the 512 KB AXI SRAM (D1), which LTDC can read.
+ *Not left to the linker: LTDC cannot reach DTCM, where a BSP may put .bss.
+ *The BSP linker script must end its AXI SRAM region below BEAM_MemoryAdd*/
+#ifndef BEAM_MemoryAdd
+#define BEAM_MemoryAdd      ( 0x24080000 - BEAM_SLOTS*BEAM_SLOT_SIZE*sizeof(lv_color_t) )
+#endif
+#define BEAM_WAIT_MS        50      /*Longer than a frame: the line event stopped, go on without it*/
+
+/*Address to program for a buffer that holds panel lines from y0. LTDC fetches line y from
+ *CFBAR + y * pitch, also after an immediate reload in the middle of a frame (which is what makes
+ *an unsynchronised buffer switch tear at the current line)*/
+#define BEAM_CFBAR(buf, y0) ( (uint32_t)(buf) - (uint32_t)(y0)*MAIN_STRIDE )
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -33,12 +83,57 @@ static lv_disp_drv_t * disp_drv_user;
 static void disp_init(void);
 
 static void disp_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static void disp_flush_rotated(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static void rotate_area(lv_color_t * panel, const lv_color_t * logical, const disp_area_t * area);
+static void overlay_panel_area(lv_coord_t x, lv_coord_t y, disp_area_t * out);
+static void overlay_init(void);
+static void overlay_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static void overlay_soft_update(const lv_color_t * pixels, lv_coord_t x, lv_coord_t y, lv_opa_t opa);
+static void rview_poll(lv_timer_t * timer);
+static rt_err_t dma2d_copy(void * dst, rt_size_t dst_stride, const void * src, rt_size_t src_stride,
+                           rt_size_t width, rt_size_t rows);
+static rt_err_t dma2d_fill16(void * dst, rt_size_t stride, rt_uint16_t color, rt_size_t width, rt_size_t rows);
+#if LV_PORT_DISP_BEAM
+static void beam_init(void);
+static void beam_rounder(lv_disp_drv_t * disp_drv, lv_area_t * area);
+static void beam_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static void beam_show(rt_uint16_t band, int slot);
+static uint32_t beam_event_line(rt_uint16_t band);
+static void beam_line_event(LTDC_HandleTypeDef * hltdc);
+#endif
 //static void gpu_fill(lv_disp_drv_t * disp_drv, lv_color_t * dest_buf, lv_coord_t dest_width,
 //        const lv_area_t * fill_area, lv_color_t color);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+static lv_disp_t * overlay_disp;
+static disp_overlay_t overlay;
+static bool overlay_soft;                   /*Composited by disp_overlay instead of LTDC layer 2*/
+static lv_color_t * main_front;             /*Main frame buffer currently scanned out*/
+static const disp_rotate_t rotation = (disp_rotate_t)(LV_PORT_DISP_ROTATION / 90);
+static lv_color_t * rot_buf[2];             /*Panel-orientation buffers, scanned out in turn*/
+static uint8_t rot_back;                    /*Index of the one not scanned out*/
+static disp_area_t rot_prev[LV_INV_BUF_SIZE];   /*Logical areas the back buffer has not seen yet*/
+static uint16_t rot_prev_cnt;
+static disp_area_t rot_overlay[2];          /*Where the software overlay was composited, per buffer*/
+static bool rot_overlay_valid[2];
+static uint8_t overlay_rot_idx;
+static const fb_dma_ops_t dma2d_ops = {
+    dma2d_copy,
+    dma2d_fill16,
+};
+#if LV_PORT_DISP_BEAM
+static lv_disp_t * beam_disp;
+static beam_sched_t beam;
+static lv_color_t * const beam_buf[BEAM_SLOTS] = {
+    (lv_color_t *)(BEAM_MemoryAdd),
+    (lv_color_t *)(BEAM_MemoryAdd) + BEAM_SLOT_SIZE,
+};
+static const lv_color_t * beam_fallback;
+static struct rt_semaphore beam_sem;        /*Released when the line event frees a band buffer*/
+static rt_uint16_t beam_next;               /*Band the next line event is for, beam.bands for the frame end*/
+#endif
 
 /**********************
  *      MACROS
@@ -55,6 +150,12 @@ void lv_port_disp_init(void)
      * -----------------------*/
     disp_init();
 
+#if LV_PORT_DISP_BEAM
+    /*No frame buffers: LVGL's band buffers are scanned out directly*/
+    beam_init();
+    return;
+#endif
+
     /*-----------------------------
      * Create a buffer for drawing
      *----------------------------*/
@@ -90,7 +191,17 @@ void lv_port_disp_init(void)
     static lv_disp_draw_buf_t draw_buf_dsc_3;
     static lv_color_t *buf_3_1 = (lv_color_t * )(LVGL_MemoryAdd);             /*A screen sized buffer*/
     static lv_color_t *buf_3_2 = (lv_color_t * )(LVGL_MemoryAdd + LCD_Width*LCD_Height*sizeof(lv_color_t));           /*Another screen sized buffer*/
-    lv_disp_draw_buf_init(&draw_buf_dsc_3, buf_3_1, buf_3_2, LCD_Width * LCD_Height);   /*Initialize the display buffer*/
+    if(rotation == DISP_ROTATE_0) {
+        lv_disp_draw_buf_init(&draw_buf_dsc_3, buf_3_1, buf_3_2, LCD_Width * LCD_Height);   /*Initialize the display buffer*/
+    }
+    else {
+        /*Rotated: LVGL keeps one complete logical frame in buf_3_1 and redraws only what changed,
+         *the panel buffers (LCD_MemoryAdd and buf_3_2) are scanned out in turn*/
+        lv_disp_draw_buf_init(&draw_buf_dsc_3, buf_3_1, NULL, LCD_Width * LCD_Height);
+        rot_buf[0] = (lv_color_t *)(LCD_MemoryAdd);
+        rot_buf[1] = buf_3_2;
+        rot_back = (LTDC_Layer1->CFBAR == (uint32_t)rot_buf[0]) ? 1 : 0;
+    }
 
     /*-----------------------------------
      * Register the display in LVGL
@@ -101,9 +212,9 @@ void lv_port_disp_init(void)
 
     /*Set up the functions to access to your display*/
 
-    /*Set the resolution of the display*/
-    disp_drv.hor_res = LCD_Width;
-    disp_drv.ver_res = LCD_Height;
+    /*Set the resolution of the display (logical orientation, swapped when the panel is rotated by 90 or 270)*/
+    disp_drv.hor_res = LOGICAL_W;
+    disp_drv.ver_res = LOGICAL_H;
 
     /*Used to copy the buffer's content to the display*/
     disp_drv.flush_cb = disp_flush;
@@ -114,6 +225,15 @@ void lv_port_disp_init(void)
     /*Required for Example 3)*/
     disp_drv.full_refresh = 1; //˫ȫ������Ҫ�򿪴�����
 
+    /*Rotated panel: LVGL draws in the logical orientation, disp_flush_rotated turns the changed areas
+     *into the panel orientation. LVGL is not told about the rotation (`rotated` stays 0) so it does not
+     *rotate the touch points again, the indev port maps them with lv_port_disp_touch_to_logical()*/
+    if(rotation != DISP_ROTATE_0) {
+        disp_drv.full_refresh = 0;
+        disp_drv.direct_mode = 1;
+        disp_drv.flush_cb = disp_flush_rotated;
+    }
+
     /* Fill a memory array with a color if you have GPU.
      * Note that, in lv_conf.h you can enable GPUs that has built-in support in LVGL.
      * But if you have a different GPU you can use with this callback.*/
@@ -121,6 +241,16 @@ void lv_port_disp_init(void)
 
     /*Finally register the driver*/
     lv_disp_drv_register(&disp_drv);
+
+    /*Register the overlay after the main display so the main display stays the default one*/
+    overlay_init();
+
+    /*Large frame buffer copies and fills go to DMA2D*/
+    fb_copy_set_dma(&dma2d_ops);
+
+    /*Remote view, started with the `rview` command*/
+    rview_init((rt_uint16_t *)(RVIEW_MemoryAdd), (rt_uint16_t *)(RVIEW_MemoryAdd + MAIN_SIZE), LOGICAL_W, LOGICAL_H);
+    lv_timer_create(rview_poll, RVIEW_POLL_MS, NULL);
 	 
 //		__HAL_RCC_DMA2D_CLK_ENABLE();					// ʹ��DMA2Dʱ��	  
 //	HAL_LTDC_ProgramLineEvent(&hltdc, 0 );
@@ -133,6 +263,85 @@ void lv_port_disp_init(void)
 	 
 }
 
+/*Return the overlay display. Create widgets on `lv_disp_get_scr_act(overlay)`.
+ *The screen is filled with the color key, give widgets an opaque background*/
+lv_disp_t * lv_port_disp_get_overlay(void)
+{
+    return overlay_disp;
+}
+
+/*Move the overlay (clipped to the screen) and set its opacity, call from the LVGL thread*/
+void lv_port_disp_set_overlay(lv_coord_t x, lv_coord_t y, lv_opa_t opa)
+{
+    disp_area_t a;
+
+    if(x < 0) x = 0;
+    if(y < 0) y = 0;
+    if(x > LOGICAL_W - OVERLAY_WIDTH) x = LOGICAL_W - OVERLAY_WIDTH;
+    if(y > LOGICAL_H - OVERLAY_HEIGHT) y = LOGICAL_H - OVERLAY_HEIGHT;
+    overlay_panel_area(x, y, &a);
+
+    if(overlay_soft) {
+        /*The main buffer is redrawn only when it changes, so update the visible one in place*/
+        if(main_front) overlay_soft_update((const lv_color_t *)overlay.pixels, a.x1, a.y1, opa);
+        else {
+            overlay.x = a.x1;
+            overlay.y = a.y1;
+            overlay.alpha = opa;
+        }
+        return;
+    }
+
+    /*Takes effect at the next reload in the line event*/
+    overlay.x = a.x1;
+    overlay.y = a.y1;
+    overlay.alpha = opa;
+    HAL_LTDC_SetWindowPosition_NoReload(&hltdc, a.x1, a.y1, LTDC_LAYER_2);
+    HAL_LTDC_SetAlpha_NoReload(&hltdc, opa, LTDC_LAYER_2);
+}
+
+/*True when the overlay is composited in software*/
+bool lv_port_disp_overlay_is_soft(void)
+{
+    return overlay_soft;
+}
+
+/*The bands hold only a few lines, so every frame is drawn from scratch. beam_flush waits for the
+ *scan, which paces lv_task_handler to the panel's frame rate*/
+bool lv_port_disp_beam_frame(void)
+{
+#if LV_PORT_DISP_BEAM
+    lv_obj_invalidate(lv_disp_get_scr_act(beam_disp));
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*Map a touch point from the panel orientation to the logical one, the inverse of the flush rotation*/
+void lv_port_disp_touch_to_logical(int16_t * x, int16_t * y)
+{
+    disp_area_t a;
+
+    if(rotation == DISP_ROTATE_0) return;
+
+    a.x1 = a.x2 = *x;
+    a.y1 = a.y2 = *y;
+    disp_rotate_area((disp_rotate_t)((4 - rotation) & 3), LOGICAL_W, LOGICAL_H, &a, &a);
+    *x = a.x1;
+    *y = a.y1;
+}
+
+/*Set the image shown for bands that were not rendered in time*/
+void lv_port_disp_beam_set_fallback(const lv_color_t * img)
+{
+#if LV_PORT_DISP_BEAM
+    beam_fallback = img;
+#else
+    LV_UNUSED(img);
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -149,6 +358,16 @@ static void disp_init(void)
 static void disp_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
 {
     /*The most simple case (but also the slowest) to put all pixels to the screen one-by-one*/
+	disp_area_t a = {area->x1, area->y1, area->x2, area->y2};
+
+	/*Remote view copies the frame before the overlay is composited, the overlay is not streamed*/
+	rview_capture((const rt_uint16_t *)color_p, &a, 1);
+	if(overlay_soft) disp_overlay_compose(&overlay, (rt_uint16_t *)color_p, LCD_Width, LCD_Height);
+
+	/*The frame buffers are write-back cached, LTDC reads SDRAM: write back the rendered area first*/
+	cache_clean_rect(color_p, MAIN_STRIDE, sizeof(lv_color_t), area->x1, area->y1, area->x2, area->y2);
+	cache_dma_handoff(color_p, MAIN_SIZE);
+	main_front = color_p;
 	LTDC_Layer1->CFBAR = (uint32_t)color_p;			// �л��Դ��ַ
 
 	/*IMPORTANT!!!
@@ -156,6 +375,397 @@ static void disp_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_colo
 	lv_disp_flush_ready(disp_drv);
 }
 
+/*Direct mode calls this for every redrawn area with the whole logical buffer. On the last one
+ *rotate this frame's areas and the previous frame's (which the back buffer missed) into the
+ *back panel buffer, then scan it out. Only changed areas are rotated*/
+static void disp_flush_rotated(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    lv_color_t * back = rot_buf[rot_back];
+    uint16_t i;
+
+    LV_UNUSED(area);
+    if(!lv_disp_flush_is_last(disp_drv)) {
+        lv_disp_flush_ready(disp_drv);
+        return;
+    }
+
+    for(i = 0; i < rot_prev_cnt; i++) rotate_area(back, color_p, &rot_prev[i]);
+
+    rot_prev_cnt = 0;
+    for(i = 0; i < disp->inv_p; i++) {
+        if(disp->inv_area_joined[i]) continue;
+        rot_prev[rot_prev_cnt].x1 = disp->inv_areas[i].x1;
+        rot_prev[rot_prev_cnt].y1 = disp->inv_areas[i].y1;
+        rot_prev[rot_prev_cnt].x2 = disp->inv_areas[i].x2;
+        rot_prev[rot_prev_cnt].y2 = disp->inv_areas[i].y2;
+        rotate_area(back, color_p, &rot_prev[rot_prev_cnt]);
+        rot_prev_cnt++;
+    }
+    rview_capture((const rt_uint16_t *)color_p, rot_prev, rot_prev_cnt);
+
+    if(overlay_soft) {
+        /*Put back the logical pixels where this buffer showed the overlay last time*/
+        if(rot_overlay_valid[rot_back]) {
+            disp_area_t a;
+            disp_rotate_area((disp_rotate_t)((4 - rotation) & 3), LOGICAL_W, LOGICAL_H, &rot_overlay[rot_back], &a);
+            rotate_area(back, color_p, &a);
+        }
+        disp_overlay_compose(&overlay, (rt_uint16_t *)back, LCD_Width, LCD_Height);
+        rot_overlay[rot_back].x1 = overlay.x;
+        rot_overlay[rot_back].y1 = overlay.y;
+        rot_overlay[rot_back].x2 = overlay.x + overlay.width - 1;
+        rot_overlay[rot_back].y2 = overlay.y + overlay.height - 1;
+        rot_overlay_valid[rot_back] = overlay.saved;
+        cache_clean_rect(back, MAIN_STRIDE, sizeof(lv_color_t), rot_overlay[rot_back].x1, rot_overlay[rot_back].y1,
+                         rot_overlay[rot_back].x2, rot_overlay[rot_back].y2);
+    }
+
+    cache_dma_handoff(back, MAIN_SIZE);
+    main_front = back;
+    rot_back ^= 1;
+    LTDC_Layer1->CFBAR = (uint32_t)back;
+
+    lv_disp_flush_ready(disp_drv);
+}
+
+/*Rotate a logical area into a panel buffer and write it back for LTDC*/
+static void rotate_area(lv_color_t * panel, const lv_color_t * logical, const disp_area_t * area)
+{
+    disp_area_t out;
+
+    disp_rotate_copy((rt_uint16_t *)panel, LCD_Width, LCD_Height, (const rt_uint16_t *)logical, rotation, area);
+    disp_rotate_area(rotation, LCD_Width, LCD_Height, area, &out);
+    cache_clean_rect(panel, MAIN_STRIDE, sizeof(lv_color_t), out.x1, out.y1, out.x2, out.y2);
+}
+
+/*Panel rect of the overlay placed at a logical position*/
+static void overlay_panel_area(lv_coord_t x, lv_coord_t y, disp_area_t * out)
+{
+    disp_area_t a;
+
+    a.x1 = x;
+    a.y1 = y;
+    a.x2 = x + OVERLAY_WIDTH - 1;
+    a.y2 = y + OVERLAY_HEIGHT - 1;
+    disp_rotate_area(rotation, LCD_Width, LCD_Height, &a, out);
+}
+
+/*Runs between refreshes, so the frame LVGL shows last is complete. Skipped with the software
+ *overlay when not rotated, the scanned out buffer holds the overlay as well*/
+static void rview_poll(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+    if(rotation != DISP_ROTATE_0) rview_capture((const rt_uint16_t *)(LVGL_MemoryAdd), NULL, 0);
+    else if(main_front && !overlay_soft) rview_capture((const rt_uint16_t *)main_front, NULL, 0);
+}
+
+/*Configure LTDC layer 2 with a color key and constant alpha. Fall back to
+ *software compositing when it is disabled or cannot be configured*/
+static void overlay_init(void)
+{
+    static lv_disp_draw_buf_t overlay_draw_buf;
+    static lv_disp_drv_t overlay_drv;
+    lv_color_t * buf_1 = (lv_color_t *)(OVERLAY_MemoryAdd);
+    lv_color_t * buf_2 = (lv_color_t *)(OVERLAY_MemoryAdd + OVERLAY_SIZE);
+    rt_uint16_t * under = (rt_uint16_t *)(OVERLAY_MemoryAdd + 2 * OVERLAY_SIZE);
+    lv_color_t key = lv_color_hex(LV_PORT_DISP_OVERLAY_KEY);
+    lv_obj_t * scr;
+    disp_area_t a;
+
+    /*Composited in the panel orientation, the size is swapped when rotated by 90 or 270*/
+    overlay_panel_area(LOGICAL_W - OVERLAY_WIDTH, 0, &a);
+    disp_overlay_init(&overlay, under, a.x2 - a.x1 + 1, a.y2 - a.y1 + 1, key.full);
+    overlay.x = a.x1;
+    overlay.y = a.y1;
+
+    overlay_soft = true;
+#if OVERLAY_USE_LTDC
+    LTDC_LayerCfgTypeDef cfg = {0};
+
+    cfg.WindowX0 = overlay.x;
+    cfg.WindowX1 = overlay.x + overlay.width;
+    cfg.WindowY0 = overlay.y;
+    cfg.WindowY1 = overlay.y + overlay.height;
+    cfg.PixelFormat = LTDC_PIXEL_FORMAT_RGB565;
+    cfg.Alpha = overlay.alpha;
+    cfg.Alpha0 = 0;
+    /*Color-keyed pixels get pixel alpha 0, every other RGB565 pixel 255*/
+    cfg.BlendingFactor1 = LTDC_BLENDING_FACTOR1_PAxCA;
+    cfg.BlendingFactor2 = LTDC_BLENDING_FACTOR2_PAxCA;
+    cfg.FBStartAdress = (rotation == DISP_ROTATE_0) ? (uint32_t)buf_1 : (uint32_t)(OVERLAY_ROT_MemoryAdd);
+    cfg.ImageWidth = overlay.width;
+    cfg.ImageHeight = overlay.height;
+    if(HAL_LTDC_ConfigLayer(&hltdc, &cfg, LTDC_LAYER_2) == HAL_OK &&
+       HAL_LTDC_ConfigColorKeying(&hltdc, LV_PORT_DISP_OVERLAY_KEY, LTDC_LAYER_2) == HAL_OK &&
+       HAL_LTDC_EnableColorKeying(&hltdc, LTDC_LAYER_2) == HAL_OK) {
+        overlay_soft = false;
+    }
+#endif
+
+    lv_disp_draw_buf_init(&overlay_draw_buf, buf_1, buf_2, OVERLAY_WIDTH * OVERLAY_HEIGHT);
+    lv_disp_drv_init(&overlay_drv);
+    overlay_drv.hor_res = OVERLAY_WIDTH;
+    overlay_drv.ver_res = OVERLAY_HEIGHT;
+    overlay_drv.flush_cb = overlay_flush;
+    overlay_drv.draw_buf = &overlay_draw_buf;
+    overlay_drv.full_refresh = 1;
+    overlay_disp = lv_disp_drv_register(&overlay_drv);
+
+    /*Everything drawn in the key color is transparent*/
+    scr = lv_disp_get_scr_act(overlay_disp);
+    lv_obj_set_style_bg_color(scr, key, 0);
+    lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+}
+
+/*The overlay is small: switch the layer 2 address, or composite it over the visible main buffer*/
+static void overlay_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    /*Rotated: turn the whole overlay into one of two panel-orientation buffers*/
+    if(rotation != DISP_ROTATE_0) {
+        lv_color_t * rot = (lv_color_t *)(OVERLAY_ROT_MemoryAdd + overlay_rot_idx * OVERLAY_SIZE);
+        overlay_rot_idx ^= 1;
+        disp_rotate_rect16((rt_uint16_t *)rot, overlay.width, (const rt_uint16_t *)color_p, OVERLAY_WIDTH,
+                           OVERLAY_WIDTH, OVERLAY_HEIGHT, rotation);
+        color_p = rot;
+    }
+
+    if(!overlay_soft) {
+        cache_clean(color_p, OVERLAY_SIZE);
+        cache_dma_handoff(color_p, OVERLAY_SIZE);
+        overlay.pixels = (const rt_uint16_t *)color_p;
+        LTDC_Layer2->CFBAR = (uint32_t)color_p;
+    }
+    else if(main_front) {
+        overlay_soft_update(color_p, overlay.x, overlay.y, overlay.alpha);
+    }
+    else {
+        overlay.pixels = (const rt_uint16_t *)color_p;
+    }
+
+    lv_disp_flush_ready(disp_drv);
+}
+
+/*Composite the overlay into the visible main buffer and write back the pixels
+ *touched at the old and the new position*/
+static void overlay_soft_update(const lv_color_t * pixels, lv_coord_t x, lv_coord_t y, lv_opa_t opa)
+{
+    lv_coord_t old_x = overlay.x;
+    lv_coord_t old_y = overlay.y;
+
+    disp_overlay_update(&overlay, (const rt_uint16_t *)pixels, x, y, opa,
+                        (rt_uint16_t *)main_front, LCD_Width, LCD_Height);
+
+    cache_clean_rect(main_front, MAIN_STRIDE, sizeof(lv_color_t),
+                     old_x, old_y, old_x + overlay.width - 1, old_y + overlay.height - 1);
+    if(x != old_x || y != old_y) {
+        cache_clean_rect(main_front, MAIN_STRIDE, sizeof(lv_color_t),
+                         x, y, x + overlay.width - 1, y + overlay.height - 1);
+    }
+    cache_dma_handoff(main_front, MAIN_SIZE);
+
+    /*Rotated: remember where the visible buffer now shows the overlay*/
+    if(rotation != DISP_ROTATE_0) {
+        rot_overlay[rot_back ^ 1].x1 = x;
+        rot_overlay[rot_back ^ 1].y1 = y;
+        rot_overlay[rot_back ^ 1].x2 = x + overlay.width - 1;
+        rot_overlay[rot_back ^ 1].y2 = y + overlay.height - 1;
+        rot_overlay_valid[rot_back ^ 1] = overlay.saved;
+    }
+}
+
+/*Wait for the DMA2D transfer, abort it when it hangs*/
+static rt_err_t dma2d_wait(void)
+{
+    rt_tick_t start = rt_tick_get();
+
+    while(DMA2D->CR & DMA2D_CR_START) {
+        if(rt_tick_get() - start > rt_tick_from_millisecond(DMA2D_TIMEOUT_MS)) {
+            DMA2D->CR |= DMA2D_CR_ABORT;
+            while(DMA2D->CR & DMA2D_CR_START);
+            return -RT_ETIMEOUT;
+        }
+    }
+    DMA2D->IFCR = DMA2D_IFCR_CTCIF;
+    return RT_EOK;
+}
+
+/*Memory to memory, RGB565 in and out. width is in bytes, strides are in bytes*/
+static rt_err_t dma2d_copy(void * dst, rt_size_t dst_stride, const void * src, rt_size_t src_stride,
+                           rt_size_t width, rt_size_t rows)
+{
+    rt_size_t w = width / sizeof(lv_color_t);
+
+    /*NLR holds 14 bits of pixels per line and 16 bits of lines*/
+    if(w > 0x3FFF || rows > 0xFFFF || (DMA2D->CR & DMA2D_CR_START)) return -RT_EBUSY;
+
+    DMA2D->CR = DMA2D_M2M;
+    DMA2D->FGPFCCR = DMA2D_INPUT_RGB565;
+    DMA2D->OPFCCR = DMA2D_OUTPUT_RGB565;
+    DMA2D->FGMAR = (uint32_t)src;
+    DMA2D->OMAR = (uint32_t)dst;
+    DMA2D->FGOR = src_stride / sizeof(lv_color_t) - w;
+    DMA2D->OOR = dst_stride / sizeof(lv_color_t) - w;
+    DMA2D->NLR = (w << 16) | rows;
+    DMA2D->CR |= DMA2D_CR_START;
+    return dma2d_wait();
+}
+
+/*Register to memory. width is in pixels, stride is in bytes*/
+static rt_err_t dma2d_fill16(void * dst, rt_size_t stride, rt_uint16_t color, rt_size_t width, rt_size_t rows)
+{
+    if(width > 0x3FFF || rows > 0xFFFF || (DMA2D->CR & DMA2D_CR_START)) return -RT_EBUSY;
+
+    DMA2D->CR = DMA2D_R2M;
+    DMA2D->OPFCCR = DMA2D_OUTPUT_RGB565;
+    DMA2D->OCOLR = color;
+    DMA2D->OMAR = (uint32_t)dst;
+    DMA2D->OOR = stride / sizeof(lv_color_t) - width;
+    DMA2D->NLR = (width << 16) | rows;
+    DMA2D->CR |= DMA2D_CR_START;
+    return dma2d_wait();
+}
+
+#if LV_PORT_DISP_BEAM
+/*Racing the beam: LVGL draws bands of LV_PORT_DISP_BEAM_LINES lines into its two draw buffers and
+ *the line event points layer 1 at each band's buffer just before LTDC scans the band out*/
+static void beam_init(void)
+{
+    static lv_disp_draw_buf_t beam_draw_buf;
+    static lv_disp_drv_t beam_drv;
+
+    /*Whole cache lines, so cleaning a band never touches its neighbour*/
+    RT_ASSERT(((uint32_t)beam_buf[0] & (CACHE_LINE_SIZE - 1)) == 0);
+    RT_ASSERT(((uint32_t)beam_buf[1] & (CACHE_LINE_SIZE - 1)) == 0);
+
+    beam_sched_init(&beam, LCD_Height, LV_PORT_DISP_BEAM_LINES, BEAM_SLOTS);
+    rt_sem_init(&beam_sem, "beam", 0, RT_IPC_FLAG_FIFO);
+
+    lv_disp_draw_buf_init(&beam_draw_buf, beam_buf[0], beam_buf[1], BEAM_SLOT_SIZE);
+    lv_disp_drv_init(&beam_drv);
+    beam_drv.hor_res = LCD_Width;
+    beam_drv.ver_res = LCD_Height;
+    beam_drv.flush_cb = beam_flush;
+    beam_drv.rounder_cb = beam_rounder;
+    beam_drv.draw_buf = &beam_draw_buf;
+    beam_disp = lv_disp_drv_register(&beam_drv);
+
+    /*Refresh on every lv_task_handler call, beam_flush sets the pace*/
+    lv_timer_set_period(_lv_disp_get_refr_timer(beam_disp), 1);
+
+    /*Show the fallback until the first frame is drawn, then follow the scan band by band*/
+    beam_show(0, -1);
+    beam_next = 0;
+    HAL_LTDC_ProgramLineEvent(&hltdc, beam_event_line(beam_next));
+
+    /*The line event has to run within a line*/
+    HAL_NVIC_SetPriority(LTDC_IRQn, 0, 0);
+    HAL_NVIC_EnableIRQ(LTDC_IRQn);
+}
+
+/*Redraw whole bands: full width and from a band boundary, so every flushed buffer holds one band*/
+static void beam_rounder(lv_disp_drv_t * disp_drv, lv_area_t * area)
+{
+    LV_UNUSED(disp_drv);
+    area->x1 = 0;
+    area->x2 = LCD_Width - 1;
+    area->y1 = area->y1 / LV_PORT_DISP_BEAM_LINES * LV_PORT_DISP_BEAM_LINES;
+    area->y2 = (area->y2 / LV_PORT_DISP_BEAM_LINES + 1) * LV_PORT_DISP_BEAM_LINES - 1;
+    if(area->y2 > LCD_Height - 1) area->y2 = LCD_Height - 1;
+}
+
+/*LVGL has drawn one band. Queue it for the scan (it is dropped when the scan has passed it already),
+ *then wait until the other buffer, which LVGL draws the next band into, has been scanned out*/
+static void beam_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    rt_uint8_t slot = (color_p == beam_buf[0]) ? 0 : 1;
+    rt_uint16_t band = area->y1 / LV_PORT_DISP_BEAM_LINES;
+    rt_base_t level;
+    bool free;
+
+    /*LTDC reads the band from RAM, write it back from the D-cache first*/
+    cache_clean(color_p, lv_area_get_height(area) * MAIN_STRIDE);
+
+    level = rt_hw_interrupt_disable();
+    if(beam_sched_begin(&beam, slot, band) == RT_EOK) beam_sched_submit(&beam, slot);
+    rt_hw_interrupt_enable(level);
+
+    for(;;) {
+        level = rt_hw_interrupt_disable();
+        free = beam_sched_slot_free(&beam, slot ^ 1);
+        rt_hw_interrupt_enable(level);
+        if(free || rt_sem_take(&beam_sem, rt_tick_from_millisecond(BEAM_WAIT_MS)) != RT_EOK) break;
+    }
+
+    lv_disp_flush_ready(disp_drv);
+}
+
+/*Point layer 1 at the band's buffer or at the fallback image, or switch it off to show the
+ *background color. Reloaded immediately, the line event runs in the line before the band*/
+static void beam_show(rt_uint16_t band, int slot)
+{
+    if(slot >= 0) {
+        LTDC_Layer1->CFBAR = BEAM_CFBAR(beam_buf[slot], band * LV_PORT_DISP_BEAM_LINES);
+        LTDC_Layer1->CR |= LTDC_LxCR_LEN;
+    }
+    else if(beam_fallback) {
+        LTDC_Layer1->CFBAR = (uint32_t)beam_fallback;
+        LTDC_Layer1->CR |= LTDC_LxCR_LEN;
+    }
+    else {
+        LTDC_Layer1->CR &= ~LTDC_LxCR_LEN;
+    }
+    LTDC->SRCR = LTDC_SRCR_IMR;
+}
+
+/*LTDC counts lines from the vertical sync and the active area starts after the accumulated back porch.
+ *A band's event is in the line before it, the frame end's in the first front porch line*/
+static uint32_t beam_event_line(rt_uint16_t band)
+{
+    if(band >= beam.bands) return (LTDC->AWCR & LTDC_AWCR_AAH) + 1;
+    return (LTDC->BPCR & LTDC_BPCR_AVBP) + band * LV_PORT_DISP_BEAM_LINES;
+}
+
+/*One event per band and one at the frame end: scan out the band, wake beam_flush when a buffer
+ *has been scanned out and program the next event*/
+static void beam_line_event(LTDC_HandleTypeDef * hltdc)
+{
+    rt_uint32_t released;
+
+    if(beam_next < beam.bands) {
+        beam_show(beam_next, beam_sched_band_start(&beam, beam_next, &released));
+        beam_next++;
+    }
+    else {
+        released = beam_sched_frame_end(&beam);
+        beam_next = 0;
+    }
+    if(released) rt_sem_release(&beam_sem);
+    HAL_LTDC_ProgramLineEvent(hltdc, beam_event_line(beam_next));
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static void beam_cmd(int argc, char ** argv)
+{
+    beam_sched_stats_t st;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    st = beam.stats;
+    rt_hw_interrupt_enable(level);
+
+    rt_kprintf("beam: %d bands of %d lines, %d bytes of band buffers\n",
+               beam.bands, LV_PORT_DISP_BEAM_LINES, (int)(BEAM_SLOTS*BEAM_SLOT_SIZE*sizeof(lv_color_t)));
+    rt_kprintf("frames %d (complete %d), bands from buffer %d, fallback %d, rendered %d, late %d\n",
+               st.frames, st.full_frames, st.bands, st.fallbacks, st.rendered, st.late);
+}
+MSH_CMD_EXPORT_ALIAS(beam_cmd, beam, show band display statistics);
+#endif
+
+#endif /*LV_PORT_DISP_BEAM*/
+
 /**
   * @brief  Line Event callback.
   * @param  hltdc: pointer to a LTDC_HandleTypeDef structure that contains
@@ -164,6 +774,10 @@ static void disp_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_colo
   */
 void HAL_LTDC_LineEvenCallback(LTDC_HandleTypeDef *hltdc)
 {   
+#if LV_PORT_DISP_BEAM
+    beam_line_event(hltdc);
+    return;
+#endif
     // ����������������Դ��ַ��Ч����ʱ��ʾ�Ż����
     // ÿ�ν����жϲŻ������ʾ����������Ч����˺������
 	__HAL_LTDC_RELOAD_CONFIG(hltdc);					
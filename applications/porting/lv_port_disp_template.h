@@ -21,6 +21,24 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
+/*Pixels of this color (lv_color_hex) on the overlay display are transparent*/
+#define LV_PORT_DISP_OVERLAY_KEY    0xFF00FF
+
+/*Panel mounting in degrees: 0, 90, 180 or 270. LVGL draws in the rotated orientation,
+ *the port rotates only the redrawn areas into the panel's frame buffers*/
+#ifndef LV_PORT_DISP_ROTATION
+#define LV_PORT_DISP_ROTATION       0
+#endif
+
+/*Racing the beam: no frame buffers, LVGL redraws the screen every frame in bands of
+ *LV_PORT_DISP_BEAM_LINES lines into two small buffers that LTDC scans out just behind it.
+ *Bands not ready in time show the fallback image. No overlay, rotation or remote view*/
+#ifndef LV_PORT_DISP_BEAM
+#define LV_PORT_DISP_BEAM           0
+#endif
+#ifndef LV_PORT_DISP_BEAM_LINES
+#define LV_PORT_DISP_BEAM_LINES     8
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -31,6 +49,25 @@ extern "C" {
  **********************/
 void lv_port_disp_init(void);
 
+/*Small second display composited over the main one, for fast-changing status widgets*/
+lv_disp_t * lv_port_disp_get_overlay(void);
+
+/*Move the overlay and set its opacity*/
+void lv_port_disp_set_overlay(lv_coord_t x, lv_coord_t y, lv_opa_t opa);
+
+/*True when the overlay is composited in software instead of by LTDC layer 2*/
+bool lv_port_disp_overlay_is_soft(void);
+
+/*Map a touch point read in the panel orientation to LVGL's orientation (LV_PORT_DISP_ROTATION)*/
+void lv_port_disp_touch_to_logical(int16_t * x, int16_t * y);
+
+/*Racing the beam: call before every lv_task_handler, the whole screen is redrawn each frame.
+ *Returns false when the mode is off*/
+bool lv_port_disp_beam_frame(void);
+
+/*Screen sized image (e.g. in flash) shown for bands not rendered in time, NULL for the background color*/
+void lv_port_disp_beam_set_fallback(const lv_color_t * img);
+
 /**********************
  *      MACROS
  **********************/
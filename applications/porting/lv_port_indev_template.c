@@ -10,8 +10,12 @@
  *      INCLUDES
  *********************/
 #include "lv_port_indev_template.h"
+#include "lv_port_disp_template.h"
 #include "../../lvgl.h"
 #include "touch_800x480.h"
+#include "touch_sampler.h"
+#include "input_replay.h"
+#include "input_keys.h"
 
 
 /*********************
@@ -28,6 +32,8 @@
 
 static void touchpad_init(void);
 static void touchpad_read(lv_indev_drv_t * indev_drv, lv_indev_data_t * data);
+static void touchpad_process(const rt_int16_t * xs, const rt_int16_t * ys, int n, uint32_t t_ms);
+static void touchpad_to_logical(rt_int16_t * xs, rt_int16_t * ys, int n);
 static bool touchpad_is_pressed(void);
 static void touchpad_get_xy(lv_coord_t * x, lv_coord_t * y);
 
@@ -38,11 +44,10 @@ static void mouse_get_xy(lv_coord_t * x, lv_coord_t * y);
 
 static void keypad_init(void);
 static void keypad_read(lv_indev_drv_t * indev_drv, lv_indev_data_t * data);
-static uint32_t keypad_get_key(void);
+static uint32_t keypad_translate(uint32_t key_id);
 
 static void encoder_init(void);
 static void encoder_read(lv_indev_drv_t * indev_drv, lv_indev_data_t * data);
-static void encoder_handler(void);
 
 static void button_init(void);
 static void button_read(lv_indev_drv_t * indev_drv, lv_indev_data_t * data);
@@ -58,8 +63,21 @@ lv_indev_t * indev_keypad;
 lv_indev_t * indev_encoder;
 lv_indev_t * indev_button;
 
-static int32_t encoder_diff;
-static lv_indev_state_t encoder_state;
+/*Zero-initialized, so the application may register its callbacks before lv_port_indev_init()*/
+static touch_gesture_t touch_gesture;
+static touch_multi_t touch_multi;
+
+/*Position reported to LVGL: the primary (oldest) contact*/
+static lv_coord_t touch_last_x = 0;
+static lv_coord_t touch_last_y = 0;
+static bool touch_last_pressed = false;
+/*Set once a second finger lands, cleared when all fingers are up*/
+static bool touch_multi_seen = false;
+
+static uint32_t keypad_last_key = 0;
+static lv_indev_state_t keypad_state = LV_INDEV_STATE_REL;
+
+static lv_indev_state_t encoder_state = LV_INDEV_STATE_REL;
 
 /**********************
  *      MACROS
@@ -84,6 +102,8 @@ void lv_port_indev_init(void)
      */
 
     static lv_indev_drv_t indev_drv;
+    static lv_indev_drv_t keypad_drv;
+    static lv_indev_drv_t encoder_drv;
 
     /*------------------
      * Touchpad
@@ -116,41 +136,36 @@ void lv_port_indev_init(void)
 //    lv_img_set_src(mouse_cursor, LV_SYMBOL_HOME);
 //    lv_indev_set_cursor(indev_mouse, mouse_cursor);
 
-//    /*------------------
-//     * Keypad
-//     * -----------------*/
-
-//    /*Initialize your keypad or keyboard if you have*/
-//    keypad_init();
-
-//    /*Register a keypad input device*/
-//    lv_indev_drv_init(&indev_drv);
-//    indev_drv.type = LV_INDEV_TYPE_KEYPAD;
-//    indev_drv.read_cb = keypad_read;
-//    indev_keypad = lv_indev_drv_register(&indev_drv);
-
-//    /*Later you should create group(s) with `lv_group_t * group = lv_group_create()`,
-//     *add objects to the group with `lv_group_add_obj(group, obj)`
-//     *and assign this input device to group to navigate in it:
-//     *`lv_indev_set_group(indev_keypad, group);`*/
+    /*------------------
+     * Keypad
+     * -----------------*/
 
-//    /*------------------
-//     * Encoder
-//     * -----------------*/
+    /*Initialize the GPIO keys and the encoder, both are optional*/
+    keypad_init();
+    encoder_init();
+
+    /*Register a keypad input device if any key is wired.
+     *The driver must outlive the indev, so each device has its own*/
+    if(input_keys_has_keypad()) {
+        lv_indev_drv_init(&keypad_drv);
+        keypad_drv.type = LV_INDEV_TYPE_KEYPAD;
+        keypad_drv.read_cb = keypad_read;
+        indev_keypad = lv_indev_drv_register(&keypad_drv);
+    }
 
-//    /*Initialize your encoder if you have*/
-//    encoder_init();
+    /*------------------
+     * Encoder
+     * -----------------*/
 
-//    /*Register a encoder input device*/
-//    lv_indev_drv_init(&indev_drv);
-//    indev_drv.type = LV_INDEV_TYPE_ENCODER;
-//    indev_drv.read_cb = encoder_read;
-//    indev_encoder = lv_indev_drv_register(&indev_drv);
+    /*Register a encoder input device*/
+    if(input_keys_has_encoder()) {
+        lv_indev_drv_init(&encoder_drv);
+        encoder_drv.type = LV_INDEV_TYPE_ENCODER;
+        encoder_drv.read_cb = encoder_read;
+        indev_encoder = lv_indev_drv_register(&encoder_drv);
+    }
 
-//    /*Later you should create group(s) with `lv_group_t * group = lv_group_create()`,
-//     *add objects to the group with `lv_group_add_obj(group, obj)`
-//     *and assign this input device to group to navigate in it:
-//     *`lv_indev_set_group(indev_encoder, group);`*/
+    /*The application creates the group and assigns it with `lv_port_indev_set_group()`*/
 
 //    /*------------------
 //     * Button
@@ -173,6 +188,25 @@ void lv_port_indev_init(void)
 //    lv_indev_set_button_points(indev_button, btn_points);
 }
 
+/*Return the gesture engine so the application can register callbacks*/
+touch_gesture_t * lv_port_indev_get_gesture(void)
+{
+    return &touch_gesture;
+}
+
+/*Return the multi-touch tracker so the application can register callbacks*/
+touch_multi_t * lv_port_indev_get_multi(void)
+{
+    return &touch_multi;
+}
+
+/*Navigate `group` with the keypad and the encoder, if they are present*/
+void lv_port_indev_set_group(lv_group_t * group)
+{
+    if(indev_keypad) lv_indev_set_group(indev_keypad, group);
+    if(indev_encoder) lv_indev_set_group(indev_encoder, group);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -187,25 +221,102 @@ static void touchpad_init(void)
     /*Your code comes here*/
 }
 
+/*Map the contacts read from the panel into LVGL's orientation*/
+static void touchpad_to_logical(rt_int16_t * xs, rt_int16_t * ys, int n)
+{
+    int i;
+
+    for(i = 0; i < n; i++) {
+        lv_port_disp_touch_to_logical(&xs[i], &ys[i]);
+    }
+}
+
+/*Assign stable IDs to the contacts (logical coordinates) and feed the gesture engines*/
+static void touchpad_process(const rt_int16_t * xs, const rt_int16_t * ys, int n, uint32_t t_ms)
+{
+    touch_frame_t frame;
+    const touch_contact_t * primary;
+
+    /*Record presses and the release that ends them*/
+    if(n > 0 || touch_last_pressed) {
+        input_replay_record(INPUT_DEV_TOUCH, n, xs, ys, t_ms);
+    }
+
+    touch_multi_track(&touch_multi, xs, ys, n, t_ms, &frame);
+    primary = touch_multi_primary(&frame);
+
+    if(frame.count >= 2 && !touch_multi_seen) {
+        /*Two-finger gestures take over: no single-finger fling, and the pointer stays put*/
+        touch_multi_seen = true;
+        touch_gesture_cancel(&touch_gesture);
+    }
+
+    if(primary != NULL && !touch_multi_seen) {
+        touch_last_x = primary->x;
+        touch_last_y = primary->y;
+    }
+    touch_last_pressed = (frame.count > 0);
+
+    if(!touch_multi_seen) {
+        touch_gesture_feed(&touch_gesture, touch_last_x, touch_last_y, touch_last_pressed, t_ms);
+    }
+
+    if(frame.count == 0) {
+        touch_multi_seen = false;
+    }
+}
+
 /*Will be called by the library to read the touchpad*/
 static void touchpad_read(lv_indev_drv_t * indev_drv, lv_indev_data_t * data)
 {
-    static lv_coord_t last_x = 0;
-    static lv_coord_t last_y = 0;
-
-    /*Save the pressed coordinates and the state*/
-	if(touchInfo.flag == 1) 
-	{
-			last_x = touchInfo.x[0];
-			last_y = touchInfo.y[0];
-        data->state = LV_INDEV_STATE_PR;
+    static bool replaying = false;
+    touch_sampler_sample_t sample;
+    input_event_t event;
+
+    if(input_replay_is_playing(INPUT_DEV_TOUCH)) {
+        /*Replay recorded frames (already in logical coordinates) in place of the hardware, discarding live samples*/
+        replaying = true;
+        while(touch_sampler_pop(&sample));
+        while(input_replay_next(INPUT_DEV_TOUCH, &event)) {
+            touchpad_process(event.x, event.y, event.count, event.t_ms);
+        }
+    } else if(replaying) {
+        /*Replay ended, release any contact it left pressed.
+         *A fast replay runs ahead of the clock: never stamp the release before the last replayed frame*/
+        uint32_t t_ms = lv_tick_get();
+        uint32_t last_ms = input_replay_last_ms(INPUT_DEV_TOUCH);
+
+        replaying = false;
+        if((int32_t)(last_ms - t_ms) > 0) t_ms = last_ms;
+        touchpad_process(NULL, NULL, 0, t_ms);
+    } else if(touch_sampler_is_running()) {
+        /*Drain all timestamped samples taken by the adaptive sampler since the last read*/
+        while(touch_sampler_pop(&sample)) {
+            touchpad_to_logical(sample.x, sample.y, sample.count);
+            touchpad_process(sample.x, sample.y, sample.count, sample.t_ms);
+        }
     } else {
-        data->state = LV_INDEV_STATE_REL;
+        /*No sampler: read the points scanned by the LVGL loop*/
+        int n = 0;
+        int i;
+
+        if(touchInfo.flag == 1) {
+            n = touchInfo.num;
+            if(n > TOUCH_MULTI_MAX_CONTACTS) n = TOUCH_MULTI_MAX_CONTACTS;
+            if(n < 1) n = 1;
+        }
+        for(i = 0; i < n; i++) {
+            sample.x[i] = touchInfo.x[i];
+            sample.y[i] = touchInfo.y[i];
+        }
+        touchpad_to_logical(sample.x, sample.y, n);
+        touchpad_process(sample.x, sample.y, n, lv_tick_get());
     }
 
-    /*Set the last pressed coordinates*/
-    data->point.x = last_x;
-    data->point.y = last_y;
+    /*Set the last pressed coordinates and the state*/
+    data->state = touch_last_pressed ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL;
+    data->point.x = touch_last_x;
+    data->point.y = touch_last_y;
 }
 
 /*Return true is the touchpad is pressed*/
@@ -226,10 +337,9 @@ static bool touchpad_is_pressed(void)
 /*Get the x and y coordinates if the touchpad is pressed*/
 static void touchpad_get_xy(lv_coord_t * x, lv_coord_t * y)
 {
-    /*Your code comes here*/
-
-    (*x) = touchInfo.x[0];
-    (*y) = touchInfo.y[0];
+    /*The primary contact; other contacts are reported through the multi-touch tracker*/
+    (*x) = touch_last_x;
+    (*y) = touch_last_y;
 }
 
 /*------------------
@@ -280,84 +390,117 @@ static void mouse_get_xy(lv_coord_t * x, lv_coord_t * y)
 /*Initialize your keypad*/
 static void keypad_init(void)
 {
-    /*Your code comes here*/
+    /*Keys and encoder share one driver; it attaches edge interrupts to the configured pins*/
+    input_keys_init();
 }
 
-/*Will be called by the library to read the mouse*/
+/*Will be called by the library to read the keypad.
+ *One debounced edge is reported per call, `continue_reading` drains the rest in the same cycle*/
 static void keypad_read(lv_indev_drv_t * indev_drv, lv_indev_data_t * data)
 {
-    static uint32_t last_key = 0;
-
-    /*Get the current x and y coordinates*/
-    mouse_get_xy(&data->point.x, &data->point.y);
-
-    /*Get whether the a key is pressed and save the pressed key*/
-    uint32_t act_key = keypad_get_key();
-    if(act_key != 0) {
-        data->state = LV_INDEV_STATE_PR;
-
-        /*Translate the keys to LVGL control characters according to your key definitions*/
-        switch(act_key) {
-        case 1:
-            act_key = LV_KEY_NEXT;
-            break;
-        case 2:
-            act_key = LV_KEY_PREV;
-            break;
-        case 3:
-            act_key = LV_KEY_LEFT;
-            break;
-        case 4:
-            act_key = LV_KEY_RIGHT;
-            break;
-        case 5:
-            act_key = LV_KEY_ENTER;
-            break;
+    static bool replaying = false;
+    input_key_event_t ev;
+    input_event_t event;
+
+    if(input_replay_is_playing(INPUT_DEV_KEYPAD)) {
+        replaying = true;
+        while(input_keys_keypad_pop(&ev));
+        if(input_replay_next(INPUT_DEV_KEYPAD, &event)) {
+            keypad_last_key = event.x[0];
+            keypad_state = event.count ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL;
         }
-
-        last_key = act_key;
-    } else {
-        data->state = LV_INDEV_STATE_REL;
+    } else if(replaying) {
+        /*Replay ended, release the key it left pressed*/
+        replaying = false;
+        keypad_state = LV_INDEV_STATE_REL;
+    } else if(input_keys_keypad_pop(&ev)) {
+        rt_int16_t key;
+
+        keypad_last_key = keypad_translate(ev.code);
+        keypad_state = ev.value ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL;
+        key = (rt_int16_t)keypad_last_key;
+        input_replay_record(INPUT_DEV_KEYPAD, ev.value, &key, NULL, ev.t_ms);
+        data->continue_reading = input_keys_keypad_pending();
     }
 
-    data->key = last_key;
+    data->state = keypad_state;
+    data->key = keypad_last_key;
 }
 
-/*Get the currently being pressed key.  0 if no key is pressed*/
-static uint32_t keypad_get_key(void)
+/*Translate the key IDs of the driver to LVGL control characters*/
+static uint32_t keypad_translate(uint32_t key_id)
 {
-    /*Your code comes here*/
-
-    return 0;
+    switch(key_id) {
+    case INPUT_KEY_UP:
+        return LV_KEY_UP;
+    case INPUT_KEY_DOWN:
+        return LV_KEY_DOWN;
+    case INPUT_KEY_ENTER:
+        return LV_KEY_ENTER;
+    case INPUT_KEY_ESC:
+        return LV_KEY_ESC;
+    case INPUT_KEY_NEXT:
+        return LV_KEY_NEXT;
+    case INPUT_KEY_PREV:
+        return LV_KEY_PREV;
+    default:
+        return 0;
+    }
 }
 
 /*------------------
  * Encoder
  * -----------------*/
 
-/*Initialize your keypad*/
+/*Initialize your encoder*/
 static void encoder_init(void)
 {
-    /*Your code comes here*/
+    /*Done by keypad_init(), see input_keys_init()*/
 }
 
-/*Will be called by the library to read the encoder*/
+/*Will be called by the library to read the encoder.
+ *All pending steps are summed; a button edge ends the read so presses and turns keep their order*/
 static void encoder_read(lv_indev_drv_t * indev_drv, lv_indev_data_t * data)
 {
+    static bool replaying = false;
+    input_key_event_t ev;
+    input_event_t event;
+    int32_t diff = 0;
+    uint32_t t_ms = 0;
+    bool changed = false;
+
+    if(input_replay_is_playing(INPUT_DEV_ENCODER)) {
+        replaying = true;
+        while(input_keys_encoder_pop(&ev));
+        if(input_replay_next(INPUT_DEV_ENCODER, &event)) {
+            diff = event.x[0];
+            encoder_state = event.count ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL;
+        }
+    } else if(replaying) {
+        replaying = false;
+        encoder_state = LV_INDEV_STATE_REL;
+    } else {
+        while(input_keys_encoder_pop(&ev)) {
+            t_ms = ev.t_ms;
+            if(ev.code == INPUT_ENCODER_ROTATE) {
+                diff += ev.value;
+            } else {
+                encoder_state = ev.value ? LV_INDEV_STATE_PR : LV_INDEV_STATE_REL;
+                changed = true;
+                break;
+            }
+        }
+        if(diff != 0 || changed) {
+            rt_int16_t d = (rt_int16_t)diff;
+            input_replay_record(INPUT_DEV_ENCODER, encoder_state == LV_INDEV_STATE_PR, &d, NULL, t_ms);
+        }
+        data->continue_reading = input_keys_encoder_pending();
+    }
 
-    data->enc_diff = encoder_diff;
+    data->enc_diff = (int16_t)diff;
     data->state = encoder_state;
 }
 
-/*Call this function in an interrupt to process encoder events (turn, press)*/
-static void encoder_handler(void)
-{
-    /*Your code comes here*/
-
-    encoder_diff += 0;
-    encoder_state = LV_INDEV_STATE_REL;
-}
-
 /*------------------
  * Button
  * -----------------*/
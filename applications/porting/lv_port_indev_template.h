@@ -18,6 +18,8 @@ extern "C" {
  *      INCLUDES
  *********************/
 #include "lvgl.h"
+#include "touch_gesture.h"
+#include "touch_multi.h"
 
 /*********************
  *      DEFINES
@@ -32,6 +34,15 @@ extern "C" {
  **********************/
 void lv_port_indev_init(void);
 
+/*Gesture engine fed by the touchpad read callback*/
+touch_gesture_t * lv_port_indev_get_gesture(void);
+
+/*Multi-touch tracker with two-finger scroll and pinch events*/
+touch_multi_t * lv_port_indev_get_multi(void);
+
+/*Assign the focus group navigated by the GPIO keypad and the rotary encoder*/
+void lv_port_indev_set_group(lv_group_t * group);
+
 /**********************
  *      MACROS
  **********************/
@@ -0,0 +1,883 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include <stdlib.h>
+#include "rview.h"
+#include "fb_copy.h"
+#include "app_perf.h"
+
+#define DBG_TAG "rview"
+#define DBG_LVL DBG_INFO
+#include <rtdbg.h>
+
+static rt_uint16_t *rview_shadow = RT_NULL;
+static rt_uint16_t *rview_sent = RT_NULL;
+static rt_uint16_t rview_width, rview_height;
+static link_transport_t *rview_link = RT_NULL;
+static volatile bool rview_running = false;
+static volatile bool rview_busy = false;       /* 编码线程正在处理work中的区域 */
+static volatile bool rview_full = false;       /* 下次复制整个屏幕 */
+static rt_tick_t rview_interval;
+static rt_tick_t rview_last;
+
+/* pending只在LVGL线程中访问，work在复制时交给编码线程 */
+static disp_area_t pending[RVIEW_AREAS_MAX];
+static rt_size_t pending_cnt;
+static bool pending_force;
+static disp_area_t work[RVIEW_AREAS_MAX];
+static rt_size_t work_cnt;
+static bool work_force;                         /* 不和已发送的内容比较，全部发送 */
+
+static rt_uint16_t rview_seq;
+static rview_stats_t rview_stats;
+
+static struct rt_thread rview_thread;
+static rt_uint8_t rview_thread_stack[RVIEW_THREAD_STACK];
+static struct rt_semaphore rview_sem;
+static bool rview_thread_started = false;
+
+/* 编码线程的缓冲区 */
+static rt_uint16_t band_pixels[RVIEW_BAND_PIXELS];
+static rt_uint8_t band_body[RVIEW_BODY_MAX];
+static rt_uint8_t band_packet[RVIEW_BODY_MAX + RVIEW_PACKET_OVERHEAD];
+
+/* ==================== 编码 ==================== */
+
+static void put_u16(rt_uint8_t *p, rt_uint16_t v)
+{
+    p[0] = (rt_uint8_t)(v & 0xFF);
+    p[1] = (rt_uint8_t)(v >> 8);
+}
+
+static rt_uint16_t get_u16(const rt_uint8_t *p)
+{
+    return (rt_uint16_t)(p[0] | (p[1] << 8));
+}
+
+/* CRC-16/CCITT-FALSE */
+static rt_uint16_t crc16(const rt_uint8_t *data, rt_size_t len)
+{
+    rt_uint16_t crc = 0xFFFF;
+
+    while (len--)
+    {
+        crc ^= (rt_uint16_t)(*data++) << 8;
+        for (int i = 0; i < 8; i++)
+            crc = (crc & 0x8000) ? (rt_uint16_t)((crc << 1) ^ 0x1021) : (rt_uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+/* PackBits编码，out为RT_NULL时只计算长度 */
+static rt_size_t encode_rle(const rt_uint16_t *px, rt_size_t count, rt_uint8_t *out)
+{
+    rt_size_t i = 0, n = 0;
+
+    while (i < count)
+    {
+        rt_size_t run = 1, lit = 1;
+
+        while (i + run < count && run < 128 && px[i + run] == px[i])
+            run++;
+        if (run >= 2)
+        {
+            if (out != RT_NULL)
+            {
+                out[n] = (rt_uint8_t)(run - 1);
+                put_u16(out + n + 1, px[i]);
+            }
+            n += 3;
+            i += run;
+            continue;
+        }
+
+        /* 原样复制，直到下一段重复的像素 */
+        while (i + lit < count && lit < 128 && !(i + lit + 1 < count && px[i + lit] == px[i + lit + 1]))
+            lit++;
+        if (out != RT_NULL)
+        {
+            out[n] = (rt_uint8_t)(0x80 + lit - 1);
+            for (rt_size_t k = 0; k < lit; k++)
+                put_u16(out + n + 1 + k * 2, px[i + k]);
+        }
+        n += 1 + lit * 2;
+        i += lit;
+    }
+    return n;
+}
+
+/* 统计颜色，超过RVIEW_PALETTE_MAX种时返回0 */
+static rt_size_t build_palette(const rt_uint16_t *px, rt_size_t count, rt_uint16_t *colors)
+{
+    rt_size_t n = 0, last = 0;
+
+    for (rt_size_t i = 0; i < count; i++)
+    {
+        rt_size_t k;
+
+        if (n > 0 && colors[last] == px[i])
+            continue;
+        for (k = 0; k < n && colors[k] != px[i]; k++)
+            ;
+        if (k == n)
+        {
+            if (n == RVIEW_PALETTE_MAX)
+                return 0;
+            colors[n++] = px[i];
+        }
+        last = k;
+    }
+    return n;
+}
+
+static rt_size_t palette_bits(rt_size_t n)
+{
+    return (n <= 2) ? 1 : (n <= 4) ? 2 : 4;
+}
+
+static rt_size_t encode_palette(const rt_uint16_t *px, rt_size_t count, const rt_uint16_t *colors,
+                                rt_size_t n, rt_uint8_t *out)
+{
+    rt_size_t bits = palette_bits(n);
+    rt_size_t idx_len = (count * bits + 7) / 8;
+    rt_uint8_t *idx = out + 1 + n * 2;
+    rt_size_t last = 0;
+
+    out[0] = (rt_uint8_t)n;
+    for (rt_size_t k = 0; k < n; k++)
+        put_u16(out + 1 + k * 2, colors[k]);
+    rt_memset(idx, 0, idx_len);
+    for (rt_size_t i = 0; i < count; i++)
+    {
+        if (colors[last] != px[i])
+        {
+            for (last = 0; colors[last] != px[i]; last++)
+                ;
+        }
+        idx[(i * bits) / 8] |= (rt_uint8_t)(last << ((i * bits) % 8));
+    }
+    return 1 + n * 2 + idx_len;
+}
+
+rt_size_t rview_encode(const rt_uint16_t *pixels, rt_size_t count, rt_uint8_t *out)
+{
+    rt_uint16_t colors[RVIEW_PALETTE_MAX];
+    rt_size_t raw_len = count * 2;
+    rt_size_t rle_len = encode_rle(pixels, count, RT_NULL);
+    rt_size_t n = build_palette(pixels, count, colors);
+    rt_size_t pal_len = n ? 1 + n * 2 + (count * palette_bits(n) + 7) / 8 : raw_len + 1;
+
+    if (pal_len <= rle_len && pal_len < raw_len)
+    {
+        out[0] = RVIEW_ENC_PALETTE;
+        return 1 + encode_palette(pixels, count, colors, n, out + 1);
+    }
+    if (rle_len < raw_len)
+    {
+        out[0] = RVIEW_ENC_RLE;
+        return 1 + encode_rle(pixels, count, out + 1);
+    }
+    out[0] = RVIEW_ENC_RAW;
+    for (rt_size_t i = 0; i < count; i++)
+        put_u16(out + 1 + i * 2, pixels[i]);
+    return 1 + raw_len;
+}
+
+rt_err_t rview_decode(const rt_uint8_t *in, rt_size_t len, rt_uint16_t *pixels, rt_size_t count)
+{
+    const rt_uint8_t *end = in + len;
+    rt_size_t n = 0;
+
+    if (len < 1)
+        return -RT_EINVAL;
+
+    switch (*in++)
+    {
+    case RVIEW_ENC_RAW:
+        if (len != 1 + count * 2)
+            return -RT_EINVAL;
+        for (rt_size_t i = 0; i < count; i++)
+            pixels[i] = get_u16(in + i * 2);
+        return RT_EOK;
+
+    case RVIEW_ENC_RLE:
+        while (in < end)
+        {
+            rt_uint8_t h = *in++;
+
+            if (h < 0x80)
+            {
+                rt_size_t run = h + 1;
+                rt_uint16_t c;
+
+                if (end - in < 2 || n + run > count)
+                    return -RT_EINVAL;
+                c = get_u16(in);
+                in += 2;
+                while (run--)
+                    pixels[n++] = c;
+            }
+            else
+            {
+                rt_size_t lit = h - 0x7F;
+
+                if ((rt_size_t)(end - in) < lit * 2 || n + lit > count)
+                    return -RT_EINVAL;
+                for (rt_size_t k = 0; k < lit; k++, in += 2)
+                    pixels[n++] = get_u16(in);
+            }
+        }
+        return (n == count) ? RT_EOK : -RT_EINVAL;
+
+    case RVIEW_ENC_PALETTE:
+    {
+        rt_size_t ncol, bits;
+        const rt_uint8_t *idx;
+
+        if (len < 2)
+            return -RT_EINVAL;
+        ncol = in[0];
+        if (ncol == 0 || ncol > RVIEW_PALETTE_MAX)
+            return -RT_EINVAL;
+        bits = palette_bits(ncol);
+        if (len != 2 + ncol * 2 + (count * bits + 7) / 8)
+            return -RT_EINVAL;
+        idx = in + 1 + ncol * 2;
+        for (rt_size_t i = 0; i < count; i++)
+        {
+            rt_size_t v = (idx[(i * bits) / 8] >> ((i * bits) % 8)) & ((1u << bits) - 1);
+
+            if (v >= ncol)
+                return -RT_EINVAL;
+            pixels[i] = get_u16(in + 1 + v * 2);
+        }
+        return RT_EOK;
+    }
+
+    default:
+        return -RT_EINVAL;
+    }
+}
+
+rt_size_t rview_packet(rt_uint8_t *out, rt_uint8_t type, const rt_uint8_t *body, rt_size_t len)
+{
+    out[0] = RVIEW_MAGIC0;
+    out[1] = RVIEW_MAGIC1;
+    out[2] = type;
+    put_u16(out + 3, (rt_uint16_t)len);
+    if (body != out + 5)
+        rt_memmove(out + 5, body, len);
+    put_u16(out + 5 + len, crc16(out + 2, len + 3));
+    return len + RVIEW_PACKET_OVERHEAD;
+}
+
+/* ==================== 接收端 ==================== */
+
+void rview_parser_init(rview_parser_t *parser, rt_uint16_t *fb, rt_uint16_t width, rt_uint16_t height)
+{
+    rt_memset(parser, 0, sizeof(rview_parser_t));
+    parser->fb = fb;
+    parser->width = width;
+    parser->height = height;
+}
+
+static void parser_handle(rview_parser_t *p, rt_uint8_t type, const rt_uint8_t *body, rt_size_t len)
+{
+    rt_uint16_t x, y, w, h;
+
+    switch (type)
+    {
+    case RVIEW_PKT_FRAME_BEGIN:
+        if (len != 6 || get_u16(body + 2) != p->width || get_u16(body + 4) != p->height)
+            p->decode_errors++;
+        break;
+
+    case RVIEW_PKT_RECT:
+        if (len < RVIEW_RECT_HEADER + 1)
+        {
+            p->decode_errors++;
+            break;
+        }
+        x = get_u16(body);
+        y = get_u16(body + 2);
+        w = get_u16(body + 4);
+        h = get_u16(body + 6);
+        if (w == 0 || h == 0 || x + w > p->width || y + h > p->height || w * h > RVIEW_BAND_PIXELS ||
+            rview_decode(body + RVIEW_RECT_HEADER, len - RVIEW_RECT_HEADER, p->pixels, w * h) != RT_EOK)
+        {
+            p->decode_errors++;
+            break;
+        }
+        fb_copy_rect(p->fb + y * p->width + x, p->width * 2, p->pixels, w * 2, w * 2, h);
+        p->rects++;
+        break;
+
+    case RVIEW_PKT_FRAME_END:
+        p->frames++;
+        break;
+
+    default:
+        p->decode_errors++;
+        break;
+    }
+}
+
+void rview_parser_input(rview_parser_t *parser, const rt_uint8_t *data, rt_size_t len)
+{
+    rview_parser_t *p = parser;
+
+    for (rt_size_t i = 0; i < len; i++)
+    {
+        rt_uint8_t b = data[i];
+        rt_size_t body_len;
+
+        /* 寻找包头 */
+        if ((p->pos == 0 && b != RVIEW_MAGIC0) || (p->pos == 1 && b != RVIEW_MAGIC1))
+        {
+            p->skipped_bytes += p->pos + 1;
+            p->pos = 0;
+            if (b == RVIEW_MAGIC0)
+            {
+                p->buf[p->pos++] = b;
+                p->skipped_bytes--;
+            }
+            continue;
+        }
+
+        p->buf[p->pos++] = b;
+        if (p->pos < 5)
+            continue;
+        body_len = get_u16(p->buf + 3);
+        if (body_len > RVIEW_BODY_MAX)
+        {
+            p->skipped_bytes += p->pos;
+            p->pos = 0;
+            continue;
+        }
+        if (p->pos < body_len + RVIEW_PACKET_OVERHEAD)
+            continue;
+
+        if (crc16(p->buf + 2, body_len + 3) == get_u16(p->buf + 5 + body_len))
+            parser_handle(p, p->buf[2], p->buf + 5, body_len);
+        else
+            p->crc_errors++;
+        p->pos = 0;
+    }
+}
+
+/* ==================== 区域记录和复制 ==================== */
+
+static void pending_add(const disp_area_t *area)
+{
+    disp_area_t a = *area;
+
+    if (a.x1 < 0) a.x1 = 0;
+    if (a.y1 < 0) a.y1 = 0;
+    if (a.x2 >= rview_width) a.x2 = rview_width - 1;
+    if (a.y2 >= rview_height) a.y2 = rview_height - 1;
+    if (a.x1 > a.x2 || a.y1 > a.y2)
+        return;
+
+    for (rt_size_t i = 0; i < pending_cnt; i++)
+    {
+        if (a.x1 >= pending[i].x1 && a.y1 >= pending[i].y1 && a.x2 <= pending[i].x2 && a.y2 <= pending[i].y2)
+            return;
+    }
+
+    /* 记录满时全部合并为外接矩形 */
+    if (pending_cnt == RVIEW_AREAS_MAX)
+    {
+        for (rt_size_t i = 1; i < pending_cnt; i++)
+        {
+            if (pending[i].x1 < pending[0].x1) pending[0].x1 = pending[i].x1;
+            if (pending[i].y1 < pending[0].y1) pending[0].y1 = pending[i].y1;
+            if (pending[i].x2 > pending[0].x2) pending[0].x2 = pending[i].x2;
+            if (pending[i].y2 > pending[0].y2) pending[0].y2 = pending[i].y2;
+        }
+        if (a.x1 < pending[0].x1) pending[0].x1 = a.x1;
+        if (a.y1 < pending[0].y1) pending[0].y1 = a.y1;
+        if (a.x2 > pending[0].x2) pending[0].x2 = a.x2;
+        if (a.y2 > pending[0].y2) pending[0].y2 = a.y2;
+        pending_cnt = 1;
+        return;
+    }
+    pending[pending_cnt++] = a;
+}
+
+/* 把记录的区域从fb复制到影子缓冲区，交给编码线程 */
+static void capture_pending(const rt_uint16_t *fb)
+{
+    rt_size_t stride = rview_width * sizeof(rt_uint16_t);
+
+    for (rt_size_t i = 0; i < pending_cnt; i++)
+    {
+        const disp_area_t *a = &pending[i];
+        rt_size_t offset = a->y1 * rview_width + a->x1;
+
+        fb_copy_rect(rview_shadow + offset, stride, fb + offset, stride,
+                     (a->x2 - a->x1 + 1) * sizeof(rt_uint16_t), a->y2 - a->y1 + 1);
+        work[i] = *a;
+    }
+    work_cnt = pending_cnt;
+    work_force = pending_force;
+    pending_cnt = 0;
+    pending_force = false;
+}
+
+static void capture_areas(const disp_area_t *areas, rt_size_t count)
+{
+    if (rview_full)
+    {
+        disp_area_t all = {0, 0, (rt_int16_t)(rview_width - 1), (rt_int16_t)(rview_height - 1)};
+
+        rview_full = false;
+        pending_force = true;
+        pending_add(&all);
+    }
+    for (rt_size_t i = 0; i < count; i++)
+        pending_add(&areas[i]);
+}
+
+void rview_capture(const rt_uint16_t *fb, const disp_area_t *areas, rt_size_t count)
+{
+    rt_uint32_t t0, us;
+
+    if (!rview_running || fb == RT_NULL)
+        return;
+
+    capture_areas(areas, count);
+    if (pending_cnt == 0)
+        return;
+
+    if (rview_busy || rt_tick_get() - rview_last < rview_interval)
+    {
+        if (count > 0)
+            rview_stats.deferred++;
+        return;
+    }
+
+    t0 = app_perf_now_cycles();
+    capture_pending(fb);
+    us = app_perf_elapsed_us(t0);
+    if (us > rview_stats.capture_us_max)
+        rview_stats.capture_us_max = us;
+    rview_stats.captures++;
+    rview_last = rt_tick_get();
+
+    rview_busy = true;
+    rt_sem_release(&rview_sem);
+}
+
+/* ==================== 编码线程 ==================== */
+
+static void send_packet(rt_uint8_t type, const rt_uint8_t *body, rt_size_t len)
+{
+    rt_size_t n = rview_packet(band_packet, type, body, len);
+
+    if (link_write(rview_link, band_packet, n) != n)
+        rview_stats.tx_errors++;
+    rview_stats.sent_bytes += n;
+}
+
+/* 条带中与已发送内容不同的部分，没有变化时返回false */
+static bool band_changed(int x, int y, int w, int h, disp_area_t *out)
+{
+    bool changed = false;
+
+    for (int row = y; row < y + h; row++)
+    {
+        const rt_uint16_t *s = rview_shadow + row * rview_width;
+        const rt_uint16_t *r = rview_sent + row * rview_width;
+        int l = x, e = x + w - 1;
+
+        if (rt_memcmp(s + x, r + x, w * 2) == 0)
+            continue;
+        while (s[l] == r[l])
+            l++;
+        while (s[e] == r[e])
+            e--;
+        if (!changed)
+        {
+            out->x1 = l;
+            out->x2 = e;
+            out->y1 = row;
+            changed = true;
+        }
+        if (l < out->x1) out->x1 = l;
+        if (e > out->x2) out->x2 = e;
+        out->y2 = row;
+    }
+    return changed;
+}
+
+/* 把work中的区域按条带编码发送，在编码线程中调用 */
+static void send_frame(void)
+{
+    rt_tick_t start = rt_tick_get();
+    rt_uint16_t rects = 0;
+    rt_uint8_t hdr[6];
+    rt_uint32_t ms;
+
+    put_u16(hdr, rview_seq);
+    put_u16(hdr + 2, rview_width);
+    put_u16(hdr + 4, rview_height);
+    send_packet(RVIEW_PKT_FRAME_BEGIN, hdr, sizeof(hdr));
+
+    for (rt_size_t i = 0; i < work_cnt; i++)
+    {
+        const disp_area_t *a = &work[i];
+        int w = a->x2 - a->x1 + 1;
+        int rows = RVIEW_BAND_PIXELS / w;
+
+        for (int y = a->y1; y <= a->y2; y += rows)
+        {
+            disp_area_t b = {a->x1, (rt_int16_t)y, a->x2, (rt_int16_t)((a->y2 - y + 1 < rows) ? a->y2 : y + rows - 1)};
+            int bw, bh;
+            rt_size_t len, offset;
+
+            /* LVGL全屏刷新时报告的区域是整个屏幕，只发送真正变化的部分 */
+            if (rview_sent != RT_NULL && !work_force && !band_changed(b.x1, b.y1, w, b.y2 - b.y1 + 1, &b))
+            {
+                rview_stats.unchanged++;
+                continue;
+            }
+            bw = b.x2 - b.x1 + 1;
+            bh = b.y2 - b.y1 + 1;
+            offset = b.y1 * rview_width + b.x1;
+            fb_copy_rect(band_pixels, bw * 2, rview_shadow + offset, rview_width * 2, bw * 2, bh);
+            if (rview_sent != RT_NULL)
+                fb_copy_rect(rview_sent + offset, rview_width * 2, band_pixels, bw * 2, bw * 2, bh);
+
+            put_u16(band_body, b.x1);
+            put_u16(band_body + 2, b.y1);
+            put_u16(band_body + 4, bw);
+            put_u16(band_body + 6, bh);
+            len = rview_encode(band_pixels, bw * bh, band_body + RVIEW_RECT_HEADER);
+            rview_stats.bands[band_body[RVIEW_RECT_HEADER]]++;
+            rview_stats.raw_bytes += bw * bh * 2;
+            send_packet(RVIEW_PKT_RECT, band_body, RVIEW_RECT_HEADER + len);
+            rects++;
+        }
+    }
+
+    put_u16(hdr, rview_seq);
+    put_u16(hdr + 2, rects);
+    send_packet(RVIEW_PKT_FRAME_END, hdr, 4);
+
+    rview_seq++;
+    rview_stats.frames++;
+    ms = (rt_tick_get() - start) * 1000 / RT_TICK_PER_SECOND;
+    if (ms > rview_stats.encode_ms_max)
+        rview_stats.encode_ms_max = ms;
+}
+
+static void rview_thread_entry(void *param)
+{
+    while (1)
+    {
+        rt_sem_take(&rview_sem, RT_WAITING_FOREVER);
+        if (rview_running)
+            send_frame();
+        rview_busy = false;
+    }
+}
+
+/* ==================== 对外接口 ==================== */
+
+rt_err_t rview_init(rt_uint16_t *shadow, rt_uint16_t *sent, rt_uint16_t width, rt_uint16_t height)
+{
+    if (shadow == RT_NULL || width == 0 || width > RVIEW_BAND_PIXELS || height == 0)
+        return -RT_EINVAL;
+
+    rview_shadow = shadow;
+    rview_sent = sent;
+    rview_width = width;
+    rview_height = height;
+    pending_cnt = 0;
+    return RT_EOK;
+}
+
+rt_err_t rview_start(link_transport_t *link, rt_uint32_t fps)
+{
+    rt_err_t err;
+
+    if (rview_shadow == RT_NULL || link == RT_NULL)
+        return -RT_EINVAL;
+    if (rview_running)
+        return -RT_EBUSY;
+    if (!link->opened && (err = link_open(link)) != RT_EOK)
+        return err;
+
+    if (!rview_thread_started)
+    {
+        rt_sem_init(&rview_sem, "rview", 0, RT_IPC_FLAG_FIFO);
+        err = rt_thread_init(&rview_thread, "rview",
+                             rview_thread_entry,
+                             RT_NULL,
+                             &rview_thread_stack[0],
+                             sizeof(rview_thread_stack),
+                             RVIEW_THREAD_PRIO,
+                             10);
+        if (err != RT_EOK)
+        {
+            LOG_E("Failed to create rview thread");
+            return err;
+        }
+        rt_thread_startup(&rview_thread);
+        rview_thread_started = true;
+    }
+
+    if (fps == 0)
+        fps = RVIEW_DEFAULT_FPS;
+    rview_link = link;
+    rview_interval = RT_TICK_PER_SECOND / fps;
+    rview_last = rt_tick_get() - rview_interval;
+    rt_memset(&rview_stats, 0, sizeof(rview_stats));
+    rview_full = true;
+    rview_running = true;
+    LOG_I("Remote view on %s, up to %d fps", link->name, fps);
+    return RT_EOK;
+}
+
+void rview_stop(void)
+{
+    rview_running = false;
+}
+
+bool rview_is_running(void)
+{
+    return rview_running;
+}
+
+void rview_refresh(void)
+{
+    rview_full = true;
+}
+
+void rview_get_stats(rview_stats_t *stats)
+{
+    *stats = rview_stats;
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static void rview_cmd(int argc, char **argv)
+{
+    rview_stats_t st;
+
+    if (argc >= 3 && rt_strcmp(argv[1], "start") == 0)
+    {
+        link_transport_t *link = link_find(argv[2]);
+        rt_err_t err;
+
+        if (link == RT_NULL)
+        {
+            rt_kprintf("no link named %s\n", argv[2]);
+            return;
+        }
+        err = rview_start(link, argc > 3 ? atoi(argv[3]) : 0);
+        if (err != RT_EOK)
+            rt_kprintf("start failed: %d\n", err);
+        return;
+    }
+    if (argc >= 2 && rt_strcmp(argv[1], "stop") == 0)
+    {
+        rview_stop();
+        return;
+    }
+    if (argc >= 2 && rt_strcmp(argv[1], "refresh") == 0)
+    {
+        rview_refresh();
+        return;
+    }
+    if (argc >= 2)
+    {
+        rt_kprintf("usage: rview [start <link> [fps] | stop | refresh]\n");
+        rt_kprintf("the link must not be the one used by the ESP32\n");
+        return;
+    }
+
+    rview_get_stats(&st);
+    rt_kprintf("remote view: %s", rview_running ? "running on " : "stopped");
+    if (rview_running)
+        rt_kprintf("%s, %d fps max", rview_link->name, RT_TICK_PER_SECOND / rview_interval);
+    rt_kprintf("\nlinks:");
+    for (link_transport_t *l = link_first(); l != RT_NULL; l = l->next)
+        rt_kprintf(" %s", l->name);
+    rt_kprintf("\nframes %d, captures %d, deferred %d, capture max %d us, encode max %d ms\n",
+               st.frames, st.captures, st.deferred, st.capture_us_max, st.encode_ms_max);
+    rt_kprintf("bands raw/rle/palette %d/%d/%d, unchanged %d, %d -> %d bytes, tx errors %d\n",
+               st.bands[RVIEW_ENC_RAW], st.bands[RVIEW_ENC_RLE], st.bands[RVIEW_ENC_PALETTE],
+               st.unchanged, st.raw_bytes, st.sent_bytes, st.tx_errors);
+}
+MSH_CMD_EXPORT_ALIAS(rview_cmd, rview, remote view of the screen: rview [start <link> [fps] | stop | refresh]);
+
+#ifdef APP_USING_TEST
+#include "app_test.h"
+
+/* ==================== 编解码和数据流测试 ==================== */
+
+#define TEST_W          96
+#define TEST_H          64
+#define TEST_FRAMES     40
+
+static rt_uint16_t test_fb[TEST_W * TEST_H];
+static rt_uint16_t test_shadow[TEST_W * TEST_H];
+static rt_uint16_t test_sent[TEST_W * TEST_H];
+static rt_uint16_t test_view[TEST_W * TEST_H];
+static rt_uint16_t test_px[RVIEW_BAND_PIXELS];
+static rt_uint16_t test_out[RVIEW_BAND_PIXELS];
+static rt_uint8_t test_enc[1 + RVIEW_BAND_PIXELS * 2];
+static rview_parser_t test_parser;
+
+/* 像素内容：纯色、少量颜色（文字和图标）、渐变、噪声 */
+static void test_fill(rt_uint16_t *px, rt_size_t count, int kind)
+{
+    rt_uint16_t base = (rt_uint16_t)app_test_rand(0x10000);
+
+    for (rt_size_t i = 0; i < count; i++)
+    {
+        switch (kind)
+        {
+        case 0: px[i] = base; break;
+        case 1: px[i] = (app_test_rand(8) == 0) ? 0x0000 : base; break;
+        case 2: px[i] = (rt_uint16_t)(base + app_test_rand(1 + app_test_rand(16))); break;
+        case 3: px[i] = (rt_uint16_t)(base + i / 7); break;
+        default: px[i] = (rt_uint16_t)app_test_rand(0x10000); break;
+        }
+    }
+}
+
+static void test_loopback_rx(void *ctx, const rt_uint8_t *data, rt_size_t len)
+{
+    rview_parser_input(&test_parser, data, len);
+}
+
+static void rview_test_cmd(int argc, char **argv)
+{
+    static link_transport_t lb_dev, lb_host;
+    static const rt_uint8_t noise[] = {'R', 0x00, 'R', 'V', 0x02, 0xFF, 0xFF, 0x55, 'V', 'R'};
+    rt_uint32_t codec_errors = 0, trunc_errors = 0, stream_errors = 0;
+    rt_uint32_t used[RVIEW_ENC_NUM] = {0};
+    rt_uint16_t *saved_shadow = rview_shadow, *saved_sent = rview_sent;
+    rt_uint16_t saved_w = rview_width, saved_h = rview_height;
+    link_transport_t *saved_link = rview_link;
+    rt_uint32_t raw0, sent0, unchanged0;
+
+    if (rview_running)
+    {
+        rt_kprintf("stop rview first\n");
+        return;
+    }
+
+    /* 编解码往返，截断的数据必须报错 */
+    app_test_srand(1);
+    for (int i = 0; i < 3000; i++)
+    {
+        rt_size_t count = 1 + app_test_rand(RVIEW_BAND_PIXELS);
+        rt_size_t len;
+
+        test_fill(test_px, count, i % 5);
+        len = rview_encode(test_px, count, test_enc);
+        used[test_enc[0]]++;
+        if (len > 1 + count * 2 || rview_decode(test_enc, len, test_out, count) != RT_EOK ||
+            rt_memcmp(test_px, test_out, count * 2) != 0)
+            codec_errors++;
+        if (rview_decode(test_enc, len - 1, test_out, count) == RT_EOK)
+            trunc_errors++;
+    }
+
+    /* 数据流：逻辑帧中随机区域变化，经回环传给接收端，中间插入噪声和损坏的包，
+     * 有时像全屏刷新一样报告整个屏幕，中途查看端重新连接 */
+    rview_init(test_shadow, test_sent, TEST_W, TEST_H);
+    link_loopback_init_pair(&lb_dev, &lb_host, "rv_dev", "rv_host");
+    link_set_rx_callback(&lb_host, test_loopback_rx, RT_NULL);
+    link_open(&lb_dev);
+    link_open(&lb_host);
+    rview_parser_init(&test_parser, test_view, TEST_W, TEST_H);
+    rview_link = &lb_dev;
+    raw0 = rview_stats.raw_bytes;
+    sent0 = rview_stats.sent_bytes;
+    unchanged0 = rview_stats.unchanged;
+
+    test_fill(test_fb, TEST_W * TEST_H, 4);
+    rview_refresh();
+    for (int f = 0; f < TEST_FRAMES; f++)
+    {
+        disp_area_t areas[RVIEW_AREAS_MAX + 4];
+        disp_area_t all = {0, 0, TEST_W - 1, TEST_H - 1};
+        rt_size_t n = (f == 0) ? 0 : 1 + app_test_rand(RVIEW_AREAS_MAX + 4);
+
+        if (f == TEST_FRAMES / 2)
+        {
+            rt_memset(test_view, 0, sizeof(test_view));
+            rview_refresh();
+        }
+        for (rt_size_t i = 0; i < n; i++)
+        {
+            disp_area_t *a = &areas[i];
+
+            a->x1 = app_test_rand(TEST_W);
+            a->y1 = app_test_rand(TEST_H);
+            a->x2 = a->x1 + app_test_rand(TEST_W - a->x1);
+            a->y2 = a->y1 + app_test_rand(TEST_H - a->y1);
+            for (int y = a->y1; y <= a->y2; y++)
+                test_fill(test_fb + y * TEST_W + a->x1, a->x2 - a->x1 + 1, app_test_rand(5));
+        }
+        if (f % 4 == 2)
+            capture_areas(&all, 1);
+        else
+            capture_areas(areas, n);
+        capture_pending(test_fb);
+        send_frame();
+        if (rt_memcmp(test_fb, test_view, sizeof(test_fb)) != 0)
+            stream_errors++;
+
+        if (f % 7 == 3)
+        {
+            link_write(&lb_dev, noise, sizeof(noise));
+        }
+        if (f % 11 == 5)
+        {
+            /* 损坏的包：CRC错误后丢弃 */
+            rt_uint8_t bad[16];
+            rt_size_t len = rview_packet(bad, RVIEW_PKT_FRAME_END, (const rt_uint8_t *)"\x01\x00\x00\x00", 4);
+
+            bad[6] ^= 0x10;
+            link_write(&lb_dev, bad, len);
+        }
+    }
+
+    rt_kprintf("codec: 3000 runs (raw %d, rle %d, palette %d), %d mismatches, %d truncations accepted\n",
+               used[RVIEW_ENC_RAW], used[RVIEW_ENC_RLE], used[RVIEW_ENC_PALETTE], codec_errors, trunc_errors);
+    rt_kprintf("stream: %d frames, %d received, %d rects, %d mismatched frames, %d crc errors, %d decode errors\n",
+               TEST_FRAMES, test_parser.frames, test_parser.rects, stream_errors,
+               test_parser.crc_errors, test_parser.decode_errors);
+    rt_kprintf("stream: %d raw bytes sent as %d, %d unchanged bands skipped\n", rview_stats.raw_bytes - raw0,
+               rview_stats.sent_bytes - sent0, rview_stats.unchanged - unchanged0);
+
+    rview_shadow = saved_shadow;
+    rview_sent = saved_sent;
+    rview_width = saved_w;
+    rview_height = saved_h;
+    rview_link = saved_link;
+    rview_full = true;
+    link_close(&lb_dev);
+    link_close(&lb_host);
+
+    rt_kprintf("%s\n", (codec_errors == 0 && trunc_errors == 0 && stream_errors == 0 &&
+                        test_parser.frames == TEST_FRAMES && test_parser.decode_errors == 0 &&
+                        rview_stats.unchanged > unchanged0) ? "PASS" : "FAIL");
+}
+MSH_CMD_EXPORT_ALIAS(rview_test_cmd, rview_test, check remote view codec and stream);
+#endif /* APP_USING_TEST */
+#endif /* RT_USING_FINSH */
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __RVIEW_H__
+#define __RVIEW_H__
+
+#include <rtthread.h>
+#include <stdbool.h>
+#include "link_transport.h"
+#include "disp_rotate.h"
+
+/* 远程查看：把屏幕上变化的区域压缩后通过选定的传输层发给技术支持的电脑（tools/rview.py）。
+ * disp_flush中只把变化的区域复制到影子帧缓冲区（fb_copy_rect，大区域由DMA2D完成），
+ * 编码和发送在低优先级的线程中进行，不增加刷新的延迟。
+ * 编码线程忙或者不到帧间隔时只记录区域，下次复制时从当时的帧缓冲区一起取出。
+ * 给出sent缓冲区时编码前和已发送的内容比较，只发送真正变化的部分（全屏刷新模式下LVGL报告的总是整个屏幕）。
+ *
+ * 数据流由数据包组成，CRC错误或丢失字节后在下一个包头重新同步：
+ *   'R' 'V' | 类型 | 长度(u16) | 内容 | CRC16(类型、长度、内容)，多字节整数为小端
+ *   FRAME_BEGIN: seq(u16) width(u16) height(u16)
+ *   RECT:        x(u16) y(u16) w(u16) h(u16) | 编码后的像素
+ *   FRAME_END:   seq(u16) rects(u16)
+ * 区域按行分成不超过RVIEW_BAND_PIXELS像素的条带，每条一个RECT包。
+ * 像素为RGB565，按行连续排列后编码，第一个字节为编码方式：
+ *   RAW:     像素
+ *   RLE:     PackBits，头字节h < 0x80时后面一个像素重复h+1次，否则后面h-0x7F个像素原样复制
+ *   PALETTE: 颜色数n(1..16) | n个颜色 | 索引（n<=2时1位，<=4时2位，否则4位，从字节低位开始）
+ * 编码器选择最短的一种 */
+
+#define RVIEW_MAGIC0            'R'
+#define RVIEW_MAGIC1            'V'
+#define RVIEW_PKT_FRAME_BEGIN   1
+#define RVIEW_PKT_RECT          2
+#define RVIEW_PKT_FRAME_END     3
+
+#define RVIEW_ENC_RAW           0
+#define RVIEW_ENC_RLE           1
+#define RVIEW_ENC_PALETTE       2
+#define RVIEW_ENC_NUM           3
+
+#define RVIEW_BAND_PIXELS       2048
+#define RVIEW_PALETTE_MAX       16
+#define RVIEW_RECT_HEADER       8
+#define RVIEW_BODY_MAX          (RVIEW_RECT_HEADER + 1 + RVIEW_BAND_PIXELS * 2)
+#define RVIEW_PACKET_OVERHEAD   7       /* 包头5字节和CRC16 */
+#define RVIEW_AREAS_MAX         16      /* 记录的区域更多时合并为外接矩形 */
+
+#define RVIEW_DEFAULT_FPS       5
+#define RVIEW_THREAD_STACK      2048
+#define RVIEW_THREAD_PRIO       (PKG_LVGL_THREAD_PRIO + 3)
+
+typedef struct {
+    rt_uint32_t frames;             /* 发送的帧数 */
+    rt_uint32_t captures;           /* 复制到影子缓冲区的次数 */
+    rt_uint32_t deferred;           /* 编码线程忙或不到间隔，只记录区域的刷新次数 */
+    rt_uint32_t capture_us_max;     /* disp_flush中复制的最长时间 */
+    rt_uint32_t encode_ms_max;      /* 编码和发送一帧的最长时间 */
+    rt_uint32_t raw_bytes;          /* 变化区域的原始大小 */
+    rt_uint32_t sent_bytes;
+    rt_uint32_t bands[RVIEW_ENC_NUM];   /* 按编码方式统计的条带数 */
+    rt_uint32_t unchanged;          /* 和已发送内容相同而跳过的条带数 */
+    rt_uint32_t tx_errors;
+} rview_stats_t;
+
+/* 接收端：解析数据流，把区域写入fb（宽width，高height），用于测试和板间查看 */
+typedef struct {
+    rt_uint16_t *fb;
+    rt_uint16_t width;
+    rt_uint16_t height;
+    rt_uint8_t buf[RVIEW_BODY_MAX + RVIEW_PACKET_OVERHEAD];
+    rt_size_t pos;
+    rt_uint16_t pixels[RVIEW_BAND_PIXELS];
+    rt_uint32_t frames;             /* 收到的FRAME_END数 */
+    rt_uint32_t rects;
+    rt_uint32_t crc_errors;
+    rt_uint32_t decode_errors;
+    rt_uint32_t skipped_bytes;      /* 重新同步时丢弃的字节 */
+} rview_parser_t;
+
+/* shadow和sent的大小与屏幕相同（逻辑方向），sent保存查看端现在的内容，可以为RT_NULL */
+rt_err_t rview_init(rt_uint16_t *shadow, rt_uint16_t *sent, rt_uint16_t width, rt_uint16_t height);
+/* 开始向link发送，fps为帧率上限 */
+rt_err_t rview_start(link_transport_t *link, rt_uint32_t fps);
+void rview_stop(void);
+bool rview_is_running(void);
+/* 下一帧发送整个屏幕，查看端中途连接时使用 */
+void rview_refresh(void);
+
+/* 在disp_flush中调用：fb为完整的一帧，areas为这一帧重绘的区域 */
+void rview_capture(const rt_uint16_t *fb, const disp_area_t *areas, rt_size_t count);
+
+void rview_get_stats(rview_stats_t *stats);
+
+/* 编码count个连续像素，返回写入out的字节数，out至少1 + count * 2字节 */
+rt_size_t rview_encode(const rt_uint16_t *pixels, rt_size_t count, rt_uint8_t *out);
+/* 解码出正好count个像素时返回RT_EOK */
+rt_err_t rview_decode(const rt_uint8_t *in, rt_size_t len, rt_uint16_t *pixels, rt_size_t count);
+/* 组成一个数据包，返回长度（len + RVIEW_PACKET_OVERHEAD） */
+rt_size_t rview_packet(rt_uint8_t *out, rt_uint8_t type, const rt_uint8_t *body, rt_size_t len);
+
+void rview_parser_init(rview_parser_t *parser, rt_uint16_t *fb, rt_uint16_t width, rt_uint16_t height);
+void rview_parser_input(rview_parser_t *parser, const rt_uint8_t *data, rt_size_t len);
+
+#endif /* __RVIEW_H__ */
@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include "spi_frame.h"
+
+#define BUF_FREE        0
+#define BUF_FILLING     1       /* 有数据，还可以继续写入 */
+#define BUF_READY       2       /* 已满或已交给DMA */
+
+#define BUSY_NONE       (-1)
+#define BUSY_IDLE       2
+
+#define HDR_MAGIC       0
+#define HDR_FLAGS       1
+#define HDR_SEQ         2
+#define HDR_LEN         3
+
+void spi_frame_init(spi_frame_t *f, rt_uint32_t poll_ms)
+{
+    rt_memset(f, 0, sizeof(spi_frame_t));
+    f->busy = BUSY_NONE;
+    f->poll_ms = poll_ms;
+    f->idle[HDR_MAGIC] = SPI_FRAME_MAGIC;
+}
+
+/* 按顺序写入发送缓冲区，两个缓冲区都满时只写入一部分，返回写入的字节数 */
+rt_size_t spi_frame_write(spi_frame_t *f, const void *data, rt_size_t len)
+{
+    const rt_uint8_t *p = (const rt_uint8_t *)data;
+    rt_size_t written = 0;
+
+    while (written < len)
+    {
+        rt_uint8_t *frame = f->buf[f->fill];
+        rt_size_t n;
+
+        if (f->state[f->fill] == BUF_READY)
+        {
+            f->stats.tx_full++;
+            break;
+        }
+
+        n = SPI_FRAME_PAYLOAD - frame[HDR_LEN];
+        if (n > len - written)
+            n = len - written;
+        rt_memcpy(frame + SPI_FRAME_HDR_SIZE + frame[HDR_LEN], p + written, n);
+        frame[HDR_LEN] += n;
+        written += n;
+
+        f->state[f->fill] = BUF_FILLING;
+        if (frame[HDR_LEN] == SPI_FRAME_PAYLOAD)
+        {
+            f->state[f->fill] = BUF_READY;
+            f->fill ^= 1;
+        }
+    }
+    return written;
+}
+
+bool spi_frame_pending(const spi_frame_t *f)
+{
+    return f->state[0] != BUF_FREE || f->state[1] != BUF_FREE;
+}
+
+/* 取出最早的有数据的缓冲区交给DMA，没有写满的也立即发送，之后的数据写入另一个缓冲区 */
+static const rt_uint8_t *take_frame(spi_frame_t *f)
+{
+    rt_uint8_t s = f->send;
+    rt_uint8_t *frame = f->buf[s];
+
+    if (f->state[s] == BUF_FREE)
+        return RT_NULL;
+    if (f->state[s] == BUF_FILLING)
+    {
+        f->state[s] = BUF_READY;
+        f->fill = s ^ 1;
+    }
+
+    frame[HDR_MAGIC] = SPI_FRAME_MAGIC;
+    frame[HDR_FLAGS] = (f->state[s ^ 1] != BUF_FREE) ? SPI_FRAME_F_MORE : 0;
+    frame[HDR_SEQ] = f->tx_seq;
+    f->busy = s;
+    return frame;
+}
+
+static const rt_uint8_t *idle_frame(spi_frame_t *f)
+{
+    f->idle[HDR_FLAGS] = 0;
+    f->idle[HDR_SEQ] = f->tx_seq;
+    f->idle[HDR_LEN] = 0;
+    f->busy = BUSY_IDLE;
+    return f->idle;
+}
+
+/* 主机调度：从机准备好后，有数据要发送或从机上一帧表示还有数据时立即传输，
+ * 否则每poll_ms发送一个空帧查询从机是否有新数据 */
+const rt_uint8_t *spi_frame_next(spi_frame_t *f, bool ready, rt_uint32_t now_ms)
+{
+    const rt_uint8_t *frame;
+
+    if (!ready || f->busy != BUSY_NONE)
+        return RT_NULL;
+
+    frame = take_frame(f);
+    if (frame != RT_NULL)
+        return frame;
+    if (f->peer_more || now_ms - f->last_ms >= f->poll_ms)
+        return idle_frame(f);
+    return RT_NULL;
+}
+
+/* 从机每次传输后都要重新准备一帧，主机随时可能发起传输 */
+const rt_uint8_t *spi_frame_arm(spi_frame_t *f)
+{
+    const rt_uint8_t *frame;
+
+    if (f->busy != BUSY_NONE)
+        return RT_NULL;
+
+    frame = take_frame(f);
+    return frame ? frame : idle_frame(f);
+}
+
+rt_size_t spi_frame_done(spi_frame_t *f, const rt_uint8_t *rx, rt_uint32_t now_ms,
+                         const rt_uint8_t **payload)
+{
+    bool tx_idle = (f->busy == BUSY_IDLE);
+    rt_size_t len;
+
+    /* 发送完成的缓冲区可以重新写入 */
+    if (f->busy == 0 || f->busy == 1)
+    {
+        f->stats.tx_payload += f->buf[f->busy][HDR_LEN];
+        f->buf[f->busy][HDR_LEN] = 0;
+        f->state[f->busy] = BUF_FREE;
+        f->send ^= 1;
+    }
+    f->busy = BUSY_NONE;
+    f->tx_seq++;
+    f->stats.frames++;
+    f->last_ms = now_ms;
+    *payload = RT_NULL;
+
+    if (rx[HDR_MAGIC] != SPI_FRAME_MAGIC || rx[HDR_LEN] > SPI_FRAME_PAYLOAD)
+    {
+        f->stats.rx_bad++;
+        f->peer_more = false;
+        return 0;
+    }
+
+    f->peer_more = (rx[HDR_FLAGS] & SPI_FRAME_F_MORE) != 0;
+    if (f->rx_synced && rx[HDR_SEQ] == f->rx_seq)
+    {
+        f->stats.rx_dup++;
+        return 0;
+    }
+    if (f->rx_synced && rx[HDR_SEQ] != (rt_uint8_t)(f->rx_seq + 1))
+        f->stats.rx_lost++;
+    f->rx_seq = rx[HDR_SEQ];
+    f->rx_synced = true;
+
+    len = rx[HDR_LEN];
+    if (len == 0 && tx_idle)
+        f->stats.idle_frames++;
+    f->stats.rx_payload += len;
+    *payload = rx + SPI_FRAME_HDR_SIZE;
+    return len;
+}
+
+void spi_frame_retry(spi_frame_t *f)
+{
+    f->busy = BUSY_NONE;
+}
+
+#ifdef APP_USING_TEST
+#include <finsh.h>
+#include <stdlib.h>
+
+/* ==================== 模拟从机 ==================== */
+
+#define SIM_CMD_LEN         24          /* 主机命令长度 */
+#define SIM_CMD_PERIOD_US   10000       /* 主机发送命令的间隔 */
+#define SIM_CMD_SEED        12345       /* 命令数据与任务数据使用不同的序列 */
+#define SIM_XFER_GAP_US     5           /* 片选和DMA启动开销 */
+#define SIM_STEP_US         10
+#define SIM_LIMIT_US        30000000
+
+static spi_frame_t sim_master, sim_slave;
+static rt_uint8_t sim_m_rx[SPI_FRAME_SIZE], sim_s_rx[SPI_FRAME_SIZE];
+
+static rt_uint8_t sim_byte(rt_uint32_t i)
+{
+    return (rt_uint8_t)(i * 31 + (i >> 8));
+}
+
+/* 用时间推进模拟ESP32从机：从机尽快写入bytes字节任务数据，主机每10ms发送一条命令，
+ * 每次传输后从机需要arm_us重新准备DMA缓冲区并拉高握手信号。
+ * 校验双方收到的数据顺序和内容，统计吞吐量、空帧和命令延迟 */
+static void spi_sim_cmd(int argc, char **argv)
+{
+    rt_uint32_t bytes = argc > 1 ? atoi(argv[1]) : 65536;
+    rt_uint32_t clock_khz = argc > 2 ? atoi(argv[2]) : 20000;
+    rt_uint32_t arm_us = argc > 3 ? atoi(argv[3]) : 20;
+    rt_uint32_t xfer_us, t = 0, ready_at = 0, next_cmd = 0, data_us = 0;
+    rt_uint32_t s_sent = 0, m_recv = 0, m_sent = 0, s_recv = 0, cmds = 0, done_cmds = 0;
+    rt_uint32_t cmd_t[16], lat_sum = 0, lat_max = 0, errors = 0;
+    const rt_uint8_t *m_tx, *s_tx = RT_NULL, *payload;
+    rt_uint8_t chunk[64];
+    rt_size_t n, w;
+
+    if (clock_khz == 0)
+        clock_khz = 20000;
+    xfer_us = SPI_FRAME_SIZE * 8 * 1000 / clock_khz + SIM_XFER_GAP_US;
+    spi_frame_init(&sim_master, SPI_FRAME_POLL_MS);
+    spi_frame_init(&sim_slave, 0);
+
+    while (t < SIM_LIMIT_US)
+    {
+        /* ESP32：任务数据尽快写入，缓冲区满时等下一次传输 */
+        while (s_sent < bytes)
+        {
+            n = (bytes - s_sent < sizeof(chunk)) ? bytes - s_sent : sizeof(chunk);
+            for (rt_size_t i = 0; i < n; i++)
+                chunk[i] = sim_byte(s_sent + i);
+            w = spi_frame_write(&sim_slave, chunk, n);
+            s_sent += w;
+            if (w < n)
+                break;
+        }
+
+        /* 主机：任务数据传输期间定时发送命令 */
+        if (t >= next_cmd && m_recv < bytes)
+        {
+            for (rt_size_t i = 0; i < SIM_CMD_LEN; i++)
+                chunk[i] = sim_byte(m_sent + i + SIM_CMD_SEED);
+            w = spi_frame_write(&sim_master, chunk, SIM_CMD_LEN);
+            if (w == SIM_CMD_LEN)
+                cmd_t[cmds++ & 15] = t;
+            m_sent += w;
+            next_cmd += SIM_CMD_PERIOD_US;
+        }
+
+        /* 从机重新准备好DMA缓冲区，拉高握手信号 */
+        if (s_tx == RT_NULL && t >= ready_at)
+            s_tx = spi_frame_arm(&sim_slave);
+
+        m_tx = spi_frame_next(&sim_master, s_tx != RT_NULL, t / 1000);
+        if (m_tx == RT_NULL)
+        {
+            if (m_recv >= bytes && s_recv >= m_sent)
+                break;
+            t += SIM_STEP_US;
+            continue;
+        }
+
+        /* 全双工交换一帧 */
+        t += xfer_us;
+        rt_memcpy(sim_m_rx, s_tx, SPI_FRAME_SIZE);
+        rt_memcpy(sim_s_rx, m_tx, SPI_FRAME_SIZE);
+        s_tx = RT_NULL;
+        ready_at = t + arm_us;
+
+        n = spi_frame_done(&sim_master, sim_m_rx, t / 1000, &payload);
+        for (rt_size_t i = 0; i < n; i++)
+        {
+            if (payload[i] != sim_byte(m_recv + i))
+                errors++;
+        }
+        m_recv += n;
+        if (n && m_recv >= bytes)
+            data_us = t;
+
+        n = spi_frame_done(&sim_slave, sim_s_rx, t / 1000, &payload);
+        for (rt_size_t i = 0; i < n; i++)
+        {
+            if (payload[i] != sim_byte(s_recv + SIM_CMD_SEED))
+                errors++;
+            if (++s_recv % SIM_CMD_LEN == 0)
+            {
+                rt_uint32_t lat = t - cmd_t[done_cmds++ & 15];
+                lat_sum += lat;
+                if (lat > lat_max) lat_max = lat;
+            }
+        }
+    }
+
+    rt_kprintf("spi %d kHz, %d B frames, slave arm %d us\n", clock_khz, SPI_FRAME_SIZE, arm_us);
+    rt_kprintf("task data: %d bytes in %d us (%d KB/s)\n", m_recv, data_us,
+               data_us ? (rt_uint32_t)((rt_uint64_t)m_recv * 1000000 / data_us / 1024) : 0);
+    rt_kprintf("frames %d, idle %d, payload efficiency %d%%\n", sim_master.stats.frames,
+               sim_master.stats.idle_frames,
+               sim_master.stats.frames ? (rt_uint32_t)((rt_uint64_t)m_recv * 100 / (sim_master.stats.frames * SPI_FRAME_PAYLOAD)) : 0);
+    rt_kprintf("commands %d, latency avg %d us, max %d us\n", done_cmds,
+               done_cmds ? lat_sum / done_cmds : 0, lat_max);
+    rt_kprintf("uart at 115200: %d ms, at 921600: %d ms\n",
+               (rt_uint32_t)((rt_uint64_t)bytes * 10 * 1000 / 115200),
+               (rt_uint32_t)((rt_uint64_t)bytes * 10 * 1000 / 921600));
+    rt_kprintf("errors %d, bad %d, lost %d, dup %d: %s\n", errors,
+               sim_master.stats.rx_bad + sim_slave.stats.rx_bad,
+               sim_master.stats.rx_lost + sim_slave.stats.rx_lost,
+               sim_master.stats.rx_dup + sim_slave.stats.rx_dup,
+               (errors == 0 && m_recv == bytes && s_recv == m_sent && done_cmds == cmds) ? "PASS" : "FAIL");
+}
+MSH_CMD_EXPORT_ALIAS(spi_sim_cmd, spi_sim, simulate SPI link to ESP32 [bytes] [clock_khz] [arm_us]);
+#endif /* APP_USING_TEST */
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __SPI_FRAME_H__
+#define __SPI_FRAME_H__
+
+#include <rtthread.h>
+#include <stdbool.h>
+
+/* SPI链路的帧调度和分段：每次传输双方同时交换一个固定大小的帧，
+ * 发送的字节流按顺序分段放入帧的负载，接收方把负载直接交给数据包解析，
+ * 数据包可以跨帧。每一方有两个发送帧缓冲区，一个在DMA传输时填充另一个。
+ * 主机和从机使用同一套逻辑，不依赖硬件，可以在主机上用模拟的从机测试。
+ *
+ * 帧格式：magic | flags | seq | len | payload[len] | 填充 */
+
+#define SPI_FRAME_SIZE          256     /* 每次DMA传输的字节数 */
+#define SPI_FRAME_HDR_SIZE      4
+#define SPI_FRAME_PAYLOAD       (SPI_FRAME_SIZE - SPI_FRAME_HDR_SIZE)
+#define SPI_FRAME_MAGIC         0xA5
+#define SPI_FRAME_F_MORE        0x01    /* 发送方还有数据，请求对方马上再传输一帧 */
+#define SPI_FRAME_POLL_MS       20      /* 主机空闲时查询从机数据的间隔 */
+
+typedef struct {
+    rt_uint32_t frames;             /* 完成的传输数 */
+    rt_uint32_t idle_frames;        /* 双方都没有负载的传输 */
+    rt_uint32_t tx_payload;
+    rt_uint32_t rx_payload;
+    rt_uint32_t rx_bad;             /* 帧头错误（对方没有准备好） */
+    rt_uint32_t rx_lost;            /* 序号不连续，中间的帧丢失 */
+    rt_uint32_t rx_dup;             /* 与上一帧序号相同，对方没有换新的帧 */
+    rt_uint32_t tx_full;            /* 写入时两个缓冲区都满 */
+} spi_frame_stats_t;
+
+/* 不加锁，写入和传输在不同线程时由调用者保证互斥 */
+typedef struct {
+    rt_uint8_t buf[2][SPI_FRAME_SIZE];
+    rt_uint8_t state[2];
+    rt_uint8_t fill;                /* 写入的缓冲区 */
+    rt_uint8_t send;                /* 下一个发送的缓冲区 */
+    rt_int8_t busy;                 /* 正在传输的缓冲区，-1为没有，2为空帧 */
+    rt_uint8_t idle[SPI_FRAME_SIZE];  /* 空帧，只有帧头 */
+    rt_uint8_t tx_seq;
+    rt_uint8_t rx_seq;
+    bool rx_synced;
+    bool peer_more;                 /* 对方上一帧带有MORE标志 */
+    rt_uint32_t poll_ms;
+    rt_uint32_t last_ms;            /* 上次传输完成的时间 */
+    spi_frame_stats_t stats;
+} spi_frame_t;
+
+void spi_frame_init(spi_frame_t *f, rt_uint32_t poll_ms);
+rt_size_t spi_frame_write(spi_frame_t *f, const void *data, rt_size_t len);
+bool spi_frame_pending(const spi_frame_t *f);
+
+/* 主机：ready为从机握手信号，返回本次要发送的帧，不需要传输时返回RT_NULL */
+const rt_uint8_t *spi_frame_next(spi_frame_t *f, bool ready, rt_uint32_t now_ms);
+/* 从机：准备下一次传输的帧，没有数据时为空帧 */
+const rt_uint8_t *spi_frame_arm(spi_frame_t *f);
+/* 传输完成，解析收到的帧，返回负载长度 */
+rt_size_t spi_frame_done(spi_frame_t *f, const rt_uint8_t *rx, rt_uint32_t now_ms,
+                         const rt_uint8_t **payload);
+/* 传输失败，正在传输的帧下次重发 */
+void spi_frame_retry(spi_frame_t *f);
+
+#endif /* __SPI_FRAME_H__ */
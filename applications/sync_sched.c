@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include <stdlib.h>
+#include "sync_sched.h"
+
+/* 链路忙时推迟的时间 */
+#define SYNC_SCHED_BUSY_RETRY_MS    200
+
+/* 时间比较，允许计数回绕 */
+static bool time_reached(rt_uint32_t now_ms, rt_uint32_t t_ms)
+{
+    return (rt_int32_t)(now_ms - t_ms) >= 0;
+}
+
+static void schedule_next(sync_sched_t *sched, rt_uint32_t now_ms, bool changed)
+{
+    if (changed)
+    {
+        sched->interval_ms = sched->min_ms;
+    }
+    else
+    {
+        sched->interval_ms = (sched->interval_ms > sched->max_ms / 2) ? sched->max_ms : sched->interval_ms * 2;
+    }
+    sched->next_ms = now_ms + sched->interval_ms;
+    sched->in_flight = false;
+}
+
+void sync_sched_init(sync_sched_t *sched, rt_uint32_t min_ms, rt_uint32_t max_ms,
+                     rt_uint32_t timeout_ms, rt_uint32_t now_ms)
+{
+    rt_memset(sched, 0, sizeof(sync_sched_t));
+    sched->min_ms = min_ms ? min_ms : 1;
+    sched->max_ms = (max_ms > sched->min_ms) ? max_ms : sched->min_ms;
+    sched->timeout_ms = timeout_ms;
+    sched->interval_ms = sched->min_ms;
+    sched->next_ms = now_ms;
+    sched->enabled = true;
+}
+
+/* 重新启用时立即同步一次 */
+void sync_sched_enable(sync_sched_t *sched, bool enable, rt_uint32_t now_ms)
+{
+    if (enable && !sched->enabled)
+    {
+        sched->interval_ms = sched->min_ms;
+        sched->next_ms = now_ms;
+    }
+    sched->enabled = enable;
+}
+
+bool sync_sched_poll(sync_sched_t *sched, rt_uint32_t now_ms, bool link_busy)
+{
+    if (!sched->enabled)
+        return false;
+
+    /* 等待响应期间不发新请求，超时后按无变化退避 */
+    if (sched->in_flight)
+    {
+        if (!time_reached(now_ms, sched->sent_ms + sched->timeout_ms))
+            return false;
+        sched->stats.timeouts++;
+        schedule_next(sched, now_ms, false);
+    }
+
+    if (!time_reached(now_ms, sched->next_ms))
+        return false;
+
+    if (link_busy)
+    {
+        sched->stats.busy_defers++;
+        sched->next_ms = now_ms + SYNC_SCHED_BUSY_RETRY_MS;
+        return false;
+    }
+
+    sched->in_flight = true;
+    sched->sent_ms = now_ms;
+    sched->stats.polls++;
+    return true;
+}
+
+void sync_sched_on_result(sync_sched_t *sched, rt_uint32_t now_ms, bool changed)
+{
+    if (changed)
+        sched->stats.changes++;
+    else
+        sched->stats.unchanged++;
+    schedule_next(sched, now_ms, changed);
+}
+
+void sync_sched_on_error(sync_sched_t *sched, rt_uint32_t now_ms)
+{
+    if (sched->in_flight)
+        schedule_next(sched, now_ms, false);
+}
+
+/* 已有请求在等待时不打断，响应到达后按最短间隔继续 */
+void sync_sched_on_activity(sync_sched_t *sched, rt_uint32_t now_ms)
+{
+    sched->interval_ms = sched->min_ms;
+    if (!sched->in_flight && !time_reached(now_ms + sched->min_ms, sched->next_ms))
+        sched->next_ms = now_ms + sched->min_ms;
+}
+
+void sync_sched_trigger(sync_sched_t *sched, rt_uint32_t now_ms)
+{
+    sched->interval_ms = sched->min_ms;
+    if (!sched->in_flight)
+        sched->next_ms = now_ms;
+}
+
+rt_uint32_t sync_sched_delay(const sync_sched_t *sched, rt_uint32_t now_ms)
+{
+    rt_uint32_t t = sched->in_flight ? sched->sent_ms + sched->timeout_ms : sched->next_ms;
+
+    if (!sched->enabled)
+        return RT_WAITING_FOREVER;
+    return time_reached(now_ms, t) ? 0 : t - now_ms;
+}
+
+#ifdef APP_USING_TEST
+#include <finsh.h>
+
+/* 用模拟时钟运行调度策略：ESP32在响应延迟latency后返回，
+ * 列表在change_at时刻发生变化，用户在activity_at时刻操作，打印每次请求的时间 */
+static void sync_sim_cmd(int argc, char **argv)
+{
+    sync_sched_t sched;
+    rt_uint32_t duration = argc > 1 ? atoi(argv[1]) : 600000;
+    rt_uint32_t latency = argc > 2 ? atoi(argv[2]) : 300;
+    rt_uint32_t change_at = duration / 2, activity_at = duration / 4;
+    rt_uint32_t reply_at = 0, now;
+    bool changed_pending = false;
+
+    sync_sched_init(&sched, SYNC_SCHED_MIN_MS, SYNC_SCHED_MAX_MS, SYNC_SCHED_TIMEOUT_MS, 0);
+
+    for (now = 0; now < duration; now += 10)
+    {
+        if (now == change_at)
+            changed_pending = true;
+        if (now == activity_at)
+        {
+            rt_kprintf("%7d ms  user activity\n", now);
+            sync_sched_on_activity(&sched, now);
+        }
+
+        if (sched.in_flight && now >= reply_at)
+        {
+            sync_sched_on_result(&sched, now, changed_pending);
+            if (changed_pending)
+                rt_kprintf("%7d ms  change detected\n", now);
+            changed_pending = false;
+        }
+
+        if (sync_sched_poll(&sched, now, false))
+        {
+            rt_kprintf("%7d ms  poll (interval %d ms)\n", now, sched.interval_ms);
+            reply_at = now + latency;
+        }
+    }
+
+    rt_kprintf("polls: %d, changes: %d, unchanged: %d, timeouts: %d\n",
+               sched.stats.polls, sched.stats.changes, sched.stats.unchanged, sched.stats.timeouts);
+}
+MSH_CMD_EXPORT_ALIAS(sync_sim_cmd, sync_sim, simulate sync scheduling [duration_ms] [latency_ms]);
+#endif /* APP_USING_TEST */
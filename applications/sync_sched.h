@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __SYNC_SCHED_H__
+#define __SYNC_SCHED_H__
+
+#include <rtthread.h>
+#include <stdbool.h>
+
+/* 后台同步调度：决定何时向ESP32请求任务列表。
+ * 用户操作或任务列表有变化后按最短间隔轮询，列表不变时间隔每次加倍直到最长间隔；
+ * 链路忙时推迟，同一时间只有一个请求在等待响应，超时后按无变化处理。
+ * 只做决策，不调用系统时钟和发送函数，时间由调用者传入，可以用模拟时钟测试 */
+
+#define SYNC_SCHED_MIN_MS       2000        /* 最短轮询间隔 */
+#define SYNC_SCHED_MAX_MS       60000       /* 最长轮询间隔 */
+#define SYNC_SCHED_TIMEOUT_MS   5000        /* 等待响应的超时时间 */
+
+typedef struct {
+    rt_uint32_t polls;          /* 发出的请求数 */
+    rt_uint32_t changes;        /* 响应中列表有变化的次数 */
+    rt_uint32_t unchanged;      /* 响应中列表没有变化的次数 */
+    rt_uint32_t timeouts;       /* 超时没有响应的次数 */
+    rt_uint32_t busy_defers;    /* 因链路忙推迟的次数 */
+} sync_sched_stats_t;
+
+typedef struct {
+    rt_uint32_t min_ms;
+    rt_uint32_t max_ms;
+    rt_uint32_t timeout_ms;
+    rt_uint32_t interval_ms;    /* 当前轮询间隔 */
+    rt_uint32_t next_ms;        /* 下一次轮询的时间 */
+    rt_uint32_t sent_ms;        /* 正在等待的请求的发出时间 */
+    bool in_flight;             /* 有请求在等待响应 */
+    bool enabled;
+    sync_sched_stats_t stats;
+} sync_sched_t;
+
+void sync_sched_init(sync_sched_t *sched, rt_uint32_t min_ms, rt_uint32_t max_ms,
+                     rt_uint32_t timeout_ms, rt_uint32_t now_ms);
+void sync_sched_enable(sync_sched_t *sched, bool enable, rt_uint32_t now_ms);
+
+/* 定期调用，返回true时调用者应立即发出一次请求 */
+bool sync_sched_poll(sync_sched_t *sched, rt_uint32_t now_ms, bool link_busy);
+/* 收到任务列表（无论是否由调度器发起），changed表示列表有变化 */
+void sync_sched_on_result(sync_sched_t *sched, rt_uint32_t now_ms, bool changed);
+/* 请求发送失败 */
+void sync_sched_on_error(sync_sched_t *sched, rt_uint32_t now_ms);
+/* 用户操作后尽快同步 */
+void sync_sched_on_activity(sync_sched_t *sched, rt_uint32_t now_ms);
+/* 手动刷新：没有请求在等待时下一次调用sync_sched_poll就发出请求 */
+void sync_sched_trigger(sync_sched_t *sched, rt_uint32_t now_ms);
+/* 距下一次需要调用sync_sched_poll的时间 */
+rt_uint32_t sync_sched_delay(const sync_sched_t *sched, rt_uint32_t now_ms);
+
+#endif /* __SYNC_SCHED_H__ */
@@ -0,0 +1,426 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include <stdlib.h>
+#include "task_diff.h"
+#include "app_perf.h"
+
+#define DBG_TAG "task.diff"
+#define DBG_LVL DBG_INFO
+#include <rtdbg.h>
+
+/* 每个位置的状态 */
+#define DIFF_SKIP           0x00    /* 重复或无法加入 */
+#define DIFF_MATCHED        0x01    /* 存储中已有 */
+#define DIFF_INSERTED       0x02    /* 新增 */
+#define DIFF_STABLE         0x10    /* 在最长递增子序列中，顺序不动 */
+
+#define DIFF_NO_POS         0xFFFFFFFF
+#define DIFF_NO_BOUND       0xFFFFFFFF
+
+/* 改动超过这个数量且超过列表的四分之一时，视图在结束时整体排序一次 */
+#define DIFF_BATCH_MIN      16
+
+static bool task_same(const task_info_t *a, const task_info_t *b)
+{
+    return a->list_num == b->list_num && a->task_num == b->task_num &&
+           a->status == b->status &&
+           rt_strcmp(a->title, b->title) == 0 &&
+           rt_strcmp(a->list_name, b->list_name) == 0;
+}
+
+static void diff_emit(task_diff_t *diff, task_diff_op_t op, task_id_t id)
+{
+    if (diff->cb)
+        diff->cb(diff->ctx, op, id);
+}
+
+/* ==================== 接口函数 ==================== */
+
+rt_err_t task_diff_init(task_diff_t *diff, rt_uint32_t capacity)
+{
+    rt_memset(diff, 0, sizeof(task_diff_t));
+
+    diff->ids = rt_malloc(capacity * sizeof(task_id_t));
+    diff->state = rt_malloc(capacity);
+    diff->tails = rt_malloc(capacity * sizeof(rt_uint32_t));
+    diff->prev = rt_malloc(capacity * sizeof(rt_uint32_t));
+    diff->bound = rt_malloc(capacity * sizeof(rt_uint32_t));
+    diff->plan = rt_malloc(capacity * sizeof(rt_uint32_t));
+    diff->seen = rt_malloc(capacity);
+    if (diff->ids == RT_NULL || diff->state == RT_NULL || diff->tails == RT_NULL ||
+        diff->prev == RT_NULL || diff->bound == RT_NULL || diff->plan == RT_NULL ||
+        diff->seen == RT_NULL)
+    {
+        task_diff_deinit(diff);
+        return -RT_ENOMEM;
+    }
+
+    diff->capacity = capacity;
+    return RT_EOK;
+}
+
+void task_diff_deinit(task_diff_t *diff)
+{
+    if (diff->ids) rt_free(diff->ids);
+    if (diff->state) rt_free(diff->state);
+    if (diff->tails) rt_free(diff->tails);
+    if (diff->prev) rt_free(diff->prev);
+    if (diff->bound) rt_free(diff->bound);
+    if (diff->plan) rt_free(diff->plan);
+    if (diff->seen) rt_free(diff->seen);
+    rt_memset(diff, 0, sizeof(task_diff_t));
+}
+
+void task_diff_set_callback(task_diff_t *diff, task_diff_cb_t cb, void *ctx)
+{
+    diff->cb = cb;
+    diff->ctx = ctx;
+}
+
+/* 调整顺序，返回移动的已有任务数 */
+static rt_uint32_t diff_reorder(task_diff_t *diff, task_store_t *store, rt_uint32_t count,
+                                task_diff_result_t *result)
+{
+    rt_uint32_t len = 0, moves = 0, lo = 0, hi = DIFF_NO_BOUND, n = 0;
+    bool has_lo = false, renumber = false;
+
+    /* 已有任务中按原序号已经有序的最大集合保持不动 */
+    for (rt_uint32_t i = 0; i < count; i++)
+    {
+        rt_uint32_t seq, l = 0, h = len;
+
+        if (diff->state[i] != DIFF_MATCHED)
+            continue;
+        seq = task_store_order(store, diff->ids[i]);
+        while (l < h)
+        {
+            rt_uint32_t mid = (l + h) / 2;
+
+            if (task_store_order(store, diff->ids[diff->tails[mid]]) < seq)
+                l = mid + 1;
+            else
+                h = mid;
+        }
+        diff->prev[i] = l > 0 ? diff->tails[l - 1] : DIFF_NO_POS;
+        diff->tails[l] = i;
+        if (l == len)
+            len++;
+    }
+    for (rt_uint32_t i = len ? diff->tails[len - 1] : DIFF_NO_POS; i != DIFF_NO_POS; i = diff->prev[i])
+        diff->state[i] |= DIFF_STABLE;
+
+    /* 从后向前记录每个位置之后最近的不动任务的序号 */
+    for (rt_uint32_t i = count; i-- > 0;)
+    {
+        diff->bound[i] = hi;
+        if (diff->state[i] & DIFF_STABLE)
+            hi = task_store_order(store, diff->ids[i]);
+    }
+
+    /* 从前向后给其余任务分配序号，原序号已经在前后任务之间的不动 */
+    for (rt_uint32_t i = 0; i < count; i++)
+    {
+        rt_uint32_t cur;
+
+        if (diff->state[i] == DIFF_SKIP)
+            continue;
+        cur = task_store_order(store, diff->ids[i]);
+        hi = diff->bound[i];
+
+        if ((diff->state[i] & DIFF_STABLE) || ((!has_lo || cur > lo) && cur < hi))
+        {
+            diff->plan[i] = cur;
+        }
+        else
+        {
+            if (diff->state[i] & DIFF_MATCHED)
+                moves++;
+
+            if (hi == DIFF_NO_BOUND)
+            {
+                /* 后面没有不动的任务，排在前一个任务之后 */
+                if (lo >= DIFF_NO_BOUND - 1 - TASK_STORE_SEQ_GAP)
+                    renumber = true;
+                else
+                    diff->plan[i] = lo + TASK_STORE_SEQ_GAP;
+            }
+            else if (!has_lo)
+            {
+                if (hi == 0)
+                    renumber = true;
+                else
+                    diff->plan[i] = hi / 2;
+            }
+            else
+            {
+                if (hi - lo < 2)
+                    renumber = true;
+                else
+                    diff->plan[i] = lo + (hi - lo) / 2;
+            }
+        }
+        if (renumber)
+            break;
+        lo = diff->plan[i];
+        has_lo = true;
+    }
+
+    /* 序号之间没有空间时按新顺序全部重新编号，视图整体排序一次 */
+    if (renumber)
+    {
+        moves = 0;
+        task_store_begin_batch(store);
+        for (rt_uint32_t i = 0; i < count; i++)
+        {
+            if (diff->state[i] == DIFF_SKIP)
+                continue;
+            n++;
+            if ((diff->state[i] & DIFF_MATCHED) && !(diff->state[i] & DIFF_STABLE))
+            {
+                moves++;
+                diff_emit(diff, TASK_DIFF_MOVE, diff->ids[i]);
+            }
+            task_store_set_order(store, diff->ids[i], n * TASK_STORE_SEQ_GAP);
+        }
+        task_store_end_batch(store);
+        result->renumbered = true;
+        return moves;
+    }
+
+    for (rt_uint32_t i = 0; i < count; i++)
+    {
+        if (diff->state[i] == DIFF_SKIP || diff->plan[i] == task_store_order(store, diff->ids[i]))
+            continue;
+        task_store_set_order(store, diff->ids[i], diff->plan[i]);
+        if (diff->state[i] & DIFF_MATCHED)
+            diff_emit(diff, TASK_DIFF_MOVE, diff->ids[i]);
+    }
+    return moves;
+}
+
+/* 需在持有ui_mutex时调用（与其他修改task_store的操作相同） */
+rt_err_t task_diff_apply(task_diff_t *diff, task_store_t *store,
+                         const task_info_t *tasks, rt_uint32_t count, task_diff_result_t *result)
+{
+    task_diff_result_t local;
+    rt_uint32_t t0 = app_perf_now_cycles();
+    rt_uint32_t matched = 0, changes = 0;
+    bool batch;
+
+    if (result == RT_NULL)
+        result = &local;
+    rt_memset(result, 0, sizeof(task_diff_result_t));
+
+    if (store->capacity > diff->capacity)
+        return -RT_EINVAL;
+    if (count > diff->capacity)
+    {
+        LOG_W("Task list truncated to %d tasks", diff->capacity);
+        count = diff->capacity;
+    }
+
+    /* 按编号匹配存储中已有的任务 */
+    rt_memset(diff->seen, 0, diff->capacity);
+    for (rt_uint32_t i = 0; i < count; i++)
+    {
+        task_id_t id = task_store_find(store, tasks[i].list_num, tasks[i].task_num);
+
+        if (id != TASK_ID_NONE && !diff->seen[id])
+        {
+            diff->seen[id] = 1;
+            diff->ids[i] = id;
+            diff->state[i] = DIFF_MATCHED;
+            matched++;
+            if (!task_same(task_store_get(store, id), &tasks[i]))
+                changes++;
+        }
+        else
+        {
+            /* 新任务，或者与前面的任务编号重复（加入时会被拒绝） */
+            diff->ids[i] = TASK_ID_NONE;
+            diff->state[i] = DIFF_SKIP;
+            changes++;
+        }
+    }
+    changes += task_store_count(store) - matched;
+
+    /* 改动很多时（比如第一次加载）不逐个维护视图 */
+    batch = changes > DIFF_BATCH_MIN && changes * 4 > count;
+    if (batch)
+        task_store_begin_batch(store);
+
+    /* 先删除，腾出的槽位给新增的任务使用 */
+    for (rt_uint32_t id = 0; id < store->capacity && task_store_count(store) > matched; id++)
+    {
+        if (diff->seen[id] || task_store_get(store, id) == RT_NULL)
+            continue;
+        task_store_remove(store, id);
+        result->removes++;
+        diff_emit(diff, TASK_DIFF_REMOVE, id);
+    }
+
+    for (rt_uint32_t i = 0; i < count; i++)
+    {
+        task_id_t id = diff->ids[i];
+
+        if (diff->state[i] == DIFF_MATCHED)
+        {
+            if (task_same(task_store_get(store, id), &tasks[i]))
+            {
+                result->unchanged++;
+                continue;
+            }
+            task_store_update(store, id, &tasks[i]);
+            result->updates++;
+            diff_emit(diff, TASK_DIFF_UPDATE, id);
+        }
+        else
+        {
+            id = task_store_add(store, &tasks[i]);
+            if (id == TASK_ID_NONE)
+            {
+                result->duplicates++;
+                continue;
+            }
+            diff->ids[i] = id;
+            diff->state[i] = DIFF_INSERTED;
+            result->inserts++;
+            diff_emit(diff, TASK_DIFF_INSERT, id);
+        }
+    }
+
+    result->moves = diff_reorder(diff, store, count, result);
+
+    if (batch)
+        task_store_end_batch(store);
+
+    result->us = app_perf_elapsed_us(t0);
+    return RT_EOK;
+}
+
+/* 改变的任务数，为0时显示不需要更新 */
+rt_uint32_t task_diff_changes(const task_diff_result_t *result)
+{
+    return result->inserts + result->removes + result->updates + result->moves;
+}
+
+#ifdef APP_USING_TEST
+#include <finsh.h>
+#include "app_test.h"
+
+static void bench_count_cb(void *ctx, task_diff_op_t op, task_id_t id)
+{
+    ((rt_uint32_t *)ctx)[op]++;
+}
+
+static void bench_run(task_diff_t *diff, task_store_t *store, const char *name,
+                      const task_info_t *tasks, rt_uint32_t count)
+{
+    task_diff_result_t result;
+    rt_uint32_t events[4] = {0};
+
+    task_diff_set_callback(diff, bench_count_cb, events);
+    task_diff_apply(diff, store, tasks, count, &result);
+    rt_kprintf("%-10s %6d us  +%d -%d ~%d >%d  unchanged %d%s\n", name, result.us,
+               events[TASK_DIFF_INSERT], events[TASK_DIFF_REMOVE],
+               events[TASK_DIFF_UPDATE], events[TASK_DIFF_MOVE],
+               result.unchanged, result.renumbered ? " (renumbered)" : "");
+}
+
+static void task_diff_bench_cmd(int argc, char **argv)
+{
+    static const task_filter_t all = {TASK_FILTER_ANY_STATUS, 0};
+    task_store_t store;
+    task_diff_t diff;
+    task_info_t *tasks, tmp;
+    rt_uint32_t count = argc > 1 ? atoi(argv[1]) : 500;
+    rt_uint32_t t0, t_reload, mid;
+
+    if (count < 4)
+        count = 4;
+    tasks = rt_malloc((count + 1) * sizeof(task_info_t));
+    if (tasks == RT_NULL)
+        return;
+    if (task_store_init(&store, count + 1) != RT_EOK)
+    {
+        rt_free(tasks);
+        return;
+    }
+    if (task_diff_init(&diff, count + 1) != RT_EOK)
+    {
+        task_store_deinit(&store);
+        rt_free(tasks);
+        return;
+    }
+    task_store_get_view(&store, TASK_SORT_ORDER, &all);
+    task_store_get_view(&store, TASK_SORT_LIST, &all);
+
+    app_test_srand(1);
+    for (rt_uint32_t i = 0; i < count; i++)
+        app_test_make_task(&tasks[i], i + 1, 7);
+    mid = count / 2;
+
+    rt_kprintf("tasks: %d (+insert -remove ~update >move)\n", count);
+    bench_run(&diff, &store, "load", tasks, count);
+    bench_run(&diff, &store, "same", tasks, count);
+
+    rt_snprintf(tasks[mid].title, sizeof(tasks[mid].title), "Task %d edited", mid + 1);
+    bench_run(&diff, &store, "update 1", tasks, count);
+
+    /* 在中间插入一个任务 */
+    rt_memmove(&tasks[mid + 1], &tasks[mid], (count - mid) * sizeof(task_info_t));
+    app_test_make_task(&tasks[mid], count + 1, 7);
+    bench_run(&diff, &store, "insert 1", tasks, count + 1);
+
+    rt_memmove(&tasks[mid], &tasks[mid + 1], (count - mid) * sizeof(task_info_t));
+    bench_run(&diff, &store, "remove 1", tasks, count);
+
+    /* 把第一个任务移到最后 */
+    tmp = tasks[0];
+    rt_memmove(&tasks[0], &tasks[1], (count - 1) * sizeof(task_info_t));
+    tasks[count - 1] = tmp;
+    bench_run(&diff, &store, "move 1", tasks, count);
+
+    /* 最后一个任务反复移到中间，直到序号空间用完 */
+    for (int i = 0; i < 10; i++)
+    {
+        tmp = tasks[count - 1];
+        rt_memmove(&tasks[mid + 1], &tasks[mid], (count - 1 - mid) * sizeof(task_info_t));
+        tasks[mid] = tmp;
+        bench_run(&diff, &store, "move mid", tasks, count);
+    }
+
+    /* 倒序 */
+    for (rt_uint32_t i = 0; i < count / 2; i++)
+    {
+        tmp = tasks[i];
+        tasks[i] = tasks[count - 1 - i];
+        tasks[count - 1 - i] = tmp;
+    }
+    bench_run(&diff, &store, "reverse", tasks, count);
+
+    /* 对比：清空后重新加载全部任务 */
+    t0 = app_perf_now_cycles();
+    task_store_begin_batch(&store);
+    task_store_clear(&store);
+    for (rt_uint32_t i = 0; i < count; i++)
+        task_store_add(&store, &tasks[i]);
+    task_store_end_batch(&store);
+    t_reload = app_perf_elapsed_us(t0);
+    rt_kprintf("%-10s %6d us  (clear and reload, every row redrawn)\n", "reload", t_reload);
+
+    task_diff_deinit(&diff);
+    task_store_deinit(&store);
+    rt_free(tasks);
+}
+MSH_CMD_EXPORT_ALIAS(task_diff_bench_cmd, task_diff_bench, benchmark keyed task list diff [count]);
+#endif /* APP_USING_TEST */
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __TASK_DIFF_H__
+#define __TASK_DIFF_H__
+
+#include <rtthread.h>
+#include <stdbool.h>
+#include "task_store.h"
+
+/* 任务列表差异更新：收到完整任务列表时按(列表编号, 任务编号)与task_store中的任务比较，
+ * 只对新增、删除、内容改变和顺序改变的任务修改存储并发出通知，未变化的任务不动。
+ * 顺序用最长递增子序列求出不需要移动的任务，其余任务插到前后任务的序号之间 */
+
+/* 差异事件 */
+typedef enum {
+    TASK_DIFF_INSERT = 0,
+    TASK_DIFF_REMOVE,
+    TASK_DIFF_UPDATE,
+    TASK_DIFF_MOVE,
+} task_diff_op_t;
+
+/* 删除事件发出时任务已从存储中移除 */
+typedef void (*task_diff_cb_t)(void *ctx, task_diff_op_t op, task_id_t id);
+
+typedef struct {
+    rt_uint32_t inserts;
+    rt_uint32_t removes;
+    rt_uint32_t updates;
+    rt_uint32_t moves;
+    rt_uint32_t unchanged;      /* 内容没变的任务（可能移动了位置） */
+    rt_uint32_t duplicates;     /* 编号重复或存储已满而忽略的任务 */
+    bool renumbered;            /* 序号没有空间，全部重新编号 */
+    rt_uint32_t us;             /* 耗时 */
+} task_diff_result_t;
+
+typedef struct {
+    rt_uint32_t capacity;       /* 与task_store的容量相同 */
+    task_id_t *ids;             /* 新列表中每个位置对应的任务 */
+    rt_uint8_t *state;          /* 每个位置的匹配状态 */
+    rt_uint32_t *tails;         /* 最长递增子序列计算用 */
+    rt_uint32_t *prev;
+    rt_uint32_t *bound;         /* 每个位置之后最近的不动任务的序号 */
+    rt_uint32_t *plan;          /* 每个位置分配的新序号 */
+    rt_uint8_t *seen;           /* 存储中已匹配的槽位 */
+    task_diff_cb_t cb;
+    void *ctx;
+} task_diff_t;
+
+rt_err_t task_diff_init(task_diff_t *diff, rt_uint32_t capacity);
+void task_diff_deinit(task_diff_t *diff);
+void task_diff_set_callback(task_diff_t *diff, task_diff_cb_t cb, void *ctx);
+
+/* 把存储更新为tasks给出的列表（按接收顺序），result可以为空 */
+rt_err_t task_diff_apply(task_diff_t *diff, task_store_t *store,
+                         const task_info_t *tasks, rt_uint32_t count, task_diff_result_t *result);
+rt_uint32_t task_diff_changes(const task_diff_result_t *result);
+
+#endif /* __TASK_DIFF_H__ */
@@ -0,0 +1,595 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include "task_list_view.h"
+
+#define DBG_TAG "task.listview"
+#define DBG_LVL DBG_INFO
+#include <rtdbg.h>
+
+#define HEADER_BG_COLOR     0xE3F2FD
+#define SELECTED_BG_COLOR   0x2195f6
+
+LV_FONT_DECLARE(lv_font_montserratMedium_12)
+
+/* 行对象当前的样式 */
+enum {
+    ROW_STYLE_NONE = -1,
+    ROW_STYLE_HEADER,
+    ROW_STYLE_TASK,
+    ROW_STYLE_SELECTED,
+};
+
+/* ==================== 行布局 ==================== */
+
+/* 分组占用的行数：标题行加展开的任务行 */
+static rt_uint32_t group_lines(const task_list_group_t *group)
+{
+    return 1 + (group->collapsed ? 0 : group->count);
+}
+
+/* 行号对应的分组和组内位置，item为-1表示标题行 */
+static bool line_lookup(const task_list_view_t *view, rt_uint32_t line, rt_uint32_t *group, int *item)
+{
+    for (rt_uint32_t g = 0; g < view->group_count; g++)
+    {
+        rt_uint32_t n = group_lines(&view->groups[g]);
+
+        if (line < n)
+        {
+            *group = g;
+            *item = (int)line - 1;
+            return true;
+        }
+        line -= n;
+    }
+    return false;
+}
+
+/* 分组中第item个任务在selectable中的位置 */
+static int selectable_index(const task_list_view_t *view, rt_uint32_t group, int item)
+{
+    int index = item;
+
+    for (rt_uint32_t g = 0; g < group; g++)
+    {
+        if (!view->groups[g].collapsed)
+            index += view->groups[g].count;
+    }
+    return index;
+}
+
+/* 根据折叠状态重新生成可选任务和总行数 */
+static void rebuild_lines(task_list_view_t *view)
+{
+    view->selectable_count = 0;
+    view->line_count = 0;
+
+    for (rt_uint32_t g = 0; g < view->group_count; g++)
+    {
+        task_list_group_t *group = &view->groups[g];
+
+        if (!group->collapsed)
+        {
+            rt_memcpy(&view->selectable[view->selectable_count], &view->order[group->first],
+                      group->count * sizeof(task_id_t));
+            view->selectable_count += group->count;
+        }
+        view->line_count += group_lines(group);
+    }
+}
+
+/* ==================== 行对象 ==================== */
+
+/* 设置文本、样式、显示状态都会使对象重绘，只在确实改变时设置 */
+static bool set_hidden(lv_obj_t *obj, bool hidden)
+{
+    if (lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN) == hidden)
+        return false;
+    if (hidden)
+        lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    else
+        lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    return true;
+}
+
+static bool set_text(lv_obj_t *label, const char *text)
+{
+    if (rt_strcmp(lv_label_get_text(label), text) == 0)
+        return false;
+    lv_label_set_text(label, text);
+    return true;
+}
+
+static void set_row_style(lv_obj_t *row, int style)
+{
+    switch (style)
+    {
+    case ROW_STYLE_HEADER:
+        lv_obj_set_style_bg_opa(row, LV_OPA_COVER, LV_PART_MAIN|LV_STATE_DEFAULT);
+        lv_obj_set_style_bg_color(row, lv_color_hex(HEADER_BG_COLOR), LV_PART_MAIN|LV_STATE_DEFAULT);
+        lv_obj_set_style_text_color(row, lv_color_hex(0x333333), LV_PART_MAIN|LV_STATE_DEFAULT);
+        break;
+    case ROW_STYLE_SELECTED:
+        lv_obj_set_style_bg_opa(row, LV_OPA_COVER, LV_PART_MAIN|LV_STATE_DEFAULT);
+        lv_obj_set_style_bg_color(row, lv_color_hex(SELECTED_BG_COLOR), LV_PART_MAIN|LV_STATE_DEFAULT);
+        lv_obj_set_style_text_color(row, lv_color_hex(0xffffff), LV_PART_MAIN|LV_STATE_DEFAULT);
+        break;
+    default:
+        lv_obj_set_style_bg_opa(row, LV_OPA_TRANSP, LV_PART_MAIN|LV_STATE_DEFAULT);
+        lv_obj_set_style_text_color(row, lv_color_hex(0x000000), LV_PART_MAIN|LV_STATE_DEFAULT);
+        break;
+    }
+}
+
+/* 把行对象绑定到一行，内容、样式和位置都没变时不做任何设置 */
+static void bind_row(task_list_view_t *view, rt_uint32_t r, rt_uint32_t line)
+{
+    lv_obj_t *row = view->rows[r];
+    const task_list_group_t *group;
+    char text[TASK_TITLE_SIZE + 16];
+    bool changed = false;
+    rt_uint32_t g;
+    int item, style;
+
+    if (!line_lookup(view, line, &g, &item))
+        return;
+    group = &view->groups[g];
+
+    if (item < 0)
+    {
+        rt_snprintf(text, sizeof(text), "%s %s (%d)", group->collapsed ? "[+]" : "[-]",
+                    group->name, group->count);
+        style = ROW_STYLE_HEADER;
+    }
+    else
+    {
+        const task_info_t *task = task_store_get(view->store, view->order[group->first + item]);
+
+        if (task == RT_NULL)
+            return;
+        rt_snprintf(text, sizeof(text), "    %s%s", task->title,
+                    task->status == TASK_STATUS_PENDING ? " ..." : "");
+        style = (selectable_index(view, g, item) == view->selected) ? ROW_STYLE_SELECTED : ROW_STYLE_TASK;
+    }
+
+    changed |= set_text(row, text);
+    if (view->row_style[r] != style)
+    {
+        set_row_style(row, style);
+        view->row_style[r] = (rt_int8_t)style;
+        changed = true;
+    }
+    if (view->row_line[r] != (int)line)
+    {
+        lv_obj_set_pos(row, 0, (lv_coord_t)(line * view->row_h));
+        view->row_line[r] = (int)line;
+        changed = true;
+    }
+    changed |= set_hidden(row, false);
+
+    if (changed)
+        view->redraw_rows++;
+}
+
+static void release_row(task_list_view_t *view, rt_uint32_t r)
+{
+    view->row_line[r] = -1;
+    set_hidden(view->rows[r], true);
+}
+
+/* 点击行：标题行折叠/展开，任务行选中 */
+static void row_event_handler(lv_event_t *e)
+{
+    task_list_view_t *view = (task_list_view_t *)lv_event_get_user_data(e);
+    lv_obj_t *target = lv_event_get_target(e);
+    rt_uint32_t g;
+    int item;
+
+    for (rt_uint32_t r = 0; r < view->row_count; r++)
+    {
+        if (view->rows[r] != target || view->row_line[r] < 0)
+            continue;
+        if (!line_lookup(view, view->row_line[r], &g, &item))
+            return;
+
+        if (item < 0)
+        {
+            task_list_view_toggle_group(view, g);
+        }
+        else
+        {
+            task_list_view_set_selected(view, selectable_index(view, g, item));
+            if (view->cb)
+                view->cb(TASK_LIST_VIEW_SELECT, view->selected, view->user_data);
+        }
+        return;
+    }
+}
+
+static lv_obj_t *create_row(task_list_view_t *view)
+{
+    lv_obj_t *row = lv_label_create(view->cont);
+
+    lv_obj_set_size(row, lv_pct(100), view->row_h);
+    lv_label_set_long_mode(row, LV_LABEL_LONG_DOT);
+    lv_obj_set_style_pad_top(row, TASK_LIST_VIEW_ROW_PAD, LV_PART_MAIN|LV_STATE_DEFAULT);
+    lv_obj_set_style_pad_left(row, 6, LV_PART_MAIN|LV_STATE_DEFAULT);
+    lv_obj_add_flag(row, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(row, row_event_handler, LV_EVENT_CLICKED, view);
+    return row;
+}
+
+/* 滚动时把行对象重新分配给可见的行 */
+static void scroll_event_handler(lv_event_t *e)
+{
+    task_list_view_refresh((task_list_view_t *)lv_event_get_user_data(e));
+}
+
+/* 布局改变后重新绑定行对象：行对象保持原来的行号，只有内容变了的行才会重绘 */
+static void relayout(task_list_view_t *view)
+{
+    lv_coord_t total = (lv_coord_t)(view->line_count * view->row_h);
+
+    lv_obj_set_pos(view->spacer, 0, total > 0 ? total - 1 : 0);
+    for (rt_uint32_t r = 0; r < view->row_count; r++)
+    {
+        if (view->row_line[r] < 0)
+            continue;
+        if (view->row_line[r] < (int)view->line_count)
+            bind_row(view, r, view->row_line[r]);
+        else
+            release_row(view, r);
+    }
+    task_list_view_refresh(view);
+}
+
+/* ==================== 接口函数 ==================== */
+
+rt_err_t task_list_view_init(task_list_view_t *view, lv_obj_t *cont, rt_uint32_t capacity)
+{
+    rt_memset(view, 0, sizeof(task_list_view_t));
+
+    view->order = rt_malloc(capacity * sizeof(task_id_t));
+    view->selectable = rt_malloc(capacity * sizeof(task_id_t));
+    if (view->order == RT_NULL || view->selectable == RT_NULL)
+    {
+        if (view->order) rt_free(view->order);
+        if (view->selectable) rt_free(view->selectable);
+        return -RT_ENOMEM;
+    }
+
+    view->capacity = capacity;
+    view->cont = cont;
+    view->selected = -1;
+
+    view->spacer = lv_obj_create(cont);
+    lv_obj_remove_style_all(view->spacer);
+    lv_obj_set_size(view->spacer, 1, 1);
+    lv_obj_clear_flag(view->spacer, LV_OBJ_FLAG_CLICKABLE);
+
+    view->empty_label = lv_label_create(cont);
+    lv_obj_set_pos(view->empty_label, 0, 0);
+    lv_label_set_long_mode(view->empty_label, LV_LABEL_LONG_WRAP);
+    lv_obj_set_width(view->empty_label, lv_pct(100));
+
+    lv_obj_add_event_cb(cont, scroll_event_handler, LV_EVENT_SCROLL, view);
+    task_list_view_set_font(view, &lv_font_montserratMedium_12);
+    return RT_EOK;
+}
+
+void task_list_view_set_callback(task_list_view_t *view, task_list_view_cb_t cb, void *user_data)
+{
+    view->cb = cb;
+    view->user_data = user_data;
+}
+
+/* 字体设置在容器上由行继承，行高随之改变 */
+void task_list_view_set_font(task_list_view_t *view, const lv_font_t *font)
+{
+    view->font = font;
+    view->row_h = lv_font_get_line_height(font) + TASK_LIST_VIEW_ROW_PAD * 2;
+    lv_obj_set_style_text_font(view->cont, font, LV_PART_MAIN|LV_STATE_DEFAULT);
+
+    /* 行高改变，所有行都要重新定位 */
+    for (rt_uint32_t r = 0; r < view->row_count; r++)
+    {
+        lv_obj_set_height(view->rows[r], view->row_h);
+        release_row(view, r);
+    }
+    relayout(view);
+}
+
+/* 设置要显示的任务（已按视图排序），按列表编号分组，组内保持原有顺序 */
+void task_list_view_set_tasks(task_list_view_t *view, const task_store_t *store,
+                              const task_id_t *ids, rt_uint32_t count, const char *empty_text)
+{
+    rt_uint32_t fill[TASK_LIST_VIEW_MAX_GROUPS];
+    rt_uint8_t group_of_task;
+    task_id_t selected_id = task_list_view_task(view, view->selected);
+
+    if (count > view->capacity)
+        count = view->capacity;
+
+    view->store = store;
+    view->group_count = 0;
+
+    /* 统计各分组的任务数，分组按首次出现的顺序排列 */
+    for (rt_uint32_t i = 0; i < count; i++)
+    {
+        const task_info_t *task = task_store_get(store, ids[i]);
+        rt_uint32_t g;
+
+        for (g = 0; g < view->group_count && view->groups[g].list_num != task->list_num; g++);
+        if (g == view->group_count)
+        {
+            if (g < TASK_LIST_VIEW_MAX_GROUPS)
+            {
+                view->groups[g].list_num = task->list_num;
+                view->groups[g].name = task->list_name;
+                view->groups[g].count = 0;
+                view->group_count++;
+            }
+            else
+            {
+                g = TASK_LIST_VIEW_MAX_GROUPS - 1;
+            }
+        }
+        view->groups[g].count++;
+    }
+
+    /* 计算各分组的起始位置并恢复折叠状态 */
+    for (rt_uint32_t g = 0, first = 0; g < view->group_count; g++)
+    {
+        task_list_group_t *group = &view->groups[g];
+
+        group->first = first;
+        fill[g] = first;
+        first += group->count;
+
+        group->collapsed = false;
+        for (rt_uint32_t k = 0; k < view->collapsed_count; k++)
+        {
+            if (view->collapsed_lists[k] == group->list_num)
+                group->collapsed = true;
+        }
+    }
+
+    /* 按分组放置任务 */
+    for (rt_uint32_t i = 0; i < count; i++)
+    {
+        const task_info_t *task = task_store_get(store, ids[i]);
+
+        for (group_of_task = 0; group_of_task < view->group_count - 1 &&
+             view->groups[group_of_task].list_num != task->list_num; group_of_task++);
+        view->order[fill[group_of_task]++] = ids[i];
+    }
+    view->order_count = count;
+
+    rebuild_lines(view);
+    view->selected = task_list_view_index_of(view, selected_id);
+
+    if (count == 0 && empty_text != RT_NULL)
+    {
+        set_text(view->empty_label, empty_text);
+        set_hidden(view->empty_label, false);
+    }
+    else
+    {
+        set_hidden(view->empty_label, true);
+    }
+
+    relayout(view);
+}
+
+/* 按当前滚动位置给可见行分配行对象，只创建可见区域需要的对象 */
+void task_list_view_refresh(task_list_view_t *view)
+{
+    lv_coord_t top, height;
+    int first, last;
+
+    if (view->row_h <= 0)
+        return;
+
+    top = lv_obj_get_scroll_y(view->cont);
+    height = lv_obj_get_content_height(view->cont);
+    first = top / view->row_h - 1;
+    last = (top + height) / view->row_h + 1;
+    if (first < 0) first = 0;
+    if (last >= (int)view->line_count) last = (int)view->line_count - 1;
+
+    /* 释放移出可见区域的行对象 */
+    for (rt_uint32_t r = 0; r < view->row_count; r++)
+    {
+        if (view->row_line[r] >= 0 && (view->row_line[r] < first || view->row_line[r] > last))
+            release_row(view, r);
+    }
+
+    /* 给还没有对象的可见行分配空闲对象，不够时创建 */
+    for (int line = first; line <= last; line++)
+    {
+        rt_uint32_t r, free_r = view->row_count;
+
+        for (r = 0; r < view->row_count; r++)
+        {
+            if (view->row_line[r] == line)
+                break;
+            if (view->row_line[r] < 0 && free_r == view->row_count)
+                free_r = r;
+        }
+        if (r < view->row_count)
+            continue;
+
+        if (free_r == view->row_count)
+        {
+            if (view->row_count >= TASK_LIST_VIEW_MAX_ROWS)
+                break;
+            view->rows[view->row_count] = create_row(view);
+            view->row_line[view->row_count] = -1;
+            view->row_style[view->row_count] = ROW_STYLE_NONE;
+            view->row_count++;
+        }
+        bind_row(view, free_r, line);
+    }
+}
+
+/* 可选（展开分组中）的任务数 */
+rt_uint32_t task_list_view_count(const task_list_view_t *view)
+{
+    return view->selectable_count;
+}
+
+task_id_t task_list_view_task(const task_list_view_t *view, int index)
+{
+    if (index < 0 || index >= (int)view->selectable_count)
+        return TASK_ID_NONE;
+    return view->selectable[index];
+}
+
+int task_list_view_index_of(const task_list_view_t *view, task_id_t id)
+{
+    if (id == TASK_ID_NONE)
+        return -1;
+    for (rt_uint32_t i = 0; i < view->selectable_count; i++)
+    {
+        if (view->selectable[i] == id)
+            return (int)i;
+    }
+    return -1;
+}
+
+/* 改变选中项，只重新绑定新旧两行 */
+void task_list_view_set_selected(task_list_view_t *view, int index)
+{
+    int old = view->selected;
+
+    if (index >= (int)view->selectable_count)
+        index = (int)view->selectable_count - 1;
+    if (index == old)
+        return;
+    view->selected = index;
+
+    for (rt_uint32_t r = 0; r < view->row_count; r++)
+    {
+        rt_uint32_t g;
+        int item, line = view->row_line[r];
+
+        if (line < 0 || !line_lookup(view, line, &g, &item) || item < 0)
+            continue;
+        item = selectable_index(view, g, item);
+        if (item == old || item == index)
+            bind_row(view, r, line);
+    }
+}
+
+/* 可选任务所在行的顶部坐标 */
+lv_coord_t task_list_view_y_of(const task_list_view_t *view, int index)
+{
+    rt_uint32_t line = 0;
+
+    for (rt_uint32_t g = 0; g < view->group_count && index >= 0; g++)
+    {
+        const task_list_group_t *group = &view->groups[g];
+
+        line++;
+        if (!group->collapsed)
+        {
+            if (index < (int)group->count)
+            {
+                /* 分组的第一个任务连同标题一起显示 */
+                if (index == 0)
+                    line--;
+                return (lv_coord_t)((line + index) * view->row_h);
+            }
+            index -= group->count;
+            line += group->count;
+        }
+    }
+    return 0;
+}
+
+/* 坐标y处或其下方的第一个可选任务，没有时返回最后一个 */
+int task_list_view_index_at_y(const task_list_view_t *view, lv_coord_t y)
+{
+    rt_uint32_t line = (y > 0 && view->row_h > 0) ? y / view->row_h : 0;
+    rt_uint32_t g;
+    int item;
+
+    if (view->selectable_count == 0)
+        return -1;
+
+    if (!line_lookup(view, line, &g, &item))
+        return (int)view->selectable_count - 1;
+
+    /* 标题行或折叠分组：取后面第一个展开分组的第一个任务 */
+    if (item < 0)
+    {
+        while (g < view->group_count && view->groups[g].collapsed)
+            g++;
+        if (g == view->group_count)
+            return (int)view->selectable_count - 1;
+        item = 0;
+    }
+    return selectable_index(view, g, item);
+}
+
+/* 折叠或展开一个分组，尽量保持选中同一个任务 */
+void task_list_view_toggle_group(task_list_view_t *view, rt_uint32_t group)
+{
+    task_id_t selected_id = task_list_view_task(view, view->selected);
+    task_list_group_t *g;
+
+    if (group >= view->group_count)
+        return;
+    g = &view->groups[group];
+    g->collapsed = !g->collapsed;
+
+    /* 记录折叠的列表，重新加载任务后保持 */
+    if (g->collapsed && view->collapsed_count < TASK_LIST_VIEW_MAX_GROUPS)
+    {
+        view->collapsed_lists[view->collapsed_count++] = g->list_num;
+    }
+    else if (!g->collapsed)
+    {
+        for (rt_uint32_t k = 0; k < view->collapsed_count; k++)
+        {
+            if (view->collapsed_lists[k] == g->list_num)
+            {
+                view->collapsed_lists[k] = view->collapsed_lists[--view->collapsed_count];
+                break;
+            }
+        }
+    }
+
+    rebuild_lines(view);
+    view->selected = task_list_view_index_of(view, selected_id);
+    if (view->selected < 0 && view->selectable_count > 0)
+        view->selected = 0;
+    relayout(view);
+
+    if (view->cb)
+        view->cb(TASK_LIST_VIEW_LAYOUT, view->selected, view->user_data);
+}
+
+void task_list_view_set_all_collapsed(task_list_view_t *view, bool collapsed)
+{
+    for (rt_uint32_t g = 0; g < view->group_count; g++)
+    {
+        if (view->groups[g].collapsed != collapsed)
+            task_list_view_toggle_group(view, g);
+    }
+}
+
+/* 控件占用的LVGL对象数 */
+rt_uint32_t task_list_view_object_count(const task_list_view_t *view)
+{
+    return view->row_count + 2;
+}
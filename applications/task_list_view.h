@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __TASK_LIST_VIEW_H__
+#define __TASK_LIST_VIEW_H__
+
+#include <rtthread.h>
+#include <stdbool.h>
+#include "lvgl.h"
+#include "task_store.h"
+
+/* 按列表分组的任务列表控件：每个列表一个带任务数的标题行，点击标题折叠/展开。
+ * 所有行等高，只为可见区域内的行创建对象，滚动时复用，
+ * 折叠的分组和屏幕外的行不占用LVGL对象。
+ * 重新设置任务时行对象保持原来的行号，只有显示内容变化的行才会被重绘 */
+
+#define TASK_LIST_VIEW_MAX_GROUPS   16      /* 超出的列表合并到最后一组 */
+#define TASK_LIST_VIEW_MAX_ROWS     40      /* 行对象池上限 */
+#define TASK_LIST_VIEW_ROW_PAD      4       /* 行高 = 字体行高 + 上下边距 */
+
+/* 一个分组 */
+typedef struct {
+    int list_num;
+    const char *name;           /* 指向分组中第一个任务的列表名 */
+    rt_uint32_t first;          /* 在order中的起始位置 */
+    rt_uint32_t count;
+    bool collapsed;
+} task_list_group_t;
+
+typedef enum {
+    TASK_LIST_VIEW_SELECT = 0,  /* 点击了任务行，index为其位置 */
+    TASK_LIST_VIEW_LAYOUT,      /* 折叠/展开改变了可选任务 */
+} task_list_view_event_t;
+
+typedef void (*task_list_view_cb_t)(task_list_view_event_t event, int index, void *user_data);
+
+typedef struct {
+    lv_obj_t *cont;                         /* 可滚动容器 */
+    lv_obj_t *spacer;                       /* 撑开滚动范围 */
+    lv_obj_t *empty_label;                  /* 没有任务时的提示 */
+    lv_obj_t *rows[TASK_LIST_VIEW_MAX_ROWS];
+    int row_line[TASK_LIST_VIEW_MAX_ROWS];  /* 行对象当前显示的行号，-1为空闲 */
+    rt_int8_t row_style[TASK_LIST_VIEW_MAX_ROWS];  /* 行对象当前的样式，没变时不重新设置 */
+    rt_uint32_t row_count;                  /* 已创建的行对象数 */
+
+    const task_store_t *store;
+    const lv_font_t *font;
+    lv_coord_t row_h;
+
+    task_list_group_t groups[TASK_LIST_VIEW_MAX_GROUPS];
+    rt_uint32_t group_count;
+    int collapsed_lists[TASK_LIST_VIEW_MAX_GROUPS];  /* 折叠状态按列表编号保留 */
+    rt_uint32_t collapsed_count;
+
+    task_id_t *order;                       /* 按分组排列的全部任务 */
+    task_id_t *selectable;                  /* 展开分组中的任务，按显示顺序 */
+    rt_uint32_t capacity;
+    rt_uint32_t order_count;
+    rt_uint32_t selectable_count;
+    rt_uint32_t line_count;                 /* 标题行 + 展开的任务行 */
+    int selected;                           /* selectable中的位置，-1为无 */
+
+    task_list_view_cb_t cb;
+    void *user_data;
+    rt_uint32_t redraw_rows;                /* 内容、样式或位置改变而重绘的行数（累计） */
+} task_list_view_t;
+
+rt_err_t task_list_view_init(task_list_view_t *view, lv_obj_t *cont, rt_uint32_t capacity);
+void task_list_view_set_callback(task_list_view_t *view, task_list_view_cb_t cb, void *user_data);
+void task_list_view_set_font(task_list_view_t *view, const lv_font_t *font);
+void task_list_view_set_tasks(task_list_view_t *view, const task_store_t *store,
+                              const task_id_t *ids, rt_uint32_t count, const char *empty_text);
+void task_list_view_refresh(task_list_view_t *view);
+
+rt_uint32_t task_list_view_count(const task_list_view_t *view);
+task_id_t task_list_view_task(const task_list_view_t *view, int index);
+int task_list_view_index_of(const task_list_view_t *view, task_id_t id);
+void task_list_view_set_selected(task_list_view_t *view, int index);
+lv_coord_t task_list_view_y_of(const task_list_view_t *view, int index);
+int task_list_view_index_at_y(const task_list_view_t *view, lv_coord_t y);
+
+void task_list_view_toggle_group(task_list_view_t *view, rt_uint32_t group);
+void task_list_view_set_all_collapsed(task_list_view_t *view, bool collapsed);
+rt_uint32_t task_list_view_object_count(const task_list_view_t *view);
+
+#endif /* __TASK_LIST_VIEW_H__ */
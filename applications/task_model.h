@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __TASK_MODEL_H__
+#define __TASK_MODEL_H__
+
+#include <rtthread.h>
+#include <stdbool.h>
+
+#define TASK_TITLE_SIZE     128
+#define TASK_LIST_NAME_SIZE 64
+#define TASK_ID_MAX_DIGITS  9       /* 列表/任务编号的最大位数，保证不超出int范围 */
+
+/* 任务状态 */
+typedef enum {
+    TASK_STATUS_OPEN = 0,       /* 未完成 */
+    TASK_STATUS_PENDING,        /* 已发送完成/删除命令，等待ESP32刷新 */
+    TASK_STATUS_NUM
+} task_status_t;
+
+/* 任务信息结构体 */
+typedef struct {
+    char title[TASK_TITLE_SIZE];            /* 任务标题 */
+    char list_name[TASK_LIST_NAME_SIZE];    /* 列表名称 */
+    int list_num;                           /* 列表编号 */
+    int task_num;                           /* 任务编号 */
+    rt_uint8_t status;                      /* 任务状态，见task_status_t */
+    bool is_valid;                          /* 是否有效 */
+} task_info_t;
+
+#endif /* __TASK_MODEL_H__ */
@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include "task_parser.h"
+#include "app_perf.h"
+
+#define DBG_TAG "task.parser"
+#define DBG_LVL DBG_INFO
+#include <rtdbg.h>
+
+#define DATA_DELIMITER ','
+
+/* 解析"数字."前缀，返回点号后的位置，不是该格式时返回NULL。
+ * 编号为正整数，位数不限于一位，超过TASK_ID_MAX_DIGITS位视为无效 */
+static char *parse_id_prefix(char *str, int *value)
+{
+    int n = 0;
+    int digits = 0;
+
+    if (str[0] < '1' || str[0] > '9')
+        return RT_NULL;
+
+    while (str[digits] >= '0' && str[digits] <= '9')
+    {
+        if (digits >= TASK_ID_MAX_DIGITS)
+            return RT_NULL;
+        n = n * 10 + (str[digits] - '0');
+        digits++;
+    }
+
+    if (str[digits] != '.')
+        return RT_NULL;
+
+    *value = n;
+    return str + digits + 1;
+}
+
+/* 处理一个token（已去除前后空白） */
+static void parse_token(task_parser_t *parser, char *token)
+{
+    char *rest, *title;
+    int list_num, task_num;
+
+    LOG_D("Processing token: [%s]", token);
+
+    rest = parse_id_prefix(token, &list_num);
+    if (rest == RT_NULL)
+        return;
+
+    /* 检查是否是任务（格式: "12.34.TaskTitle"），标题中可以有点号 */
+    title = parse_id_prefix(rest, &task_num);
+    if (title != RT_NULL)
+    {
+        task_info_t task;
+
+        rt_memset(&task, 0, sizeof(task));
+        rt_strncpy(task.title, title, sizeof(task.title) - 1);
+        rt_strncpy(task.list_name, parser->list_name, sizeof(task.list_name) - 1);
+        task.list_num = list_num;
+        task.task_num = task_num;
+        task.is_valid = true;
+
+        parser->tasks++;
+        LOG_D("Parsed task %d.%d: %s", task.list_num, task.task_num, task.title);
+
+        if (!parser->emit(parser->ctx, &task))
+        {
+            parser->stopped = true;
+        }
+    }
+    /* 检查是否是列表名（格式: "12.ListName"） */
+    else if (strchr(rest, '.') == NULL)  /* 确保后面没有其他点号 */
+    {
+        parser->list_num = list_num;
+        rt_strncpy(parser->list_name, rest, sizeof(parser->list_name) - 1);
+        parser->list_name[sizeof(parser->list_name) - 1] = '\0';
+        LOG_D("Found list %d: %s", parser->list_num, parser->list_name);
+    }
+}
+
+/* 开始解析，复制数据以便原地切分 */
+rt_err_t task_parser_begin(task_parser_t *parser, const char *data,
+                           task_parser_emit_t emit, void *ctx)
+{
+    rt_memset(parser, 0, sizeof(task_parser_t));
+
+    if (data == RT_NULL || emit == RT_NULL)
+        return -RT_EINVAL;
+
+    parser->len = rt_strlen(data);
+    parser->buf = rt_malloc(parser->len + 1);
+    if (parser->buf == RT_NULL)
+    {
+        LOG_E("Failed to allocate memory for task data parsing");
+        return -RT_ENOMEM;
+    }
+    rt_memcpy(parser->buf, data, parser->len + 1);
+
+    parser->emit = emit;
+    parser->ctx = ctx;
+    return RT_EOK;
+}
+
+/* 换成下一段数据继续解析，保留当前列表和统计信息 */
+rt_err_t task_parser_next(task_parser_t *parser, const char *data)
+{
+    rt_size_t len;
+    char *buf;
+
+    if (data == RT_NULL || parser->emit == RT_NULL)
+        return -RT_EINVAL;
+
+    len = rt_strlen(data);
+    buf = rt_malloc(len + 1);
+    if (buf == RT_NULL)
+    {
+        LOG_E("Failed to allocate memory for task data parsing");
+        return -RT_ENOMEM;
+    }
+    rt_memcpy(buf, data, len + 1);
+
+    task_parser_end(parser);
+    parser->buf = buf;
+    parser->len = len;
+    parser->pos = 0;
+    return RT_EOK;
+}
+
+/* 解析一片：最多max_tokens个token或max_us微秒（0表示不限制） */
+task_parse_status_t task_parser_step(task_parser_t *parser, int max_tokens, rt_uint32_t max_us)
+{
+    rt_uint32_t start = app_perf_now_cycles();
+    rt_uint32_t elapsed;
+    int count = 0;
+
+    while (parser->pos < parser->len && !parser->stopped)
+    {
+        char *token = parser->buf + parser->pos;
+        char *sep = strchr(token, DATA_DELIMITER);
+
+        /* 切出当前token并移动游标 */
+        if (sep != RT_NULL)
+        {
+            *sep = '\0';
+            parser->pos = sep - parser->buf + 1;
+        }
+        else
+        {
+            parser->pos = parser->len;
+        }
+
+        /* 去除前后空白 */
+        while (*token == ' ' || *token == '\t') token++;
+        char *end = token + rt_strlen(token) - 1;
+        while (end > token && (*end == ' ' || *end == '\t')) *end-- = '\0';
+
+        if (*token != '\0')
+        {
+            parse_token(parser, token);
+        }
+        parser->tokens++;
+        count++;
+
+        if (max_tokens > 0 && count >= max_tokens)
+            break;
+        if (max_us > 0 && app_perf_elapsed_us(start) >= max_us)
+            break;
+    }
+
+    elapsed = app_perf_elapsed_us(start);
+    parser->slices++;
+    if (elapsed > parser->max_slice_us)
+        parser->max_slice_us = elapsed;
+
+    if (parser->pos >= parser->len || parser->stopped)
+        return TASK_PARSE_DONE;
+    return TASK_PARSE_MORE;
+}
+
+/* 结束解析，释放数据副本 */
+void task_parser_end(task_parser_t *parser)
+{
+    if (parser->buf)
+    {
+        rt_free(parser->buf);
+        parser->buf = RT_NULL;
+    }
+}
+
+#ifdef APP_USING_TEST
+#include <finsh.h>
+#include "app_test.h"
+
+/* ==================== 分片解析模拟 ==================== */
+
+#define PARSE_SIM_FRAME_US      16667   /* 60Hz的帧周期 */
+#define PARSE_SIM_RENDER_US     6000    /* 每帧LVGL的渲染工作量 */
+#define PARSE_SIM_TICK_US       1000    /* 两片之间让出CPU的时间（一个tick） */
+
+typedef struct {
+    rt_uint32_t frames;
+    rt_uint32_t max_interval_us;    /* 最长的帧完成间隔 */
+    rt_uint32_t max_jitter_us;      /* 帧完成间隔与帧周期之差的最大值 */
+    rt_uint32_t total_us;           /* 解析结束的模拟时间 */
+} parse_sim_result_t;
+
+static rt_uint32_t parse_sim_tasks;
+
+static bool parse_sim_emit(void *ctx, const task_info_t *task)
+{
+    *(task_info_t *)ctx = *task;
+    parse_sim_tasks++;
+    return true;
+}
+
+/* 模拟时间轴：UART线程优先级不低于LVGL，解析器醒来就抢占，每片的时间为实际测得的执行时间，
+ * 每片之后休眠一个tick；LVGL每个帧周期要完成PARSE_SIM_RENDER_US的渲染，只在解析器休眠时执行。
+ * max_tokens和max_us为0时一次解析完，用于对比 */
+static void parse_sim_run(const char *data, int max_tokens, rt_uint32_t max_us,
+                          task_parser_t *parser, parse_sim_result_t *r)
+{
+    task_info_t last;
+    rt_uint32_t t = 0, wake = 0, due = 0, remain = 0, last_done = 0;
+    bool parsing = true;
+
+    rt_memset(r, 0, sizeof(*r));
+    parse_sim_tasks = 0;
+    task_parser_begin(parser, data, parse_sim_emit, &last);
+
+    /* 解析完后再多跑两帧，统计最后一片的影响 */
+    while (parsing || r->frames < 2 || due <= r->total_us + 2 * PARSE_SIM_FRAME_US)
+    {
+        if (remain == 0 && t >= due)
+        {
+            remain = PARSE_SIM_RENDER_US;
+            due += PARSE_SIM_FRAME_US;
+        }
+
+        if (parsing && t >= wake)
+        {
+            rt_uint32_t start = app_perf_now_cycles();
+
+            parsing = task_parser_step(parser, max_tokens, max_us) == TASK_PARSE_MORE;
+            t += app_perf_elapsed_us(start);
+            wake = t + PARSE_SIM_TICK_US;
+            if (!parsing)
+                r->total_us = t;
+        }
+        else if (remain > 0)
+        {
+            /* 渲染到完成或被解析器抢占 */
+            rt_uint32_t run = remain;
+
+            if (parsing && wake - t < run)
+                run = wake - t;
+            t += run;
+            remain -= run;
+            if (remain == 0)
+            {
+                rt_uint32_t interval = t - last_done;
+                rt_uint32_t jitter = interval > PARSE_SIM_FRAME_US ? interval - PARSE_SIM_FRAME_US
+                                                                   : PARSE_SIM_FRAME_US - interval;
+
+                if (r->frames > 0 && jitter > r->max_jitter_us)
+                    r->max_jitter_us = jitter;
+                if (r->frames > 0 && interval > r->max_interval_us)
+                    r->max_interval_us = interval;
+                last_done = t;
+                r->frames++;
+            }
+        }
+        else
+        {
+            /* 空闲到下一个事件 */
+            t = (parsing && wake < due) ? wake : due;
+        }
+    }
+}
+
+/* 生成n个任务的TASKS数据，解析时与真实数据一样按列表分组 */
+static char *parse_sim_make_data(rt_uint32_t n)
+{
+    char *data = rt_malloc(n * 64 + 1);
+    task_info_t task;
+    rt_size_t len = 0;
+    int list_num = -1;
+
+    if (data == RT_NULL)
+        return RT_NULL;
+
+    app_test_srand(n);
+    data[0] = '\0';
+    for (rt_uint32_t i = 0; i < n; i++)
+    {
+        app_test_make_task(&task, i + 1, 9);
+        /* 标题最长约40个字符，列表项和任务项合计不超过64字节 */
+        if (task.list_num != list_num)
+        {
+            list_num = task.list_num;
+            len += rt_snprintf(data + len, n * 64 + 1 - len, "%s%d.L%d", len ? "," : "", list_num, list_num);
+        }
+        len += rt_snprintf(data + len, n * 64 + 1 - len, ",%d.%d.%s", task.list_num, task.task_num, task.title);
+    }
+    return data;
+}
+
+/* 分片解析大列表时测量帧时间抖动，与一次解析完对比。
+ * 每片不超过时间限制，且没有一帧的间隔超过两个帧周期（不出现可见的停顿）时通过 */
+static void parse_sim_cmd(int argc, char **argv)
+{
+    rt_uint32_t n = argc > 1 ? atoi(argv[1]) : 10000;
+    char *data;
+    task_parser_t parser;
+    parse_sim_result_t sliced, whole;
+    bool pass;
+
+    if (n == 0 || (data = parse_sim_make_data(n)) == RT_NULL)
+    {
+        rt_kprintf("usage: parse_sim [tasks] (needs about 64 bytes per task)\n");
+        return;
+    }
+    rt_kprintf("%d tasks, %d bytes, frame %d us, render %d us\n",
+               n, rt_strlen(data), PARSE_SIM_FRAME_US, PARSE_SIM_RENDER_US);
+
+    parse_sim_run(data, TASK_PARSE_SLICE_TOKENS, TASK_PARSE_SLICE_US, &parser, &sliced);
+    pass = parse_sim_tasks == n && parser.max_slice_us <= TASK_PARSE_SLICE_US * 3 / 2
+           && sliced.max_interval_us <= 2 * PARSE_SIM_FRAME_US;
+    rt_kprintf("sliced: %d tasks, %d slices, max slice %d us, parse %d ms\n",
+               parse_sim_tasks, parser.slices, parser.max_slice_us, sliced.total_us / 1000);
+    rt_kprintf("        %d frames, max interval %d us, max jitter %d us\n",
+               sliced.frames, sliced.max_interval_us, sliced.max_jitter_us);
+    task_parser_end(&parser);
+
+    parse_sim_run(data, 0, 0, &parser, &whole);
+    rt_kprintf("whole:  %d tasks, parse %d us\n", parse_sim_tasks, parser.max_slice_us);
+    rt_kprintf("        %d frames, max interval %d us, max jitter %d us\n",
+               whole.frames, whole.max_interval_us, whole.max_jitter_us);
+    task_parser_end(&parser);
+
+    rt_kprintf("parse_sim: %s\n", pass ? "PASS" : "FAIL");
+    rt_free(data);
+}
+MSH_CMD_EXPORT_ALIAS(parse_sim_cmd, parse_sim, measure frame jitter while parsing a large task list [tasks]);
+#endif /* APP_USING_TEST */
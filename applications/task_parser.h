@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __TASK_PARSER_H__
+#define __TASK_PARSER_H__
+
+#include <rtthread.h>
+#include "task_model.h"
+
+/* 可分片执行的任务列表解析器：每次最多处理N个token或M微秒，
+ * 游标保存在解析器中，调用者在两片之间让出CPU */
+
+#define TASK_PARSE_SLICE_TOKENS 32      /* 每片最多处理的token数 */
+#define TASK_PARSE_SLICE_US     2000    /* 每片最长执行时间 */
+
+/* 解析出一个任务时回调，返回false停止解析 */
+typedef bool (*task_parser_emit_t)(void *ctx, const task_info_t *task);
+
+typedef enum {
+    TASK_PARSE_MORE = 0,    /* 还有数据，需要继续调用 */
+    TASK_PARSE_DONE,        /* 解析完成 */
+} task_parse_status_t;
+
+typedef struct {
+    char *buf;                      /* 数据副本，解析时原地切分 */
+    rt_size_t len;
+    rt_size_t pos;                  /* 当前游标 */
+    char list_name[TASK_LIST_NAME_SIZE];
+    int list_num;
+    task_parser_emit_t emit;
+    void *ctx;
+    bool stopped;
+
+    /* 统计信息 */
+    rt_uint32_t tokens;
+    rt_uint32_t tasks;
+    rt_uint32_t slices;
+    rt_uint32_t max_slice_us;
+} task_parser_t;
+
+rt_err_t task_parser_begin(task_parser_t *parser, const char *data,
+                           task_parser_emit_t emit, void *ctx);
+/* 列表分成几段到达时，解析完一段后换成下一段，段必须在token边界切开 */
+rt_err_t task_parser_next(task_parser_t *parser, const char *data);
+task_parse_status_t task_parser_step(task_parser_t *parser, int max_tokens, rt_uint32_t max_us);
+void task_parser_end(task_parser_t *parser);
+
+#endif /* __TASK_PARSER_H__ */
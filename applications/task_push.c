@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include <stdlib.h>
+#include "task_push.h"
+
+#define DBG_TAG "task.push"
+#define DBG_LVL DBG_INFO
+#include <rtdbg.h>
+
+static const char *const kind_names[] = {"ALL", "SET", "DEL"};
+
+/* 时间比较，允许计数回绕 */
+static bool time_reached(rt_uint32_t now_ms, rt_uint32_t t_ms)
+{
+    return (rt_int32_t)(now_ms - t_ms) >= 0;
+}
+
+void task_push_init(task_push_t *push, rt_uint32_t timeout_ms, rt_uint32_t retry_ms, rt_uint32_t now_ms)
+{
+    rt_memset(push, 0, sizeof(task_push_t));
+    push->state = TASK_PUSH_IDLE;
+    push->timeout_ms = timeout_ms;
+    push->retry_interval_ms = retry_ms;
+    push->retry_ms = now_ms;
+    push->enabled = true;
+}
+
+void task_push_enable(task_push_t *push, bool enable, rt_uint32_t now_ms)
+{
+    push->enabled = enable;
+    push->state = TASK_PUSH_IDLE;
+    push->retry_ms = now_ms;
+}
+
+bool task_push_poll(task_push_t *push, rt_uint32_t now_ms, bool link_busy)
+{
+    if (!push->enabled)
+        return false;
+
+    if (push->state == TASK_PUSH_SUBSCRIBING && time_reached(now_ms, push->sent_ms + push->timeout_ms))
+    {
+        LOG_W("No reply to subscribe, falling back to polling");
+        push->stats.timeouts++;
+        push->state = TASK_PUSH_IDLE;
+        push->retry_ms = now_ms + push->retry_interval_ms;
+        return false;
+    }
+
+    if (push->state != TASK_PUSH_IDLE || link_busy || !time_reached(now_ms, push->retry_ms))
+        return false;
+
+    push->state = TASK_PUSH_SUBSCRIBING;
+    push->sent_ms = now_ms;
+    push->stats.subscribes++;
+    return true;
+}
+
+void task_push_reset(task_push_t *push, rt_uint32_t now_ms)
+{
+    if (push->state == TASK_PUSH_SUBSCRIBING)
+        push->stats.timeouts++;
+    push->state = TASK_PUSH_IDLE;
+    push->retry_ms = now_ms + push->retry_interval_ms;
+}
+
+/* DATA格式：<序号>:<类型>:<内容> */
+rt_err_t task_push_parse(const char *data, rt_uint32_t *seq, task_push_kind_t *kind, const char **payload)
+{
+    const char *p = data;
+    rt_uint32_t value = 0;
+    int digits = 0, k;
+
+    while (*p >= '0' && *p <= '9' && digits < 10)
+    {
+        value = value * 10 + (*p++ - '0');
+        digits++;
+    }
+    if (digits == 0 || *p++ != ':')
+        return -RT_EINVAL;
+
+    for (k = 0; k < (int)(sizeof(kind_names) / sizeof(kind_names[0])); k++)
+    {
+        if (rt_strncmp(p, kind_names[k], 3) == 0 && p[3] == ':')
+            break;
+    }
+    if (k == (int)(sizeof(kind_names) / sizeof(kind_names[0])))
+        return -RT_EINVAL;
+
+    *seq = value;
+    *kind = (task_push_kind_t)k;
+    *payload = p + 4;
+    return RT_EOK;
+}
+
+task_push_action_t task_push_accept(task_push_t *push, rt_uint32_t seq, task_push_kind_t kind, rt_uint32_t now_ms)
+{
+    push->stats.pushes++;
+
+    /* 完整列表总是作为新的基准，包括订阅期间和ESP32主动重发 */
+    if (kind == TASK_PUSH_ALL)
+    {
+        if (push->state == TASK_PUSH_IDLE && !push->enabled)
+        {
+            push->stats.duplicates++;
+            return TASK_PUSH_IGNORE;
+        }
+        push->state = TASK_PUSH_ACTIVE;
+        push->expected_seq = seq + 1;
+        push->stats.applied++;
+        return TASK_PUSH_APPLY;
+    }
+
+    if (push->state != TASK_PUSH_ACTIVE)
+    {
+        push->stats.duplicates++;
+        return TASK_PUSH_IGNORE;
+    }
+
+    if (seq == push->expected_seq)
+    {
+        push->expected_seq++;
+        push->stats.applied++;
+        return TASK_PUSH_APPLY;
+    }
+
+    /* 比期望小：重复发送或基准之前的推送 */
+    if ((rt_int32_t)(seq - push->expected_seq) < 0)
+    {
+        push->stats.duplicates++;
+        return TASK_PUSH_IGNORE;
+    }
+
+    LOG_W("Push sequence gap: expected %u, got %u", push->expected_seq, seq);
+    push->stats.gaps++;
+    push->stats.subscribes++;
+    push->state = TASK_PUSH_SUBSCRIBING;
+    push->sent_ms = now_ms;
+    return TASK_PUSH_RESYNC;
+}
+
+bool task_push_active(const task_push_t *push)
+{
+    return push->state == TASK_PUSH_ACTIVE;
+}
+
+const char *task_push_kind_name(task_push_kind_t kind)
+{
+    return (kind <= TASK_PUSH_DEL) ? kind_names[kind] : "?";
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __TASK_PUSH_H__
+#define __TASK_PUSH_H__
+
+#include <rtthread.h>
+#include <stdbool.h>
+
+/* ESP32主动推送的订阅状态：发送subscribe后，ESP32先推送一次完整列表，
+ * 之后上游任务变化时立即推送增量，每条推送带递增的序号。
+ * 数据包格式 TYPE:PUSH|DATA:<序号>:<类型>:<内容>
+ *   ALL  完整任务列表，格式与TASKS相同，作为新的序号基准
+ *   SET  新增或修改的任务，格式与TASKS相同（新任务需包含所在列表项）
+ *   DEL  删除的任务，逗号分隔的"列表编号.任务编号"
+ * 序号跳变时重新订阅，由ESP32重新推送完整列表。
+ * 只维护状态，不调用系统时钟和发送函数，时间由调用者传入 */
+
+#define TASK_PUSH_TIMEOUT_MS    5000        /* 订阅后等待完整列表的时间 */
+#define TASK_PUSH_RETRY_MS      60000       /* 订阅失败后重试的间隔 */
+
+typedef enum {
+    TASK_PUSH_IDLE = 0,         /* 未订阅，使用轮询 */
+    TASK_PUSH_SUBSCRIBING,      /* 已发送subscribe，等待完整列表 */
+    TASK_PUSH_ACTIVE,           /* 接收增量推送 */
+} task_push_state_t;
+
+typedef enum {
+    TASK_PUSH_ALL = 0,
+    TASK_PUSH_SET,
+    TASK_PUSH_DEL,
+} task_push_kind_t;
+
+/* 收到一条推送后调用者要做的处理 */
+typedef enum {
+    TASK_PUSH_APPLY = 0,        /* 按顺序到达，应用 */
+    TASK_PUSH_IGNORE,           /* 重复、过期或未订阅 */
+    TASK_PUSH_RESYNC,           /* 序号跳变，丢弃并重新订阅 */
+} task_push_action_t;
+
+typedef struct {
+    rt_uint32_t pushes;         /* 收到的推送数 */
+    rt_uint32_t applied;
+    rt_uint32_t duplicates;     /* 重复或过期 */
+    rt_uint32_t gaps;           /* 序号跳变次数 */
+    rt_uint32_t subscribes;     /* 发送subscribe的次数 */
+    rt_uint32_t timeouts;       /* 订阅超时或被拒绝 */
+    rt_uint32_t invalid;        /* 格式错误 */
+} task_push_stats_t;
+
+typedef struct {
+    task_push_state_t state;
+    rt_uint32_t expected_seq;   /* 下一条推送的序号 */
+    rt_uint32_t sent_ms;        /* 发送subscribe的时间 */
+    rt_uint32_t retry_ms;       /* 下一次尝试订阅的时间 */
+    rt_uint32_t timeout_ms;
+    rt_uint32_t retry_interval_ms;
+    bool enabled;
+    task_push_stats_t stats;
+} task_push_t;
+
+void task_push_init(task_push_t *push, rt_uint32_t timeout_ms, rt_uint32_t retry_ms, rt_uint32_t now_ms);
+void task_push_enable(task_push_t *push, bool enable, rt_uint32_t now_ms);
+
+/* 定期调用，返回true时调用者应发送subscribe */
+bool task_push_poll(task_push_t *push, rt_uint32_t now_ms, bool link_busy);
+/* 订阅被拒绝（ESP32不支持）或链路断开，改用轮询，稍后重试 */
+void task_push_reset(task_push_t *push, rt_uint32_t now_ms);
+
+/* 解析DATA字段，payload指向data中的内容部分 */
+rt_err_t task_push_parse(const char *data, rt_uint32_t *seq, task_push_kind_t *kind, const char **payload);
+task_push_action_t task_push_accept(task_push_t *push, rt_uint32_t seq, task_push_kind_t kind, rt_uint32_t now_ms);
+
+bool task_push_active(const task_push_t *push);
+const char *task_push_kind_name(task_push_kind_t kind);
+
+#endif /* __TASK_PUSH_H__ */
@@ -0,0 +1,467 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include "task_search.h"
+#include "app_perf.h"
+
+#define DBG_TAG "task.search"
+#define DBG_LVL DBG_INFO
+#include <rtdbg.h>
+
+#define BUCKET_MASK     (TASK_SEARCH_BUCKETS - 1)
+#define MAX_TASK_GRAMS  (TASK_TITLE_SIZE + TASK_LIST_NAME_SIZE)
+
+static int to_lower(int c)
+{
+    return (c >= 'A' && c <= 'Z') ? c + 'a' - 'A' : c;
+}
+
+/* 三字母组散列到桶 */
+static rt_uint32_t gram_bucket(const char *p)
+{
+    rt_uint32_t h = ((rt_uint32_t)to_lower((unsigned char)p[0]) << 16) |
+                    ((rt_uint32_t)to_lower((unsigned char)p[1]) << 8) |
+                    (rt_uint32_t)to_lower((unsigned char)p[2]);
+
+    return ((h * 2654435761u) >> 16) & BUCKET_MASK;
+}
+
+/* 收集一段文本的桶号，加入out并去重，返回新的数量 */
+static int collect_grams(const char *text, rt_uint16_t *out, int n, int max)
+{
+    int len = rt_strlen(text);
+
+    for (int i = 0; i + TASK_SEARCH_GRAM <= len && n < max; i++)
+    {
+        rt_uint16_t b = (rt_uint16_t)gram_bucket(text + i);
+        int k;
+
+        /* 插入排序，顺便去重 */
+        for (k = n; k > 0 && out[k - 1] > b; k--);
+        if (k > 0 && out[k - 1] == b)
+            continue;
+        rt_memmove(&out[k + 1], &out[k], (n - k) * sizeof(rt_uint16_t));
+        out[k] = b;
+        n++;
+    }
+    return n;
+}
+
+static int task_grams(const task_info_t *task, rt_uint16_t *out)
+{
+    int n = collect_grams(task->title, out, 0, MAX_TASK_GRAMS);
+    return collect_grams(task->list_name, out, n, MAX_TASK_GRAMS);
+}
+
+/* 不区分大小写的子串查找，needle已是小写 */
+static bool contains_nocase(const char *hay, const char *needle)
+{
+    for (; *hay; hay++)
+    {
+        const char *h = hay;
+        const char *n = needle;
+
+        while (*n && to_lower((unsigned char)*h) == *n)
+        {
+            h++;
+            n++;
+        }
+        if (*n == '\0')
+            return true;
+    }
+    return false;
+}
+
+static bool task_matches(const task_info_t *task, const char *query)
+{
+    return contains_nocase(task->title, query) || contains_nocase(task->list_name, query);
+}
+
+/* ==================== 桶操作 ==================== */
+
+static rt_uint32_t bucket_lower_bound(const task_search_bucket_t *b, task_id_t id)
+{
+    rt_uint32_t lo = 0, hi = b->count;
+
+    while (lo < hi)
+    {
+        rt_uint32_t mid = (lo + hi) / 2;
+        if (b->ids[mid] < id)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+static bool bucket_contains(const task_search_bucket_t *b, task_id_t id)
+{
+    rt_uint32_t pos = bucket_lower_bound(b, id);
+    return pos < b->count && b->ids[pos] == id;
+}
+
+static bool bucket_insert(task_search_t *search, task_search_bucket_t *b, task_id_t id)
+{
+    rt_uint32_t pos = bucket_lower_bound(b, id);
+
+    if (pos < b->count && b->ids[pos] == id)
+        return true;
+
+    if (b->count == b->cap)
+    {
+        rt_uint32_t cap = b->cap ? b->cap * 2 : 4;
+        task_id_t *ids;
+
+        if (cap > search->capacity)
+            cap = search->capacity;
+        ids = rt_realloc(b->ids, cap * sizeof(task_id_t));
+        if (ids == RT_NULL)
+            return false;
+        b->ids = ids;
+        b->cap = (rt_uint16_t)cap;
+    }
+
+    rt_memmove(&b->ids[pos + 1], &b->ids[pos], (b->count - pos) * sizeof(task_id_t));
+    b->ids[pos] = id;
+    b->count++;
+    search->postings++;
+    return true;
+}
+
+static void bucket_remove(task_search_t *search, task_search_bucket_t *b, task_id_t id)
+{
+    rt_uint32_t pos = bucket_lower_bound(b, id);
+
+    if (pos >= b->count || b->ids[pos] != id)
+        return;
+    rt_memmove(&b->ids[pos], &b->ids[pos + 1], (b->count - pos - 1) * sizeof(task_id_t));
+    b->count--;
+    search->postings--;
+}
+
+static void free_buckets(task_search_t *search)
+{
+    for (int i = 0; i < TASK_SEARCH_BUCKETS; i++)
+    {
+        if (search->buckets[i].ids)
+            rt_free(search->buckets[i].ids);
+        search->buckets[i].ids = RT_NULL;
+        search->buckets[i].count = 0;
+        search->buckets[i].cap = 0;
+    }
+    search->postings = 0;
+}
+
+/* 超出内存上限时放弃索引，查询退化为线性扫描，直到下次清空 */
+static void index_overflow(task_search_t *search)
+{
+    LOG_W("Search index full (%d postings), falling back to scan", search->postings);
+    free_buckets(search);
+    search->overflow = true;
+}
+
+/* ==================== 索引维护 ==================== */
+
+rt_err_t task_search_init(task_search_t *search, rt_uint32_t capacity, rt_uint32_t max_postings)
+{
+    rt_memset(search, 0, sizeof(task_search_t));
+
+    search->match = rt_calloc((capacity + 7) / 8, 1);
+    if (search->match == RT_NULL)
+        return -RT_ENOMEM;
+
+    search->capacity = capacity;
+    search->max_postings = max_postings;
+    return RT_EOK;
+}
+
+void task_search_deinit(task_search_t *search)
+{
+    free_buckets(search);
+    if (search->match)
+        rt_free(search->match);
+    rt_memset(search, 0, sizeof(task_search_t));
+}
+
+/* 清空索引，保留桶的内存供重新加载使用 */
+void task_search_clear(task_search_t *search)
+{
+    for (int i = 0; i < TASK_SEARCH_BUCKETS; i++)
+        search->buckets[i].count = 0;
+    search->postings = 0;
+    search->overflow = false;
+    rt_memset(search->match, 0, (search->capacity + 7) / 8);
+}
+
+void task_search_add(task_search_t *search, task_id_t id, const task_info_t *task)
+{
+    rt_uint16_t grams[MAX_TASK_GRAMS];
+    int n;
+
+    if (search->overflow || id >= search->capacity)
+        return;
+
+    n = task_grams(task, grams);
+    if (search->postings + n > search->max_postings)
+    {
+        index_overflow(search);
+        return;
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        if (!bucket_insert(search, &search->buckets[grams[i]], id))
+        {
+            index_overflow(search);
+            return;
+        }
+    }
+}
+
+/* task为任务被删除或修改前的内容，用来找到它所在的桶 */
+void task_search_remove(task_search_t *search, task_id_t id, const task_info_t *task)
+{
+    rt_uint16_t grams[MAX_TASK_GRAMS];
+    int n;
+
+    if (search->overflow)
+        return;
+
+    n = task_grams(task, grams);
+    for (int i = 0; i < n; i++)
+        bucket_remove(search, &search->buckets[grams[i]], id);
+}
+
+static void set_match(task_search_t *search, task_id_t id, bool match)
+{
+    if (match)
+        search->match[id / 8] |= (rt_uint8_t)(1 << (id % 8));
+    else
+        search->match[id / 8] &= (rt_uint8_t)~(1 << (id % 8));
+}
+
+/* 任务变化时更新索引，有查询条件时同时更新该任务的查询结果 */
+void task_search_on_change(void *ctx, task_id_t id, const task_info_t *old, const task_info_t *task)
+{
+    task_search_t *search = (task_search_t *)ctx;
+
+    if (id == TASK_ID_NONE)
+    {
+        task_search_clear(search);
+        return;
+    }
+    if (id >= search->capacity)
+        return;
+
+    if (old)
+        task_search_remove(search, id, old);
+    if (task)
+        task_search_add(search, id, task);
+
+    if (search->active)
+        set_match(search, id, task != RT_NULL && task_matches(task, search->query));
+}
+
+/* ==================== 查询 ==================== */
+
+/* 执行查询并更新结果位图，返回匹配的任务数；空查询表示不过滤 */
+rt_uint32_t task_search_query(task_search_t *search, const task_store_t *store, const char *query)
+{
+    rt_uint16_t grams[TASK_SEARCH_QUERY_SIZE];
+    rt_uint32_t t0 = app_perf_now_cycles();
+    rt_uint32_t matches = 0, candidates = 0;
+    int len = 0, n;
+
+    /* 保存小写的查询串 */
+    while (query && query[len] && len < TASK_SEARCH_QUERY_SIZE - 1)
+    {
+        search->query[len] = (char)to_lower((unsigned char)query[len]);
+        len++;
+    }
+    search->query[len] = '\0';
+
+    search->active = (len > 0);
+    if (!search->active)
+        return task_store_count(store);
+
+    rt_memset(search->match, 0, (search->capacity + 7) / 8);
+    search->stats.queries++;
+
+    if (len < TASK_SEARCH_GRAM || search->overflow)
+    {
+        /* 短查询：扫描全部任务 */
+        search->stats.scans++;
+        for (rt_uint32_t id = 0; id < search->capacity; id++)
+        {
+            const task_info_t *task = task_store_get(store, (task_id_t)id);
+            if (task == RT_NULL)
+                continue;
+            candidates++;
+            if (task_matches(task, search->query))
+            {
+                set_match(search, (task_id_t)id, true);
+                matches++;
+            }
+        }
+    }
+    else
+    {
+        const task_search_bucket_t *smallest;
+
+        /* 以最短的桶为候选，检查其余各桶是否都包含，再确认子串 */
+        n = collect_grams(search->query, grams, 0, TASK_SEARCH_QUERY_SIZE);
+        smallest = &search->buckets[grams[0]];
+        for (int i = 1; i < n; i++)
+        {
+            if (search->buckets[grams[i]].count < smallest->count)
+                smallest = &search->buckets[grams[i]];
+        }
+
+        for (rt_uint32_t k = 0; k < smallest->count; k++)
+        {
+            task_id_t id = smallest->ids[k];
+            const task_info_t *task;
+            int i;
+
+            for (i = 0; i < n; i++)
+            {
+                if (&search->buckets[grams[i]] != smallest &&
+                    !bucket_contains(&search->buckets[grams[i]], id))
+                    break;
+            }
+            if (i < n)
+                continue;
+
+            candidates++;
+            task = task_store_get(store, id);
+            if (task != RT_NULL && task_matches(task, search->query))
+            {
+                set_match(search, id, true);
+                matches++;
+            }
+        }
+    }
+
+    search->stats.candidates = candidates;
+    search->stats.matches = matches;
+    search->stats.last_us = app_perf_elapsed_us(t0);
+    if (search->stats.last_us > search->stats.max_us)
+        search->stats.max_us = search->stats.last_us;
+    return matches;
+}
+
+/* 没有查询条件时所有任务都匹配 */
+bool task_search_match(const task_search_t *search, task_id_t id)
+{
+    if (!search->active)
+        return true;
+    if (id >= search->capacity)
+        return false;
+    return (search->match[id / 8] & (1 << (id % 8))) != 0;
+}
+
+/* 索引占用的内存字节数 */
+rt_uint32_t task_search_memory(const task_search_t *search)
+{
+    rt_uint32_t bytes = sizeof(task_search_t) + (search->capacity + 7) / 8;
+
+    for (int i = 0; i < TASK_SEARCH_BUCKETS; i++)
+        bytes += search->buckets[i].cap * sizeof(task_id_t);
+    return bytes;
+}
+
+#ifdef APP_USING_TEST
+#include <finsh.h>
+#include "app_test.h"
+
+static void search_bench_cmd(int argc, char **argv)
+{
+    task_store_t store;
+    task_search_t search;
+    task_info_t task;
+    rt_uint32_t count = argc > 1 ? atoi(argv[1]) : 5000;
+    rt_uint32_t queries = argc > 2 ? atoi(argv[2]) : 200;
+    rt_uint32_t t0, t_build, us, max_us = 0, sum_us = 0, sum_matches = 0;
+    rt_uint32_t upd_max = 0, upd_sum = 0, updates = 1000;
+
+    if (task_store_init(&store, count) != RT_EOK)
+        return;
+    if (task_search_init(&search, count, count * 48) != RT_EOK)
+    {
+        task_store_deinit(&store);
+        return;
+    }
+    task_store_set_listener(&store, task_search_on_change, &search);
+    app_test_srand(1);
+
+    /* 建立索引 */
+    t0 = app_perf_now_cycles();
+    task_store_begin_batch(&store);
+    for (rt_uint32_t i = 0; i < count; i++)
+    {
+        app_test_make_task(&task, i + 1, 9);
+        task_store_add(&store, &task);
+    }
+    task_store_end_batch(&store);
+    t_build = app_perf_elapsed_us(t0);
+
+    /* 修改单个任务标题 */
+    for (rt_uint32_t i = 0; i < updates; i++)
+    {
+        task_id_t id = app_test_rand(count);
+
+        task = *task_store_get(&store, id);
+        rt_snprintf(task.title, sizeof(task.title), "%s %s %d",
+                    app_test_word(), app_test_word(), i);
+        t0 = app_perf_now_cycles();
+        task_store_update(&store, id, &task);
+        us = app_perf_elapsed_us(t0);
+        upd_sum += us;
+        if (us > upd_max) upd_max = us;
+    }
+
+    /* 查询：随机任务标题中的3~6个字符 */
+    for (rt_uint32_t i = 0; i < queries; i++)
+    {
+        const task_info_t *t = task_store_get(&store, app_test_rand(count));
+        char q[8];
+        int len = 3 + app_test_rand(4);
+        int start = app_test_rand(rt_strlen(t->title) - len + 1);
+
+        rt_strncpy(q, t->title + start, len);
+        q[len] = '\0';
+        t0 = app_perf_now_cycles();
+        sum_matches += task_search_query(&search, &store, q);
+        us = app_perf_elapsed_us(t0);
+        sum_us += us;
+        if (us > max_us) max_us = us;
+    }
+
+    rt_kprintf("tasks: %d, postings: %d%s\n", count, search.postings, search.overflow ? " (overflow)" : "");
+    rt_kprintf("build: %d us, %d updates: avg %d us, max %d us\n",
+               t_build, updates, upd_sum / updates, upd_max);
+    if (queries)
+    {
+        rt_kprintf("%d queries: avg %d us, max %d us, avg %d matches\n",
+                   queries, sum_us / queries, max_us, sum_matches / queries);
+    }
+    t0 = app_perf_now_cycles();
+    task_search_query(&search, &store, "ch");
+    rt_kprintf("2-char scan: %d us, %d matches\n", app_perf_elapsed_us(t0), search.stats.matches);
+    rt_kprintf("index memory: %d bytes\n", task_search_memory(&search));
+
+    task_search_deinit(&search);
+    task_store_deinit(&store);
+}
+MSH_CMD_EXPORT_ALIAS(search_bench_cmd, search_bench, benchmark task search index [count] [queries]);
+#endif /* APP_USING_TEST */
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __TASK_SEARCH_H__
+#define __TASK_SEARCH_H__
+
+#include <rtthread.h>
+#include <stdbool.h>
+#include "task_store.h"
+
+/* 任务全文搜索：对标题和列表名建立三字母组（trigram）倒排索引，
+ * 三字母组散列到固定数量的桶中，每个桶是有序的任务ID数组。
+ * 通过task_store的变化通知增量维护；查询时取各三字母组的桶求交集，
+ * 再对候选任务做子串确认。少于3个字符的查询直接扫描 */
+
+#define TASK_SEARCH_BUCKETS     1024    /* 散列桶数（2的幂） */
+#define TASK_SEARCH_GRAM        3
+#define TASK_SEARCH_QUERY_SIZE  32
+
+typedef struct {
+    task_id_t *ids;             /* 有序 */
+    rt_uint16_t count;
+    rt_uint16_t cap;
+} task_search_bucket_t;
+
+typedef struct {
+    rt_uint32_t queries;
+    rt_uint32_t scans;          /* 短查询或索引溢出时的线性扫描 */
+    rt_uint32_t candidates;     /* 最近一次查询的候选数 */
+    rt_uint32_t matches;        /* 最近一次查询的结果数 */
+    rt_uint32_t last_us;        /* 最近一次查询耗时 */
+    rt_uint32_t max_us;
+} task_search_stats_t;
+
+typedef struct {
+    task_search_bucket_t buckets[TASK_SEARCH_BUCKETS];
+    rt_uint32_t postings;       /* 索引项总数 */
+    rt_uint32_t max_postings;   /* 索引项上限，超过后退化为线性扫描 */
+    bool overflow;
+    rt_uint32_t capacity;       /* 任务ID上限 */
+    rt_uint8_t *match;          /* 查询结果位图 */
+    bool active;                /* 有查询条件 */
+    char query[TASK_SEARCH_QUERY_SIZE];
+    task_search_stats_t stats;
+} task_search_t;
+
+rt_err_t task_search_init(task_search_t *search, rt_uint32_t capacity, rt_uint32_t max_postings);
+void task_search_deinit(task_search_t *search);
+void task_search_clear(task_search_t *search);
+void task_search_add(task_search_t *search, task_id_t id, const task_info_t *task);
+void task_search_remove(task_search_t *search, task_id_t id, const task_info_t *task);
+
+/* 作为task_store的监听者，ctx为task_search_t */
+void task_search_on_change(void *ctx, task_id_t id, const task_info_t *old, const task_info_t *task);
+
+rt_uint32_t task_search_query(task_search_t *search, const task_store_t *store, const char *query);
+bool task_search_match(const task_search_t *search, task_id_t id);
+rt_uint32_t task_search_memory(const task_search_t *search);
+
+#endif /* __TASK_SEARCH_H__ */
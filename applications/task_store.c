@@ -0,0 +1,777 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include "task_store.h"
+
+#define DBG_TAG "task.store"
+#define DBG_LVL DBG_INFO
+#include <rtdbg.h>
+
+static const char *sort_names[TASK_SORT_NUM] = {"order", "list", "title", "status"};
+
+/* ==================== 排序与过滤 ==================== */
+
+/* 不区分大小写的字符串比较 */
+static int title_cmp(const char *a, const char *b)
+{
+    int ca, cb;
+
+    do
+    {
+        ca = (unsigned char)*a++;
+        cb = (unsigned char)*b++;
+        if (ca >= 'A' && ca <= 'Z') ca += 'a' - 'A';
+        if (cb >= 'A' && cb <= 'Z') cb += 'a' - 'A';
+    } while (ca == cb && ca != '\0');
+
+    return ca - cb;
+}
+
+/* 比较两个任务在视图中的先后，最后按ID比较，保证是全序，二分查找可以精确定位 */
+static int entry_cmp(task_sort_t sort,
+                     const task_info_t *ta, rt_uint32_t seqa, task_id_t ida,
+                     const task_info_t *tb, rt_uint32_t seqb, task_id_t idb)
+{
+    int r = 0;
+
+    switch (sort)
+    {
+    case TASK_SORT_STATUS:
+        r = (int)ta->status - (int)tb->status;
+        if (r != 0) break;
+        /* 同状态按列表 */
+        /* fall through */
+    case TASK_SORT_LIST:
+        r = ta->list_num - tb->list_num;
+        if (r == 0) r = ta->task_num - tb->task_num;
+        break;
+    case TASK_SORT_TITLE:
+        r = title_cmp(ta->title, tb->title);
+        break;
+    default:
+        break;
+    }
+
+    if (r == 0)
+        r = (seqa > seqb) - (seqa < seqb);
+    if (r == 0)
+        r = (int)ida - (int)idb;
+    return r;
+}
+
+static bool filter_match(const task_filter_t *filter, const task_info_t *task)
+{
+    if (!(filter->status_mask & (1 << task->status)))
+        return false;
+    if (filter->list_num != 0 && task->list_num != filter->list_num)
+        return false;
+    return true;
+}
+
+/* 在视图中查找任务应在的位置（第一个不小于它的位置） */
+static rt_uint32_t view_lower_bound(const task_store_t *store, const task_view_t *view,
+                                    const task_info_t *task, rt_uint32_t seq, task_id_t id)
+{
+    rt_uint32_t lo = 0, hi = view->count;
+
+    while (lo < hi)
+    {
+        rt_uint32_t mid = (lo + hi) / 2;
+        task_id_t mid_id = view->ids[mid];
+
+        /* 删除时目标任务已被修改，遇到它本身时视为相等 */
+        if (mid_id == id)
+            hi = mid;
+        else if (entry_cmp(view->sort, &store->tasks[mid_id], store->seq[mid_id], mid_id,
+                           task, seq, id) < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+static void view_insert(task_store_t *store, task_view_t *view, task_id_t id)
+{
+    rt_uint32_t pos;
+
+    if (!filter_match(&view->filter, &store->tasks[id]))
+        return;
+
+    pos = view_lower_bound(store, view, &store->tasks[id], store->seq[id], id);
+    rt_memmove(&view->ids[pos + 1], &view->ids[pos], (view->count - pos) * sizeof(task_id_t));
+    view->ids[pos] = id;
+    view->count++;
+    store->stats.view_inserts++;
+}
+
+/* old为任务修改前的内容，用它定位任务在视图中的位置 */
+static void view_remove(task_store_t *store, task_view_t *view, task_id_t id, const task_info_t *old)
+{
+    rt_uint32_t pos;
+
+    if (!filter_match(&view->filter, old))
+        return;
+
+    /* 其他任务用当前内容比较，目标任务用修改前的内容 */
+    pos = view_lower_bound(store, view, old, store->seq[id], id);
+    if (pos >= view->count || view->ids[pos] != id)
+    {
+        /* 不应发生，退回线性查找 */
+        for (pos = 0; pos < view->count && view->ids[pos] != id; pos++);
+        if (pos >= view->count)
+            return;
+    }
+
+    rt_memmove(&view->ids[pos], &view->ids[pos + 1], (view->count - pos - 1) * sizeof(task_id_t));
+    view->count--;
+    store->stats.view_removes++;
+}
+
+/* qsort没有上下文参数，排序期间通过静态变量传递（只在持有ui_mutex时调用） */
+static const task_store_t *qsort_store;
+static task_sort_t qsort_sort;
+
+static int qsort_cmp(const void *a, const void *b)
+{
+    task_id_t ida = *(const task_id_t *)a;
+    task_id_t idb = *(const task_id_t *)b;
+
+    return entry_cmp(qsort_sort, &qsort_store->tasks[ida], qsort_store->seq[ida], ida,
+                     &qsort_store->tasks[idb], qsort_store->seq[idb], idb);
+}
+
+/* 完整重建视图 */
+static void view_build(task_store_t *store, task_view_t *view)
+{
+    view->count = 0;
+    for (rt_uint32_t i = 0; i < store->capacity; i++)
+    {
+        if (store->tasks[i].is_valid && filter_match(&view->filter, &store->tasks[i]))
+            view->ids[view->count++] = (task_id_t)i;
+    }
+
+    qsort_store = store;
+    qsort_sort = view->sort;
+    qsort(view->ids, view->count, sizeof(task_id_t), qsort_cmp);
+
+    view->stale = false;
+    store->stats.view_builds++;
+}
+
+/* ==================== 编号索引 ==================== */
+
+/* 线性探测的散列表，删除时后移填补空位，不使用墓碑 */
+static rt_uint32_t key_hash(int list_num, int task_num)
+{
+    rt_uint32_t h = (rt_uint32_t)list_num * 0x9E3779B1u ^ (rt_uint32_t)task_num * 0x85EBCA77u;
+    return h ^ (h >> 15);
+}
+
+static rt_uint32_t slot_home(const task_store_t *store, task_id_t id)
+{
+    return key_hash(store->tasks[id].list_num, store->tasks[id].task_num) & store->hash_mask;
+}
+
+static void hash_insert(task_store_t *store, task_id_t id)
+{
+    rt_uint32_t i = slot_home(store, id);
+
+    while (store->hash[i] != TASK_ID_NONE)
+        i = (i + 1) & store->hash_mask;
+    store->hash[i] = id;
+}
+
+static void hash_remove(task_store_t *store, task_id_t id, int list_num, int task_num)
+{
+    rt_uint32_t i = key_hash(list_num, task_num) & store->hash_mask;
+    rt_uint32_t j, k;
+
+    while (store->hash[i] != id)
+    {
+        if (store->hash[i] == TASK_ID_NONE)
+            return;
+        i = (i + 1) & store->hash_mask;
+    }
+
+    /* 把后面探测链上的项前移，保证查找不会提前遇到空位 */
+    j = i;
+    for (;;)
+    {
+        j = (j + 1) & store->hash_mask;
+        if (store->hash[j] == TASK_ID_NONE)
+            break;
+        k = slot_home(store, store->hash[j]);
+        if ((j > i && (k <= i || k > j)) || (j < i && k <= i && k > j))
+        {
+            store->hash[i] = store->hash[j];
+            i = j;
+        }
+    }
+    store->hash[i] = TASK_ID_NONE;
+}
+
+/* 按(列表编号, 任务编号)查找任务，没有时返回TASK_ID_NONE */
+task_id_t task_store_find(task_store_t *store, int list_num, int task_num)
+{
+    rt_uint32_t i;
+
+    if (store->hash == RT_NULL)
+        return TASK_ID_NONE;
+
+    store->stats.lookups++;
+    i = key_hash(list_num, task_num) & store->hash_mask;
+    while (store->hash[i] != TASK_ID_NONE)
+    {
+        const task_info_t *task = &store->tasks[store->hash[i]];
+
+        store->stats.probes++;
+        if (task->list_num == list_num && task->task_num == task_num)
+            return store->hash[i];
+        i = (i + 1) & store->hash_mask;
+    }
+    return TASK_ID_NONE;
+}
+
+/* ==================== 存储 ==================== */
+
+rt_err_t task_store_init(task_store_t *store, rt_uint32_t capacity)
+{
+    rt_uint32_t hash_size = 1;
+
+    rt_memset(store, 0, sizeof(task_store_t));
+
+    if (capacity == 0 || capacity >= TASK_ID_NONE / 2)
+        return -RT_EINVAL;
+
+    /* 散列表至少是容量的两倍，装载率不超过一半 */
+    while (hash_size < capacity * 2)
+        hash_size <<= 1;
+
+    store->tasks = rt_calloc(capacity, sizeof(task_info_t));
+    store->seq = rt_calloc(capacity, sizeof(rt_uint32_t));
+    store->free_ids = rt_malloc(capacity * sizeof(task_id_t));
+    store->hash = rt_malloc(hash_size * sizeof(task_id_t));
+    store->hash_mask = hash_size - 1;
+    if (store->tasks == RT_NULL || store->seq == RT_NULL || store->free_ids == RT_NULL ||
+        store->hash == RT_NULL)
+    {
+        LOG_E("No memory for %d tasks", capacity);
+        task_store_deinit(store);
+        return -RT_ENOMEM;
+    }
+
+    store->capacity = capacity;
+    task_store_clear(store);
+    return RT_EOK;
+}
+
+void task_store_deinit(task_store_t *store)
+{
+    for (int i = 0; i < TASK_STORE_MAX_VIEWS; i++)
+    {
+        if (store->views[i].ids)
+            rt_free(store->views[i].ids);
+    }
+    if (store->tasks) rt_free(store->tasks);
+    if (store->seq) rt_free(store->seq);
+    if (store->free_ids) rt_free(store->free_ids);
+    if (store->hash) rt_free(store->hash);
+    rt_memset(store, 0, sizeof(task_store_t));
+}
+
+/* 清空所有任务，已缓存的视图保留并清空 */
+void task_store_clear(task_store_t *store)
+{
+    for (rt_uint32_t i = 0; i < store->capacity; i++)
+    {
+        store->tasks[i].is_valid = false;
+        /* 低编号槽位在栈顶，先被使用 */
+        store->free_ids[i] = (task_id_t)(store->capacity - 1 - i);
+    }
+    store->free_count = store->capacity;
+    store->count = 0;
+    rt_memset(store->hash, 0xFF, (store->hash_mask + 1) * sizeof(task_id_t));
+
+    for (int i = 0; i < TASK_STORE_MAX_VIEWS; i++)
+    {
+        store->views[i].count = 0;
+        store->views[i].stale = false;
+    }
+
+    if (store->listener)
+        store->listener(store->listener_ctx, TASK_ID_NONE, RT_NULL, RT_NULL);
+}
+
+/* 注册任务变化通知，用于维护视图以外的索引 */
+void task_store_set_listener(task_store_t *store, task_store_listener_t listener, void *ctx)
+{
+    store->listener = listener;
+    store->listener_ctx = ctx;
+}
+
+void task_store_begin_batch(task_store_t *store)
+{
+    store->batch_depth++;
+}
+
+void task_store_end_batch(task_store_t *store)
+{
+    if (store->batch_depth == 0 || --store->batch_depth > 0)
+        return;
+
+    for (int i = 0; i < TASK_STORE_MAX_VIEWS; i++)
+    {
+        if (store->views[i].valid && store->views[i].stale)
+            view_build(store, &store->views[i]);
+    }
+}
+
+/* 任务变化时维护所有视图并通知监听者，old为空表示新增，present为false表示删除 */
+static void views_update(task_store_t *store, task_id_t id, const task_info_t *old, bool present)
+{
+    if (store->listener)
+        store->listener(store->listener_ctx, id, old, present ? &store->tasks[id] : RT_NULL);
+
+    for (int i = 0; i < TASK_STORE_MAX_VIEWS; i++)
+    {
+        task_view_t *view = &store->views[i];
+
+        if (!view->valid)
+            continue;
+        if (store->batch_depth > 0)
+        {
+            view->stale = true;
+            continue;
+        }
+        /* 排序字段和过滤结果都没变时位置不变 */
+        if (old && present &&
+            filter_match(&view->filter, old) == filter_match(&view->filter, &store->tasks[id]) &&
+            entry_cmp(view->sort, old, 0, 0, &store->tasks[id], 0, 0) == 0)
+            continue;
+
+        if (old)
+            view_remove(store, view, id, old);
+        if (present)
+            view_insert(store, view, id);
+    }
+}
+
+/* 新增任务，存储已满或编号重复时返回TASK_ID_NONE */
+task_id_t task_store_add(task_store_t *store, const task_info_t *task)
+{
+    task_id_t id;
+
+    if (store->free_count == 0 || task_store_find(store, task->list_num, task->task_num) != TASK_ID_NONE)
+        return TASK_ID_NONE;
+
+    id = store->free_ids[--store->free_count];
+    store->tasks[id] = *task;
+    store->tasks[id].is_valid = true;
+    store->seq[id] = store->next_seq;
+    store->next_seq += TASK_STORE_SEQ_GAP;
+    store->count++;
+    hash_insert(store, id);
+
+    views_update(store, id, RT_NULL, true);
+    return id;
+}
+
+rt_err_t task_store_update(task_store_t *store, task_id_t id, const task_info_t *task)
+{
+    task_info_t old;
+
+    bool rekey;
+
+    if (task_store_get(store, id) == RT_NULL)
+        return -RT_EINVAL;
+
+    /* 编号改变时不能与其他任务重复 */
+    rekey = (task->list_num != store->tasks[id].list_num || task->task_num != store->tasks[id].task_num);
+    if (rekey && task_store_find(store, task->list_num, task->task_num) != TASK_ID_NONE)
+        return -RT_EINVAL;
+
+    old = store->tasks[id];
+    store->tasks[id] = *task;
+    store->tasks[id].is_valid = true;
+    if (rekey)
+    {
+        hash_remove(store, id, old.list_num, old.task_num);
+        hash_insert(store, id);
+    }
+
+    views_update(store, id, &old, true);
+    return RT_EOK;
+}
+
+rt_err_t task_store_set_status(task_store_t *store, task_id_t id, rt_uint8_t status)
+{
+    task_info_t task;
+
+    if (task_store_get(store, id) == RT_NULL || status >= TASK_STATUS_NUM)
+        return -RT_EINVAL;
+
+    task = store->tasks[id];
+    task.status = status;
+    return task_store_update(store, id, &task);
+}
+
+rt_err_t task_store_remove(task_store_t *store, task_id_t id)
+{
+    task_info_t old;
+
+    if (task_store_get(store, id) == RT_NULL)
+        return -RT_EINVAL;
+
+    old = store->tasks[id];
+    store->tasks[id].is_valid = false;
+    hash_remove(store, id, old.list_num, old.task_num);
+    store->free_ids[store->free_count++] = id;
+    store->count--;
+
+    views_update(store, id, &old, false);
+    return RT_EOK;
+}
+
+/* 改变任务的接收序号（即在接收顺序中的位置），内容不变，不通知监听者 */
+rt_err_t task_store_set_order(task_store_t *store, task_id_t id, rt_uint32_t seq)
+{
+    if (task_store_get(store, id) == RT_NULL)
+        return -RT_EINVAL;
+    if (store->seq[id] == seq)
+        return RT_EOK;
+
+    /* 先用旧序号从视图中取出，再按新序号插入 */
+    for (int i = 0; i < TASK_STORE_MAX_VIEWS; i++)
+    {
+        if (!store->views[i].valid)
+            continue;
+        if (store->batch_depth > 0)
+            store->views[i].stale = true;
+        else
+            view_remove(store, &store->views[i], id, &store->tasks[id]);
+    }
+
+    store->seq[id] = seq;
+    if (seq >= store->next_seq)
+        store->next_seq = seq + TASK_STORE_SEQ_GAP;
+
+    for (int i = 0; i < TASK_STORE_MAX_VIEWS; i++)
+    {
+        if (store->views[i].valid && store->batch_depth == 0)
+            view_insert(store, &store->views[i], id);
+    }
+    return RT_EOK;
+}
+
+rt_uint32_t task_store_order(const task_store_t *store, task_id_t id)
+{
+    return store->seq[id];
+}
+
+const task_info_t *task_store_get(const task_store_t *store, task_id_t id)
+{
+    if (id >= store->capacity || !store->tasks[id].is_valid)
+        return RT_NULL;
+    return &store->tasks[id];
+}
+
+rt_uint32_t task_store_count(const task_store_t *store)
+{
+    return store->count;
+}
+
+/* ==================== 视图 ==================== */
+
+task_view_t *task_store_get_view(task_store_t *store, task_sort_t sort, const task_filter_t *filter)
+{
+    task_view_t *view = RT_NULL;
+
+    if (sort >= TASK_SORT_NUM)
+        return RT_NULL;
+
+    for (int i = 0; i < TASK_STORE_MAX_VIEWS; i++)
+    {
+        task_view_t *v = &store->views[i];
+
+        if (v->valid && v->sort == sort &&
+            v->filter.status_mask == filter->status_mask && v->filter.list_num == filter->list_num)
+        {
+            v->last_used = ++store->use_clock;
+            store->stats.view_hits++;
+            return v;
+        }
+        /* 优先使用空闲槽位，否则淘汰最久未使用的视图 */
+        if (view == RT_NULL || (view->valid && (!v->valid || v->last_used < view->last_used)))
+            view = v;
+    }
+
+    if (view->ids == RT_NULL)
+    {
+        view->ids = rt_malloc(store->capacity * sizeof(task_id_t));
+        if (view->ids == RT_NULL)
+            return RT_NULL;
+    }
+
+    view->sort = sort;
+    view->filter = *filter;
+    view->valid = true;
+    view->last_used = ++store->use_clock;
+    view_build(store, view);
+    return view;
+}
+
+task_id_t task_view_at(const task_view_t *view, rt_uint32_t index)
+{
+    if (view == RT_NULL || index >= view->count)
+        return TASK_ID_NONE;
+    return view->ids[index];
+}
+
+/* 返回任务在视图中的位置，不在视图中时返回view->count */
+rt_uint32_t task_view_find(const task_store_t *store, const task_view_t *view, task_id_t id)
+{
+    rt_uint32_t pos;
+
+    if (task_store_get(store, id) == RT_NULL)
+        return view->count;
+
+    pos = view_lower_bound(store, view, &store->tasks[id], store->seq[id], id);
+    if (pos < view->count && view->ids[pos] == id)
+        return pos;
+    return view->count;
+}
+
+/* 从start开始属于同一列表的最后一个位置之后，按列表排序的视图中即为一个分组 */
+rt_uint32_t task_view_group_end(const task_store_t *store, const task_view_t *view, rt_uint32_t start)
+{
+    rt_uint32_t end = start;
+    int list_num;
+
+    if (start >= view->count)
+        return view->count;
+
+    list_num = store->tasks[view->ids[start]].list_num;
+    while (end < view->count && store->tasks[view->ids[end]].list_num == list_num)
+        end++;
+    return end;
+}
+
+const char *task_sort_name(task_sort_t sort)
+{
+    return sort < TASK_SORT_NUM ? sort_names[sort] : "?";
+}
+
+#ifdef APP_USING_TEST
+#include <finsh.h>
+#include "app_perf.h"
+#include "app_test.h"
+
+static void task_bench_cmd(int argc, char **argv)
+{
+    static const task_filter_t all = {TASK_FILTER_ANY_STATUS, 0};
+    static const task_filter_t open_only = {1 << TASK_STATUS_OPEN, 0};
+    task_store_t store;
+    task_info_t task;
+    rt_uint32_t count = argc > 1 ? atoi(argv[1]) : 10000;
+    rt_uint32_t updates = argc > 2 ? atoi(argv[2]) : 1000;
+    rt_uint32_t t0, t_fill, t_views, t_switch, t_rebuild;
+    rt_uint32_t max_us = 0, sum_us = 0;
+
+    if (task_store_init(&store, count) != RT_EOK)
+        return;
+
+    app_test_srand(1);
+
+    /* 批量加载 */
+    t0 = app_perf_now_cycles();
+    task_store_begin_batch(&store);
+    for (rt_uint32_t i = 0; i < count; i++)
+    {
+        app_test_make_task(&task, i + 1, 9);
+        task_store_add(&store, &task);
+    }
+    task_store_end_batch(&store);
+    t_fill = app_perf_elapsed_us(t0);
+
+    /* 首次建立四个视图 */
+    t0 = app_perf_now_cycles();
+    if (task_store_get_view(&store, TASK_SORT_LIST, &all) == RT_NULL ||
+        task_store_get_view(&store, TASK_SORT_TITLE, &all) == RT_NULL ||
+        task_store_get_view(&store, TASK_SORT_STATUS, &all) == RT_NULL ||
+        task_store_get_view(&store, TASK_SORT_TITLE, &open_only) == RT_NULL)
+    {
+        rt_kprintf("No memory for views\n");
+        task_store_deinit(&store);
+        return;
+    }
+    t_views = app_perf_elapsed_us(t0);
+
+    /* 单个任务修改，增量维护全部视图 */
+    for (rt_uint32_t i = 0; i < updates; i++)
+    {
+        task_id_t id = app_test_rand(count);
+        rt_uint32_t us;
+
+        t0 = app_perf_now_cycles();
+        if (i & 1)
+        {
+            task_store_set_status(&store, id, !store.tasks[id].status);
+        }
+        else
+        {
+            task = store.tasks[id];
+            task.title[0] = 'a' + app_test_rand(26);
+            task_store_update(&store, id, &task);
+        }
+        us = app_perf_elapsed_us(t0);
+        sum_us += us;
+        if (us > max_us) max_us = us;
+    }
+
+    /* 切换到已缓存的视图 */
+    t0 = app_perf_now_cycles();
+    task_store_get_view(&store, TASK_SORT_LIST, &all);
+    task_store_get_view(&store, TASK_SORT_TITLE, &open_only);
+    t_switch = app_perf_elapsed_us(t0);
+
+    /* 对比：单个视图完整重新排序 */
+    t0 = app_perf_now_cycles();
+    view_build(&store, &store.views[0]);
+    t_rebuild = app_perf_elapsed_us(t0);
+
+    rt_kprintf("tasks: %d, views: %d\n", count, TASK_STORE_MAX_VIEWS);
+    rt_kprintf("batch load: %d us, build 4 views: %d us\n", t_fill, t_views);
+    rt_kprintf("%d updates: avg %d us, max %d us (all views)\n",
+               updates, updates ? sum_us / updates : 0, max_us);
+    rt_kprintf("switch 2 cached views: %d us, full resort of 1 view: %d us\n", t_switch, t_rebuild);
+    rt_kprintf("memory: %d bytes tasks, %d bytes per view\n",
+               count * (sizeof(task_info_t) + sizeof(rt_uint32_t) + sizeof(task_id_t)),
+               count * sizeof(task_id_t));
+
+    task_store_deinit(&store);
+}
+MSH_CMD_EXPORT_ALIAS(task_bench_cmd, task_bench, benchmark task views [count] [updates]);
+
+/* ==================== 编号测试 ==================== */
+#include "task_parser.h"
+
+#define ID_TEST_COUNT   4096
+
+typedef struct {
+    int list_num, task_num;
+    const char *title;
+    const char *list_name;
+} id_test_expect_t;
+
+/* 多位编号、最大位数、超出位数、前导零和标题中的点号 */
+static const char id_test_data[] =
+    "10.Work,10.1.a,10.23.b,123456789.987654321.c.d,1234567890.1.too long,12.0x.bad,"
+    "42.Home,42.7.e,1.23.f,12.3.g";
+static const id_test_expect_t id_test_expect[] = {
+    {10, 1, "a", "Work"},
+    {10, 23, "b", "Work"},
+    {123456789, 987654321, "c.d", "Work"},
+    {42, 7, "e", "Home"},
+    {1, 23, "f", "Home"},
+    {12, 3, "g", "Home"},
+};
+#define ID_TEST_EXPECT (sizeof(id_test_expect) / sizeof(id_test_expect[0]))
+
+static bool id_test_emit(void *ctx, const task_info_t *task)
+{
+    return task_store_add((task_store_t *)ctx, task) != TASK_ID_NONE;
+}
+
+/* 大编号测试：解析多位编号并按编号查找，再用大量接近int上限的编号检查散列表的探测次数和删除 */
+static void task_id_test_cmd(void)
+{
+    task_store_t store;
+    task_parser_t parser;
+    task_info_t task;
+    rt_uint32_t found = 0, missing = 0, t0, us;
+    bool pass, all = true;
+
+    if (task_store_init(&store, ID_TEST_COUNT) != RT_EOK)
+        return;
+
+    /* 解析后按编号找到的任务应与期望一致，无效的token被忽略 */
+    task_parser_begin(&parser, id_test_data, id_test_emit, &store);
+    while (task_parser_step(&parser, 0, 0) == TASK_PARSE_MORE);
+    task_parser_end(&parser);
+    pass = task_store_count(&store) == ID_TEST_EXPECT;
+    for (rt_uint32_t i = 0; i < ID_TEST_EXPECT; i++)
+    {
+        const id_test_expect_t *e = &id_test_expect[i];
+        task_id_t id = task_store_find(&store, e->list_num, e->task_num);
+
+        pass = pass && id != TASK_ID_NONE
+               && rt_strcmp(task_store_get(&store, id)->title, e->title) == 0
+               && rt_strcmp(task_store_get(&store, id)->list_name, e->list_name) == 0;
+    }
+    pass = pass && task_store_find(&store, 123456789, 98765432) == TASK_ID_NONE
+           && task_store_find(&store, 1234567890, 1) == TASK_ID_NONE;
+    rt_kprintf("parse   %d tasks from %d tokens  %s\n", task_store_count(&store), parser.tokens,
+               pass ? "PASS" : "FAIL");
+    all &= pass;
+
+    /* 编号接近int上限，列表编号只有几十种 */
+    task_store_clear(&store);
+    rt_memset(&task, 0, sizeof(task));
+    task.is_valid = true;
+    for (rt_uint32_t i = 0; i < ID_TEST_COUNT; i++)
+    {
+        task.list_num = 100000000 + (i % 64) * 1000003;
+        task.task_num = 999999999 - i * 7;
+        rt_snprintf(task.title, sizeof(task.title), "t%d", i);
+        task_store_add(&store, &task);
+    }
+    rt_memset(&store.stats, 0, sizeof(store.stats));
+    t0 = app_perf_now_cycles();
+    for (rt_uint32_t i = 0; i < ID_TEST_COUNT; i++)
+    {
+        task_id_t id = task_store_find(&store, 100000000 + (i % 64) * 1000003, 999999999 - i * 7);
+
+        if (id != TASK_ID_NONE && atoi(store.tasks[id].title + 1) == (int)i)
+            found++;
+    }
+    us = app_perf_elapsed_us(t0);
+    /* 装载率不超过一半，平均探测次数应接近1 */
+    pass = found == ID_TEST_COUNT && store.stats.probes <= store.stats.lookups * 2;
+    rt_kprintf("find    %d/%d, %d probes per 100 lookups, %d us  %s\n", found, ID_TEST_COUNT,
+               store.stats.probes * 100 / store.stats.lookups, us, pass ? "PASS" : "FAIL");
+    all &= pass;
+
+    /* 删除一半后，删除的找不到，留下的都还能找到 */
+    for (rt_uint32_t i = 0; i < ID_TEST_COUNT; i += 2)
+        task_store_remove(&store, task_store_find(&store, 100000000 + (i % 64) * 1000003, 999999999 - i * 7));
+    found = 0;
+    for (rt_uint32_t i = 0; i < ID_TEST_COUNT; i++)
+    {
+        task_id_t id = task_store_find(&store, 100000000 + (i % 64) * 1000003, 999999999 - i * 7);
+
+        if (i & 1)
+            found += (id != TASK_ID_NONE && atoi(store.tasks[id].title + 1) == (int)i);
+        else
+            missing += (id == TASK_ID_NONE);
+    }
+    pass = found == ID_TEST_COUNT / 2 && missing == ID_TEST_COUNT / 2
+           && task_store_count(&store) == ID_TEST_COUNT / 2;
+    rt_kprintf("remove  %d found, %d gone  %s\n", found, missing, pass ? "PASS" : "FAIL");
+    all &= pass;
+
+    rt_kprintf("task_id_test: %s\n", all ? "PASS" : "FAIL");
+    task_store_deinit(&store);
+}
+MSH_CMD_EXPORT_ALIAS(task_id_test_cmd, task_id_test, check task lookup with large list and task IDs);
+#endif /* APP_USING_TEST */
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __TASK_STORE_H__
+#define __TASK_STORE_H__
+
+#include <rtthread.h>
+#include <stdbool.h>
+#include "task_model.h"
+
+/* 任务存储与视图：任务存放在固定槽位中，ID即槽位号，增删改时不移动数据。
+ * 任务的身份是(列表编号, 任务编号)，通过散列索引在O(1)时间内找到槽位，不允许重复。
+ * 视图是按排序方式和过滤条件得到的ID数组，增删改时用二分查找增量维护；
+ * 多个视图同时缓存，切换排序或过滤时直接使用已缓存的视图，不重新排序 */
+
+#define TASK_STORE_MAX_VIEWS    4           /* 同时缓存的视图数 */
+#define TASK_ID_NONE            0xFFFF
+#define TASK_STORE_SEQ_GAP      256         /* 相邻新增任务的接收序号间隔，调整顺序时可插在中间 */
+
+typedef rt_uint16_t task_id_t;
+
+/* 排序方式 */
+typedef enum {
+    TASK_SORT_ORDER = 0,        /* 接收顺序 */
+    TASK_SORT_LIST,             /* 按列表分组，组内按任务编号 */
+    TASK_SORT_TITLE,            /* 按标题（不区分大小写） */
+    TASK_SORT_STATUS,           /* 按状态，同状态按列表 */
+    TASK_SORT_NUM
+} task_sort_t;
+
+/* 过滤条件 */
+#define TASK_FILTER_ANY_STATUS  0xFF
+typedef struct {
+    rt_uint8_t status_mask;     /* 允许的状态位：1 << status */
+    int list_num;               /* 只显示该列表，0表示全部 */
+} task_filter_t;
+
+typedef struct {
+    task_sort_t sort;
+    task_filter_t filter;
+    task_id_t *ids;             /* 排序后的任务ID */
+    rt_uint32_t count;
+    rt_uint32_t last_used;      /* 用于淘汰最久未使用的视图 */
+    bool valid;
+    bool stale;                 /* 批量修改期间失效，结束时重建 */
+} task_view_t;
+
+/* 任务变化通知：新增时old为NULL，删除时task为NULL，清空时id为TASK_ID_NONE */
+typedef void (*task_store_listener_t)(void *ctx, task_id_t id,
+                                      const task_info_t *old, const task_info_t *task);
+
+typedef struct {
+    rt_uint32_t view_hits;      /* 切换到已缓存的视图 */
+    rt_uint32_t view_builds;    /* 完整排序建立视图 */
+    rt_uint32_t view_inserts;   /* 增量插入 */
+    rt_uint32_t view_removes;   /* 增量删除 */
+    rt_uint32_t lookups;        /* 按编号查找次数 */
+    rt_uint32_t probes;         /* 查找时探测的槽位总数 */
+} task_store_stats_t;
+
+typedef struct {
+    task_info_t *tasks;         /* 槽位，is_valid表示占用 */
+    rt_uint32_t *seq;           /* 每个槽位的接收序号 */
+    task_id_t *free_ids;        /* 空闲槽位栈 */
+    task_id_t *hash;            /* (列表编号, 任务编号)到槽位的开放寻址散列表 */
+    rt_uint32_t hash_mask;
+    rt_uint32_t free_count;
+    rt_uint32_t capacity;
+    rt_uint32_t count;
+    rt_uint32_t next_seq;
+    rt_uint32_t use_clock;
+    int batch_depth;
+    task_view_t views[TASK_STORE_MAX_VIEWS];
+    task_store_listener_t listener;
+    void *listener_ctx;
+    task_store_stats_t stats;
+} task_store_t;
+
+rt_err_t task_store_init(task_store_t *store, rt_uint32_t capacity);
+void task_store_deinit(task_store_t *store);
+void task_store_clear(task_store_t *store);
+void task_store_set_listener(task_store_t *store, task_store_listener_t listener, void *ctx);
+
+/* 批量修改期间不维护视图，结束时对受影响的视图做一次完整排序 */
+void task_store_begin_batch(task_store_t *store);
+void task_store_end_batch(task_store_t *store);
+
+task_id_t task_store_add(task_store_t *store, const task_info_t *task);
+task_id_t task_store_find(task_store_t *store, int list_num, int task_num);
+rt_err_t task_store_update(task_store_t *store, task_id_t id, const task_info_t *task);
+rt_err_t task_store_set_status(task_store_t *store, task_id_t id, rt_uint8_t status);
+rt_err_t task_store_remove(task_store_t *store, task_id_t id);
+rt_err_t task_store_set_order(task_store_t *store, task_id_t id, rt_uint32_t seq);
+rt_uint32_t task_store_order(const task_store_t *store, task_id_t id);
+const task_info_t *task_store_get(const task_store_t *store, task_id_t id);
+rt_uint32_t task_store_count(const task_store_t *store);
+
+/* 取得视图，已缓存时直接返回；返回的指针在下一次取其他视图之前有效 */
+task_view_t *task_store_get_view(task_store_t *store, task_sort_t sort, const task_filter_t *filter);
+task_id_t task_view_at(const task_view_t *view, rt_uint32_t index);
+rt_uint32_t task_view_find(const task_store_t *store, const task_view_t *view, task_id_t id);
+rt_uint32_t task_view_group_end(const task_store_t *store, const task_view_t *view, rt_uint32_t start);
+
+const char *task_sort_name(task_sort_t sort);
+
+#endif /* __TASK_STORE_H__ */
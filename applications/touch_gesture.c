@@ -0,0 +1,381 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include "touch_gesture.h"
+
+#define DBG_TAG "touch.gesture"
+#define DBG_LVL DBG_INFO
+#include <rtdbg.h>
+
+static float clamp_velocity(float v)
+{
+    if (v > TOUCH_GESTURE_MAX_V) return TOUCH_GESTURE_MAX_V;
+    if (v < -TOUCH_GESTURE_MAX_V) return -TOUCH_GESTURE_MAX_V;
+    return v;
+}
+
+static float abs_f(float v)
+{
+    return (v < 0) ? -v : v;
+}
+
+/* 取第i新的采样（0为最新） */
+static const touch_sample_t *history_get(const touch_gesture_t *g, int i)
+{
+    int idx = (g->head + TOUCH_GESTURE_HISTORY - 1 - i) % TOUCH_GESTURE_HISTORY;
+    return &g->history[idx];
+}
+
+static void history_push(touch_gesture_t *g, rt_int16_t x, rt_int16_t y, rt_uint32_t t_ms)
+{
+    g->history[g->head].x = x;
+    g->history[g->head].y = y;
+    g->history[g->head].t_ms = t_ms;
+    g->head = (g->head + 1) % TOUCH_GESTURE_HISTORY;
+    if (g->count < TOUCH_GESTURE_HISTORY)
+        g->count++;
+}
+
+static touch_gesture_dir_t gesture_direction(int dx, int dy)
+{
+    if (dx == 0 && dy == 0)
+        return TOUCH_DIR_NONE;
+    if ((dx < 0 ? -dx : dx) > (dy < 0 ? -dy : dy))
+        return (dx > 0) ? TOUCH_DIR_RIGHT : TOUCH_DIR_LEFT;
+    return (dy > 0) ? TOUCH_DIR_DOWN : TOUCH_DIR_UP;
+}
+
+/* 手指抬起时根据位移、时长和速度分类手势 */
+static void gesture_release(touch_gesture_t *g, rt_uint32_t t_ms)
+{
+    touch_gesture_event_t evt;
+    const touch_sample_t *last = history_get(g, 0);
+    int dx = last->x - g->start.x;
+    int dy = last->y - g->start.y;
+    int adx = dx < 0 ? -dx : dx;
+    int ady = dy < 0 ? -dy : dy;
+
+    rt_memset(&evt, 0, sizeof(evt));
+    evt.start_x = g->start.x;
+    evt.start_y = g->start.y;
+    evt.end_x = last->x;
+    evt.end_y = last->y;
+    evt.duration_ms = t_ms - g->start.t_ms;
+    evt.dir = gesture_direction(dx, dy);
+
+    /* 抬起之前手指已静止一段时间，不计速度 */
+    if (t_ms - last->t_ms <= TOUCH_GESTURE_VELOCITY_MS)
+        touch_gesture_get_velocity(g, &evt.vx, &evt.vy);
+
+    if (adx <= TOUCH_GESTURE_TAP_SLOP && ady <= TOUCH_GESTURE_TAP_SLOP)
+    {
+        if (evt.duration_ms <= TOUCH_GESTURE_TAP_MAX_MS)
+            evt.type = TOUCH_GESTURE_TAP;
+    }
+    else if (abs_f(evt.vx) >= TOUCH_GESTURE_FLING_MIN_V || abs_f(evt.vy) >= TOUCH_GESTURE_FLING_MIN_V)
+    {
+        evt.type = TOUCH_GESTURE_FLING;
+    }
+    else if (adx >= TOUCH_GESTURE_SWIPE_MIN || ady >= TOUCH_GESTURE_SWIPE_MIN)
+    {
+        evt.type = TOUCH_GESTURE_SWIPE;
+    }
+
+    LOG_D("gesture %d dir %d v=(%d,%d)", evt.type, evt.dir, (int)evt.vx, (int)evt.vy);
+
+    if (evt.type != TOUCH_GESTURE_NONE && g->cb)
+        g->cb(&evt, g->user_data);
+}
+
+/* ==================== 对外接口 ==================== */
+
+void touch_gesture_init(touch_gesture_t *g)
+{
+    rt_memset(g, 0, sizeof(touch_gesture_t));
+}
+
+void touch_gesture_set_callback(touch_gesture_t *g, touch_gesture_cb_t cb, void *user_data)
+{
+    g->cb = cb;
+    g->user_data = user_data;
+}
+
+/* 输入一个采样，t_ms为采样时间 */
+void touch_gesture_feed(touch_gesture_t *g, rt_int16_t x, rt_int16_t y, bool pressed, rt_uint32_t t_ms)
+{
+    if (pressed)
+    {
+        if (!g->pressed)
+        {
+            /* 新的触摸开始 */
+            g->pressed = true;
+            g->count = 0;
+            g->head = 0;
+            g->start.x = x;
+            g->start.y = y;
+            g->start.t_ms = t_ms;
+            history_push(g, x, y, t_ms);
+        }
+        else
+        {
+            const touch_sample_t *last = history_get(g, 0);
+            /* 同一时刻的重复采样只更新坐标 */
+            if (last->t_ms == t_ms)
+            {
+                int idx = (g->head + TOUCH_GESTURE_HISTORY - 1) % TOUCH_GESTURE_HISTORY;
+                g->history[idx].x = x;
+                g->history[idx].y = y;
+            }
+            else
+            {
+                history_push(g, x, y, t_ms);
+            }
+        }
+    }
+    else if (g->pressed)
+    {
+        g->pressed = false;
+        gesture_release(g, t_ms);
+    }
+}
+
+/* 对时间窗口内的采样做最小二乘拟合，得到速度(像素/秒) */
+void touch_gesture_get_velocity(const touch_gesture_t *g, float *vx, float *vy)
+{
+    float sum_t = 0, sum_x = 0, sum_y = 0;
+    float mean_t, mean_x, mean_y;
+    float stt = 0, stx = 0, sty = 0;
+    const touch_sample_t *newest;
+    int n = 0;
+
+    *vx = 0;
+    *vy = 0;
+    if (g->count < 2)
+        return;
+
+    newest = history_get(g, 0);
+    for (int i = 0; i < g->count; i++)
+    {
+        const touch_sample_t *s = history_get(g, i);
+        if (newest->t_ms - s->t_ms > TOUCH_GESTURE_VELOCITY_MS)
+            break;
+        sum_t += (float)(rt_int32_t)(s->t_ms - newest->t_ms);
+        sum_x += s->x;
+        sum_y += s->y;
+        n++;
+    }
+    if (n < 2)
+        return;
+
+    mean_t = sum_t / n;
+    mean_x = sum_x / n;
+    mean_y = sum_y / n;
+    for (int i = 0; i < n; i++)
+    {
+        const touch_sample_t *s = history_get(g, i);
+        float dt = (float)(rt_int32_t)(s->t_ms - newest->t_ms) - mean_t;
+        stt += dt * dt;
+        stx += dt * (s->x - mean_x);
+        sty += dt * (s->y - mean_y);
+    }
+    if (stt <= 0)
+        return;
+
+    *vx = clamp_velocity(stx / stt * 1000.0f);
+    *vy = clamp_velocity(sty / stt * 1000.0f);
+}
+
+bool touch_gesture_is_pressed(const touch_gesture_t *g)
+{
+    return g->pressed;
+}
+
+/* 取消当前触摸，抬起时不产生手势（例如变成了多指操作） */
+void touch_gesture_cancel(touch_gesture_t *g)
+{
+    g->pressed = false;
+    g->count = 0;
+}
+
+/* ==================== 惯性滚动 ==================== */
+
+void touch_kinetic_start(touch_kinetic_t *k, float v, rt_uint32_t t_ms)
+{
+    k->v = clamp_velocity(v);
+    k->remainder = 0;
+    k->last_ms = t_ms;
+    k->active = abs_f(k->v) >= TOUCH_KINETIC_STOP_V;
+}
+
+/* 推进惯性滚动，delta输出本次应移动的像素数，返回false表示已停止 */
+bool touch_kinetic_step(touch_kinetic_t *k, rt_uint32_t t_ms, rt_int32_t *delta)
+{
+    rt_uint32_t dt;
+    float dist;
+
+    *delta = 0;
+    if (!k->active)
+        return false;
+
+    dt = t_ms - k->last_ms;
+    k->last_ms = t_ms;
+    if (dt > TOUCH_KINETIC_TAU_MS / 2)
+        dt = TOUCH_KINETIC_TAU_MS / 2;
+
+    dist = k->v * dt / 1000.0f + k->remainder;
+    *delta = (rt_int32_t)dist;
+    k->remainder = dist - *delta;
+
+    /* 指数衰减的一阶近似 */
+    k->v -= k->v * dt / TOUCH_KINETIC_TAU_MS;
+    if (abs_f(k->v) < TOUCH_KINETIC_STOP_V)
+        k->active = false;
+
+    return true;
+}
+
+void touch_kinetic_stop(touch_kinetic_t *k)
+{
+    k->active = false;
+    k->v = 0;
+}
+
+#ifdef APP_USING_TEST
+#include <finsh.h>
+
+/* ==================== 录制轨迹测试 ==================== */
+
+/* 一段录制的触摸轨迹：按下期间的采样、抬起时间和应识别出的手势，
+ * v_min/v_max为抬起时主方向速度的绝对值范围（像素/秒），都为0时不检查 */
+typedef struct {
+    const char *name;
+    const touch_sample_t *samples;
+    rt_uint8_t count;
+    rt_uint32_t release_ms;
+    touch_gesture_type_t type;
+    touch_gesture_dir_t dir;
+    rt_int16_t v_min, v_max;
+} gesture_trace_t;
+
+/* 轻点，坐标有1~2像素的抖动 */
+static const touch_sample_t trace_tap[] = {
+    {400, 240, 0}, {401, 241, 10}, {402, 240, 20}, {401, 239, 30},
+};
+/* 长按不动，超过点击时长 */
+static const touch_sample_t trace_press[] = {
+    {300, 200, 0}, {301, 200, 100}, {302, 201, 200}, {301, 202, 300},
+    {300, 201, 400}, {301, 200, 500}, {301, 201, 600},
+};
+/* 慢速下滑，约200像素/秒 */
+static const touch_sample_t trace_swipe[] = {
+    {240, 100, 0}, {241, 110, 50}, {240, 120, 100}, {242, 130, 150}, {241, 140, 200},
+    {240, 150, 250}, {239, 160, 300}, {240, 170, 350}, {241, 180, 400}, {240, 190, 450},
+    {241, 200, 500}, {240, 210, 550}, {240, 220, 600},
+};
+/* 快速上甩，每10ms移动30像素 */
+static const touch_sample_t trace_fling[] = {
+    {200, 400, 0}, {200, 370, 10}, {201, 340, 20}, {201, 310, 30}, {202, 280, 40}, {202, 250, 50},
+};
+/* 快速下拉后停住再抬起，不应产生fling */
+static const touch_sample_t trace_stop[] = {
+    {100, 100, 0}, {100, 130, 10}, {101, 160, 20}, {101, 190, 30}, {102, 220, 40}, {102, 250, 50},
+    {102, 250, 100}, {102, 251, 150}, {102, 250, 200},
+};
+/* 左甩，采样间隔不均匀且坐标有噪声，约2000像素/秒 */
+static const touch_sample_t trace_jitter[] = {
+    {600, 300, 0}, {583, 301, 9}, {557, 300, 21}, {541, 302, 30},
+    {517, 301, 41}, {501, 300, 50}, {478, 301, 61},
+};
+/* 右甩，驱动在同一时刻重复上报（第二个10ms采样应覆盖第一个） */
+static const touch_sample_t trace_repeat[] = {
+    {100, 200, 0}, {125, 200, 10}, {130, 200, 10}, {160, 200, 20}, {190, 200, 30}, {220, 200, 40},
+};
+
+#define GESTURE_TRACE(name, samples, release, type, dir, v_min, v_max) \
+    {name, samples, sizeof(samples) / sizeof(samples[0]), release, type, dir, v_min, v_max}
+
+static const gesture_trace_t gesture_traces[] = {
+    GESTURE_TRACE("tap",    trace_tap,    80,  TOUCH_GESTURE_TAP,   TOUCH_DIR_NONE,  0, 0),
+    GESTURE_TRACE("press",  trace_press,  620, TOUCH_GESTURE_NONE,  TOUCH_DIR_NONE,  0, 0),
+    GESTURE_TRACE("swipe",  trace_swipe,  610, TOUCH_GESTURE_SWIPE, TOUCH_DIR_DOWN,  150, 250),
+    GESTURE_TRACE("fling",  trace_fling,  58,  TOUCH_GESTURE_FLING, TOUCH_DIR_UP,    2700, 3300),
+    GESTURE_TRACE("stop",   trace_stop,   210, TOUCH_GESTURE_SWIPE, TOUCH_DIR_DOWN,  0, 0),
+    GESTURE_TRACE("jitter", trace_jitter, 66,  TOUCH_GESTURE_FLING, TOUCH_DIR_LEFT,  1800, 2200),
+    GESTURE_TRACE("repeat", trace_repeat, 45,  TOUCH_GESTURE_FLING, TOUCH_DIR_RIGHT, 2700, 3300),
+};
+
+static void test_gesture_cb(const touch_gesture_event_t *evt, void *user_data)
+{
+    *(touch_gesture_event_t *)user_data = *evt;
+}
+
+/* 用录制的轨迹驱动手势引擎检查分类、方向和速度，再检查惯性滚动的距离和停止时间 */
+static void gesture_test_cmd(void)
+{
+    static const char *type_names[] = {"none", "tap", "swipe", "fling"};
+    touch_gesture_t g;
+    touch_gesture_event_t evt;
+    touch_kinetic_t k;
+    rt_uint32_t t, passed = 0, total = sizeof(gesture_traces) / sizeof(gesture_traces[0]);
+    rt_int32_t delta, dist = 0;
+    bool pass;
+
+    touch_gesture_init(&g);
+    touch_gesture_set_callback(&g, test_gesture_cb, &evt);
+
+    for (rt_uint32_t i = 0; i < total; i++)
+    {
+        const gesture_trace_t *tr = &gesture_traces[i];
+        const touch_sample_t *last = &tr->samples[tr->count - 1];
+        int v;
+
+        /* 时间轴从非零开始，顺便检查时间戳相对计算 */
+        rt_memset(&evt, 0, sizeof(evt));
+        for (rt_uint8_t j = 0; j < tr->count; j++)
+            touch_gesture_feed(&g, tr->samples[j].x, tr->samples[j].y, true, 100000 + tr->samples[j].t_ms);
+        touch_gesture_feed(&g, last->x, last->y, false, 100000 + tr->release_ms);
+
+        v = (int)((tr->dir == TOUCH_DIR_UP || tr->dir == TOUCH_DIR_DOWN) ? evt.vy : evt.vx);
+        if (v < 0)
+            v = -v;
+        pass = evt.type == tr->type
+               && (tr->type == TOUCH_GESTURE_NONE || tr->type == TOUCH_GESTURE_TAP || evt.dir == tr->dir)
+               && (tr->v_max == 0 || (v >= tr->v_min && v <= tr->v_max));
+        passed += pass;
+        rt_kprintf("%-7s %-5s dir %d, v %4d px/s, %3d ms  %s\n", tr->name, type_names[evt.type],
+                   evt.dir, v, evt.duration_ms, pass ? "PASS" : "FAIL");
+    }
+
+    /* 取消后抬起不产生手势 */
+    rt_memset(&evt, 0, sizeof(evt));
+    touch_gesture_feed(&g, 100, 100, true, 0);
+    touch_gesture_feed(&g, 200, 100, true, 20);
+    touch_gesture_cancel(&g);
+    touch_gesture_feed(&g, 200, 100, false, 30);
+    pass = evt.type == TOUCH_GESTURE_NONE;
+    passed += pass;
+    total++;
+    rt_kprintf("cancel  %-5s  %s\n", type_names[evt.type], pass ? "PASS" : "FAIL");
+
+    /* 惯性滚动按16ms一帧推进，总距离约为v*tau，速度衰减到停止速度以下后结束 */
+    touch_kinetic_start(&k, 2000, 0);
+    for (t = 16; touch_kinetic_step(&k, t, &delta) && t < 5000; t += 16)
+        dist += delta;
+    pass = dist >= 2000 * TOUCH_KINETIC_TAU_MS / 1000 * 9 / 10
+           && dist <= 2000 * TOUCH_KINETIC_TAU_MS / 1000 * 11 / 10 && t < 2500;
+    passed += pass;
+    total++;
+    rt_kprintf("kinetic %d px, stopped after %d ms  %s\n", dist, t, pass ? "PASS" : "FAIL");
+
+    rt_kprintf("gesture_test: %d/%d %s\n", passed, total, passed == total ? "PASS" : "FAIL");
+}
+MSH_CMD_EXPORT_ALIAS(gesture_test_cmd, gesture_test, replay recorded touch traces through the gesture engine);
+#endif /* APP_USING_TEST */
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __TOUCH_GESTURE_H__
+#define __TOUCH_GESTURE_H__
+
+#include <rtthread.h>
+#include <stdbool.h>
+
+/* 手势引擎：位于触摸驱动和LVGL之间，记录带时间戳的采样点，
+ * 估算速度并识别点击、滑动和快速甩动(fling)，不依赖硬件，可用录制的触摸轨迹驱动 */
+
+#define TOUCH_GESTURE_HISTORY       16      /* 采样历史长度 */
+#define TOUCH_GESTURE_VELOCITY_MS   100     /* 速度估算使用的时间窗口 */
+#define TOUCH_GESTURE_TAP_SLOP      10      /* 点击允许的最大位移(像素) */
+#define TOUCH_GESTURE_TAP_MAX_MS    300     /* 点击最长按下时间 */
+#define TOUCH_GESTURE_SWIPE_MIN     40      /* 滑动最小位移(像素) */
+#define TOUCH_GESTURE_FLING_MIN_V   400     /* fling最小速度(像素/秒) */
+#define TOUCH_GESTURE_MAX_V         8000    /* 速度上限(像素/秒) */
+
+#define TOUCH_KINETIC_TAU_MS        325     /* 惯性滚动衰减时间常数 */
+#define TOUCH_KINETIC_STOP_V        20      /* 低于该速度(像素/秒)时停止 */
+
+typedef enum {
+    TOUCH_GESTURE_NONE = 0,
+    TOUCH_GESTURE_TAP,
+    TOUCH_GESTURE_SWIPE,
+    TOUCH_GESTURE_FLING,
+} touch_gesture_type_t;
+
+typedef enum {
+    TOUCH_DIR_NONE = 0,
+    TOUCH_DIR_UP,
+    TOUCH_DIR_DOWN,
+    TOUCH_DIR_LEFT,
+    TOUCH_DIR_RIGHT,
+} touch_gesture_dir_t;
+
+/* 带时间戳的触摸采样 */
+typedef struct {
+    rt_int16_t x;
+    rt_int16_t y;
+    rt_uint32_t t_ms;
+} touch_sample_t;
+
+/* 手势事件，在手指抬起时产生 */
+typedef struct {
+    touch_gesture_type_t type;
+    touch_gesture_dir_t dir;
+    rt_int16_t start_x, start_y;
+    rt_int16_t end_x, end_y;
+    float vx, vy;                   /* 抬起时的速度(像素/秒) */
+    rt_uint32_t duration_ms;
+} touch_gesture_event_t;
+
+typedef void (*touch_gesture_cb_t)(const touch_gesture_event_t *evt, void *user_data);
+
+typedef struct {
+    touch_sample_t history[TOUCH_GESTURE_HISTORY];
+    rt_uint8_t head;                /* 下一个写入位置 */
+    rt_uint8_t count;
+    bool pressed;
+    touch_sample_t start;
+    touch_gesture_cb_t cb;
+    void *user_data;
+} touch_gesture_t;
+
+/* 惯性滚动状态 */
+typedef struct {
+    float v;                        /* 当前速度(像素/秒) */
+    float remainder;                /* 未输出的小数像素 */
+    rt_uint32_t last_ms;
+    bool active;
+} touch_kinetic_t;
+
+void touch_gesture_init(touch_gesture_t *g);
+void touch_gesture_set_callback(touch_gesture_t *g, touch_gesture_cb_t cb, void *user_data);
+void touch_gesture_feed(touch_gesture_t *g, rt_int16_t x, rt_int16_t y, bool pressed, rt_uint32_t t_ms);
+void touch_gesture_get_velocity(const touch_gesture_t *g, float *vx, float *vy);
+bool touch_gesture_is_pressed(const touch_gesture_t *g);
+void touch_gesture_cancel(touch_gesture_t *g);
+
+void touch_kinetic_start(touch_kinetic_t *k, float v, rt_uint32_t t_ms);
+bool touch_kinetic_step(touch_kinetic_t *k, rt_uint32_t t_ms, rt_int32_t *delta);
+void touch_kinetic_stop(touch_kinetic_t *k);
+
+#endif /* __TOUCH_GESTURE_H__ */
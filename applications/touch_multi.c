@@ -0,0 +1,376 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include "touch_multi.h"
+
+#define DBG_TAG "touch.multi"
+#define DBG_LVL DBG_INFO
+#include <rtdbg.h>
+
+static rt_uint32_t isqrt(rt_uint32_t v)
+{
+    rt_uint32_t res = 0;
+    rt_uint32_t bit = 1UL << 30;
+
+    while (bit > v)
+        bit >>= 2;
+    while (bit != 0)
+    {
+        if (v >= res + bit)
+        {
+            v -= res + bit;
+            res = (res >> 1) + bit;
+        }
+        else
+        {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+static rt_uint32_t dist2(rt_int32_t x0, rt_int32_t y0, rt_int32_t x1, rt_int32_t y1)
+{
+    rt_int32_t dx = x1 - x0;
+    rt_int32_t dy = y1 - y0;
+    return (rt_uint32_t)(dx * dx + dy * dy);
+}
+
+static bool id_in_use(const touch_frame_t *frame, rt_uint8_t id)
+{
+    for (int i = 0; i < frame->count; i++)
+    {
+        if (frame->contacts[i].id == id)
+            return true;
+    }
+    return false;
+}
+
+static void emit_event(touch_multi_t *m, touch_multi_event_type_t type,
+                       rt_int16_t cx, rt_int16_t cy, rt_int16_t dx, rt_int16_t dy, rt_uint32_t scale)
+{
+    touch_multi_event_t evt;
+
+    if (m->cb == RT_NULL)
+        return;
+
+    evt.type = type;
+    evt.center_x = cx;
+    evt.center_y = cy;
+    evt.dx = dx;
+    evt.dy = dy;
+    evt.scale = scale;
+    m->cb(&evt, m->user_data);
+}
+
+/* 根据最老的两个触点识别双指滚动和缩放 */
+static void update_two_finger(touch_multi_t *m, const touch_frame_t *frame)
+{
+    const touch_contact_t *a, *b;
+    rt_int16_t cx, cy;
+    rt_int32_t dist;
+
+    if (frame->count < 2)
+    {
+        if (m->two_active)
+        {
+            m->two_active = false;
+            emit_event(m, TOUCH_MULTI_TWO_END, m->last_cx, m->last_cy, 0, 0, TOUCH_MULTI_SCALE_ONE);
+        }
+        return;
+    }
+
+    a = &frame->contacts[0];
+    b = &frame->contacts[1];
+    cx = (a->x + b->x) / 2;
+    cy = (a->y + b->y) / 2;
+    dist = isqrt(dist2(a->x, a->y, b->x, b->y));
+    if (dist < 1)
+        dist = 1;
+
+    if (!m->two_active || m->two_ids[0] != a->id || m->two_ids[1] != b->id)
+    {
+        if (m->two_active)
+            emit_event(m, TOUCH_MULTI_TWO_END, m->last_cx, m->last_cy, 0, 0, TOUCH_MULTI_SCALE_ONE);
+
+        m->two_active = true;
+        m->two_ids[0] = a->id;
+        m->two_ids[1] = b->id;
+        m->base_dist = dist;
+        m->last_cx = cx;
+        m->last_cy = cy;
+        emit_event(m, TOUCH_MULTI_TWO_BEGIN, cx, cy, 0, 0, TOUCH_MULTI_SCALE_ONE);
+        return;
+    }
+
+    emit_event(m, TOUCH_MULTI_TWO_MOVE, cx, cy, cx - m->last_cx, cy - m->last_cy,
+               (rt_uint32_t)(dist * TOUCH_MULTI_SCALE_ONE / m->base_dist));
+    m->last_cx = cx;
+    m->last_cy = cy;
+}
+
+/* ==================== 对外接口 ==================== */
+
+void touch_multi_init(touch_multi_t *m)
+{
+    rt_memset(m, 0, sizeof(touch_multi_t));
+}
+
+void touch_multi_set_callback(touch_multi_t *m, touch_multi_cb_t cb, void *user_data)
+{
+    m->cb = cb;
+    m->user_data = user_data;
+}
+
+/* 输入一帧原始坐标，输出带稳定ID的触点。输出中触点按按下先后排序，
+ * 已存在的触点在前，新触点在后 */
+void touch_multi_track(touch_multi_t *m, const rt_int16_t *xs, const rt_int16_t *ys, int n,
+                       rt_uint32_t t_ms, touch_frame_t *out)
+{
+    bool used_new[TOUCH_MULTI_MAX_CONTACTS] = {false};
+    bool used_prev[TOUCH_MULTI_MAX_CONTACTS] = {false};
+    rt_int8_t match[TOUCH_MULTI_MAX_CONTACTS];   /* 上一帧触点 -> 新坐标下标 */
+    const rt_uint32_t max_d2 = TOUCH_MULTI_MATCH_DIST * TOUCH_MULTI_MATCH_DIST;
+
+    if (n > TOUCH_MULTI_MAX_CONTACTS)
+        n = TOUCH_MULTI_MAX_CONTACTS;
+    if (n < 0)
+        n = 0;
+
+    for (int i = 0; i < TOUCH_MULTI_MAX_CONTACTS; i++)
+        match[i] = -1;
+
+    /* 贪心匹配：每次选距离最近的一对 */
+    while (1)
+    {
+        rt_uint32_t best = max_d2 + 1;
+        int best_p = -1, best_n = -1;
+
+        for (int p = 0; p < m->prev.count; p++)
+        {
+            if (used_prev[p])
+                continue;
+            for (int j = 0; j < n; j++)
+            {
+                rt_uint32_t d2;
+                if (used_new[j])
+                    continue;
+                d2 = dist2(m->prev.contacts[p].x, m->prev.contacts[p].y, xs[j], ys[j]);
+                if (d2 < best)
+                {
+                    best = d2;
+                    best_p = p;
+                    best_n = j;
+                }
+            }
+        }
+        if (best_p < 0)
+            break;
+        used_prev[best_p] = true;
+        used_new[best_n] = true;
+        match[best_p] = best_n;
+    }
+
+    out->count = 0;
+    out->t_ms = t_ms;
+
+    /* 已存在的触点保持原顺序 */
+    for (int p = 0; p < m->prev.count; p++)
+    {
+        if (match[p] < 0)
+            continue;
+        out->contacts[out->count].id = m->prev.contacts[p].id;
+        out->contacts[out->count].x = xs[match[p]];
+        out->contacts[out->count].y = ys[match[p]];
+        out->count++;
+    }
+
+    /* 新触点分配新ID */
+    for (int j = 0; j < n; j++)
+    {
+        if (used_new[j])
+            continue;
+        while (id_in_use(out, m->next_id))
+            m->next_id++;
+        out->contacts[out->count].id = m->next_id++;
+        out->contacts[out->count].x = xs[j];
+        out->contacts[out->count].y = ys[j];
+        out->count++;
+    }
+
+    m->prev = *out;
+    update_two_finger(m, out);
+}
+
+/* 主触点：按下最早的触点，用于LVGL指针设备和单指手势 */
+const touch_contact_t *touch_multi_primary(const touch_frame_t *frame)
+{
+    return frame->count > 0 ? &frame->contacts[0] : RT_NULL;
+}
+
+#ifdef APP_USING_TEST
+#include <finsh.h>
+
+/* ==================== 多点轨迹测试 ==================== */
+
+#define MULTI_TEST_CONTACTS 3
+
+/* 驱动上报的一帧原始坐标，顺序不保证与触点对应 */
+typedef struct {
+    rt_uint8_t n;
+    rt_int16_t x[MULTI_TEST_CONTACTS];
+    rt_int16_t y[MULTI_TEST_CONTACTS];
+} multi_raw_t;
+
+typedef struct {
+    int begins, moves, ends;
+    int sum_dx, sum_dy;
+    rt_uint32_t scale;
+} multi_log_t;
+
+/* 两个手指，第二帧起驱动交换了上报顺序 */
+static const multi_raw_t trace_swap[] = {
+    {2, {100, 300}, {100, 100}},
+    {2, {305, 102}, {102, 101}},
+    {2, {104, 310}, {103, 104}},
+    {2, {315, 106}, {106, 105}},
+};
+/* 先按一个手指，第二个手指按下后一起下移5帧，然后先按下的手指抬起 */
+static const multi_raw_t trace_scroll[] = {
+    {1, {200}, {200}},
+    {2, {200, 300}, {200, 200}},
+    {2, {200, 300}, {210, 210}},
+    {2, {300, 200}, {220, 220}},
+    {2, {200, 300}, {230, 230}},
+    {2, {200, 300}, {240, 240}},
+    {2, {300, 200}, {250, 250}},
+    {1, {300}, {250}},
+    {0},
+};
+/* 双指张开，距离从100增加到300 */
+static const multi_raw_t trace_pinch[] = {
+    {2, {350, 450}, {240, 240}},
+    {2, {325, 475}, {240, 240}},
+    {2, {300, 500}, {241, 239}},
+    {2, {525, 275}, {240, 240}},
+    {2, {250, 550}, {240, 240}},
+    {0},
+};
+/* 双指滚动中途按下又抬起第三个手指，双指手势不应中断 */
+static const multi_raw_t trace_third[] = {
+    {2, {200, 300}, {200, 200}},
+    {2, {200, 300}, {205, 205}},
+    {3, {600, 200, 300}, {400, 210, 210}},
+    {3, {200, 600, 300}, {215, 400, 215}},
+    {2, {300, 200}, {220, 220}},
+    {0},
+};
+/* 单指一帧跳过超出匹配距离，应当作新的触点 */
+static const multi_raw_t trace_jump[] = {
+    {1, {100}, {100}},
+    {1, {104}, {102}},
+    {1, {400}, {100}},
+};
+
+static void test_multi_cb(const touch_multi_event_t *evt, void *user_data)
+{
+    multi_log_t *log = (multi_log_t *)user_data;
+
+    if (evt->type == TOUCH_MULTI_TWO_BEGIN)
+        log->begins++;
+    else if (evt->type == TOUCH_MULTI_TWO_END)
+        log->ends++;
+    else
+    {
+        log->moves++;
+        log->sum_dx += evt->dx;
+        log->sum_dy += evt->dy;
+        log->scale = evt->scale;
+    }
+}
+
+/* 运行一段轨迹，ids返回每帧输出的触点ID（按输出顺序） */
+static void multi_run(const multi_raw_t *trace, int frames, multi_log_t *log,
+                      rt_uint8_t ids[][MULTI_TEST_CONTACTS], rt_int16_t first_x[])
+{
+    touch_multi_t m;
+    touch_frame_t out;
+
+    rt_memset(log, 0, sizeof(*log));
+    touch_multi_init(&m);
+    touch_multi_set_callback(&m, test_multi_cb, log);
+    for (int f = 0; f < frames; f++)
+    {
+        touch_multi_track(&m, trace[f].x, trace[f].y, trace[f].n, f * 10, &out);
+        for (int i = 0; i < MULTI_TEST_CONTACTS; i++)
+            ids[f][i] = i < out.count ? out.contacts[i].id : 0xFF;
+        first_x[f] = out.count > 0 ? touch_multi_primary(&out)->x : -1;
+    }
+}
+
+#define MULTI_FRAMES(trace) (sizeof(trace) / sizeof(trace[0]))
+
+/* 用合成的多点轨迹检查触点ID的稳定性、主触点和双指滚动/缩放事件 */
+static void multi_test_cmd(void)
+{
+    rt_uint8_t ids[16][MULTI_TEST_CONTACTS];
+    rt_int16_t first_x[16];
+    multi_log_t log;
+    int passed = 0, total = 0;
+    bool pass;
+
+    /* 顺序交换时ID跟着坐标走，主触点始终是左边的手指 */
+    multi_run(trace_swap, MULTI_FRAMES(trace_swap), &log, ids, first_x);
+    pass = true;
+    for (rt_uint32_t f = 1; f < MULTI_FRAMES(trace_swap); f++)
+        pass = pass && ids[f][0] == ids[0][0] && ids[f][1] == ids[0][1] && first_x[f] < 200;
+    pass = pass && log.begins == 1 && log.ends == 0;
+    passed += pass;
+    total++;
+    rt_kprintf("swap    ids %d,%d  %s\n", ids[3][0], ids[3][1], pass ? "PASS" : "FAIL");
+
+    /* 每帧中心下移10像素，比例不变；先按下的手指抬起后剩下的手指成为主触点 */
+    multi_run(trace_scroll, MULTI_FRAMES(trace_scroll), &log, ids, first_x);
+    pass = log.begins == 1 && log.moves == 5 && log.ends == 1 && log.sum_dx == 0 && log.sum_dy == 50
+           && log.scale == TOUCH_MULTI_SCALE_ONE && ids[7][0] == ids[1][1] && first_x[7] == 300;
+    passed += pass;
+    total++;
+    rt_kprintf("scroll  begin %d, move %d, end %d, dy %d, scale %d  %s\n",
+               log.begins, log.moves, log.ends, log.sum_dy, log.scale, pass ? "PASS" : "FAIL");
+
+    /* 距离变为3倍，中心不动 */
+    multi_run(trace_pinch, MULTI_FRAMES(trace_pinch), &log, ids, first_x);
+    pass = log.begins == 1 && log.moves == 4 && log.ends == 1 && log.sum_dx == 0
+           && log.scale >= TOUCH_MULTI_SCALE_ONE * 3 - 8 && log.scale <= TOUCH_MULTI_SCALE_ONE * 3 + 8;
+    passed += pass;
+    total++;
+    rt_kprintf("pinch   move %d, dx %d, scale %d  %s\n", log.moves, log.sum_dx, log.scale, pass ? "PASS" : "FAIL");
+
+    /* 第三个手指排在后面，不影响前两个 */
+    multi_run(trace_third, MULTI_FRAMES(trace_third), &log, ids, first_x);
+    pass = log.begins == 1 && log.moves == 4 && log.ends == 1 && log.sum_dy == 20
+           && ids[2][0] == ids[0][0] && ids[2][1] == ids[0][1] && ids[4][0] == ids[0][0];
+    passed += pass;
+    total++;
+    rt_kprintf("third   begin %d, move %d, end %d, dy %d  %s\n",
+               log.begins, log.moves, log.ends, log.sum_dy, pass ? "PASS" : "FAIL");
+
+    multi_run(trace_jump, MULTI_FRAMES(trace_jump), &log, ids, first_x);
+    pass = ids[1][0] == ids[0][0] && ids[2][0] != ids[0][0];
+    passed += pass;
+    total++;
+    rt_kprintf("jump    ids %d,%d,%d  %s\n", ids[0][0], ids[1][0], ids[2][0], pass ? "PASS" : "FAIL");
+
+    rt_kprintf("multi_test: %d/%d %s\n", passed, total, passed == total ? "PASS" : "FAIL");
+}
+MSH_CMD_EXPORT_ALIAS(multi_test_cmd, multi_test, run multi-contact traces through the contact tracker);
+#endif /* APP_USING_TEST */
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __TOUCH_MULTI_H__
+#define __TOUCH_MULTI_H__
+
+#include <rtthread.h>
+#include <stdbool.h>
+
+/* 多点触摸跟踪：给每个触点分配稳定的ID（按相邻帧最近距离匹配），
+ * 并识别双指滚动和双指缩放，不依赖硬件，可用合成的多点轨迹驱动 */
+
+#define TOUCH_MULTI_MAX_CONTACTS    5
+#define TOUCH_MULTI_MATCH_DIST      80      /* 相邻帧同一触点允许的最大移动距离(像素) */
+#define TOUCH_MULTI_SCALE_ONE       256     /* 缩放比例的定点数表示，256为1.0 */
+
+/* 一个触点 */
+typedef struct {
+    rt_uint8_t id;
+    rt_int16_t x;
+    rt_int16_t y;
+} touch_contact_t;
+
+/* 一帧触摸数据 */
+typedef struct {
+    rt_uint8_t count;
+    touch_contact_t contacts[TOUCH_MULTI_MAX_CONTACTS];
+    rt_uint32_t t_ms;
+} touch_frame_t;
+
+typedef enum {
+    TOUCH_MULTI_TWO_BEGIN = 0,      /* 第二个手指按下 */
+    TOUCH_MULTI_TWO_MOVE,           /* 双指移动：dx/dy为中心点位移，scale为相对起始的缩放比例 */
+    TOUCH_MULTI_TWO_END,            /* 不再是双指 */
+} touch_multi_event_type_t;
+
+typedef struct {
+    touch_multi_event_type_t type;
+    rt_int16_t center_x, center_y;
+    rt_int16_t dx, dy;              /* 相对上一帧的中心点位移 */
+    rt_uint32_t scale;              /* 相对双指开始时的距离比例，TOUCH_MULTI_SCALE_ONE为1.0 */
+} touch_multi_event_t;
+
+typedef void (*touch_multi_cb_t)(const touch_multi_event_t *evt, void *user_data);
+
+typedef struct {
+    touch_frame_t prev;
+    rt_uint8_t next_id;
+    bool two_active;
+    rt_uint8_t two_ids[2];          /* 参与双指手势的两个触点 */
+    rt_int32_t base_dist;           /* 双指开始时的距离 */
+    rt_int16_t last_cx, last_cy;
+    touch_multi_cb_t cb;
+    void *user_data;
+} touch_multi_t;
+
+void touch_multi_init(touch_multi_t *m);
+void touch_multi_set_callback(touch_multi_t *m, touch_multi_cb_t cb, void *user_data);
+void touch_multi_track(touch_multi_t *m, const rt_int16_t *xs, const rt_int16_t *ys, int n,
+                       rt_uint32_t t_ms, touch_frame_t *out);
+const touch_contact_t *touch_multi_primary(const touch_frame_t *frame);
+
+#endif /* __TOUCH_MULTI_H__ */
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <stdlib.h>
+#include "touch_sampler.h"
+#include "touch_800x480.h"
+
+#define DBG_TAG "touch.sampler"
+#define DBG_LVL DBG_INFO
+#include <rtdbg.h>
+
+#define RING_MASK (TOUCH_SAMPLER_RING_SIZE - 1)
+
+#ifndef TOUCH_MAX
+#define TOUCH_MAX 5
+#endif
+
+static struct rt_thread sampler_thread;
+static rt_uint8_t sampler_thread_stack[TOUCH_SAMPLER_THREAD_STACK];
+static struct rt_semaphore touch_irq_sem;
+static bool sampler_running = false;
+
+static touch_sampler_sample_t sample_ring[TOUCH_SAMPLER_RING_SIZE];
+static rt_uint32_t ring_head;   /* 写入位置 */
+static rt_uint32_t ring_tail;   /* 读取位置 */
+
+static touch_sampler_stats_t sampler_stats;
+static rt_tick_t cooldown_until;
+
+/* 触摸中断：唤醒采样线程 */
+static void touch_irq_handler(void *args)
+{
+    sampler_stats.irqs++;
+    rt_sem_release(&touch_irq_sem);
+}
+
+/* 写入一个采样，缓冲区满时覆盖最旧的采样 */
+static void ring_push(const touch_sampler_sample_t *sample)
+{
+    rt_base_t level = rt_hw_interrupt_disable();
+
+    if (ring_head - ring_tail >= TOUCH_SAMPLER_RING_SIZE)
+    {
+        ring_tail++;
+        sampler_stats.dropped++;
+    }
+    sample_ring[ring_head & RING_MASK] = *sample;
+    ring_head++;
+
+    rt_hw_interrupt_enable(level);
+}
+
+/* 从触摸驱动读取所有触点 */
+static void read_touch_points(touch_sampler_sample_t *sample)
+{
+    int n = 0;
+
+    if (touchInfo.flag == 1)
+    {
+        n = touchInfo.num;
+        if (n > TOUCH_MAX) n = TOUCH_MAX;
+        if (n > TOUCH_MULTI_MAX_CONTACTS) n = TOUCH_MULTI_MAX_CONTACTS;
+        if (n < 1) n = 1;
+    }
+
+    sample->count = n;
+    for (int i = 0; i < n; i++)
+    {
+        sample->x[i] = touchInfo.x[i];
+        sample->y[i] = touchInfo.y[i];
+    }
+}
+
+/* 空闲等待：有中断引脚时等待中断，否则按空闲采样率轮询 */
+static void sampler_wait_idle(void)
+{
+    if (sampler_stats.use_irq)
+    {
+        /* 丢弃按下期间累积的中断 */
+        while (rt_sem_trytake(&touch_irq_sem) == RT_EOK);
+        rt_sem_take(&touch_irq_sem, RT_WAITING_FOREVER);
+    }
+    else
+    {
+        rt_thread_mdelay(1000 / sampler_stats.idle_hz);
+    }
+}
+
+static void sampler_thread_entry(void *parameter)
+{
+    rt_base_t level;
+    touch_sampler_sample_t sample;
+    bool pressed, last_pressed = false;
+    rt_tick_t now, until;
+
+    while (1)
+    {
+        if (sampler_stats.state == TOUCH_SAMPLER_IDLE)
+            sampler_wait_idle();
+        else
+            rt_thread_mdelay(1000 / sampler_stats.active_hz);
+
+        Touch_Scan();
+        read_touch_points(&sample);
+        pressed = (sample.count > 0);
+        now = rt_tick_get();
+        sample.t_ms = rt_tick_get_millisecond();
+
+        level = rt_hw_interrupt_disable();
+        sampler_stats.scans++;
+        if (sampler_stats.state == TOUCH_SAMPLER_IDLE)
+            sampler_stats.idle_scans++;
+        else
+            sampler_stats.active_scans++;
+
+        if (pressed)
+        {
+            sampler_stats.state = TOUCH_SAMPLER_ACTIVE;
+        }
+        else if (sampler_stats.state == TOUCH_SAMPLER_ACTIVE)
+        {
+            /* 抬起，进入冷却期 */
+            sampler_stats.state = TOUCH_SAMPLER_COOLDOWN;
+            until = now + rt_tick_from_millisecond(sampler_stats.cooldown_ms);
+            if ((rt_int32_t)(until - cooldown_until) > 0)
+                cooldown_until = until;
+        }
+        else if (sampler_stats.state == TOUCH_SAMPLER_COOLDOWN &&
+                 (rt_int32_t)(now - cooldown_until) >= 0)
+        {
+            sampler_stats.state = TOUCH_SAMPLER_IDLE;
+        }
+        rt_hw_interrupt_enable(level);
+
+        /* 按下时记录坐标，抬起时记录一次释放事件 */
+        if (pressed || last_pressed)
+            ring_push(&sample);
+        last_pressed = pressed;
+    }
+}
+
+/* ==================== 对外接口 ==================== */
+
+rt_err_t touch_sampler_init(void)
+{
+    rt_err_t err;
+
+    if (sampler_running)
+        return RT_EOK;
+
+    rt_memset(&sampler_stats, 0, sizeof(sampler_stats));
+    sampler_stats.active_hz = TOUCH_SAMPLER_ACTIVE_HZ;
+    sampler_stats.idle_hz = TOUCH_SAMPLER_IDLE_HZ;
+    sampler_stats.cooldown_ms = TOUCH_SAMPLER_COOLDOWN_MS;
+    ring_head = ring_tail = 0;
+
+    rt_sem_init(&touch_irq_sem, "touch", 0, RT_IPC_FLAG_FIFO);
+
+    if (TOUCH_SAMPLER_INT_PIN >= 0)
+    {
+        rt_pin_mode(TOUCH_SAMPLER_INT_PIN, PIN_MODE_INPUT_PULLUP);
+        if (rt_pin_attach_irq(TOUCH_SAMPLER_INT_PIN, PIN_IRQ_MODE_FALLING, touch_irq_handler, RT_NULL) == RT_EOK &&
+            rt_pin_irq_enable(TOUCH_SAMPLER_INT_PIN, PIN_IRQ_ENABLE) == RT_EOK)
+        {
+            sampler_stats.use_irq = true;
+        }
+        else
+        {
+            LOG_W("Touch interrupt unavailable, polling when idle");
+        }
+    }
+
+    err = rt_thread_init(&sampler_thread, "touch",
+                         sampler_thread_entry,
+                         RT_NULL,
+                         &sampler_thread_stack[0],
+                         sizeof(sampler_thread_stack),
+                         TOUCH_SAMPLER_THREAD_PRIO,
+                         10);
+    if (err != RT_EOK)
+    {
+        LOG_E("Failed to create touch sampler thread");
+        return err;
+    }
+    rt_thread_startup(&sampler_thread);
+
+    sampler_running = true;
+    LOG_I("Touch sampler started (%s, active %d Hz)",
+          sampler_stats.use_irq ? "irq" : "poll", sampler_stats.active_hz);
+    return RT_EOK;
+}
+
+bool touch_sampler_is_running(void)
+{
+    return sampler_running;
+}
+
+/* 取出最旧的一个采样，没有采样时返回false */
+bool touch_sampler_pop(touch_sampler_sample_t *sample)
+{
+    rt_base_t level = rt_hw_interrupt_disable();
+
+    if (ring_tail == ring_head)
+    {
+        rt_hw_interrupt_enable(level);
+        return false;
+    }
+    *sample = sample_ring[ring_tail & RING_MASK];
+    ring_tail++;
+
+    rt_hw_interrupt_enable(level);
+    return true;
+}
+
+/* 在之后ms毫秒内保持高速采样，用于惯性滚动等需要及时响应按下的场景 */
+void touch_sampler_keep_alive(rt_uint32_t ms)
+{
+    rt_base_t level;
+    rt_tick_t until = rt_tick_get() + rt_tick_from_millisecond(ms);
+    bool wake = false;
+
+    level = rt_hw_interrupt_disable();
+    if ((rt_int32_t)(until - cooldown_until) > 0)
+        cooldown_until = until;
+    if (sampler_stats.state == TOUCH_SAMPLER_IDLE)
+    {
+        sampler_stats.state = TOUCH_SAMPLER_COOLDOWN;
+        wake = true;
+    }
+    rt_hw_interrupt_enable(level);
+
+    if (wake && sampler_stats.use_irq)
+        rt_sem_release(&touch_irq_sem);
+}
+
+/* 设置采样率，参数为0时保持原值 */
+void touch_sampler_set_rate(rt_uint32_t active_hz, rt_uint32_t idle_hz, rt_uint32_t cooldown_ms)
+{
+    if (active_hz > 0 && active_hz <= 1000)
+        sampler_stats.active_hz = active_hz;
+    if (idle_hz > 0 && idle_hz <= 1000)
+        sampler_stats.idle_hz = idle_hz;
+    if (cooldown_ms > 0)
+        sampler_stats.cooldown_ms = cooldown_ms;
+}
+
+void touch_sampler_get_stats(touch_sampler_stats_t *stats)
+{
+    rt_base_t level = rt_hw_interrupt_disable();
+    *stats = sampler_stats;
+    rt_hw_interrupt_enable(level);
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static void touch_stats_cmd(void)
+{
+    static const char *state_names[] = {"idle", "active", "cooldown"};
+    touch_sampler_stats_t stats;
+
+    touch_sampler_get_stats(&stats);
+    rt_kprintf("state: %s, idle mode: %s\n", state_names[stats.state], stats.use_irq ? "irq" : "poll");
+    rt_kprintf("rate: active %d Hz, idle %d Hz, cooldown %d ms\n",
+               stats.active_hz, stats.idle_hz, stats.cooldown_ms);
+    rt_kprintf("scans: %d (idle %d, active %d), irqs: %d, dropped: %d\n",
+               stats.scans, stats.idle_scans, stats.active_scans, stats.irqs, stats.dropped);
+}
+MSH_CMD_EXPORT_ALIAS(touch_stats_cmd, touch_stats, show adaptive touch sampler statistics);
+
+static void touch_rate_cmd(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        rt_kprintf("usage: touch_rate <active_hz> [idle_hz] [cooldown_ms]\n");
+        return;
+    }
+    touch_sampler_set_rate(atoi(argv[1]),
+                           argc > 2 ? atoi(argv[2]) : 0,
+                           argc > 3 ? atoi(argv[3]) : 0);
+}
+MSH_CMD_EXPORT_ALIAS(touch_rate_cmd, touch_rate, set adaptive touch sampling rate);
+#endif /* RT_USING_FINSH */
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __TOUCH_SAMPLER_H__
+#define __TOUCH_SAMPLER_H__
+
+#include <rtthread.h>
+#include <stdbool.h>
+#include "touch_multi.h"
+
+/* 自适应触摸采样：空闲时只等待触摸中断（没有中断引脚时低速轮询），
+ * 按下期间和抬起后的冷却期内高速采样，采样点带时间戳放入环形缓冲区，
+ * 由LVGL的touchpad_read取出 */
+
+#ifndef TOUCH_SAMPLER_INT_PIN
+#define TOUCH_SAMPLER_INT_PIN       (-1)    /* 触摸中断引脚，-1表示没有中断，空闲时轮询 */
+#endif
+
+#define TOUCH_SAMPLER_ACTIVE_HZ     200     /* 按下时的采样率 */
+#define TOUCH_SAMPLER_IDLE_HZ       10      /* 没有中断引脚时空闲轮询的采样率 */
+#define TOUCH_SAMPLER_COOLDOWN_MS   300     /* 抬起后保持高速采样的时间 */
+#define TOUCH_SAMPLER_RING_SIZE     32      /* 采样缓冲区大小（2的幂） */
+#define TOUCH_SAMPLER_THREAD_STACK  1024
+#define TOUCH_SAMPLER_THREAD_PRIO   (PKG_LVGL_THREAD_PRIO - 1)
+
+typedef enum {
+    TOUCH_SAMPLER_IDLE = 0,     /* 等待中断或低速轮询 */
+    TOUCH_SAMPLER_ACTIVE,       /* 手指按下 */
+    TOUCH_SAMPLER_COOLDOWN,     /* 抬起后或惯性滚动期间 */
+} touch_sampler_state_t;
+
+/* 一次采样结果，包含所有触点的原始坐标 */
+typedef struct {
+    rt_uint32_t t_ms;
+    rt_uint8_t count;               /* 触点数，0表示抬起 */
+    rt_int16_t x[TOUCH_MULTI_MAX_CONTACTS];
+    rt_int16_t y[TOUCH_MULTI_MAX_CONTACTS];
+} touch_sampler_sample_t;
+
+typedef struct {
+    touch_sampler_state_t state;
+    rt_uint32_t active_hz;
+    rt_uint32_t idle_hz;
+    rt_uint32_t cooldown_ms;
+    rt_uint32_t scans;          /* Touch_Scan调用总次数（每次一组I2C传输） */
+    rt_uint32_t idle_scans;
+    rt_uint32_t active_scans;
+    rt_uint32_t irqs;           /* 触摸中断次数 */
+    rt_uint32_t dropped;        /* 缓冲区满丢弃的采样数 */
+    bool use_irq;
+} touch_sampler_stats_t;
+
+rt_err_t touch_sampler_init(void);
+bool touch_sampler_is_running(void);
+bool touch_sampler_pop(touch_sampler_sample_t *sample);
+void touch_sampler_keep_alive(rt_uint32_t ms);
+void touch_sampler_set_rate(rt_uint32_t active_hz, rt_uint32_t idle_hz, rt_uint32_t cooldown_ms);
+void touch_sampler_get_stats(touch_sampler_stats_t *stats);
+
+#endif /* __TOUCH_SAMPLER_H__ */
@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include <stdlib.h>
+#include "ui_quality.h"
+
+static const char *const level_names[UI_QUALITY_LEVELS] = {
+    "full", "no shadow", "no aa", "no blend",
+};
+
+const char *ui_quality_level_name(int level)
+{
+    return (level >= 0 && level < UI_QUALITY_LEVELS) ? level_names[level] : "?";
+}
+
+/* ==================== 决策 ==================== */
+
+void ui_quality_init(ui_quality_t *q, rt_uint32_t budget_us)
+{
+    rt_memset(q, 0, sizeof(ui_quality_t));
+    q->budget_us = budget_us;
+    q->level = UI_QUALITY_FULL;
+    q->locked = -1;
+    q->since_upgrade = 0xFFFF;
+    q->idle = true;
+}
+
+static int bit_count(rt_uint8_t v)
+{
+    int n = 0;
+
+    for (; v; v &= v - 1)
+        n++;
+    return n;
+}
+
+static bool set_level(ui_quality_t *q, int level)
+{
+    if (q->level == level)
+        return false;
+    q->level = (rt_uint8_t)level;
+    q->history = 0;
+    q->fast = 0;
+    q->settle = UI_QUALITY_SETTLE_FRAMES;
+    return true;
+}
+
+bool ui_quality_frame(ui_quality_t *q, rt_uint32_t frame_us, rt_uint32_t now_ms)
+{
+    /* 空闲：一段时间后恢复完整质量，忙碌时的升级限制也一起解除 */
+    if (frame_us < UI_QUALITY_IDLE_US)
+    {
+        if (!q->idle)
+        {
+            q->idle = true;
+            q->idle_since_ms = now_ms;
+        }
+        if (q->locked < 0 && q->level != UI_QUALITY_FULL &&
+            (rt_int32_t)(now_ms - q->idle_since_ms) >= UI_QUALITY_RESTORE_MS)
+        {
+            q->upgrade_blocked = false;
+            q->stats.restores++;
+            return set_level(q, UI_QUALITY_FULL);
+        }
+        return false;
+    }
+
+    q->idle = false;
+    q->stats.frames[q->level]++;
+    if (frame_us > q->budget_us)
+        q->stats.over_budget[q->level]++;
+    q->avg_us = q->avg_us ? q->avg_us - q->avg_us / 4 + frame_us / 4 : frame_us;
+    if (q->since_upgrade < 0xFFFF)
+        q->since_upgrade++;
+
+    /* 切换后的第一帧可能还在按原来的级别绘制 */
+    if (q->locked >= 0)
+        return false;
+    if (q->settle > 0)
+    {
+        q->settle--;
+        return false;
+    }
+
+    q->history = (rt_uint8_t)((q->history << 1) | (frame_us > q->budget_us));
+    if (bit_count(q->history) >= UI_QUALITY_DEGRADE_FRAMES && q->level < UI_QUALITY_LEVELS - 1)
+    {
+        if (q->since_upgrade <= UI_QUALITY_UPGRADE_FRAMES)
+        {
+            q->upgrade_blocked = true;
+            q->stats.upgrade_failures++;
+        }
+        q->stats.degrades++;
+        return set_level(q, q->level + 1);
+    }
+
+    q->fast = (q->avg_us < q->budget_us / 100 * UI_QUALITY_UPGRADE_PCT) ? q->fast + 1 : 0;
+    if (q->fast >= UI_QUALITY_UPGRADE_FRAMES && q->level > UI_QUALITY_FULL && !q->upgrade_blocked)
+    {
+        q->since_upgrade = 0;
+        q->stats.upgrades++;
+        return set_level(q, q->level - 1);
+    }
+    return false;
+}
+
+bool ui_quality_lock(ui_quality_t *q, int level)
+{
+    if (level < 0 || level >= UI_QUALITY_LEVELS)
+    {
+        q->locked = -1;
+        return false;
+    }
+    q->locked = (rt_int8_t)level;
+    return set_level(q, level);
+}
+
+/* ==================== 绘制 ==================== */
+
+static ui_quality_t *quality = RT_NULL;
+static lv_disp_t *quality_disp = RT_NULL;
+static void (*base_draw_rect)(lv_draw_ctx_t *draw_ctx, const lv_draw_rect_dsc_t *dsc, const lv_area_t *coords);
+static bool base_antialiasing;
+static rt_uint8_t applied_level = UI_QUALITY_FULL;
+
+static bool flatten_opa(lv_opa_t *opa)
+{
+    if (*opa == LV_OPA_TRANSP || *opa == LV_OPA_COVER)
+        return false;
+    *opa = (*opa >= LV_OPA_50) ? LV_OPA_COVER : LV_OPA_TRANSP;
+    return true;
+}
+
+/* LVGL的矩形绘制（背景、边框、阴影）都经过这里，按级别去掉效果后交给原来的函数 */
+static void quality_draw_rect(lv_draw_ctx_t *draw_ctx, const lv_draw_rect_dsc_t *dsc, const lv_area_t *coords)
+{
+    lv_draw_rect_dsc_t simple;
+    bool changed = false;
+
+    if (quality->level == UI_QUALITY_FULL)
+    {
+        base_draw_rect(draw_ctx, dsc, coords);
+        return;
+    }
+
+    simple = *dsc;
+    if (simple.shadow_width > 0 && simple.shadow_opa > LV_OPA_TRANSP)
+    {
+        simple.shadow_width = 0;
+        simple.shadow_opa = LV_OPA_TRANSP;
+        changed = true;
+    }
+    if (quality->level >= UI_QUALITY_NO_BLEND)
+    {
+        changed |= flatten_opa(&simple.bg_opa);
+        changed |= flatten_opa(&simple.border_opa);
+        changed |= flatten_opa(&simple.outline_opa);
+    }
+
+    if (changed)
+        quality->stats.simplified++;
+    base_draw_rect(draw_ctx, changed ? &simple : dsc, coords);
+}
+
+void ui_quality_attach(ui_quality_t *q, lv_disp_t *disp)
+{
+    lv_draw_ctx_t *draw_ctx = disp->driver->draw_ctx;
+
+    if (quality_disp != RT_NULL || draw_ctx == RT_NULL)
+        return;
+
+    quality = q;
+    quality_disp = disp;
+    base_draw_rect = draw_ctx->draw_rect;
+    base_antialiasing = disp->driver->antialiasing;
+    draw_ctx->draw_rect = quality_draw_rect;
+}
+
+void ui_quality_apply(ui_quality_t *q)
+{
+    if (quality_disp == RT_NULL)
+        return;
+
+    /* 抗锯齿在绘制时读取驱动的设置 */
+    quality_disp->driver->antialiasing = (q->level >= UI_QUALITY_NO_AA) ? 0 : base_antialiasing;
+
+    /* 降级时不重绘，滚动本来就会重绘；提高质量时把简化绘制的内容重画一遍 */
+    if (q->level < applied_level)
+        lv_obj_invalidate(lv_disp_get_scr_act(quality_disp));
+    applied_level = q->level;
+}
+
+#ifdef APP_USING_TEST
+#include <finsh.h>
+#include "app_test.h"
+
+/* 各级别下重界面一帧的相对开销（百分比），估计值，板上用quality_bench测量实际的比例 */
+static const rt_uint8_t sim_cost_pct[UI_QUALITY_LEVELS] = {100, 70, 58, 45};
+
+typedef struct {
+    const char *name;
+    rt_uint32_t duration_ms;
+    rt_uint32_t cost_us;        /* 完整质量下一帧的时间，0为空闲 */
+} sim_phase_t;
+
+typedef struct {
+    rt_uint32_t frames;
+    rt_uint32_t over;
+    rt_uint32_t time_ms;
+    rt_uint8_t end_level;
+    rt_uint8_t max_level;
+} sim_result_t;
+
+/* ±15%的抖动 */
+static rt_uint32_t sim_jitter(rt_uint32_t us)
+{
+    return us - us * 15 / 100 + us * app_test_rand(31) / 100;
+}
+
+static rt_uint32_t sim_run(ui_quality_t *q, const sim_phase_t *phases, int count, rt_uint32_t period_ms,
+                           sim_result_t *result, bool verbose)
+{
+    rt_uint32_t now = 0, changes = 0;
+
+    app_test_srand(1);
+    for (int p = 0; p < count; p++)
+    {
+        rt_uint32_t end = now + phases[p].duration_ms;
+        sim_result_t *r = &result[p];
+
+        rt_memset(r, 0, sizeof(sim_result_t));
+        r->max_level = q->level;
+        while ((rt_int32_t)(now - end) < 0)
+        {
+            rt_uint32_t us = phases[p].cost_us ? sim_jitter(phases[p].cost_us * sim_cost_pct[q->level] / 100)
+                                               : sim_jitter(300);
+            rt_uint32_t ms = us / 1000;
+
+            if (phases[p].cost_us)
+            {
+                r->frames++;
+                if (us > q->budget_us)
+                    r->over++;
+            }
+            now += (ms > period_ms) ? ms : period_ms;
+            if (ui_quality_frame(q, us, now))
+            {
+                changes++;
+                if (verbose)
+                    rt_kprintf("%6d ms  %-10s -> %s (frame %d us)\n", now, phases[p].name,
+                               ui_quality_level_name(q->level), us);
+            }
+            if (q->level > r->max_level)
+                r->max_level = q->level;
+        }
+        r->time_ms = phases[p].duration_ms;
+        r->end_level = q->level;
+    }
+    return changes;
+}
+
+/* 用模拟的帧时间运行调节策略：空闲、重界面快速滚动、滚动减速、空闲、轻界面滚动、空闲。
+ * 与固定完整质量对比超出预算的帧数和帧率 */
+static void quality_sim_cmd(int argc, char **argv)
+{
+    rt_uint32_t budget = (argc > 2 ? atoi(argv[2]) : LV_DISP_DEF_REFR_PERIOD) * 1000;
+    rt_uint32_t heavy = (argc > 1 ? atoi(argv[1]) : LV_DISP_DEF_REFR_PERIOD * 8 / 5) * 1000;
+    const sim_phase_t phases[] = {
+        {"idle",   1000, 0},
+        {"heavy",  3000, heavy},
+        {"slow",   4000, budget * 2 / 5},
+        {"idle",   1000, 0},
+        {"light",  2000, budget * 2 / 3},
+        {"idle",   1000, 0},
+    };
+    const int count = sizeof(phases) / sizeof(phases[0]);
+    sim_result_t fixed[sizeof(phases) / sizeof(phases[0])];
+    sim_result_t adaptive[sizeof(phases) / sizeof(phases[0])];
+    ui_quality_t q;
+    rt_uint32_t changes;
+    bool pass;
+
+    ui_quality_init(&q, budget);
+    ui_quality_lock(&q, UI_QUALITY_FULL);
+    sim_run(&q, phases, count, budget / 1000, fixed, false);
+
+    ui_quality_init(&q, budget);
+    changes = sim_run(&q, phases, count, budget / 1000, adaptive, true);
+
+    rt_kprintf("budget %d us, heavy frame %d us at full quality\n", budget, heavy);
+    rt_kprintf("phase    fixed: frames over fps | adaptive: frames over fps  end level\n");
+    for (int p = 0; p < count; p++)
+    {
+        if (phases[p].cost_us == 0)
+        {
+            rt_kprintf("%-6s   %44s  %s\n", phases[p].name, "", ui_quality_level_name(adaptive[p].end_level));
+            continue;
+        }
+        rt_kprintf("%-6s   %12d %4d %3d | %15d %4d %3d  %s\n", phases[p].name,
+                   fixed[p].frames, fixed[p].over, fixed[p].frames * 1000 / fixed[p].time_ms,
+                   adaptive[p].frames, adaptive[p].over, adaptive[p].frames * 1000 / adaptive[p].time_ms,
+                   ui_quality_level_name(adaptive[p].end_level));
+    }
+    rt_kprintf("changes %d, degrades %d, upgrades %d (failed %d), restores %d\n", changes,
+               q.stats.degrades, q.stats.upgrades, q.stats.upgrade_failures, q.stats.restores);
+
+    /* 重界面超出预算的帧大幅减少（最低级别也超出预算时至少降到最低级别）并且帧率提高，
+     * 减速后逐级升回完整质量，轻界面不降级，空闲后是完整质量，不来回切换 */
+    pass = (adaptive[1].over * 4 < fixed[1].over || adaptive[1].max_level == UI_QUALITY_LEVELS - 1) &&
+           adaptive[1].frames > fixed[1].frames &&
+           adaptive[2].end_level == UI_QUALITY_FULL && adaptive[2].over == 0 &&
+           adaptive[3].end_level == UI_QUALITY_FULL &&
+           adaptive[4].max_level == UI_QUALITY_FULL &&
+           adaptive[5].end_level == UI_QUALITY_FULL &&
+           changes <= 2 * (UI_QUALITY_LEVELS + 1);
+    rt_kprintf("%s\n", pass ? "PASS" : "FAIL");
+}
+MSH_CMD_EXPORT_ALIAS(quality_sim_cmd, quality_sim, simulate adaptive render quality [heavy_ms] [budget_ms]);
+#endif /* APP_USING_TEST */
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __UI_QUALITY_H__
+#define __UI_QUALITY_H__
+
+#include <rtthread.h>
+#include <stdbool.h>
+#include "lvgl.h"
+
+/* 绘制质量调节：根据测得的帧时间在快速滚动等重绘多的时候临时关闭开销大的效果，
+ * 最近几帧中有多帧超出预算时降一级，每级多关闭一种效果；界面空闲后恢复完整质量并重绘屏幕。
+ * 忙碌时帧时间长期远低于预算也会升一级，升级后马上又超出预算则直到空闲前不再升级，避免来回切换。
+ * 决策部分不调用系统时钟和LVGL，帧时间和时间由调用者传入，可以用模拟的帧时间测试 */
+
+typedef enum {
+    UI_QUALITY_FULL = 0,
+    UI_QUALITY_NO_SHADOW,       /* 不画阴影 */
+    UI_QUALITY_NO_AA,           /* 再关闭抗锯齿（圆角、线条） */
+    UI_QUALITY_NO_BLEND,        /* 再把半透明的背景和边框画成不透明或不画 */
+    UI_QUALITY_LEVELS,
+} ui_quality_level_t;
+
+#define UI_QUALITY_IDLE_US          2000    /* 短于此时间的帧没有重绘，算作空闲 */
+#define UI_QUALITY_DEGRADE_FRAMES   3       /* 最近8帧中超出预算的帧数 */
+#define UI_QUALITY_SETTLE_FRAMES    2       /* 切换后不参与判断的帧数 */
+#define UI_QUALITY_UPGRADE_PCT      50      /* 平均帧时间低于预算的这个比例时可以升级 */
+#define UI_QUALITY_UPGRADE_FRAMES   30
+#define UI_QUALITY_RESTORE_MS       500     /* 空闲多久后恢复完整质量 */
+
+typedef struct {
+    rt_uint32_t degrades;
+    rt_uint32_t upgrades;           /* 忙碌时升级 */
+    rt_uint32_t upgrade_failures;   /* 升级后很快又降级 */
+    rt_uint32_t restores;           /* 空闲后恢复完整质量 */
+    rt_uint32_t frames[UI_QUALITY_LEVELS];      /* 各级别下有重绘的帧数 */
+    rt_uint32_t over_budget[UI_QUALITY_LEVELS];
+    rt_uint32_t simplified;         /* 被简化的矩形绘制次数 */
+} ui_quality_stats_t;
+
+typedef struct {
+    rt_uint32_t budget_us;
+    rt_uint32_t avg_us;             /* 有重绘的帧的平均时间（指数平均） */
+    rt_uint8_t level;
+    rt_int8_t locked;               /* 固定的级别，-1为自动 */
+    rt_uint8_t history;             /* 最近8帧是否超出预算，每帧一位 */
+    rt_uint8_t settle;
+    rt_uint16_t fast;               /* 连续有余量的帧数 */
+    rt_uint16_t since_upgrade;
+    bool upgrade_blocked;
+    bool idle;
+    rt_uint32_t idle_since_ms;
+    ui_quality_stats_t stats;
+} ui_quality_t;
+
+void ui_quality_init(ui_quality_t *q, rt_uint32_t budget_us);
+/* 每次LVGL处理后调用，返回true时级别改变，调用者应调用ui_quality_apply */
+bool ui_quality_frame(ui_quality_t *q, rt_uint32_t frame_us, rt_uint32_t now_ms);
+/* 固定级别（测试和对比用），level为-1时恢复自动，返回true时级别改变 */
+bool ui_quality_lock(ui_quality_t *q, int level);
+
+/* 在disp的绘制函数前插入简化步骤，只需调用一次 */
+void ui_quality_attach(ui_quality_t *q, lv_disp_t *disp);
+/* 使当前级别生效，质量提高时重绘屏幕 */
+void ui_quality_apply(ui_quality_t *q);
+
+const char *ui_quality_level_name(int level);
+
+#endif /* __UI_QUALITY_H__ */
@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#include <rtthread.h>
+#include "ui_workq.h"
+
+#define DBG_TAG "ui.workq"
+#define DBG_LVL DBG_INFO
+#include <rtdbg.h>
+
+/* 工作项 */
+typedef struct ui_work {
+    struct ui_work *next;
+    ui_work_fn_t fn;
+    ui_work_done_fn_t done;
+    rt_err_t result;
+    rt_tick_t submit_tick;          /* 提交时间 */
+    rt_tick_t finish_tick;          /* 执行完成时间 */
+    rt_uint8_t data[UI_WORKQ_DATA_SIZE];
+} ui_work_t;
+
+/* 单向FIFO链表 */
+typedef struct {
+    ui_work_t *head;
+    ui_work_t *tail;
+} ui_work_list_t;
+
+static ui_work_t work_pool[UI_WORKQ_POOL_SIZE];
+static ui_work_t *free_list = RT_NULL;
+static ui_work_list_t pending_lists[UI_WORKQ_PRIO_NUM];
+static ui_work_list_t done_list;
+
+static struct rt_semaphore work_sem;
+static struct rt_thread workq_thread;
+static rt_uint8_t workq_thread_stack[UI_WORKQ_THREAD_STACK];
+static rt_bool_t workq_inited = RT_FALSE;
+
+static ui_workq_stats_t workq_stats;
+static rt_uint32_t queue_latency_sum;
+static rt_uint32_t executed_count;
+
+/* ==================== 链表操作（需在临界区内调用） ==================== */
+
+static void work_list_push(ui_work_list_t *list, ui_work_t *work)
+{
+    work->next = RT_NULL;
+    if (list->tail)
+        list->tail->next = work;
+    else
+        list->head = work;
+    list->tail = work;
+}
+
+static ui_work_t *work_list_pop(ui_work_list_t *list)
+{
+    ui_work_t *work = list->head;
+    if (work)
+    {
+        list->head = work->next;
+        if (list->head == RT_NULL)
+            list->tail = RT_NULL;
+        work->next = RT_NULL;
+    }
+    return work;
+}
+
+/* ==================== 工作线程 ==================== */
+
+static void workq_thread_entry(void *parameter)
+{
+    rt_base_t level;
+    ui_work_t *work;
+    rt_tick_t start, latency, exec;
+
+    while (1)
+    {
+        rt_sem_take(&work_sem, RT_WAITING_FOREVER);
+
+        /* 按优先级取出一个工作 */
+        work = RT_NULL;
+        level = rt_hw_interrupt_disable();
+        for (int prio = 0; prio < UI_WORKQ_PRIO_NUM && work == RT_NULL; prio++)
+        {
+            work = work_list_pop(&pending_lists[prio]);
+        }
+        if (work)
+            workq_stats.pending--;
+        rt_hw_interrupt_enable(level);
+
+        if (work == RT_NULL)
+            continue;
+
+        start = rt_tick_get();
+        work->result = work->fn(work->data);
+        work->finish_tick = rt_tick_get();
+
+        latency = start - work->submit_tick;
+        exec = work->finish_tick - start;
+
+        /* 放入完成队列，等待UI线程派发回调 */
+        level = rt_hw_interrupt_disable();
+        queue_latency_sum += latency;
+        executed_count++;
+        if (latency > workq_stats.queue_latency_max)
+            workq_stats.queue_latency_max = latency;
+        if (exec > workq_stats.exec_time_max)
+            workq_stats.exec_time_max = exec;
+        work_list_push(&done_list, work);
+        rt_hw_interrupt_enable(level);
+    }
+}
+
+/* ==================== 对外接口 ==================== */
+
+/* 初始化工作队列并启动工作线程 */
+rt_err_t ui_workq_init(void)
+{
+    rt_err_t err;
+
+    if (workq_inited)
+        return RT_EOK;
+
+    rt_memset(work_pool, 0, sizeof(work_pool));
+    rt_memset(pending_lists, 0, sizeof(pending_lists));
+    rt_memset(&done_list, 0, sizeof(done_list));
+    rt_memset(&workq_stats, 0, sizeof(workq_stats));
+    queue_latency_sum = 0;
+    executed_count = 0;
+
+    free_list = RT_NULL;
+    for (int i = UI_WORKQ_POOL_SIZE - 1; i >= 0; i--)
+    {
+        work_pool[i].next = free_list;
+        free_list = &work_pool[i];
+    }
+
+    rt_sem_init(&work_sem, "ui_wq", 0, RT_IPC_FLAG_FIFO);
+
+    err = rt_thread_init(&workq_thread, "ui_wq",
+                         workq_thread_entry,
+                         RT_NULL,
+                         &workq_thread_stack[0],
+                         sizeof(workq_thread_stack),
+                         UI_WORKQ_THREAD_PRIO,
+                         10);
+    if (err != RT_EOK)
+    {
+        LOG_E("Failed to create work queue thread");
+        return err;
+    }
+    rt_thread_startup(&workq_thread);
+
+    workq_inited = RT_TRUE;
+    LOG_I("UI work queue started (pool=%d)", UI_WORKQ_POOL_SIZE);
+    return RT_EOK;
+}
+
+/* 提交工作，data会被复制到工作项中（最多UI_WORKQ_DATA_SIZE字节） */
+rt_err_t ui_workq_submit(ui_workq_prio_t prio, ui_work_fn_t fn, ui_work_done_fn_t done,
+                         const void *data, rt_size_t len)
+{
+    rt_base_t level;
+    ui_work_t *work;
+
+    if (!workq_inited || fn == RT_NULL || prio >= UI_WORKQ_PRIO_NUM)
+        return -RT_EINVAL;
+    if (len > UI_WORKQ_DATA_SIZE)
+        return -RT_EINVAL;
+
+    level = rt_hw_interrupt_disable();
+    work = free_list;
+    if (work == RT_NULL)
+    {
+        workq_stats.rejected++;
+        rt_hw_interrupt_enable(level);
+        LOG_W("Work queue full, request dropped");
+        return -RT_EFULL;
+    }
+    free_list = work->next;
+    rt_hw_interrupt_enable(level);
+
+    work->fn = fn;
+    work->done = done;
+    work->result = RT_EOK;
+    rt_memset(work->data, 0, sizeof(work->data));
+    if (data && len)
+        rt_memcpy(work->data, data, len);
+    work->submit_tick = rt_tick_get();
+
+    level = rt_hw_interrupt_disable();
+    work_list_push(&pending_lists[prio], work);
+    workq_stats.submitted++;
+    workq_stats.pending++;
+    if (workq_stats.pending > workq_stats.peak_pending)
+        workq_stats.peak_pending = workq_stats.pending;
+    rt_hw_interrupt_enable(level);
+
+    rt_sem_release(&work_sem);
+    return RT_EOK;
+}
+
+/* 在LVGL线程中调用（持有ui_mutex），派发已完成工作的回调 */
+void ui_workq_dispatch(void)
+{
+    rt_base_t level;
+    ui_work_t *work;
+    rt_tick_t latency;
+
+    if (!workq_inited)
+        return;
+
+    while (1)
+    {
+        level = rt_hw_interrupt_disable();
+        work = work_list_pop(&done_list);
+        rt_hw_interrupt_enable(level);
+
+        if (work == RT_NULL)
+            break;
+
+        latency = rt_tick_get() - work->finish_tick;
+        if (work->done)
+            work->done(work->data, work->result);
+
+        level = rt_hw_interrupt_disable();
+        workq_stats.completed++;
+        if (latency > workq_stats.done_latency_max)
+            workq_stats.done_latency_max = latency;
+        work->next = free_list;
+        free_list = work;
+        rt_hw_interrupt_enable(level);
+    }
+}
+
+/* 获取统计信息 */
+void ui_workq_get_stats(ui_workq_stats_t *stats)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    *stats = workq_stats;
+    if (executed_count > 0)
+        stats->queue_latency_avg = queue_latency_sum / executed_count;
+    rt_hw_interrupt_enable(level);
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static void workq_stats_cmd(void)
+{
+    ui_workq_stats_t stats;
+
+    ui_workq_get_stats(&stats);
+    rt_kprintf("submitted: %d, completed: %d, rejected: %d\n",
+               stats.submitted, stats.completed, stats.rejected);
+    rt_kprintf("pending: %d (peak %d)\n", stats.pending, stats.peak_pending);
+    rt_kprintf("queue latency: avg %d, max %d ticks\n",
+               stats.queue_latency_avg, stats.queue_latency_max);
+    rt_kprintf("exec time max: %d ticks, done latency max: %d ticks\n",
+               stats.exec_time_max, stats.done_latency_max);
+}
+MSH_CMD_EXPORT_ALIAS(workq_stats_cmd, workq_stats, show UI work queue statistics);
+
+#ifdef APP_USING_TEST
+/* 检查运行中的工作队列：先提交一个等待信号量的工作占住工作线程，其余工作在它后面排队，
+ * 放行后应按优先级执行、使用提交时复制的数据，池满时拒绝，完成回调在UI线程中执行 */
+#define WORKQ_TEST_ORDERED  3
+
+static struct rt_semaphore test_gate;
+static rt_thread_t test_worker;
+static char test_order[WORKQ_TEST_ORDERED + 1];
+static volatile int test_order_len;
+static volatile int test_done;
+static volatile rt_bool_t test_wrong;
+
+static rt_err_t test_gate_work(void *data)
+{
+    test_worker = rt_thread_self();
+    rt_sem_take(&test_gate, RT_WAITING_FOREVER);
+    return RT_EOK;
+}
+
+/* 记录执行顺序，高优先级的工作返回错误，检查结果是否传给完成回调 */
+static rt_err_t test_order_work(void *data)
+{
+    char tag = *(char *)data;
+
+    if (test_order_len < WORKQ_TEST_ORDERED)
+        test_order[test_order_len++] = tag;
+    return tag == 'H' ? -RT_EBUSY : RT_EOK;
+}
+
+static rt_err_t test_nop_work(void *data)
+{
+    return RT_EOK;
+}
+
+static void test_done_cb(void *data, rt_err_t result)
+{
+    char tag = *(char *)data;
+
+    if (rt_thread_self() == test_worker || result != (tag == 'H' ? -RT_EBUSY : RT_EOK))
+        test_wrong = RT_TRUE;
+    test_done++;
+}
+
+static void workq_test_cmd(void)
+{
+    ui_workq_stats_t before, after;
+    char tag[2] = "L";
+    int accepted = 0, expect_done;
+    rt_tick_t start;
+    rt_bool_t order_ok, full_ok, done_ok;
+
+    if (!workq_inited)
+    {
+        rt_kprintf("work queue not started\n");
+        return;
+    }
+
+    test_worker = RT_NULL;
+    test_order_len = 0;
+    test_done = 0;
+    test_wrong = RT_FALSE;
+    rt_memset(test_order, 0, sizeof(test_order));
+    rt_sem_init(&test_gate, "wq_test", 0, RT_IPC_FLAG_FIFO);
+
+    if (ui_workq_submit(UI_WORKQ_PRIO_LOW, test_gate_work, test_done_cb, "G", 2) != RT_EOK)
+    {
+        rt_kprintf("work queue busy, try again\n");
+        rt_sem_detach(&test_gate);
+        return;
+    }
+    start = rt_tick_get();
+    while (test_worker == RT_NULL && rt_tick_get() - start < rt_tick_from_millisecond(500))
+        rt_thread_mdelay(1);
+
+    /* 提交后立即修改数据，工作中看到的应是提交时的值 */
+    ui_workq_submit(UI_WORKQ_PRIO_LOW, test_order_work, test_done_cb, tag, sizeof(tag));
+    tag[0] = 'N';
+    ui_workq_submit(UI_WORKQ_PRIO_NORMAL, test_order_work, test_done_cb, tag, sizeof(tag));
+    tag[0] = 'H';
+    ui_workq_submit(UI_WORKQ_PRIO_HIGH, test_order_work, test_done_cb, tag, sizeof(tag));
+    tag[0] = 'X';
+
+    /* 占满工作项池 */
+    ui_workq_get_stats(&before);
+    while (accepted < UI_WORKQ_POOL_SIZE
+           && ui_workq_submit(UI_WORKQ_PRIO_LOW, test_nop_work, test_done_cb, "F", 2) == RT_EOK)
+    {
+        accepted++;
+    }
+    ui_workq_get_stats(&after);
+    full_ok = accepted <= UI_WORKQ_POOL_SIZE - 1 - WORKQ_TEST_ORDERED
+              && after.rejected == before.rejected + 1;
+
+    /* 放行，等UI线程派发所有完成回调 */
+    rt_sem_release(&test_gate);
+    expect_done = 1 + WORKQ_TEST_ORDERED + accepted;
+    start = rt_tick_get();
+    while (test_done < expect_done && rt_tick_get() - start < rt_tick_from_millisecond(1000))
+        rt_thread_mdelay(10);
+    rt_sem_detach(&test_gate);
+
+    order_ok = rt_strcmp(test_order, "HNL") == 0;
+    done_ok = test_done == expect_done && !test_wrong;
+    rt_kprintf("order: %s (expected HNL)  %s\n", test_order, order_ok ? "PASS" : "FAIL");
+    rt_kprintf("pool full after %d more works  %s\n", accepted, full_ok ? "PASS" : "FAIL");
+    rt_kprintf("done callbacks: %d of %d in UI thread  %s\n", test_done, expect_done, done_ok ? "PASS" : "FAIL");
+    rt_kprintf("workq_test: %s\n", order_ok && full_ok && done_ok ? "PASS" : "FAIL");
+}
+MSH_CMD_EXPORT_ALIAS(workq_test_cmd, workq_test, check work queue priority and completion);
+#endif /* APP_USING_TEST */
+#endif /* RT_USING_FINSH */
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2006-2025, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     RT-Thread    first version
+ */
+
+#ifndef __UI_WORKQ_H__
+#define __UI_WORKQ_H__
+
+#include <rtthread.h>
+
+/* 后台工作队列：UI事件中的阻塞操作（串口发送、存储写入等）都提交到这里执行，
+ * 完成回调再回到LVGL线程中（持有ui_mutex时）执行，保证渲染路径上没有阻塞调用 */
+
+#define UI_WORKQ_POOL_SIZE      16      /* 工作项池大小 */
+#define UI_WORKQ_DATA_SIZE      64      /* 每个工作项携带的数据大小 */
+#define UI_WORKQ_THREAD_STACK   2048
+#define UI_WORKQ_THREAD_PRIO    (PKG_LVGL_THREAD_PRIO + 2)
+
+/* 工作优先级，数值越小越先执行 */
+typedef enum {
+    UI_WORKQ_PRIO_HIGH = 0,     /* 用户命令 */
+    UI_WORKQ_PRIO_NORMAL,       /* 普通后台任务 */
+    UI_WORKQ_PRIO_LOW,          /* 日志、统计等 */
+    UI_WORKQ_PRIO_NUM
+} ui_workq_prio_t;
+
+/* 在工作线程中执行，data指向提交时复制的数据 */
+typedef rt_err_t (*ui_work_fn_t)(void *data);
+/* 在UI线程中执行，result为工作函数的返回值 */
+typedef void (*ui_work_done_fn_t)(void *data, rt_err_t result);
+
+/* 队列统计信息，时间单位为tick */
+typedef struct {
+    rt_uint32_t submitted;          /* 提交总数 */
+    rt_uint32_t completed;          /* 完成总数 */
+    rt_uint32_t rejected;           /* 池满被拒绝的次数 */
+    rt_uint32_t pending;            /* 当前等待执行的数量 */
+    rt_uint32_t peak_pending;       /* 等待数量峰值 */
+    rt_uint32_t queue_latency_avg;  /* 提交到开始执行的平均延迟 */
+    rt_uint32_t queue_latency_max;  /* 提交到开始执行的最大延迟 */
+    rt_uint32_t exec_time_max;      /* 单个工作最长执行时间 */
+    rt_uint32_t done_latency_max;   /* 执行完成到UI回调的最大延迟 */
+} ui_workq_stats_t;
+
+rt_err_t ui_workq_init(void);
+rt_err_t ui_workq_submit(ui_workq_prio_t prio, ui_work_fn_t fn, ui_work_done_fn_t done,
+                         const void *data, rt_size_t len);
+void ui_workq_dispatch(void);
+void ui_workq_get_stats(ui_workq_stats_t *stats);
+
+#endif /* __UI_WORKQ_H__ */
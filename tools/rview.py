@@ -0,0 +1,259 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2006-2025, RT-Thread Development Team
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Change Logs:
+# Date           Author       Notes
+# 2026-10-18     RT-Thread    first version
+#
+"""Viewer for the board's remote view stream (applications/rview.h).
+
+Start the stream on the board with `rview start <link> [fps]`, then:
+
+    python3 tools/rview.py /dev/ttyUSB1 --baud 921600
+    python3 tools/rview.py capture.bin --png frame.png
+
+Only the standard library is needed. The frame is shown with tkinter when it is
+available, --png writes the latest complete frame after every FRAME_END.
+"""
+
+import argparse
+import base64
+import os
+import struct
+import sys
+import threading
+import zlib
+
+MAGIC = b"RV"
+PKT_FRAME_BEGIN = 1
+PKT_RECT = 2
+PKT_FRAME_END = 3
+ENC_RAW = 0
+ENC_RLE = 1
+ENC_PALETTE = 2
+BAND_PIXELS = 2048
+PALETTE_MAX = 16
+RECT_HEADER = 8
+BODY_MAX = RECT_HEADER + 1 + BAND_PIXELS * 2
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE, same as the board."""
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def decode(data, count):
+    """Decode one band into a list of RGB565 pixels, None when malformed."""
+    if not data:
+        return None
+    enc, body = data[0], data[1:]
+    if enc == ENC_RAW:
+        if len(body) != count * 2:
+            return None
+        return list(struct.unpack("<%dH" % count, body))
+    if enc == ENC_RLE:
+        out, i = [], 0
+        while i < len(body):
+            h = body[i]
+            i += 1
+            if h < 0x80:
+                if i + 2 > len(body):
+                    return None
+                out.extend([body[i] | body[i + 1] << 8] * (h + 1))
+                i += 2
+            else:
+                n = h - 0x7F
+                if i + n * 2 > len(body):
+                    return None
+                out.extend(struct.unpack_from("<%dH" % n, body, i))
+                i += n * 2
+        return out if len(out) == count else None
+    if enc == ENC_PALETTE:
+        if not body or not 1 <= body[0] <= PALETTE_MAX:
+            return None
+        ncol = body[0]
+        bits = 1 if ncol <= 2 else 2 if ncol <= 4 else 4
+        if len(body) != 1 + ncol * 2 + (count * bits + 7) // 8:
+            return None
+        colors = struct.unpack_from("<%dH" % ncol, body, 1)
+        idx = body[1 + ncol * 2:]
+        mask = (1 << bits) - 1
+        out = []
+        for i in range(count):
+            v = (idx[i * bits // 8] >> (i * bits % 8)) & mask
+            if v >= ncol:
+                return None
+            out.append(colors[v])
+        return out
+    return None
+
+
+class Viewer:
+    """Reassembles packets and keeps the remote frame as RGB565 pixels."""
+
+    def __init__(self):
+        self.buf = bytearray()
+        self.width = self.height = 0
+        self.fb = []
+        self.frames = self.crc_errors = self.decode_errors = 0
+        self.on_frame = None
+
+    def feed(self, data):
+        self.buf += data
+        while True:
+            start = self.buf.find(MAGIC)
+            if start < 0:
+                del self.buf[:-1]
+                return
+            del self.buf[:start]
+            if len(self.buf) < 5:
+                return
+            ptype, length = self.buf[2], self.buf[3] | self.buf[4] << 8
+            if length > BODY_MAX:
+                del self.buf[:2]
+                continue
+            if len(self.buf) < length + 7:
+                return
+            packet = bytes(self.buf[:length + 7])
+            if crc16(packet[2:5 + length]) != (packet[5 + length] | packet[6 + length] << 8):
+                self.crc_errors += 1
+                del self.buf[:2]
+                continue
+            del self.buf[:length + 7]
+            self.handle(ptype, packet[5:5 + length])
+
+    def handle(self, ptype, body):
+        if ptype == PKT_FRAME_BEGIN and len(body) == 6:
+            _, w, h = struct.unpack("<3H", body)
+            if (w, h) != (self.width, self.height):
+                self.width, self.height = w, h
+                self.fb = [0] * (w * h)
+        elif ptype == PKT_RECT and len(body) > RECT_HEADER and self.fb:
+            x, y, w, h = struct.unpack_from("<4H", body)
+            px = None
+            if w and h and x + w <= self.width and y + h <= self.height and w * h <= BAND_PIXELS:
+                px = decode(body[RECT_HEADER:], w * h)
+            if px is None:
+                self.decode_errors += 1
+                return
+            for row in range(h):
+                o = (y + row) * self.width + x
+                self.fb[o:o + w] = px[row * w:(row + 1) * w]
+        elif ptype == PKT_FRAME_END:
+            self.frames += 1
+            if self.on_frame and self.fb:
+                self.on_frame()
+
+    def rgb(self):
+        out = bytearray(len(self.fb) * 3)
+        for i, c in enumerate(self.fb):
+            r, g, b = c >> 11, (c >> 5) & 0x3F, c & 0x1F
+            out[i * 3:i * 3 + 3] = bytes(((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)))
+        return bytes(out)
+
+    def ppm(self):
+        return b"P6 %d %d 255\n" % (self.width, self.height) + self.rgb()
+
+    def write_png(self, path):
+        rgb, stride = self.rgb(), self.width * 3
+        raw = b"".join(b"\x00" + rgb[y * stride:(y + 1) * stride] for y in range(self.height))
+
+        def chunk(tag, data):
+            return struct.pack(">I", len(data)) + tag + data + struct.pack(">I", zlib.crc32(tag + data))
+
+        with open(path + ".tmp", "wb") as f:
+            f.write(b"\x89PNG\r\n\x1a\n")
+            f.write(chunk(b"IHDR", struct.pack(">2I5B", self.width, self.height, 8, 2, 0, 0, 0)))
+            f.write(chunk(b"IDAT", zlib.compress(raw)))
+            f.write(chunk(b"IEND", b""))
+        os.replace(path + ".tmp", path)
+
+
+def open_source(path, baud):
+    if path == "-":
+        return sys.stdin.buffer
+    f = open(path, "rb", buffering=0)
+    if baud and os.isatty(f.fileno()):
+        import termios
+        import tty
+        tty.setraw(f.fileno())
+        attrs = termios.tcgetattr(f.fileno())
+        speed = getattr(termios, "B%d" % baud)
+        attrs[4] = attrs[5] = speed
+        termios.tcsetattr(f.fileno(), termios.TCSANOW, attrs)
+    return f
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("source", help="serial device, capture file or - for stdin")
+    ap.add_argument("--baud", type=int, default=0, help="set the serial port speed")
+    ap.add_argument("--png", help="write the latest frame to this PNG file")
+    ap.add_argument("--no-gui", action="store_true", help="do not open a window")
+    args = ap.parse_args()
+
+    src = open_source(args.source, args.baud)
+    viewer = Viewer()
+    lock = threading.Lock()
+    done = threading.Event()
+    updated = threading.Event()
+
+    def frame_done():
+        if args.png:
+            viewer.write_png(args.png)
+        updated.set()
+
+    viewer.on_frame = frame_done
+
+    def reader():
+        while True:
+            data = src.read(4096)
+            if not data:
+                break
+            with lock:
+                viewer.feed(data)
+        done.set()
+
+    tk = None
+    if not args.no_gui:
+        try:
+            import tkinter
+            tk = tkinter.Tk()
+        except Exception:
+            tk = None
+
+    threading.Thread(target=reader, daemon=True).start()
+
+    if tk is None:
+        done.wait()
+    else:
+        tk.title("rview")
+        label = tkinter.Label(tk)
+        label.pack()
+
+        def poll():
+            if updated.is_set():
+                updated.clear()
+                with lock:
+                    data = viewer.ppm()
+                label.image = tkinter.PhotoImage(data=base64.b64encode(data), format="PPM")
+                label.configure(image=label.image)
+                tk.title("rview %dx%d frame %d" % (viewer.width, viewer.height, viewer.frames))
+            tk.after(50, poll)
+
+        poll()
+        tk.mainloop()
+
+    print("%d frames, %d crc errors, %d decode errors" % (viewer.frames, viewer.crc_errors, viewer.decode_errors))
+
+
+if __name__ == "__main__":
+    main()